@@ -66,6 +66,12 @@ static std::string mmsi(
     return to_string_dec_uint(mmsi, 9, '0');  // MMSI is always is always 9 characters pre-padded with zeros
 }
 
+static StringBuilder& mmsi(
+    StringBuilder& s,
+    const ais::MMSI& mmsi) {
+    return s.append_dec_uint(mmsi, 9, '0');
+}
+
 static std::string mid(
     const ais::MMSI& mmsi) {
     database db;
@@ -91,6 +97,11 @@ static std::string text(const std::string& text) {
     return (end == std::string::npos) ? "" : text.substr(0, end + 1);
 }
 
+static StringBuilder& text(StringBuilder& s, std::string_view text) {
+    size_t end = text.find_last_not_of("@");
+    return (end == std::string_view::npos) ? s : s.append(text.substr(0, end + 1));
+}
+
 static std::string navigational_status(const unsigned int value) {
     switch (value) {
         case 0:
@@ -184,13 +195,13 @@ static std::string true_heading(const TrueHeading value) {
 
 void AISLogger::on_packet(const ais::Packet& packet) {
     // TODO: Unstuff here, not in baseband!
-    std::string entry;
-    entry.reserve((packet.length() + 3) / 4);
+    StringBuilder entry{line};
 
     for (size_t i = 0; i < packet.length(); i += 4) {
         const auto nibble = packet.read(i, 4);
-        entry += (nibble >= 10) ? ('W' + nibble) : ('0' + nibble);
+        entry.append((nibble >= 10) ? ('W' + nibble) : ('0' + nibble));
     }
+    entry.append(" S:").append_dec_uint(packet.sample_index());
 
     log_file.write_entry(packet.received_at(), entry);
 
@@ -273,11 +284,13 @@ void RecentEntriesTable<AISRecentEntries>::draw(
     const Rect& target_rect,
     Painter& painter,
     const Style& style) {
-    std::string line = ais::format::mmsi(entry.mmsi) + " ";
+    // Drawn for every row on every repaint, built without allocating.
+    StringBuffer<64> line;
+    ais::format::mmsi(line, entry.mmsi).append(' ');
     if (!entry.name.empty()) {
-        line += ais::format::text(entry.name);
+        ais::format::text(line, entry.name);
     } else {
-        line += ais::format::text(entry.call_sign);
+        ais::format::text(line, entry.call_sign);
     }
 
     line.resize(target_rect.width() / 8, ' ');
@@ -396,8 +409,10 @@ AISAppView::AISAppView(NavigationView& nav)
 
     options_channel.on_change = [this](size_t, OptionsField::value_t v) {
         receiver_model.set_target_frequency(v);
+        baseband::set_ais(v == ais_dual_channel_frequency);
     };
     options_channel.set_by_value(receiver_model.target_frequency());
+    baseband::set_ais(receiver_model.target_frequency() == ais_dual_channel_frequency);
 
     recent_entries_view.on_select = [this](const AISRecentEntry& entry) {
         on_show_detail(entry);
@@ -40,6 +40,7 @@
 #include "lpc43xx_cpp.hpp"
 using namespace lpc43xx;
 
+#include <array>
 #include <cstdint>
 #include <cstddef>
 #include <string>
@@ -107,6 +108,8 @@ class AISLogger {
 
    private:
     LogFile log_file{};
+    // The longest message is 1008 bits, logged as nibbles with its FCS and flag.
+    std::array<char, 288> line{};
 };
 
 namespace ui {
@@ -162,8 +165,11 @@ class AISAppView : public View {
     std::string title() const override { return "AIS RX"; };
 
    private:
+    // 87B and 88B together, decoded either side of the center.
+    static constexpr uint32_t ais_dual_channel_frequency = 162000000;
+
     RxRadioState radio_state_{
-        162025000 /* frequency*/,
+        ais_dual_channel_frequency /* frequency*/,
         1750000 /* bandwidth */,
         2457600 /* sampling rate */
     };
@@ -194,6 +200,7 @@ class AISAppView : public View {
         {
             {"87B", 161975000},
             {"88B", 162025000},
+            {"A+B", ais_dual_channel_frequency},
         }};
 
     RFAmpField field_rf_amp{
@@ -235,6 +235,8 @@ void BLECommView::switch_rx_tx(bool inRxMode) {
         // Start Rx
         transmitter_model.disable();
         baseband::shutdown();
+        receiver_model.set_sampling_rate(BTLERxConfigureMessage::sampling_rate);
+        receiver_model.set_baseband_bandwidth(BTLERxConfigureMessage::baseband_bandwidth);
         baseband::run_image(portapack::spi_flash::image_tag_btle_rx);
     } else {
         // Start Tx
@@ -82,8 +82,8 @@ class BLECommView : public View {
 
     RxRadioState radio_state_rx_{
         2'402'000'000 /* frequency */,
-        4'000'000 /* bandwidth */,
-        4'000'000 /* sampling rate */,
+        BTLERxConfigureMessage::baseband_bandwidth,
+        BTLERxConfigureMessage::sampling_rate,
         ReceiverModel::Mode::WidebandFMAudio};
 
     TxRadioState radio_state_tx_{
@@ -39,7 +39,7 @@ using namespace portapack;
 using namespace modems;
 namespace fs = std::filesystem;
 
-void BLELogger::log_raw_data(const std::string& data) {
+void BLELogger::log_raw_data(std::string_view data) {
     log_file.write_entry(data);
 }
 
@@ -127,34 +127,17 @@ void RecentEntriesTable<BleRecentEntries>::draw(
     const Rect& target_rect,
     Painter& painter,
     const Style& style) {
-    std::string line{};
-    line.reserve(30);
+    // Drawn for every row on every repaint, built without allocating.
+    StringBuffer<64> line;
 
     if (!entry.nameString.empty() && entry.include_name) {
-        line = entry.nameString;
-
-        if (line.length() < 17) {
-            line += pad_string_with_spaces(17 - line.length());
-        } else {
-            line = truncate(line, 17);
-        }
+        line.append(entry.nameString).resize(17);
     } else {
-        line = to_string_mac_address(entry.packetData.macAddress, 6, false);
+        append_mac_address(line, entry.packetData.macAddress, 6, false);
     }
 
     // Pushing single digit values down right justified.
-    std::string hitsStr = to_string_dec_int(entry.numHits);
-    int hitsDigits = hitsStr.length();
-    uint8_t hits_spacing = 8 - hitsDigits;
-
-    // Pushing single digit values down right justified.
-    std::string dbStr = to_string_dec_int(entry.dbValue);
-    int dbDigits = dbStr.length();
-    uint8_t db_spacing = 5 - dbDigits;
-
-    line += pad_string_with_spaces(hits_spacing) + hitsStr;
-
-    line += pad_string_with_spaces(db_spacing) + dbStr;
+    line.append_dec(entry.numHits, 8).append_dec(entry.dbValue, 5);
 
     line.resize(target_rect.width() / 8, ' ');
     painter.draw_string(target_rect.location(), style, line);
@@ -410,6 +393,9 @@ void BLERxView::file_error() {
 
 BLERxView::BLERxView(NavigationView& nav)
     : nav_{nav} {
+    // Saved settings may hold the old rate, the processor needs this one.
+    receiver_model.set_sampling_rate(BTLERxConfigureMessage::sampling_rate);
+    receiver_model.set_baseband_bandwidth(BTLERxConfigureMessage::baseband_bandwidth);
     baseband::run_image(portapack::spi_flash::image_tag_btle_rx);
 
     add_children({&rssi,
@@ -551,20 +537,27 @@ BLERxView::BLERxView(NavigationView& nav)
     receiver_model.enable();
 }
 
-std::string BLERxView::build_line_str(BleRecentEntry entry) {
-    std::string macAddressStr = to_string_mac_address(entry.packetData.macAddress, 6, false) + ",";
-    std::string timestameStr = entry.timestamp + ",";
-    std::string nameStr = entry.nameString + ",";
-    std::string pduStr = pdu_type_to_string(entry.pduType) + ",";
-    std::string dataStr = "0x" + entry.dataString + ",";
-    std::string hitsStr = to_string_dec_int(entry.numHits) + ",";
-    std::string dbStr = to_string_dec_int(entry.dbValue) + ",";
-    std::string channelStr = to_string_dec_int(entry.channelNumber) + ",";
-
-    std::string lineStr = timestameStr + macAddressStr + nameStr + pduStr + dataStr + hitsStr + dbStr + channelStr;
-    lineStr += pad_string_with_spaces(maxLineLength - lineStr.length());
-
-    return lineStr;
+std::string_view BLERxView::build_line_str(const BleRecentEntry& entry) {
+    // Records are a fixed maxLineLength so they can be updated in place,
+    // longer ones are cut short.
+    StringBuilder line{line_buffer};
+    line.append(entry.timestamp).append(',');
+    append_mac_address(line, entry.packetData.macAddress, 6, false).append(',');
+    line.append(entry.nameString)
+        .append(',')
+        .append(pdu_type_to_string(entry.pduType))
+        .append(",0x")
+        .append(entry.dataString)
+        .append(',')
+        .append_dec(entry.numHits)
+        .append(',')
+        .append_dec(entry.dbValue)
+        .append(',')
+        .append_dec(entry.channelNumber)
+        .append(',')
+        .resize(maxLineLength);
+
+    return line.view();
 }
 
 void BLERxView::on_save_file(const std::string value) {
@@ -598,7 +591,7 @@ bool BLERxView::saveFile(const std::filesystem::path& path) {
 
         while (it != tempList.end()) {
             BleRecentEntry entry = (BleRecentEntry)*it;
-            src->write_line(build_line_str(entry).c_str());
+            src->write_line(build_line_str(entry));
             it++;
         }
     } else {
@@ -666,7 +659,7 @@ bool BLERxView::saveFile(const std::filesystem::path& path) {
             }
 
             if (foundEntry.entryFound) {
-                dst->write_line(build_line_str(foundEntry).c_str());
+                dst->write_line(build_line_str(foundEntry));
             }
 
         } while (bytePos <= currentSize);
@@ -678,7 +671,7 @@ bool BLERxView::saveFile(const std::filesystem::path& path) {
             BleRecentEntry entry = (BleRecentEntry)*it;
 
             if (!entry.entryFound) {
-                dst->write_line(build_line_str(entry).c_str());
+                dst->write_line(build_line_str(entry));
             }
 
             it++;
@@ -703,18 +696,13 @@ void BLERxView::on_data(BlePacketData* packet) {
         str_log = "";
     }
 
-    str_console += pdu_type_to_string((ADV_PDU_TYPE)packet->type);
-    str_console += " Len:";
-    str_console += to_string_dec_uint(packet->size);
-    str_console += " Mac:";
-    str_console += to_string_mac_address(packet->macAddress, 6, false);
-    str_console += " Data:";
-
-    int i;
-
-    for (i = 0; i < packet->dataLen; i++) {
-        str_console += to_string_hex(packet->data[i], 2);
-    }
+    StringBuilder console_line{console_buffer};
+    console_line.append(pdu_type_to_string((ADV_PDU_TYPE)packet->type))
+        .append(" Len:")
+        .append_dec_uint(packet->size)
+        .append(" Mac:");
+    append_mac_address(console_line, packet->macAddress, 6, false).append(" Data:");
+    append_hex_array(console_line, packet->data, packet->dataLen);
 
     uint64_t macAddressEncoded = copy_mac_address_to_uint64(packet->macAddress);
 
@@ -732,16 +720,16 @@ void BLERxView::on_data(BlePacketData* packet) {
 
     handle_entries_sort(options_sort.selected_index());
 
-    // Log at End of Packet.
-    if (logger && logging) {
-        logger->log_raw_data(str_console + "\r\n");
-    }
-
     if (serial_logging) {
-        usb_serial_thread->serial_str = str_console + "\r\n";
+        usb_serial_thread->serial_str = std::string{console_line.view()} + "\r\n";
         usb_serial_thread->str_ready = true;
     }
-    str_console = "";
+
+    // Log at End of Packet, the log file ends the line itself.
+    if (logger && logging) {
+        console_line.append(" S:").append_dec_uint(packet->sampleIndex);
+        logger->log_raw_data(console_line);
+    }
 
     if (!searchList.empty()) {
         auto it = searchList.begin();
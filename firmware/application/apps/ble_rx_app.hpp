@@ -46,7 +46,7 @@ class BLELogger {
         return log_file.append(filename);
     }
 
-    void log_raw_data(const std::string& data);
+    void log_raw_data(std::string_view data);
 
    private:
     LogFile log_file{};
@@ -193,7 +193,7 @@ class BLERxView : public View {
     std::string title() const override { return "BLE RX"; };
 
    private:
-    std::string build_line_str(BleRecentEntry entry);
+    std::string_view build_line_str(const BleRecentEntry& entry);
     void on_save_file(const std::string value);
     bool saveFile(const std::filesystem::path& path);
     std::unique_ptr<UsbSerialThread> usb_serial_thread{};
@@ -209,8 +209,8 @@ class BLERxView : public View {
     NavigationView& nav_;
     RxRadioState radio_state_{
         2402000000 /* frequency */,
-        4000000 /* bandwidth */,
-        4000000 /* sampling rate */,
+        BTLERxConfigureMessage::baseband_bandwidth,
+        BTLERxConfigureMessage::sampling_rate,
         ReceiverModel::Mode::WidebandFMAudio};
 
     uint8_t channel_index{0};
@@ -235,7 +235,8 @@ class BLERxView : public View {
             {"name"sv, &name_enable},
         }};
 
-    std::string str_console = "";
+    // Type, length, MAC and up to 40 data bytes in hex, then the sample index.
+    std::array<char, 176> console_buffer{};
     uint8_t console_color{0};
     uint32_t prev_value{0};
     uint8_t channel_number = 37;
@@ -247,7 +248,8 @@ class BLERxView : public View {
     std::string filterBuffer{};
     std::string listFileBuffer{};
     std::string headerStr = "Timestamp, MAC Address, Name, Packet Type, Data, Hits, dB, Channel";
-    uint16_t maxLineLength = 140;
+    static constexpr uint16_t maxLineLength = 140;
+    std::array<char, maxLineLength + 1> line_buffer{};
 
     std::filesystem::path file_path{};
     uint64_t found_count = 0;
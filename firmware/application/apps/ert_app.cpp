@@ -39,38 +39,38 @@ namespace ert {
 
 namespace format {
 
-std::string type(Packet::Type value) {
+StringBuilder& type(StringBuilder& s, Packet::Type value) {
     switch (value) {
         default:
         case Packet::Type::Unknown:
-            return "???";
+            return s.append("???");
         case Packet::Type::IDM:
-            return "IDM";
+            return s.append("IDM");
         case Packet::Type::SCM:
-            return "SCM";
+            return s.append("SCM");
         case Packet::Type::SCMPLUS:
-            return "SCM+";
+            return s.append("SCM+");
     }
 }
 
-std::string id(ID value) {
-    return to_string_dec_uint(value, 10);
+StringBuilder& id(StringBuilder& s, ID value) {
+    return s.append_dec_uint(value, 10);
 }
 
-std::string consumption(Consumption value) {
-    return to_string_dec_uint(value, 8);
+StringBuilder& consumption(StringBuilder& s, Consumption value) {
+    return s.append_dec_uint(value, 8);
 }
 
-std::string commodity_type(CommodityType value) {
-    return to_string_dec_uint(value, 2);
+StringBuilder& commodity_type(StringBuilder& s, CommodityType value) {
+    return s.append_dec_uint(value, 2);
 }
 
-std::string tamper_flags(TamperFlags value) {
-    return to_string_hex(value & 0xFFFF, 4);  // Note: ignoring bits 32-47 of tamper flags in IDM type due to screen width
+StringBuilder& tamper_flags(StringBuilder& s, TamperFlags value) {
+    return s.append_hex(value & 0xFFFF, 4);  // Note: ignoring bits 32-47 of tamper flags in IDM type due to screen width
 }
 
-std::string tamper_flags_scm(TamperFlags value) {
-    return " " + to_string_hex(value & 0x0F, 1) + "/" + to_string_hex(value >> 4, 1);  // Physical/Encoder flags
+StringBuilder& tamper_flags_scm(StringBuilder& s, TamperFlags value) {
+    return s.append(' ').append_hex(value & 0x0F, 1).append('/').append_hex(value >> 4, 1);  // Physical/Encoder flags
 }
 
 } /* namespace format */
@@ -79,9 +79,18 @@ std::string tamper_flags_scm(TamperFlags value) {
 
 void ERTLogger::on_packet(const ert::Packet& packet, const uint32_t target_frequency) {
     const auto formatted = packet.symbols_formatted();
-    const auto target_frequency_str = to_string_dec_uint(target_frequency, 10);
 
-    std::string entry = target_frequency_str + " " + ert::format::type(packet.type()) + " " + formatted.data + "/" + formatted.errors + " ID:" + to_string_dec_uint(packet.id(), 1);
+    StringBuilder entry{line};
+    entry.append_dec_uint(target_frequency, 10).append(' ');
+    ert::format::type(entry, packet.type())
+        .append(' ')
+        .append(formatted.data)
+        .append('/')
+        .append(formatted.errors)
+        .append(" ID:")
+        .append_dec_uint(packet.id())
+        .append(" S:")
+        .append_dec_uint(packet.sample_index());
 
     log_file.write_entry(packet.received_at(), entry);
 }
@@ -104,10 +113,21 @@ void RecentEntriesTable<ERTRecentEntries>::draw(
     const Rect& target_rect,
     Painter& painter,
     const Style& style) {
-    std::string line = ert::format::id(entry.id) + " " + ert::format::commodity_type(entry.commodity_type) + " " + ert::format::consumption(entry.last_consumption) + " ";
-
-    line += (entry.packet_type == ert::Packet::Type::SCM) ? ert::format::tamper_flags_scm(entry.last_tamper_flags) : ert::format::tamper_flags(entry.last_tamper_flags);
-    line += (entry.received_count > 99) ? " ++" : to_string_dec_uint(entry.received_count, 3);
+    // Drawn for every row on every repaint, built without allocating.
+    StringBuffer<64> line;
+    ert::format::id(line, entry.id).append(' ');
+    ert::format::commodity_type(line, entry.commodity_type).append(' ');
+    ert::format::consumption(line, entry.last_consumption).append(' ');
+
+    if (entry.packet_type == ert::Packet::Type::SCM)
+        ert::format::tamper_flags_scm(line, entry.last_tamper_flags);
+    else
+        ert::format::tamper_flags(line, entry.last_tamper_flags);
+
+    if (entry.received_count > 99)
+        line.append(" ++");
+    else
+        line.append_dec_uint(entry.received_count, 3);
 
     line.resize(target_rect.width() / 8, ' ');
     painter.draw_string(target_rect.location(), style, line);
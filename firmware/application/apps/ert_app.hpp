@@ -38,6 +38,7 @@
 
 #include "recent_entries.hpp"
 
+#include <array>
 #include <cstddef>
 #include <string>
 
@@ -102,6 +103,8 @@ class ERTLogger {
 
    private:
     LogFile log_file{};
+    // Frequency, type, IDM symbols and errors in hex, ID and sample index.
+    std::array<char, 448> line{};
 };
 
 using ERTRecentEntries = RecentEntries<ERTRecentEntry>;
@@ -34,18 +34,31 @@ using namespace pocsag;
 namespace pmem = portapack::persistent_memory;
 
 void POCSAGLogger::log_raw_data(const pocsag::POCSAGPacket& packet, const uint32_t frequency) {
-    std::string entry = "Raw: F:" + to_string_dec_uint(frequency) + "Hz " +
-                        to_string_dec_uint(packet.bitrate()) + " Codewords:";
+    StringBuilder entry{line};
+    entry.append("Raw: F:")
+        .append_dec_uint(frequency)
+        .append("Hz ")
+        .append_dec_uint(packet.bitrate())
+        .append(" Codewords:");
 
     // Raw hex dump of all the codewords
     for (size_t c = 0; c < 16; c++)
-        entry += to_string_hex(packet[c], 8) + " ";
+        entry.append_hex(packet[c], 8).append(' ');
+    entry.append("S:").append_dec_uint(packet.sample_index());
 
     log_file.write_entry(packet.timestamp(), entry);
 }
 
-void POCSAGLogger::log_decoded(Timestamp timestamp, const std::string& text) {
-    log_file.write_entry(timestamp, text);
+void POCSAGLogger::log_decoded(const pocsag::POCSAGPacket& packet, const POCSAGState& state) {
+    StringBuilder entry{line};
+    entry.append_dec_uint(state.address)
+        .append(" F")
+        .append_dec_uint(state.function);
+    if (state.out_type == MESSAGE)
+        entry.append(' ').append(state.output);
+    entry.append(" S:").append_dec_uint(packet.sample_index());
+
+    log_file.write_entry(packet.timestamp(), entry);
 }
 
 namespace ui {
@@ -199,7 +212,7 @@ bool POCSAGAppView::ignore_address(uint32_t address) const {
     }
 }
 
-void POCSAGAppView::handle_decoded(Timestamp timestamp, const std::string& prefix) {
+void POCSAGAppView::handle_decoded(const pocsag::POCSAGPacket& packet, const std::string& prefix) {
     bool bad_data = pocsag_state.errors >= 3;
 
     // Too many errors for reliable decode.
@@ -230,10 +243,7 @@ void POCSAGAppView::handle_decoded(Timestamp timestamp, const std::string& prefi
             console.write(console_info);
 
             if (logging()) {
-                logger.log_decoded(
-                    timestamp,
-                    to_string_dec_uint(pocsag_state.address) +
-                        " F" + to_string_dec_uint(pocsag_state.function));
+                logger.log_decoded(packet, pocsag_state);
             }
         }
 
@@ -249,11 +259,7 @@ void POCSAGAppView::handle_decoded(Timestamp timestamp, const std::string& prefi
         }
 
         if (logging()) {
-            logger.log_decoded(
-                timestamp,
-                to_string_dec_uint(pocsag_state.address) +
-                    " F" + to_string_dec_uint(pocsag_state.function) +
-                    " " + pocsag_state.output);
+            logger.log_decoded(packet, pocsag_state);
         }
     }
 }
@@ -300,10 +306,10 @@ void POCSAGAppView::on_packet(const POCSAGPacketMessage* message) {
 
         // Handle multiple messages (if any).
         while (pocsag_decode_batch(message->packet, pocsag_state))
-            handle_decoded(message->packet.timestamp(), prefix);
+            handle_decoded(message->packet, prefix);
 
         // Handle the remainder.
-        handle_decoded(message->packet.timestamp(), prefix);
+        handle_decoded(message->packet, prefix);
     }
 
     // Set status icon color to indicate state machine state.
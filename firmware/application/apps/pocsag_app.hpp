@@ -34,6 +34,7 @@
 #include "pocsag_packet.hpp"
 #include "radio_state.hpp"
 
+#include <array>
 #include <functional>
 
 class POCSAGLogger {
@@ -43,10 +44,12 @@ class POCSAGLogger {
     }
 
     void log_raw_data(const pocsag::POCSAGPacket& packet, const uint32_t frequency);
-    void log_decoded(Timestamp timestamp, const std::string& text);
+    void log_decoded(const pocsag::POCSAGPacket& packet, const pocsag::POCSAGState& state);
 
    private:
     LogFile log_file{};
+    // Fits the raw dump of a batch, and a decoded address with its message.
+    std::array<char, 256> line{};
 };
 
 namespace ui {
@@ -225,13 +228,12 @@ class POCSAGAppView : public View {
 
     void refresh_ui();
     bool ignore_address(uint32_t address) const;
-    void handle_decoded(Timestamp timestamp, const std::string& prefix);
+    void handle_decoded(const pocsag::POCSAGPacket& packet, const std::string& prefix);
     void on_packet(const POCSAGPacketMessage* message);
     void on_stats(const POCSAGStatsMessage* stats);
 
     uint32_t last_address = 0;
-    pocsag::EccContainer ecc{};
-    pocsag::POCSAGState pocsag_state{&ecc};
+    pocsag::POCSAGState pocsag_state{};
     POCSAGLogger logger{};
     uint16_t packet_count = 0;
 
@@ -51,30 +51,39 @@ void RecentEntriesTable<AircraftRecentEntries>::draw(
     Painter& painter,
     const Style& style) {
     Color target_color;
-    std::string entry_string;
+    // Drawn for every row on every repaint, built without allocating.
+    StringBuffer<64> entry_string;
 
     switch (entry.state) {
         case ADSBAgeState::Invalid:
         case ADSBAgeState::Current:
-            entry_string = "";
             target_color = Theme::getInstance()->fg_green->foreground;
             break;
         case ADSBAgeState::Recent:
-            entry_string = STR_COLOR_LIGHT_GREY;
+            entry_string.append(STR_COLOR_LIGHT_GREY);
             target_color = Theme::getInstance()->fg_light->foreground;
             break;
         default:
-            entry_string = STR_COLOR_DARK_GREY;
+            entry_string.append(STR_COLOR_DARK_GREY);
             target_color = Theme::getInstance()->fg_medium->foreground;
     };
 
-    entry_string +=
-        (entry.callsign.empty() ? entry.icao_str + "   " : entry.callsign + " ") +
-        to_string_dec_uint((unsigned int)(entry.pos.altitude / 100), 4) +
-        to_string_dec_uint((unsigned int)entry.velo.speed, 4) +
-        to_string_dec_uint((unsigned int)(entry.amp >> 9), 4) + " " +
-        (entry.hits <= 999 ? to_string_dec_uint(entry.hits, 3) + " " : "1k+ ") +
-        to_string_dec_uint(entry.age, 4);
+    if (entry.callsign.empty())
+        entry_string.append(entry.icao_str).append("   ");
+    else
+        entry_string.append(entry.callsign).append(' ');
+
+    entry_string.append_dec_uint((unsigned int)(entry.pos.altitude / 100), 4)
+        .append_dec_uint((unsigned int)entry.velo.speed, 4)
+        .append_dec_uint((unsigned int)(entry.amp >> 9), 4)
+        .append(' ');
+
+    if (entry.hits <= 999)
+        entry_string.append_dec_uint(entry.hits, 3).append(' ');
+    else
+        entry_string.append("1k+ ");
+
+    entry_string.append_dec_uint(entry.age, 4);
 
     painter.draw_string(
         target_rect.location(),
@@ -89,26 +98,29 @@ void RecentEntriesTable<AircraftRecentEntries>::draw(
 /* ADSBLogger ********************************************/
 
 void ADSBLogger::log(const ADSBLogEntry& log_entry) {
-    std::string log_line;
-    log_line.reserve(100);
+    StringBuilder log_line{line};
 
-    log_line = log_entry.raw_data;
-    log_line += "ICAO:" + log_entry.icao;
+    log_line.append(log_entry.raw_data).append("ICAO:").append(log_entry.icao);
 
     if (!log_entry.callsign.empty())
-        log_line += " " + log_entry.callsign;
+        log_line.append(' ').append(log_entry.callsign);
 
-    if (log_entry.pos.valid)
-        log_line += " Alt:" + to_string_dec_int(log_entry.pos.altitude) +
-                    " Lat:" + to_string_decimal(log_entry.pos.latitude, 7) +
-                    " Lon:" + to_string_decimal(log_entry.pos.longitude, 7);
+    if (log_entry.pos.valid) {
+        log_line.append(" Alt:").append_dec(log_entry.pos.altitude).append(" Lat:");
+        append_decimal(log_line, log_entry.pos.latitude, 7).append(" Lon:");
+        append_decimal(log_line, log_entry.pos.longitude, 7);
+    }
 
     if (log_entry.vel.valid)
-        log_line += " Type:" + to_string_dec_uint(log_entry.vel_type) +
-                    " Hdg:" + to_string_dec_uint(log_entry.vel.heading) +
-                    " Spd: " + to_string_dec_int(log_entry.vel.speed);
+        log_line.append(" Type:")
+            .append_dec_uint(log_entry.vel_type)
+            .append(" Hdg:")
+            .append_dec_uint(log_entry.vel.heading)
+            .append(" Spd: ")
+            .append_dec(log_entry.vel.speed);
     if (log_entry.sil != 0)
-        log_line += " Sil:" + to_string_dec_uint(log_entry.sil);
+        log_line.append(" Sil:").append_dec_uint(log_entry.sil);
+    log_line.append(" S:").append_dec_uint(log_entry.sample_index);
     log_file.write_entry(log_line);
 }
 
@@ -447,6 +459,7 @@ void ADSBRxView::on_frame(const ADSBFrameMessage* message) {
 
     log_entry.raw_data = to_string_hex_array(frame.get_raw_data(), 14);
     log_entry.icao = entry.icao_str;
+    log_entry.sample_index = frame.get_sample_index();
 
     if (frame.get_DF() == DF_ADSB) {
         uint8_t msg_type = frame.get_msg_type();
@@ -178,6 +178,7 @@ struct ADSBLogEntry {
     adsb_vel vel{};
     uint8_t vel_type{};
     uint8_t sil{};
+    uint64_t sample_index{};
 };
 
 // TODO: Make logging optional.
@@ -191,6 +192,8 @@ class ADSBLogger {
 
    private:
     LogFile log_file{};
+    // Raw frame in hex, ICAO, callsign, position, velocity and sample index.
+    std::array<char, 192> line{};
 };
 
 /* Shows detailed information about an aircraft. */
@@ -42,6 +42,9 @@ void BTLERxView::focus() {
 
 BTLERxView::BTLERxView(NavigationView& nav)
     : nav_{nav} {
+    // Saved settings may hold the old rate, the processor needs this one.
+    receiver_model.set_sampling_rate(BTLERxConfigureMessage::sampling_rate);
+    receiver_model.set_baseband_bandwidth(BTLERxConfigureMessage::baseband_bandwidth);
     baseband::run_image(portapack::spi_flash::image_tag_btle_rx);
 
     add_children({&rssi,
@@ -51,8 +51,8 @@ class BTLERxView : public View {
     NavigationView& nav_;
     RxRadioState radio_state_{
         2426000000 /* frequency */,
-        4000000 /* bandwidth */,
-        4000000 /* sampling rate */,
+        BTLERxConfigureMessage::baseband_bandwidth,
+        BTLERxConfigureMessage::sampling_rate,
         ReceiverModel::Mode::WidebandFMAudio};
     app_settings::SettingsManager settings_{
         "rx_btle", app_settings::Mode::RX};
@@ -39,6 +39,9 @@
 #include "ui_debug_max17055.hpp"
 #include "ui_external_module_view.hpp"
 
+#include "baseband_api.hpp"
+#include "portapack_shared_memory.hpp"
+
 #include "portapack.hpp"
 #include "portapack_persistent_memory.hpp"
 using namespace portapack;
@@ -57,23 +60,59 @@ DebugMemoryView::DebugMemoryView(NavigationView& nav) {
                   &text_label_m0_heap_fragmented_free_value,
                   &text_label_m0_heap_fragments,
                   &text_label_m0_heap_fragments_value,
+                  &text_label_m0_largest_free,
+                  &text_label_m0_largest_free_value,
+                  &text_label_m0_heap_peak,
+                  &text_label_m0_heap_peak_value,
+                  &console,
+                  &button_refresh,
                   &button_done});
 
-    const auto m0_core_free = chCoreStatus();
-    text_label_m0_core_free_value.set(to_string_dec_uint(m0_core_free, 5));
-
-    size_t m0_fragmented_free_space = 0;
-    const auto m0_fragments = chHeapStatus(NULL, &m0_fragmented_free_space);
-    text_label_m0_heap_fragmented_free_value.set(to_string_dec_uint(m0_fragmented_free_space, 5));
-    text_label_m0_heap_fragments_value.set(to_string_dec_uint(m0_fragments, 5));
-
+    button_refresh.on_select = [this](Button&) { refresh(); };
     button_done.on_select = [&nav](Button&) { nav.pop(); };
+
+    refresh();
 }
 
 void DebugMemoryView::focus() {
     button_done.focus();
 }
 
+void DebugMemoryView::refresh() {
+    const auto m0 = memory_stats::snapshot();
+    text_label_m0_core_free_value.set(to_string_dec_uint(m0.core_free, 5));
+    text_label_m0_heap_fragmented_free_value.set(to_string_dec_uint(m0.heap_free, 5));
+    text_label_m0_heap_fragments_value.set(to_string_dec_uint(m0.fragments, 5));
+    text_label_m0_largest_free_value.set(to_string_dec_uint(m0.largest_free, 5));
+    text_label_m0_heap_peak_value.set(to_string_dec_uint(m0.heap_size - m0.core_low, 5));
+
+    console.clear(true);
+    write_stats("M0", m0);
+
+    if (baseband::request_memory_stats()) {
+        const auto& m4 = shared_memory.m4_memory;
+        console.writeln("M4 free " + to_string_dec_uint(m4.core_free) +
+                        " largest " + to_string_dec_uint(m4.largest_free));
+        write_stats("M4", m4);
+    } else {
+        console.writeln("M4 not responding");
+    }
+}
+
+void DebugMemoryView::write_stats(const char* core, const memory_stats::Snapshot& stats) {
+    for (size_t i = 0; i < memory_stats::tag_count; i++) {
+        const auto& usage = stats.tags[i];
+        if (usage.peak == 0)
+            continue;
+
+        console.writeln(std::string{core} + " " + memory_stats::tag_name(static_cast<memory_stats::Tag>(i)) + " " +
+                        to_string_dec_uint(usage.bytes) + " pk " + to_string_dec_uint(usage.peak));
+    }
+
+    for (size_t i = 0; i < stats.stack_count; i++)
+        console.writeln(std::string{core} + " stack " + stats.stacks[i].name + " " + to_string_dec_uint(stats.stacks[i].free));
+}
+
 /* RegistersWidget *******************************************************/
 
 RegistersWidget::RegistersWidget(
@@ -34,6 +34,7 @@
 #include "portapack.hpp"
 #include "memory_map.hpp"
 #include "irq_controls.hpp"
+#include "memory_stats.hpp"
 
 #include <functional>
 #include <utility>
@@ -49,40 +50,68 @@ class DebugMemoryView : public View {
     std::string title() const override { return "Memory"; };
 
    private:
+    void refresh();
+    void write_stats(const char* core, const memory_stats::Snapshot& stats);
+
     Text text_title{
-        {72, 96, 96, 16},
+        {72, 8, 96, 16},
         "Memory Usage",
     };
 
     Text text_label_m0_core_free{
-        {0, 128, 144, 16},
+        {0, 32, 144, 16},
         "M0 Core Free Bytes",
     };
 
     Text text_label_m0_core_free_value{
-        {200, 128, 40, 16},
+        {200, 32, 40, 16},
     };
 
     Text text_label_m0_heap_fragmented_free{
-        {0, 144, 184, 16},
+        {0, 48, 184, 16},
         "M0 Heap Fragmented Free",
     };
 
     Text text_label_m0_heap_fragmented_free_value{
-        {200, 144, 40, 16},
+        {200, 48, 40, 16},
     };
 
     Text text_label_m0_heap_fragments{
-        {0, 160, 136, 16},
+        {0, 64, 136, 16},
         "M0 Heap Fragments",
     };
 
     Text text_label_m0_heap_fragments_value{
-        {200, 160, 40, 16},
+        {200, 64, 40, 16},
+    };
+
+    Text text_label_m0_largest_free{
+        {0, 80, 184, 16},
+        "M0 Largest Free Block",
     };
 
+    Text text_label_m0_largest_free_value{
+        {200, 80, 40, 16},
+    };
+
+    Text text_label_m0_heap_peak{
+        {0, 96, 184, 16},
+        "M0 Heap Peak Used",
+    };
+
+    Text text_label_m0_heap_peak_value{
+        {200, 96, 40, 16},
+    };
+
+    Console console{
+        {0, 120, 240, 160}};
+
+    Button button_refresh{
+        {16, 288, 96, 24},
+        "Refresh"};
+
     Button button_done{
-        {72, 192, 96, 24},
+        {128, 288, 96, 24},
         "Done"};
 };
 
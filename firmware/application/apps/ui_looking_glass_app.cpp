@@ -27,6 +27,7 @@
 #include "string_format.hpp"
 #include "audio.hpp"
 #include "file_path.hpp"
+#include "rtc_time.hpp"
 
 using namespace portapack;
 
@@ -36,6 +37,7 @@ void GlassView::focus() {
 }
 
 GlassView::~GlassView() {
+    stop_survey();
     audio::output::stop();
     receiver_model.set_sampling_rate(3072000);  // Just a hack to avoid hanging other apps
     receiver_model.disable();
@@ -132,6 +134,10 @@ void GlassView::add_spectrum_pixel(uint8_t power) {
 
     if (pixel_index == SCREEN_W)  // got an entire waterfall line
     {
+        if (survey_.is_active()) {
+            if (survey_.end_sweep((chTimeNow() - survey_start_time) / CH_FREQUENCY))
+                survey_config.set_selected_index(0);  // SD error, survey stopped
+        }
         if (live_frequency_view > 0) {
             constexpr int rssi_sample_range = SPEC_NB_BINS;
             constexpr float rssi_voltage_min = 0.4;
@@ -159,7 +165,7 @@ void GlassView::add_spectrum_pixel(uint8_t power) {
             }
             if (last_max_freq != max_freq_hold) {
                 last_max_freq = max_freq_hold;
-                freq_stats.set("MAX HOLD: " + to_string_short_freq(max_freq_hold));
+                freq_stats.set("MAX:" + to_string_short_freq(max_freq_hold));
             }
             plot_marker(marker_pixel_index);
         } else {
@@ -173,10 +179,11 @@ bool GlassView::process_bins(uint8_t* powerlevel) {
     bins_hz_size += each_bin_size;          // add pixel to fulfilled bag of Hz
     if (bins_hz_size >= marker_pixel_step)  // new pixel fullfilled
     {
-        if (*powerlevel > min_color_power)
+        if (*powerlevel > min_color_power) {
+            survey_.add_bin(pixel_index, *powerlevel);
             add_spectrum_pixel(*powerlevel);  // Pixel will represent max_power
-        else
-            add_spectrum_pixel(0);  // Filtered out, show black
+        } else
+            add_spectrum_pixel(0);  // Filtered out, show black and keep it out of the survey
         *powerlevel = 0;
 
         if (!pixel_index)  // Received indication that a waterfall line has been completed
@@ -288,6 +295,11 @@ void GlassView::on_range_changed() {
     on_marker_change();
     update_range_field();
 
+    // A survey file covers a single range. Tuning ends it, the user
+    // starts a new one for the new range when done tuning.
+    if (survey_.is_active())
+        survey_config.set_selected_index(0);
+
     // set the sample rate and bandwidth
     receiver_model.set_sampling_rate(looking_glass_sampling_rate);
     receiver_model.set_baseband_bandwidth(looking_glass_bandwidth);
@@ -295,9 +307,18 @@ void GlassView::on_range_changed() {
     receiver_model.set_squelch_level(0);
     f_center = f_center_ini;  // Reset sweep into first slice
     baseband::set_spectrum(looking_glass_bandwidth, trigger);
+    update_spectrum_processing();  // Also restarts holds and averages for the new range.
     receiver_model.set_target_frequency(f_center);  // tune rx for this slice
 }
 
+void GlassView::update_spectrum_processing() {
+    // Only single pass shows the same slice every frame, sweeps would mix slices in the detector.
+    const auto detector_mode = (mode == LOOKING_GLASS_SINGLEPASS)
+                                   ? static_cast<SpectrumDetectorMode>(detector)
+                                   : SpectrumDetectorMode::Sample;
+    baseband::set_spectrum_processing(static_cast<dsp::window::Type>(fft_window), detector_mode, 8 /* AVG alpha 1/8 */);
+}
+
 void GlassView::plot_marker(uint8_t pos) {
     uint8_t shift_y = 0;
     if (live_frequency_view > 0)  // plot one line down when in live view
@@ -373,12 +394,15 @@ GlassView::GlassView(
                   &filter_config,
                   &field_rf_amp,
                   &range_presets,
+                  &window_config,
+                  &detector_config,
                   &button_beep_squelch,
                   &field_marker,
                   &field_trigger,
                   &button_jump,
                   &button_rst,
                   &field_rx_iq_phase_cal,
+                  &survey_config,
                   &freq_stats});
 
     load_presets();  // Load available presets from TXT files (or default).
@@ -485,6 +509,18 @@ GlassView::GlassView(
     };
     range_presets.set_selected_index(preset_index);
 
+    window_config.on_change = [this](size_t, OptionsField::value_t v) {
+        fft_window = v;
+        update_spectrum_processing();
+    };
+    window_config.set_by_value(fft_window);
+
+    detector_config.on_change = [this](size_t, OptionsField::value_t v) {
+        detector = v;
+        update_spectrum_processing();
+    };
+    detector_config.set_by_value(detector);
+
     field_marker.on_encoder_change = [this](TextField&, EncoderEvent delta) {
         if ((marker_pixel_index + delta) < 0)
             marker_pixel_index = marker_pixel_index + delta + SCREEN_W;
@@ -500,6 +536,14 @@ GlassView::GlassView(
         launch_audio(marker);
     };
 
+    survey_config.on_change = [this](size_t, OptionsField::value_t v) {
+        survey_bucket_seconds = v;
+        if (v > 0)
+            start_survey();
+        else
+            stop_survey();
+    };
+
     field_trigger.on_change = [this](int32_t v) {
         trigger = v;
         baseband::set_spectrum(looking_glass_bandwidth, trigger);
@@ -563,6 +607,8 @@ GlassView::GlassView(
 
     manage_beep_audio();
     update_display_beep();
+
+    survey_config.set_by_value(survey_bucket_seconds);
 }
 
 void GlassView::on_freqchg(int64_t freq) {
@@ -636,4 +682,32 @@ void GlassView::launch_audio(rf::Frequency center_freq) {
     nav_.replace<AnalogAudioView>(settings);  // Jump into audio view
 }
 
+void GlassView::start_survey() {
+    stop_survey();
+
+    rtc::RTC datetime;
+    rtc_time::now(datetime);
+
+    survey::SpectrumSurvey::Config config{
+        .f_min = static_cast<uint64_t>(f_min),
+        .f_max = static_cast<uint64_t>(f_max),
+        .bucket_seconds = survey_bucket_seconds,
+        .threshold = std::max<uint8_t>(min_color_power, 118),  // Ignore the noise floor even when the filter is OFF.
+        .year = datetime.year(),
+        .month = datetime.month(),
+        .day = datetime.day(),
+        .hour = datetime.hour(),
+        .minute = datetime.minute(),
+        .second = datetime.second(),
+    };
+
+    survey_start_time = chTimeNow();
+    if (survey_.start(looking_glass_dir / u"SURVEY_????.PHM", config))
+        survey_config.set_selected_index(0);  // Couldn't create the file, turn the survey off.
+}
+
+void GlassView::stop_survey() {
+    survey_.stop();
+}
+
 }  // namespace ui
@@ -36,6 +36,7 @@
 #include "string_format.hpp"
 #include "analog_audio_app.hpp"
 #include "spectrum_color_lut.hpp"
+#include "spectrum_survey.hpp"
 
 namespace ui {
 
@@ -87,6 +88,9 @@ class GlassView : public View {
     uint8_t iq_phase_calibration_value{15};  // initial default RX IQ phase calibration value , used for both max2837 & max2839
     int32_t beep_squelch = 20;               // range from -100 to +20, >=20 disabled
     bool beep_enabled = false;               // activate on bip button click
+    uint32_t survey_bucket_seconds = 0;      // survey time bucket, 0 = survey off
+    uint8_t fft_window = 0;                  // dsp::window::Type, legacy Hamming
+    uint8_t detector = 0;                    // SpectrumDetectorMode, only used in single pass
     app_settings::SettingsManager settings_{
         "rx_glass"sv,
         app_settings::Mode::RX,
@@ -102,6 +106,9 @@ class GlassView : public View {
             {"iq_phase_calibration"sv, &iq_phase_calibration_value},  // we are saving and restoring that CAL from Settings.
             {"beep_squelch"sv, &beep_squelch},
             {"beep_enabled"sv, &beep_enabled},
+            {"survey_bucket"sv, &survey_bucket_seconds},
+            {"fft_window"sv, &fft_window},
+            {"detector"sv, &detector},
         }};
 
     struct preset_entry {
@@ -128,12 +135,15 @@ class GlassView : public View {
     int64_t next_mult_of(int64_t num, int64_t multiplier);
     void adjust_range(int64_t* f_min, int64_t* f_max, int64_t width);
     void on_range_changed();
+    void update_spectrum_processing();
     void reset_live_view();
     void add_spectrum_pixel(uint8_t power);
     void plot_marker(uint8_t pos);
     void load_presets();
     void populate_presets();
     void launch_audio(rf::Frequency center_freq);
+    void start_survey();
+    void stop_survey();
 
     rf::Frequency search_span{0};
     rf::Frequency f_center{0};
@@ -171,6 +181,9 @@ class GlassView : public View {
     uint8_t offset = 0;
     uint8_t ignore_dc = 0;
 
+    survey::SpectrumSurvey survey_{};
+    systime_t survey_start_time{0};
+
     Labels labels{
         {{0, 0 * 16}, "MIN:     MAX:     LNA   VGA  ", Theme::getInstance()->fg_light->foreground},
         {{0, 1 * 16}, "RANGE:       FILTER:     AMP:", Theme::getInstance()->fg_light->foreground},
@@ -217,9 +230,30 @@ class GlassView : public View {
 
     OptionsField range_presets{
         {2 * 8, 2 * 16},
-        20,
+        13,
         {}};
 
+    OptionsField window_config{
+        {15 * 8, 2 * 16},
+        4,
+        {
+            {"HAM3", static_cast<int32_t>(dsp::window::Type::Hamming3)},
+            {"HANN", static_cast<int32_t>(dsp::window::Type::Hann)},
+            {"BH  ", static_cast<int32_t>(dsp::window::Type::BlackmanHarris)},
+            {"FLAT", static_cast<int32_t>(dsp::window::Type::FlatTop)},
+            {"RECT", static_cast<int32_t>(dsp::window::Type::Rectangular)},
+        }};
+
+    OptionsField detector_config{
+        {19 * 8, 2 * 16},
+        3,
+        {
+            {"SMP", static_cast<int32_t>(SpectrumDetectorMode::Sample)},
+            {"AVG", static_cast<int32_t>(SpectrumDetectorMode::AverageExponential)},
+            {"MAX", static_cast<int32_t>(SpectrumDetectorMode::MaxHold)},
+            {"MIN", static_cast<int32_t>(SpectrumDetectorMode::MinHold)},
+        }};
+
     ButtonWithEncoder button_beep_squelch{
         {240 - 8 * 8, 2 * 16 + 4, 8 * 8, 1 * 8},
         ""};
@@ -299,8 +333,19 @@ class GlassView : public View {
         {SCREEN_W - 9 * 8, 5 * 16, 4 * 8, 16},
         "RST"};
 
+    OptionsField survey_config{
+        {0 * 8, 5 * 16},
+        7,
+        {
+            {"SRV:OFF", 0},
+            {"SRV:1m ", 60},
+            {"SRV:5m ", 300},
+            {"SRV:15m", 900},
+            {"SRV:1h ", 3600},
+        }};
+
     Text freq_stats{
-        {0 * 8, 5 * 16, SCREEN_W - 10 * 8, 8},
+        {8 * 8, 5 * 16, SCREEN_W - 18 * 8, 8},
         ""};
 
     MessageHandlerRegistration message_handler_spectrum_config{
@@ -246,6 +246,76 @@ bool PlaylistView::next_track() {
     return true;
 }
 
+/* Opens a track for replay, C8 captures are sent to the baseband as is. */
+static Optional<File::Error> open_track(FileConvertReader& reader, const fs::path& path) {
+    auto error = reader.open(path);
+    reader.convert_c8_to_c16 = false;
+    return error;
+}
+
+/* True if the replay can run from one track into the next without
+ * reconfiguring the radio or the baseband. */
+bool PlaylistView::can_continue(const playlist_entry& from, const playlist_entry& to) const {
+    return to.ms_delay == 0 &&
+           to.metadata.center_frequency == from.metadata.center_frequency &&
+           to.metadata.sample_rate == from.metadata.sample_rate &&
+           to.metadata.peak == from.metadata.peak &&
+           capture_file_sample_size(to.path) == capture_file_sample_size(from.path);
+}
+
+/* Collects the tracks following the current one that can be streamed
+ * without a restart. A looping playlist that continues all the way
+ * round repeats forever, a single track is rewound instead of reopened. */
+ReplayThread::Continuation PlaylistView::make_continuation() {
+    std::vector<fs::path> tracks{current()->path};
+    bool cyclic = false;
+
+    for (auto index = current_index_;;) {
+        const auto& from = playlist_db_[index];
+        if (++index == playlist_db_.size()) {
+            if (!check_loop.value())
+                break;
+            index = 0;
+        }
+
+        if (!can_continue(from, playlist_db_[index]))
+            break;
+
+        if (index == current_index_) {
+            cyclic = true;
+            break;
+        }
+
+        tracks.push_back(playlist_db_[index].path);
+    }
+
+    if (tracks.size() == 1 && !cyclic)
+        return {};
+
+    return [tracks = std::move(tracks), cyclic, position = size_t{0}](std::unique_ptr<stream::Reader>& reader) mutable {
+        const auto previous = position;
+        if (++position == tracks.size()) {
+            if (!cyclic)
+                return false;
+            position = 0;
+        }
+
+        if (position == previous) {
+            if (static_cast<FileConvertReader&>(*reader).rewind())
+                return false;
+        } else {
+            auto next = std::make_unique<FileConvertReader>();
+            if (open_track(*next, tracks[position]))
+                return false;
+            reader = std::move(next);
+        }
+
+        ReplayThreadDoneMessage message{ReplayThread::CONTINUED};
+        EventDispatcher::send_message(message);
+        return true;
+    };
+}
+
 /* Transmits the current_entry_ */
 void PlaylistView::send_current_track() {
     // Prepare to send a file.
@@ -262,15 +332,17 @@ void PlaylistView::send_current_track() {
 
     // Open the sample file to send.
     auto reader = std::make_unique<FileConvertReader>();
-    auto error = reader->open(current()->path);
+    auto error = open_track(*reader, current()->path);
     if (error) {
         show_file_error(current()->path, "Can't open file to send.");
         return;
     }
+    const bool c8 = capture_file_sample_size(current()->path) == sizeof(complex8_t);
 
     // Update the sample rate in proc_replay baseband.
     baseband::set_sample_rate(current()->metadata.sample_rate,
                               get_oversample_rate(current()->metadata.sample_rate));
+    baseband::set_replay_gain(current()->metadata.peak, dither_);
 
     // ReplayThread starts immediately on construction; must be set before creating.
     transmitter_model.set_target_frequency(current()->metadata.center_frequency);
@@ -279,6 +351,7 @@ void PlaylistView::send_current_track() {
     transmitter_model.enable();
 
     // Reset the transmit progress bar.
+    progress_base_ = 0;
     progressbar_transmit.set_value(0);
 
     // Use the ReplayThread class to send the data.
@@ -290,7 +363,9 @@ void PlaylistView::send_current_track() {
         [](uint32_t return_code) {
             ReplayThreadDoneMessage message{return_code};
             EventDispatcher::send_message(message);
-        });
+        },
+        c8,
+        make_continuation());
 
     // Now it's sending, update the UI.
     update_ui();
@@ -339,17 +414,29 @@ void PlaylistView::update_ui() {
 
         progressbar_track.set_max(playlist_db_.size() - 1);
         progressbar_track.set_value(current_index_);
-        progressbar_transmit.set_max(current()->file_size * sizeof(complex16_t) / sample_size);
+        progressbar_transmit.set_max(current()->file_size);
     }
 
     button_play.set_bitmap(is_active() ? &bitmap_stop : &bitmap_play);
 }
 
 void PlaylistView::on_tx_progress(uint32_t progress) {
-    progressbar_transmit.set_value(progress);
+    // The next track is queued a few buffers before the baseband gets to it.
+    progressbar_transmit.set_value(std::max<int32_t>(static_cast<int32_t>(progress - progress_base_), 0));
 }
 
 void PlaylistView::handle_replay_thread_done(uint32_t return_code) {
+    if (return_code == ReplayThread::CONTINUED) {
+        // The replay thread has moved on to the next track by itself.
+        if (!is_active())
+            return;
+
+        progress_base_ += current()->file_size;
+        next_track();
+        update_ui();
+        return;
+    }
+
     if (return_code == ReplayThread::END_OF_FILE) {
         if (next_track()) {
             send_current_track();
@@ -375,6 +462,7 @@ PlaylistView::PlaylistView(
         &progressbar_track,
         &progressbar_transmit,
         &field_frequency,
+        &check_dither,
         &tx_view,
         &check_loop,
         &button_play,
@@ -403,6 +491,11 @@ PlaylistView::PlaylistView(
         };
     };
 
+    check_dither.set_value(dither_);
+    check_dither.on_select = [this](Checkbox&, bool v) {
+        dither_ = v;
+    };
+
     button_play.on_select = [this](ImageButton&) {
         toggle();
     };
@@ -56,8 +56,13 @@ class PlaylistView : public View {
    private:
     NavigationView& nav_;
     TxRadioState radio_state_{};
+    bool dither_{false};
     app_settings::SettingsManager settings_{
-        "tx_replay", app_settings::Mode::TX};
+        "tx_replay",
+        app_settings::Mode::TX,
+        {
+            {"dither"sv, &dither_},
+        }};
 
     // More header == less spectrum view.
     static constexpr ui::Dim header_height = 6 * 16;
@@ -73,6 +78,8 @@ class PlaylistView : public View {
     bool ready_signal_{};  // Used to signal the ReplayThread.
 
     size_t current_index_{0};
+    // Stream bytes of the tracks already sent without restarting the replay.
+    uint32_t progress_base_{0};
     bool playlist_dirty_{};
     std::vector<playlist_entry> playlist_db_{};
     std::filesystem::path playlist_path_{};
@@ -97,6 +104,8 @@ class PlaylistView : public View {
     void toggle();
     void start();
     bool next_track();
+    bool can_continue(const playlist_entry& from, const playlist_entry& to) const;
+    ReplayThread::Continuation make_continuation();
     void send_current_track();
     void stop();
 
@@ -128,6 +137,12 @@ class PlaylistView : public View {
 
     // TODO: delay duration field.
 
+    Checkbox check_dither{
+        {5 * 8, 2 * 16},
+        4,
+        "Dith",
+        true};
+
     TransmitterView2 tx_view{
         {11 * 8, 2 * 16},
         /*short_ui*/ true};
@@ -28,7 +28,6 @@
 #include "ui_navigation.hpp"
 #include "ui_receiver.hpp"
 #include "ui_transmitter.hpp"
-#include "bch_code.hpp"
 #include "message.hpp"
 #include "transmitter_model.hpp"
 #include "app_settings.hpp"
@@ -67,13 +66,6 @@ class POCSAGTXView : public View {
     app_settings::SettingsManager settings_{
         "tx_pocsag", app_settings::Mode::TX};
 
-    BCHCode BCH_code{
-        {1, 0, 1, 0, 0, 1},
-        5,
-        31,
-        21,
-        2};
-
     void on_set_text(NavigationView& nav);
     void on_tx_progress(const uint32_t progress, const bool done);
     void on_remote(const PocsagTosendMessage data);
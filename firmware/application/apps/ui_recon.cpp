@@ -1367,6 +1367,7 @@ void ReconView::start_repeat() {
         // Update the sample rate in proc_replay baseband.
         baseband::set_sample_rate(metadata->sample_rate,
                                   get_oversample_rate(metadata->sample_rate));
+        baseband::set_replay_gain(metadata->peak);
 
         transmitter_model.set_sampling_rate(get_actual_sample_rate(metadata->sample_rate));
         transmitter_model.set_baseband_bandwidth(metadata->sample_rate <= 500'000 ? 1'750'000 : 2'500'000);  // TX LPF min 1M75 for SR <=500K, and  2M5 (by experimental test) for SR >500K
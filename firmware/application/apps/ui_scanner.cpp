@@ -26,6 +26,7 @@
 #include "optional.hpp"
 #include "ui_fileman.hpp"
 #include "ui_freqman.hpp"
+#include "freqman_cache.hpp"
 #include "file_path.hpp"
 
 using namespace portapack;
@@ -545,8 +546,10 @@ void ScannerView::frequency_file_load(const fs::path& path) {
     freqman_index_t def_bw_index{freqman_invalid_index};
     freqman_index_t def_step_index{freqman_invalid_index};
 
+    FreqmanCache cache;
     FreqmanDB db;
-    if (!db.open(path)) {
+    auto cached = cache.open(path);
+    if (!cached && !db.open(path)) {
         text_current_desc.set("NO " + path.filename().string());
         return;
     }
@@ -555,7 +558,8 @@ void ScannerView::frequency_file_load(const fs::path& path) {
     freqman_file = path.stem().string();
     Optional<scanner_range_t> range;
 
-    for (auto entry : db) {
+    // Returns false when no more entries fit.
+    auto add_entry = [&](const freqman_entry& entry) {
         if (is_invalid(def_mod_index))
             def_mod_index = entry.modulation;
 
@@ -583,8 +587,17 @@ void ScannerView::frequency_file_load(const fs::path& path) {
                 break;
         }
 
-        if (entries.size() >= FREQMAN_MAX_PER_FILE)
-            break;
+        return entries.size() < FREQMAN_MAX_PER_FILE;
+    };
+
+    // Read the compiled cache when available, it skips text parsing.
+    if (cached) {
+        cache.for_each_in_file_order(add_entry);
+    } else {
+        for (auto entry : db) {
+            if (!add_entry(entry))
+                break;
+        }
     }
 
     if (is_valid(def_mod_index) && def_mod_index != (freqman_index_t)field_mode.selected_index_value())
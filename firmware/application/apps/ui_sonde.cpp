@@ -39,7 +39,7 @@ namespace pmem = portapack::persistent_memory;
 
 void SondeLogger::on_packet(const sonde::Packet& packet) {
     const auto formatted = packet.symbols_formatted();
-    log_file.write_entry(packet.received_at(), formatted.data);
+    log_file.write_entry(packet.received_at(), formatted.data + " S:" + to_string_dec_uint(packet.sample_index()));
 }
 
 namespace ui {
@@ -29,7 +29,7 @@ using namespace portapack;
 #include "string_format.hpp"
 
 void TestLogger::log_raw_data(const testapp::Packet& packet, const int32_t alt) {
-    std::string entry = to_string_dec_uint(packet.value()) + " " + to_string_dec_int(alt);
+    std::string entry = to_string_dec_uint(packet.value()) + " " + to_string_dec_int(alt) + " S:" + to_string_dec_uint(packet.sample_index());
 
     // Raw hex dump
     // for (size_t c = 0; c < 10; c++)
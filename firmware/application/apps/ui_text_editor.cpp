@@ -543,7 +543,8 @@ void TextEditorView::open_file(const fs::path& path) {
             auto percent = (value * 100) / total;
             auto width = (percent * screen_width) / 100;
             p.draw_hline({0, 16}, width, Theme::getInstance()->fg_yellow->foreground);
-        });
+        },
+        /*keep_index*/ true);
 
     if (!result) {
         nav_.display_modal("Read Error", "Cannot open file:\n" + result.error().what());
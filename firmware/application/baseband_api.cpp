@@ -45,25 +45,47 @@ using namespace portapack;
 
 namespace baseband {
 
-static void send_message(const Message* const message) {
-    // If message is only sent by this function via one thread, no need to check if
-    // another message is present before setting new message.
-    shared_memory.baseband_message = message;
+struct SpectrumProcessing {
+    dsp::window::Type window{dsp::window::Type::Hamming3};
+    SpectrumDetectorMode detector{SpectrumDetectorMode::Sample};
+    uint8_t detector_count{1};
+    bool waterfall_rows{false};
+};
+
+static SpectrumProcessing spectrum_processing{};
+
+/* Queues a copy of the message for the baseband. The M4 drains the queue
+ * in batches, so this only waits if the queue is full. */
+template <typename T>
+static CommandQueue::Token send_message(const T& message) {
+    auto count = UINT32_MAX;
+    CommandQueue::Token token;
+
+    while (!shared_memory.baseband_queue.push(message, token)) {
+        if (check_for_message_hang && --count == 0)
+            chDbgPanic("Baseband Send Fail");
+    }
+
     creg::m0apptxevent::assert_event();
+    return token;
+}
 
-    if constexpr (check_for_message_hang) {
-        auto count = UINT32_MAX;
-        while (shared_memory.baseband_message && --count)
-            /* spin */;
+/* Waits for the baseband to handle the command, for messages pointing at
+ * M0 memory or when the caller depends on the M4's response. */
+static void wait_for(const CommandQueue::Token token) {
+    auto count = UINT32_MAX;
 
-        if (count == 0)
+    while (!shared_memory.baseband_queue.is_complete(token)) {
+        if (check_for_message_hang && --count == 0)
             chDbgPanic("Baseband Send Fail");
-    } else {
-        while (shared_memory.baseband_message)
-            /* spin */;
     }
 }
 
+template <typename T>
+static void send_message_and_wait(const T& message) {
+    wait_for(send_message(message));
+}
+
 void AMConfig::apply() const {
     const AMConfigureMessage message{
         taps_6k0_decim_0,  // common FIR filter taps pre-decim_0 to all 5 x AM mod types.(AM-9K, AM-6K, USB, LSB, CW)
@@ -72,7 +94,7 @@ void AMConfig::apply() const {
         channel,           // var channel FIR taps filter , variable values, depending selected  AM mode, each one different  (DSB-9K, DSB-6K, USB-3K, LSB-3K,CW)
         modulation,        // var parameter .
         audio_12k_hpf_300hz_config};
-    send_message(&message);
+    send_message(message);
     audio::set_rate(audio::Rate::Hz_12000);
 }
 
@@ -86,7 +108,7 @@ void NBFMConfig::apply(const uint8_t squelch_level) const {
         audio_24k_hpf_300hz_config,
         audio_24k_deemph_300_6_config,
         squelch_level};
-    send_message(&message);
+    send_message(message);
     audio::set_rate(audio::Rate::Hz_24000);
 }
 
@@ -98,7 +120,7 @@ void WFMConfig::apply() const {
         75000,
         audio_48k_hpf_30hz_config,
         audio_48k_deemph_2122_6_config};
-    send_message(&message);
+    send_message(message);
     audio::set_rate(audio::Rate::Hz_48000);
 }
 
@@ -114,7 +136,7 @@ void set_tones_config(const uint32_t bw, const uint32_t pre_silence, const uint1
         tone_count,
         dual_tone,
         audio_out};
-    send_message(&message);
+    send_message(message);
 }
 
 void kill_tone() {
@@ -124,14 +146,14 @@ void kill_tone() {
         0,
         false,
         false};
-    send_message(&message);
+    send_message(message);
 }
 
 void set_sstv_data(const uint8_t vis_code, const uint32_t pixel_duration) {
     const SSTVConfigureMessage message{
         vis_code,
         pixel_duration};
-    send_message(&message);
+    send_message(message);
 }
 
 void set_afsk(const uint32_t baudrate, const uint32_t word_length, const uint32_t trigger_value, const bool trigger_word) {
@@ -140,19 +162,25 @@ void set_afsk(const uint32_t baudrate, const uint32_t word_length, const uint32_
         word_length,
         trigger_value,
         trigger_word};
-    send_message(&message);
+    send_message(message);
 }
 
 void set_aprs(const uint32_t baudrate) {
     const APRSRxConfigureMessage message{
         baudrate};
-    send_message(&message);
+    send_message(message);
 }
 
 void set_btlerx(uint8_t channel_number) {
     const BTLERxConfigureMessage message{
         channel_number};
-    send_message(&message);
+    send_message(message);
+}
+
+void set_ais(const bool dual_channel) {
+    const AISConfigureMessage message{
+        dual_channel};
+    send_message(message);
 }
 
 void set_btletx(uint8_t channel_number, char* macAddress, char* advertisementData, uint8_t pduType) {
@@ -161,7 +189,7 @@ void set_btletx(uint8_t channel_number, char* macAddress, char* advertisementDat
         macAddress,
         advertisementData,
         pduType};
-    send_message(&message);
+    send_message_and_wait(message);
 }
 
 void set_nrf(const uint32_t baudrate, const uint32_t word_length, const uint32_t trigger_value, const bool trigger_word) {
@@ -170,7 +198,7 @@ void set_nrf(const uint32_t baudrate, const uint32_t word_length, const uint32_t
         word_length,
         trigger_value,
         trigger_word};
-    send_message(&message);
+    send_message(message);
 }
 
 void set_fsk(const size_t deviation) {
@@ -181,7 +209,7 @@ void set_fsk(const size_t deviation) {
         2,
         deviation};
 
-    send_message(&message);
+    send_message(message);
 }
 
 void set_afsk_data(const uint32_t afsk_samples_per_bit, const uint32_t afsk_phase_inc_mark, const uint32_t afsk_phase_inc_space, const uint8_t afsk_repeat, const uint32_t afsk_bw, const uint8_t symbol_count) {
@@ -192,7 +220,7 @@ void set_afsk_data(const uint32_t afsk_samples_per_bit, const uint32_t afsk_phas
         afsk_repeat,
         afsk_bw,
         symbol_count};
-    send_message(&message);
+    send_message(message);
 }
 
 void kill_afsk() {
@@ -203,7 +231,7 @@ void kill_afsk() {
         0,
         0,
         false};
-    send_message(&message);
+    send_message(message);
 }
 
 void set_audiotx_config(
@@ -229,20 +257,20 @@ void set_audiotx_config(
         dsb_enabled,
         usb_enabled,
         lsb_enabled};
-    send_message(&message);
+    send_message(message);
 }
 
 void set_fifo_data(const int8_t* data) {
     const FIFODataMessage message{
         data};
-    send_message(&message);
+    send_message_and_wait(message);
 }
 
 void set_pitch_rssi(int32_t avg, bool enabled) {
     const PitchRSSIConfigureMessage message{
         enabled,
         avg};
-    send_message(&message);
+    send_message(message);
 }
 
 void set_ook_data(const uint32_t stream_length, const uint32_t samples_per_bit, const uint8_t repeat, const uint32_t pause_symbols, const uint8_t de_bruijn_length) {
@@ -252,7 +280,7 @@ void set_ook_data(const uint32_t stream_length, const uint32_t samples_per_bit,
         repeat,
         pause_symbols,
         de_bruijn_length};
-    send_message(&message);
+    send_message(message);
 }
 
 void kill_ook() {
@@ -262,7 +290,7 @@ void kill_ook() {
         0,
         0,
         0};
-    send_message(&message);
+    send_message(message);
 }
 
 void set_fsk_data(const uint32_t stream_length, const uint32_t samples_per_bit, const uint32_t shift, const uint32_t progress_notice) {
@@ -271,17 +299,17 @@ void set_fsk_data(const uint32_t stream_length, const uint32_t samples_per_bit,
         samples_per_bit,
         shift,
         progress_notice};
-    send_message(&message);
+    send_message(message);
 }
 
 void set_pocsag() {
     const POCSAGConfigureMessage message{};
-    send_message(&message);
+    send_message(message);
 }
 
 void set_adsb() {
     const ADSBConfigureMessage message{};
-    send_message(&message);
+    send_message(message);
 }
 
 void set_jammer(const bool run, const jammer::JammerType type, const uint32_t speed) {
@@ -289,67 +317,94 @@ void set_jammer(const bool run, const jammer::JammerType type, const uint32_t sp
         run,
         type,
         speed};
-    send_message(&message);
+    send_message(message);
 }
 
 void set_rds_data(const uint16_t message_length) {
     const RDSConfigureMessage message{
         message_length};
-    send_message(&message);
+    send_message(message);
 }
 
 void set_spectrum(const size_t sampling_rate, const size_t trigger) {
     const WidebandSpectrumConfigMessage message{
         sampling_rate, trigger};
-    send_message(&message);
+    send_message(message);
 }
 
 void set_siggen_tone(const uint32_t tone) {
     const SigGenToneMessage message{
         TONES_F2D(tone, TONES_SAMPLERATE)};
-    send_message(&message);
+    send_message(message);
 }
 
 void set_siggen_config(const uint32_t bw, const uint32_t shape, const uint32_t duration) {
     const SigGenConfigMessage message{
         bw, shape, duration * TONES_SAMPLERATE};
-    send_message(&message);
+    send_message(message);
 }
 
 void set_spectrum_painter_config(const uint16_t width, const uint16_t height, bool update, int32_t bw) {
     SpectrumPainterBufferConfigureRequestMessage message{width, height, update, bw};
-    send_message(&message);
+    send_message(message);
 }
 
 void set_subghzd_config(uint8_t modulation = 0, uint32_t sampling_rate = 0) {
     const SubGhzFPRxConfigureMessage message{modulation, sampling_rate};
-    send_message(&message);
+    send_message(message);
+}
+
+void set_ism(const uint8_t decoders) {
+    const ISMConfigureMessage message{
+        decoders};
+    send_message(message);
 }
 
 static bool baseband_image_running = false;
+static ImageSwitchStats image_switch_stats{};
 
-void run_image(const spi_flash::image_tag_t image_tag) {
-    if (baseband_image_running) {
-        chDbgPanic("BBRunning");
-    }
+static void wait_for_baseband_ready() {
+    if constexpr (enforce_core_sync) {
+        // Wait up to 3 seconds for baseband to start handling events.
+        const auto start = chTimeNow();
+        while (!shared_memory.baseband_ready) {
+            if (chTimeNow() - start > MS2ST(3000))
+                chDbgPanic("Baseband Sync Fail");
 
-    creg::m4txevent::clear();
-    shared_memory.clear_baseband_ready();
+            chThdYield();
+        }
+    }
+}
 
-    m4_init(image_tag, memory::map::m4_code, false);
+static void start_image(const spi_flash::image_tag_t image_tag, const bool reused, const systime_t start) {
     baseband_image_running = true;
+    spectrum_processing = {};
 
+    const auto loaded = chTimeNow();
     creg::m4txevent::enable();
+    wait_for_baseband_ready();
 
-    if constexpr (enforce_core_sync) {
-        // Wait up to 3 seconds for baseband to start handling events.
-        auto count = 3'000u;
-        while (!shared_memory.baseband_ready && --count)
-            chThdSleepMilliseconds(1);
+    auto& stats = image_switch_stats;
+    stats.image_tag = image_tag;
+    stats.reused = reused;
+    stats.load_ms = (loaded - start) * 1000 / CH_FREQUENCY;
+    stats.ready_ms = (chTimeNow() - loaded) * 1000 / CH_FREQUENCY;
+    stats.count++;
+    stats.reused_count += reused ? 1 : 0;
+}
 
-        if (count == 0)
-            chDbgPanic("Baseband Sync Fail");
+void run_image(const spi_flash::image_tag_t image_tag) {
+    if (baseband_image_running) {
+        chDbgPanic("BBRunning");
     }
+
+    const auto start = chTimeNow();
+    creg::m4txevent::clear();
+    shared_memory.clear_baseband_ready();
+    shared_memory.baseband_queue.reset();
+
+    const bool reused = m4_init(image_tag, memory::map::m4_code, false);
+    start_image(image_tag, reused, start);
 }
 
 void run_prepared_image(const uint32_t m4_code) {
@@ -357,23 +412,33 @@ void run_prepared_image(const uint32_t m4_code) {
         chDbgPanic("BBRunning");
     }
 
+    const auto start = chTimeNow();
     creg::m4txevent::clear();
     shared_memory.clear_baseband_ready();
+    shared_memory.baseband_queue.reset();
 
     m4_init_prepared(m4_code, false);
-    baseband_image_running = true;
+    start_image(spi_flash::image_tag_none, false, start);
+}
 
-    creg::m4txevent::enable();
+const ImageSwitchStats& last_image_switch() {
+    return image_switch_stats;
+}
 
-    if constexpr (enforce_core_sync) {
-        // Wait up to 3 seconds for baseband to start handling events.
-        auto count = 3'000u;
-        while (!shared_memory.baseband_ready && --count)
-            chThdSleepMilliseconds(1);
+bool request_memory_stats(const uint32_t timeout_ms, const bool reset_peaks) {
+    if (!baseband_image_running || !shared_memory.baseband_ready)
+        return false;
+
+    const auto token = send_message(MemoryStatsRequestMessage{reset_peaks});
+    const auto start = chTimeNow();
+    while (!shared_memory.baseband_queue.is_complete(token)) {
+        if (chTimeNow() - start > MS2ST(timeout_ms))
+            return false;
 
-        if (count == 0)
-            chDbgPanic("Baseband Sync Fail");
+        chThdSleepMilliseconds(5);
     }
+
+    return true;
 }
 
 void shutdown() {
@@ -384,53 +449,78 @@ void shutdown() {
     creg::m4txevent::disable();
 
     ShutdownMessage message;
-    send_message(&message);
+    send_message_and_wait(message);
 
     shared_memory.application_queue.reset();
 
     baseband_image_running = false;
 }
 
-void spectrum_streaming_start() {
+void spectrum_streaming_start(const bool waterfall_rows) {
+    spectrum_processing.waterfall_rows |= waterfall_rows;
+
     SpectrumStreamingConfigMessage message{
-        SpectrumStreamingConfigMessage::Mode::Running};
-    send_message(&message);
+        SpectrumStreamingConfigMessage::Mode::Running,
+        spectrum_processing.window,
+        spectrum_processing.detector,
+        spectrum_processing.detector_count,
+        spectrum_processing.waterfall_rows};
+    send_message(message);
 }
 
 void spectrum_streaming_stop() {
     SpectrumStreamingConfigMessage message{
         SpectrumStreamingConfigMessage::Mode::Stopped};
-    send_message(&message);
+    send_message(message);
+}
+
+void set_spectrum_processing(
+    const dsp::window::Type window,
+    const SpectrumDetectorMode detector,
+    const uint8_t detector_count) {
+    spectrum_processing = {window, detector, detector_count, spectrum_processing.waterfall_rows};
+
+    SpectrumStreamingConfigMessage message{
+        SpectrumStreamingConfigMessage::Mode::Configure,
+        window,
+        detector,
+        detector_count};
+    send_message(message);
 }
 
 void set_sample_rate(uint32_t sample_rate, OversampleRate oversample_rate) {
     SampleRateConfigMessage message{sample_rate, oversample_rate};
-    send_message(&message);
+    send_message(message);
 }
 
 void capture_start(CaptureConfig* const config) {
     CaptureConfigMessage message{config};
-    send_message(&message);
+    send_message_and_wait(message);
 }
 
 void capture_stop() {
     CaptureConfigMessage message{nullptr};
-    send_message(&message);
+    send_message_and_wait(message);
 }
 
 void replay_start(ReplayConfig* const config) {
     ReplayConfigMessage message{config};
-    send_message(&message);
+    send_message_and_wait(message);
 }
 
 void replay_stop() {
     ReplayConfigMessage message{nullptr};
-    send_message(&message);
+    send_message_and_wait(message);
+}
+
+void set_replay_gain(const uint16_t peak, const bool dither) {
+    ReplayGainConfigMessage message{peak, dither};
+    send_message(message);
 }
 
 void request_beep(RequestSignalMessage::Signal beep_type) {
     RequestSignalMessage message{beep_type};
-    send_message(&message);
+    send_message(message);
 }
 
 void request_roger_beep() {
@@ -447,7 +537,7 @@ void request_beep_stop() {
 
 void request_audio_beep(uint32_t freq, uint32_t sample_rate, uint32_t duration_ms) {
     AudioBeepMessage message{freq, sample_rate, duration_ms};
-    send_message(&message);
+    send_message(message);
 }
 
 } /* namespace baseband */
@@ -73,6 +73,7 @@ void set_fsk(const size_t deviation);
 void set_aprs(const uint32_t baudrate);
 
 void set_btlerx(uint8_t channel_number);
+void set_ais(const bool dual_channel);
 void set_btletx(uint8_t channel_number, char* macAddress, char* advertisementData, uint8_t pduType);
 
 void set_nrf(const uint32_t baudrate, const uint32_t word_length, const uint32_t trigger_value, const bool trigger_word);
@@ -89,6 +90,7 @@ void set_siggen_tone(const uint32_t tone);
 void set_siggen_config(const uint32_t bw, const uint32_t shape, const uint32_t duration);
 void set_spectrum_painter_config(const uint16_t width, const uint16_t height, bool update, int32_t bw);
 void set_subghzd_config(uint8_t modulation, uint32_t sampling_rate);
+void set_ism(const uint8_t decoders);
 
 void request_roger_beep();
 void request_rssi_beep();
@@ -97,17 +99,48 @@ void request_audio_beep(uint32_t freq, uint32_t sample_rate, uint32_t duration_m
 
 void run_image(const portapack::spi_flash::image_tag_t image_tag);
 void run_prepared_image(const uint32_t m4_code);
+
+/* Timing of the last baseband image start, for diagnostics. */
+struct ImageSwitchStats {
+    portapack::spi_flash::image_tag_t image_tag{};
+    bool reused{false};  // Image was still in place, no extraction needed.
+    uint32_t load_ms{0};
+    uint32_t ready_ms{0};
+    uint32_t count{0};
+    uint32_t reused_count{0};
+};
+
+const ImageSwitchStats& last_image_switch();
+
+/* Has the running image refresh shared_memory.m4_memory, starting its
+ * peaks over first if reset_peaks is set. False if no image answered
+ * within timeout_ms. */
+bool request_memory_stats(const uint32_t timeout_ms = 500, const bool reset_peaks = false);
+
 void shutdown();
 
-void spectrum_streaming_start();
+/* waterfall_rows asks the baseband to also stream pre-folded waterfall
+ * rows. Once asked for, rows stay on until a new image is run. */
+void spectrum_streaming_start(const bool waterfall_rows = false);
 void spectrum_streaming_stop();
 
+/* Selects the FFT window and video detector used by the spectrum collector.
+ * Kept across start/stop, reset to defaults when a new image is run. */
+void set_spectrum_processing(
+    const dsp::window::Type window,
+    const SpectrumDetectorMode detector = SpectrumDetectorMode::Sample,
+    const uint8_t detector_count = 1);
+
 /* NB: sample_rate should be desired rate. Don't pre-scale. */
 void set_sample_rate(uint32_t sample_rate, OversampleRate oversample_rate = OversampleRate::None);
 void capture_start(CaptureConfig* const config);
 void capture_stop();
 void replay_start(ReplayConfig* const config);
 void replay_stop();
+/* Scales replay so a source peaking at peak (C16 units, from the
+ * capture metadata) fills the DAC. 0 keeps the plain C16 to C8 shift.
+ * dither adds TPDF noise before the samples are rounded to C8. */
+void set_replay_gain(const uint16_t peak, const bool dither = false);
 
 } /* namespace baseband */
 
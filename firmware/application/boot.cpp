@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "boot.hpp"
+
+#include <array>
+
+namespace boot {
+
+static std::array<TraceEntry, max_trace_entries> trace_entries{};
+static size_t trace_entries_count = 0;
+
+static std::array<std::function<void()>, 8> deferred_tasks{};
+static size_t deferred_count = 0;
+static bool deferred_complete = false;
+
+void trace(const char* phase) {
+    if (trace_entries_count < trace_entries.size())
+        trace_entries[trace_entries_count++] = {phase, chTimeNow()};
+}
+
+size_t trace_count() {
+    return trace_entries_count;
+}
+
+const TraceEntry& trace_entry(size_t index) {
+    return trace_entries[index];
+}
+
+void defer(std::function<void()> task) {
+    // Too late, or no room left, to defer.
+    if (deferred_complete || deferred_count == deferred_tasks.size()) {
+        task();
+        return;
+    }
+
+    deferred_tasks[deferred_count++] = std::move(task);
+}
+
+void run_deferred() {
+    if (deferred_complete)
+        return;
+
+    trace("first frame");
+
+    // Tasks may defer more work, it runs right away from now on.
+    deferred_complete = true;
+
+    for (size_t i = 0; i < deferred_count; i++) {
+        deferred_tasks[i]();
+        deferred_tasks[i] = nullptr;
+    }
+    deferred_count = 0;
+
+    trace("deferred init");
+}
+
+bool deferred_done() {
+    return deferred_complete;
+}
+
+} /* namespace boot */
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __BOOT_H__
+#define __BOOT_H__
+
+#include <cstddef>
+#include <functional>
+
+#include "ch.h"
+
+namespace boot {
+
+/* Boot trace, a RAM log of when each init phase finished. */
+struct TraceEntry {
+    const char* phase;
+    systime_t time;
+};
+
+constexpr size_t max_trace_entries = 32;
+
+/* Records that phase has finished. Entries past the limit are dropped. */
+void trace(const char* phase);
+
+size_t trace_count();
+const TraceEntry& trace_entry(size_t index);
+
+/* Deferred init, for subsystems the first UI frame doesn't depend on. The
+ * tasks run in order on the UI thread once the first frame is painted. */
+void defer(std::function<void()> task);
+void run_deferred();
+bool deferred_done();
+
+} /* namespace boot */
+
+#endif /*__BOOT_H__*/
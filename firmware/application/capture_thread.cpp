@@ -23,6 +23,8 @@
 
 #include "baseband_api.hpp"
 #include "buffer_exchange.hpp"
+#include "memory_stats.hpp"
+#include "metadata_file.hpp"
 
 struct BasebandCapture {
     BasebandCapture(CaptureConfig* const config) {
@@ -41,11 +43,13 @@ CaptureThread::CaptureThread(
     size_t write_size,
     size_t buffer_count,
     std::function<void()> success_callback,
-    std::function<void(File::Error)> error_callback)
+    std::function<void(File::Error)> error_callback,
+    std::filesystem::path metadata_path)
     : config{write_size, buffer_count},
       writer{std::move(writer)},
       success_callback{std::move(success_callback)},
-      error_callback{std::move(error_callback)} {
+      error_callback{std::move(error_callback)},
+      metadata_path{std::move(metadata_path)} {
     // Need significant stack for FATFS
     thread = chThdCreateFromHeap(NULL, 1024, NORMALPRIO + 10, CaptureThread::static_fn, this);
 }
@@ -59,6 +63,9 @@ CaptureThread::~CaptureThread() {
 }
 
 msg_t CaptureThread::static_fn(void* arg) {
+    chRegSetThreadName("capture");
+    memory_stats::set_thread_tag(memory_stats::Tag::Radio);
+
     auto obj = static_cast<CaptureThread*>(arg);
     const auto error = obj->run();
     if (error.is_valid() && obj->error_callback) {
@@ -72,6 +79,15 @@ msg_t CaptureThread::static_fn(void* arg) {
 }
 
 Optional<File::Error> CaptureThread::run() {
+    // 'File' is too big for this stack. The time index is best effort,
+    // the capture goes on without it.
+    std::unique_ptr<File> metadata;
+    if (!metadata_path.empty()) {
+        metadata = std::make_unique<File>();
+        if (metadata->append(metadata_path))
+            metadata.reset();
+    }
+
     BasebandCapture capture{&config};
     BufferExchange buffers{&config};
 
@@ -83,7 +99,24 @@ Optional<File::Error> CaptureThread::run() {
         }
         buffer->empty();
         buffers.put(buffer);
+
+        if (metadata)
+            write_time_marks(*metadata);
     }
 
+    if (metadata && config.peak > 0)
+        write_metadata_peak(*metadata, config.peak);
+
     return {};
 }
+
+void CaptureThread::write_time_marks(File& f) {
+    const uint32_t written = config.time_marks_written;
+
+    // Marks the M4 has already overwritten are lost.
+    if (written - time_marks_read > CaptureConfig::time_marks_count)
+        time_marks_read = written - CaptureConfig::time_marks_count;
+
+    for (; time_marks_read != written; time_marks_read++)
+        write_metadata_time_mark(f, config.time_marks[time_marks_read % CaptureConfig::time_marks_count]);
+}
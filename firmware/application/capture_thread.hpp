@@ -40,7 +40,8 @@ class CaptureThread {
         size_t write_size,
         size_t buffer_count,
         std::function<void()> success_callback,
-        std::function<void(File::Error)> error_callback);
+        std::function<void(File::Error)> error_callback,
+        std::filesystem::path metadata_path = {});
     ~CaptureThread();
 
     CaptureThread(const CaptureThread&) = delete;
@@ -57,11 +58,14 @@ class CaptureThread {
     std::unique_ptr<stream::Writer> writer;
     std::function<void()> success_callback;
     std::function<void(File::Error)> error_callback;
+    std::filesystem::path metadata_path;
+    uint32_t time_marks_read{0};
     Thread* thread{nullptr};
 
     static msg_t static_fn(void* arg);
 
     Optional<File::Error> run();
+    void write_time_marks(File& f);
 };
 
 #endif /*__CAPTURE_THREAD_H__*/
@@ -26,40 +26,101 @@
 #include "lpc43xx_cpp.hpp"
 #include "lz4.h"
 #include "message.hpp"
+#include "utility.hpp"
 
+#include <array>
 #include <cstring>
 
 using namespace lpc43xx;
 using namespace portapack;
 
-void m4_init(const spi_flash::image_tag_t image_tag, const memory::region_t to, const bool full_reset) {
+/* Images in SPI flash, indexed on first use so a lookup doesn't have to
+ * walk the chunk list in flash. Images past the end of a full directory
+ * are still found by walking the rest of the list. */
+struct image_entry_t {
+    spi_flash::image_tag_t tag;
+    const spi_flash::chunk_t* chunk;
+};
+
+static std::array<image_entry_t, 64> image_directory{};
+static size_t image_count = 0;
+static const spi_flash::chunk_t* unindexed_chunk = nullptr;  // First image the directory had no room for.
+
+/* The M4 never writes to its code region, so the last image extracted into
+ * m4_code is still intact when it's needed again unless something else
+ * (like an external app) has since been loaded there. The checksum of the
+ * whole region catches that. */
+static spi_flash::image_tag_t m4_code_tag{};
+static uint32_t m4_code_checksum = 0;
+
+static void build_image_directory() {
     const spi_flash::chunk_t* chunk = reinterpret_cast<const spi_flash::chunk_t*>(spi_flash::images.base());
-    while (chunk->tag) {
-        if (chunk->tag == image_tag) {
-            const void* src = &chunk->data[0];
-            void* dst = reinterpret_cast<void*>(to.base());
+    while (chunk->tag && image_count < image_directory.size()) {
+        image_directory[image_count++] = {chunk->tag, chunk};
+        chunk = chunk->next();
+    }
+
+    if (chunk->tag)
+        unindexed_chunk = chunk;
+}
+
+static const spi_flash::chunk_t* find_image(const spi_flash::image_tag_t image_tag) {
+    if (image_count == 0)
+        build_image_directory();
+
+    for (size_t i = 0; i < image_count; i++) {
+        if (image_directory[i].tag == image_tag)
+            return image_directory[i].chunk;
+    }
+
+    for (auto chunk = unindexed_chunk; chunk && chunk->tag; chunk = chunk->next()) {
+        if (chunk->tag == image_tag)
+            return chunk;
+    }
+
+    return nullptr;
+}
+
+static uint32_t m4_code_region_checksum() {
+    return simple_checksum(memory::map::m4_code.base(), memory::map::m4_code.size());
+}
 
-            /* extract and initialize M4 code RAM */
-            unlz4_len(src, dst, chunk->compressed_data_size);
+bool m4_init(const spi_flash::image_tag_t image_tag, const memory::region_t to, const bool full_reset) {
+    const auto chunk = find_image(image_tag);
+    if (!chunk)
+        chDbgPanic("NoImg");
 
-            /* M4 core is assumed to be sleeping with interrupts off, so we can mess
-             * with its address space and RAM without concern.
-             */
-            LPC_CREG->M4MEMMAP = to.base();
+    const bool to_m4_code = (to.base() == memory::map::m4_code.base());
+    const bool reused = to_m4_code && (m4_code_tag == image_tag) && (m4_code_region_checksum() == m4_code_checksum);
 
-            /* Reset M4 core and optionally all peripherals */
-            LPC_RGU->RESET_CTRL[0] = (full_reset) ? (1 << 1)    // PERIPH_RST
-                                                  : (1 << 13);  // M4_RST
+    if (!reused) {
+        /* extract and initialize M4 code RAM */
+        unlz4_len(&chunk->data[0], reinterpret_cast<void*>(to.base()), chunk->compressed_data_size);
 
-            return;
+        if (to_m4_code) {
+            m4_code_tag = image_tag;
+            m4_code_checksum = m4_code_region_checksum();
         }
-        chunk = chunk->next();
     }
 
-    chDbgPanic("NoImg");
+    /* M4 core is assumed to be sleeping with interrupts off, so we can mess
+     * with its address space and RAM without concern.
+     */
+    LPC_CREG->M4MEMMAP = to.base();
+
+    /* Reset M4 core and optionally all peripherals */
+    LPC_RGU->RESET_CTRL[0] = (full_reset) ? (1 << 1)    // PERIPH_RST
+                                          : (1 << 13);  // M4_RST
+
+    return reused;
 }
 
 void m4_init_prepared(const uint32_t m4_code, const bool full_reset) {
+    /* The caller has put its own code in place, so whatever image was
+     * extracted before can't be reused. */
+    m4_code_tag = {};
+    m4_code_checksum = 0;
+
     /* M4 core is assumed to be sleeping with interrupts off, so we can mess
      * with its address space and RAM without concern.
      */
@@ -46,6 +46,8 @@ void __debug_log(const std::string& msg) {
     }
 
     pg_debug_log->write_entry(msg);
+    // Debug output is often the last thing before a fault.
+    pg_debug_log->flush();
 }
 
 void runtime_error(uint8_t source);
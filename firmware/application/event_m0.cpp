@@ -26,6 +26,7 @@
 #include "debug.hpp"
 
 #include "sd_card.hpp"
+#include "boot.hpp"
 #include "rtc_time.hpp"
 
 #include "message.hpp"
@@ -339,6 +340,8 @@ void EventDispatcher::handle_lcd_frame_sync() {
 
     portapack::backlight()->on();
 
+    boot::run_deferred();
+
     if (waiting_for_frame)
         this->waiting_for_frame = false;
 }
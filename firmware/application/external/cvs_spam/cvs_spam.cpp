@@ -113,6 +113,7 @@ void CVSSpamView::start_tx(const uint32_t id) {
     ready_signal = false;
 
     baseband::set_sample_rate(metadata->sample_rate, get_oversample_rate(metadata->sample_rate));
+    baseband::set_replay_gain(metadata->peak);
 
     auto reader = std::make_unique<FileConvertReader>();
     if (auto error = reader->open(current_file)) {
@@ -187,6 +188,7 @@ void CVSSpamView::start_random_tx() {
     ready_signal = false;
 
     baseband::set_sample_rate(metadata->sample_rate, get_oversample_rate(metadata->sample_rate));
+    baseband::set_replay_gain(metadata->peak);
 
     auto reader = std::make_unique<FileConvertReader>();
     if (auto error = reader->open(current_file)) {
@@ -146,6 +146,10 @@ set(EXTCPPSRC
 	#metronome
 	external/metronome/main.cpp
 	external/metronome/ui_metronome.cpp
+
+	#ismrx
+	external/ismrx/main.cpp
+	external/ismrx/ism_app.cpp
 )
 
 set(EXTAPPLIST
@@ -184,4 +188,5 @@ set(EXTAPPLIST
 	fmradio
 	tuner
 	metronome
+	ismrx
 )
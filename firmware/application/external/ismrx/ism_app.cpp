@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "ism_app.hpp"
+
+#include "baseband_api.hpp"
+#include "portapack.hpp"
+#include "rtc_time.hpp"
+#include "string_builder.hpp"
+#include "string_format.hpp"
+
+#include "ert_packet.hpp"
+#include "tpms_packet.hpp"
+#include "ui_subghzd.hpp"
+
+using namespace portapack;
+
+namespace ui::external_app::ismrx {
+
+ISMAppView::ISMAppView(NavigationView& nav)
+    : nav_{nav} {
+    add_children({&field_frequency,
+                  &field_rf_amp,
+                  &field_lna,
+                  &field_vga,
+                  &rssi,
+                  &check_tpms,
+                  &check_ert,
+                  &check_weather,
+                  &check_subghzd,
+                  &console});
+
+    baseband::run_image(portapack::spi_flash::image_tag_ism);
+
+    const std::pair<Checkbox*, ism::Protocol> checks[] = {
+        {&check_tpms, ism::Protocol::TPMS},
+        {&check_ert, ism::Protocol::ERT},
+        {&check_weather, ism::Protocol::Weather},
+        {&check_subghzd, ism::Protocol::SubGhzD},
+    };
+
+    for (const auto& [check, protocol] : checks) {
+        const auto bit = ism::decoder_bit(protocol);
+        check->set_value(decoders & bit);
+        check->on_select = [this, bit](Checkbox&, bool v) {
+            decoders = v ? (decoders | bit) : (decoders & ~bit);
+            update_decoders();
+        };
+    }
+
+    field_frequency.set_step(10000);
+    update_decoders();
+    receiver_model.enable();
+}
+
+ISMAppView::~ISMAppView() {
+    receiver_model.disable();
+    baseband::shutdown();
+}
+
+void ISMAppView::focus() {
+    field_frequency.focus();
+}
+
+void ISMAppView::update_decoders() {
+    baseband::set_ism(decoders);
+}
+
+void ISMAppView::on_packet(const ISMPacketMessage& message) {
+    StringBuffer<64> line;
+    append_datetime(line, rtc_time::now(), HMS).append(' ');
+
+    switch (message.protocol) {
+        case ism::Protocol::TPMS: {
+            const tpms::Packet packet{message.packet, static_cast<tpms::SignalType>(message.type)};
+            const auto reading = packet.reading();
+            if (!reading)
+                return;
+
+            line.append("TPMS ").append_hex(reading->id().value(), 8);
+            if (reading->pressure())
+                line.append(' ').append_dec(reading->pressure()->kilopascal()).append("kPa");
+            if (reading->temperature())
+                line.append(' ').append_dec(reading->temperature()->celsius()).append('C');
+            break;
+        }
+
+        case ism::Protocol::ERT: {
+            const ert::Packet packet{static_cast<ert::Packet::Type>(message.type), message.packet};
+            if (!packet.crc_ok())
+                return;
+
+            line.append("ERT ").append_dec_uint(packet.id()).append(' ').append_dec_uint(packet.consumption());
+            break;
+        }
+
+        case ism::Protocol::Weather:
+            line.append("Wthr type ").append_dec_uint(message.type).append(' ').append_hex(message.data, 16);
+            break;
+
+        case ism::Protocol::SubGhzD:
+            line.append(SubGhzDView::getSensorTypeName(static_cast<FPROTO_SUBGHZD_SENSOR>(message.type)))
+                .append(' ')
+                .append_dec_uint(message.bits)
+                .append("b ")
+                .append_hex(message.data, 16);
+            break;
+
+        default:
+            return;
+    }
+
+    console.writeln(line);
+}
+
+} /* namespace ui::external_app::ismrx */
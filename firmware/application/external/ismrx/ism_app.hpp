@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __ISM_APP_H__
+#define __ISM_APP_H__
+
+#include "ui.hpp"
+#include "ui_navigation.hpp"
+#include "ui_receiver.hpp"
+#include "ui_freq_field.hpp"
+#include "app_settings.hpp"
+#include "radio_state.hpp"
+
+#include "message.hpp"
+
+namespace ui::external_app::ismrx {
+
+/* Listens for TPMS, ERT, weather stations and SubGhzD remotes at once
+ * using the multi-protocol ISM image. */
+class ISMAppView : public View {
+   public:
+    ISMAppView(NavigationView& nav);
+    ~ISMAppView();
+
+    void focus() override;
+
+    std::string title() const override { return "ISM Multi"; };
+
+   private:
+    void on_packet(const ISMPacketMessage& message);
+    void update_decoders();
+
+    NavigationView& nav_;
+    RxRadioState radio_state_{
+        433'920'000 /* frequency */,
+        1'750'000 /* bandwidth */,
+        4'194'304 /* sampling rate */};
+    uint8_t decoders{ism::all_decoders};
+    app_settings::SettingsManager settings_{
+        "rx_ism",
+        app_settings::Mode::RX,
+        {
+            {"decoders"sv, &decoders},
+        }};
+
+    RxFrequencyField field_frequency{
+        {0 * 8, 0 * 16},
+        nav_};
+    RFAmpField field_rf_amp{
+        {13 * 8, 0 * 16}};
+    LNAGainField field_lna{
+        {15 * 8, 0 * 16}};
+    VGAGainField field_vga{
+        {18 * 8, 0 * 16}};
+    RSSI rssi{
+        {21 * 8, 0, 6 * 8, 4}};
+
+    Checkbox check_tpms{
+        {0 * 8, 1 * 16},
+        4,
+        "TPMS",
+        true};
+    Checkbox check_ert{
+        {7 * 8, 1 * 16},
+        3,
+        "ERT",
+        true};
+    Checkbox check_weather{
+        {13 * 8, 1 * 16},
+        4,
+        "Wthr",
+        true};
+    Checkbox check_subghzd{
+        {20 * 8, 1 * 16},
+        4,
+        "SubG",
+        true};
+
+    Console console{
+        {0, 3 * 16, screen_width, screen_height - 3 * 16}};
+
+    MessageHandlerRegistration message_handler_packet{
+        Message::ID::ISMPacket,
+        [this](Message* const p) {
+            const auto message = static_cast<const ISMPacketMessage*>(p);
+            this->on_packet(*message);
+        }};
+};
+
+} /* namespace ui::external_app::ismrx */
+
+#endif /*__ISM_APP_H__*/
@@ -490,6 +490,7 @@ void RemoteAppView::send_button(RemoteButton& btn) {
     baseband::set_sample_rate(
         btn.entry()->metadata.sample_rate,
         get_oversample_rate(btn.entry()->metadata.sample_rate));
+    baseband::set_replay_gain(btn.entry()->metadata.peak);
 
     // ReplayThread starts immediately on construction; must be set before creating.
     transmitter_model.set_target_frequency(btn.entry()->metadata.center_frequency);
@@ -79,7 +79,7 @@ void TPMSLogger::on_packet(const tpms::Packet& packet, const uint32_t target_fre
     // TODO: function doesn't take uint64_t, so when >= 1<<32, weirdness will ensue!
     const auto target_frequency_str = to_string_dec_uint(target_frequency, 10);
 
-    std::string entry = target_frequency_str + " " + ui::external_app::tpmsrx::format::signal_type(packet.signal_type()) + " " + hex_formatted.data + "/" + hex_formatted.errors;
+    std::string entry = target_frequency_str + " " + ui::external_app::tpmsrx::format::signal_type(packet.signal_type()) + " " + hex_formatted.data + "/" + hex_formatted.errors + " S:" + to_string_dec_uint(packet.sample_index());
     log_file.write_entry(packet.received_at(), entry);
 }
 
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "external_app_catalog.hpp"
+
+#include "file_path.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace fs = std::filesystem;
+
+static fs::path get_catalog_path() {
+    return apps_dir / u"CATALOG.PPC";
+}
+
+static bool read_all(File& f, void* data, File::Size size) {
+    auto result = f.read(data, size);
+    return result.is_ok() && *result == size;
+}
+
+static bool write_all(File& f, const void* data, File::Size size) {
+    auto result = f.write(data, size);
+    return result.is_ok() && *result == size;
+}
+
+uint32_t external_app_name_hash(const fs::path& name) {
+    uint32_t hash = 0x811c9dc5;
+    for (auto c : name.native()) {
+        if (c >= u'a' && c <= u'z')
+            c -= u'a' - u'A';
+
+        hash = (hash ^ (c & 0xff)) * 0x01000193;
+        hash = (hash ^ (c >> 8)) * 0x01000193;
+    }
+    return hash;
+}
+
+std::string external_app_catalog_entry::call_name() const {
+    return path.stem().string();
+}
+
+static std::vector<external_app_catalog_record> read_catalog() {
+    std::vector<external_app_catalog_record> records;
+    File f;
+    if (f.open(get_catalog_path()))
+        return records;
+
+    external_app_catalog_header header{};
+    if (!read_all(f, &header, sizeof(header)) ||
+        header.magic != external_app_catalog_magic ||
+        header.version != external_app_catalog_version ||
+        f.size() != sizeof(header) + header.count * sizeof(external_app_catalog_record))
+        return records;
+
+    records.resize(header.count);
+    if (!read_all(f, records.data(), records.size() * sizeof(external_app_catalog_record)))
+        records.clear();
+
+    return records;
+}
+
+static void write_catalog(const std::vector<external_app_catalog_entry>& entries) {
+    const auto path = get_catalog_path();
+    bool ok = false;
+
+    {
+        File f;
+        if (f.create(path))
+            return;
+
+        external_app_catalog_header header{
+            .magic = external_app_catalog_magic,
+            .version = external_app_catalog_version,
+            .reserved = 0,
+            .count = static_cast<uint32_t>(entries.size()),
+        };
+
+        ok = write_all(f, &header, sizeof(header));
+        for (const auto& entry : entries)
+            ok = ok && write_all(f, &entry.record, sizeof(entry.record));
+    }
+
+    // A short catalog fails the size check anyway, don't leave it around.
+    if (!ok)
+        delete_file(path);
+}
+
+/* Reads the menu fields from the app header, false if it can't be read. */
+static bool read_app_header(const fs::path& path, external_app_kind kind, external_app_catalog_record& rec) {
+    File app;
+    if (app.open(path))
+        return false;
+
+    if (kind == external_app_kind::Application) {
+        application_information_t info = {};
+        if (!app.read(&info, sizeof(info)))
+            return false;
+
+        rec.header_version = info.header_version;
+        rec.app_version = info.app_version;
+        rec.icon_color = info.icon_color;
+        rec.menu_location = info.menu_location;
+        rec.desired_position = info.desired_menu_position;
+        memcpy(rec.app_name, info.app_name, sizeof(rec.app_name));
+        memcpy(rec.bitmap_data, info.bitmap_data, sizeof(rec.bitmap_data));
+    } else {
+        standalone_application_information_t info = {};
+        if (!app.read(&info, sizeof(info)))
+            return false;
+
+        rec.header_version = info.header_version;
+        rec.app_version = 0;
+        rec.icon_color = info.icon_color;
+        rec.menu_location = info.menu_location;
+        rec.desired_position = -1;  // No desired position support for standalone apps yet
+        memcpy(rec.app_name, info.app_name, sizeof(rec.app_name));
+        memcpy(rec.bitmap_data, info.bitmap_data, sizeof(rec.bitmap_data));
+    }
+
+    // The menu prints the name as a C string.
+    rec.app_name[sizeof(rec.app_name) - 1] = 0;
+    rec.kind = kind;
+    return true;
+}
+
+std::vector<external_app_catalog_entry> load_external_app_catalog() {
+    std::vector<external_app_catalog_entry> entries;
+    const auto cached = read_catalog();
+    bool changed = false;
+
+    auto scan = [&entries, &cached, &changed](const fs::path& filter, external_app_kind kind) {
+        for (const auto& file : fs::directory_iterator(apps_dir, filter)) {
+            if (fs::is_directory(file.status()))
+                continue;
+
+            external_app_catalog_entry entry{{}, apps_dir / file.path()};
+            const auto hash = external_app_name_hash(file.path());
+            const auto size = static_cast<uint32_t>(file.size());
+
+            auto it = std::find_if(cached.begin(), cached.end(), [&](const external_app_catalog_record& rec) {
+                return rec.name_hash == hash && rec.kind == kind && rec.file_size == size &&
+                       rec.file_date == file.fdate && rec.file_time == file.ftime;
+            });
+
+            if (it != cached.end()) {
+                entry.record = *it;
+            } else {
+                // Not cached on failure so it's retried next time.
+                if (!read_app_header(entry.path, kind, entry.record))
+                    continue;
+
+                entry.record.name_hash = hash;
+                entry.record.file_size = size;
+                entry.record.file_date = file.fdate;
+                entry.record.file_time = file.ftime;
+                changed = true;
+            }
+
+            entries.push_back(std::move(entry));
+        }
+    };
+
+    scan(u"*.ppma", external_app_kind::Application);
+    scan(u"*.ppmp", external_app_kind::Standalone);
+
+    if (changed || entries.size() != cached.size())
+        write_catalog(entries);
+
+    return entries;
+}
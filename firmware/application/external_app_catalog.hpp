@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __EXTERNAL_APP_CATALOG_H__
+#define __EXTERNAL_APP_CATALOG_H__
+
+#include "file.hpp"
+#include "standalone_app.hpp"
+#include "external_app.hpp"
+
+#include <cstdint>
+#include <vector>
+
+/* External app catalog (APPS/CATALOG.PPC) layout, all little-endian:
+ *
+ *   header     external_app_catalog_header
+ *   records    count x external_app_catalog_record
+ *
+ * Holds the menu fields of every .ppma and .ppmp header so building a
+ * menu doesn't have to open each app. A record belongs to the file with
+ * the same name hash, size and FAT modified time. Only files without a
+ * matching record are opened, and the catalog is rewritten only when a
+ * file was added, changed or removed. Headers are cached as read, the
+ * version checks are left to the menu so they follow firmware updates. */
+
+constexpr uint32_t external_app_catalog_magic = 0x43415050;  // "PPAC"
+constexpr uint16_t external_app_catalog_version = 1;
+
+enum class external_app_kind : uint8_t {
+    Application = 0,  // .ppma
+    Standalone = 1,   // .ppmp
+};
+
+struct external_app_catalog_record {
+    uint32_t name_hash;
+    uint32_t file_size;
+    uint16_t file_date;
+    uint16_t file_time;
+    external_app_kind kind;
+    uint8_t reserved[3];
+    uint32_t header_version;
+    uint32_t app_version;
+    uint32_t icon_color;
+    app_location_t menu_location;
+    int32_t desired_position;
+    uint8_t app_name[16];
+    uint8_t bitmap_data[32];
+};
+static_assert(sizeof(external_app_catalog_record) == 84, "external_app_catalog_record size changed.");
+
+struct external_app_catalog_header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t count;
+};
+static_assert(sizeof(external_app_catalog_header) == 12, "external_app_catalog_header size changed.");
+
+struct external_app_catalog_entry {
+    external_app_catalog_record record;
+    std::filesystem::path path;
+
+    /* File name without the extension, the name apps are started by. */
+    std::string call_name() const;
+};
+
+/* FNV-1a hash of the file name, case insensitive like FatFs. */
+uint32_t external_app_name_hash(const std::filesystem::path& name);
+
+/* Lists the apps in apps_dir, .ppma files first, reading
+ * only the headers the catalog doesn't already hold. */
+std::vector<external_app_catalog_entry> load_external_app_catalog();
+
+#endif /* __EXTERNAL_APP_CATALOG_H__ */
@@ -132,8 +132,8 @@ File::Size File::size() const {
     return f_size(&f);
 }
 
-Optional<File::Error> File::write_line(const std::string& s) {
-    const auto result_s = write(s.c_str(), s.size());
+Optional<File::Error> File::write_line(std::string_view s) {
+    const auto result_s = write(s.data(), s.size());
     if (result_s.is_error()) {
         return {result_s.error()};
     }
@@ -31,6 +31,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <array>
 #include <memory>
 #include <iterator>
@@ -350,7 +351,7 @@ class File {
         return write(data.data(), N);
     }
 
-    Optional<Error> write_line(const std::string& s);
+    Optional<Error> write_line(std::string_view s);
 
     // TODO: Return Result<>.
     Optional<Error> sync();
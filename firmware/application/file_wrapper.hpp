@@ -26,9 +26,11 @@
 #include "file.hpp"
 #include "optional.hpp"
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <string_view>
+#include <vector>
 
 enum class LineEnding : uint8_t {
     LF,
@@ -37,8 +39,6 @@ enum class LineEnding : uint8_t {
 
 /* TODO:
  * - CRLF handling.
- * - Avoid full re-read on edits.
- *   - Would need to read old/new text when editing to track newlines.
  * - How to surface errors? Exceptions?
  */
 
@@ -53,6 +53,97 @@ enum class LineEnding : uint8_t {
  * Optional<Error> sync()
  */
 
+/* Start offset of a line. */
+struct LineCheckpoint {
+    uint32_t line;
+    uint32_t offset;
+};
+
+/* Sparse index of line start offsets, roughly one every stride() lines,
+ * plus the total newline count of the buffer. Lets the wrapper jump
+ * close to any line without scanning from the beginning. */
+class LineIndex {
+   public:
+    static constexpr size_t max_checkpoints = 128;
+    static constexpr uint32_t initial_stride = 32;
+
+    void clear() {
+        checkpoints_.clear();
+        stride_ = initial_stride;
+        newline_count_ = 0;
+    }
+
+    /* Replaces the index with previously saved contents. */
+    void restore(uint32_t stride, uint32_t newline_count, std::vector<LineCheckpoint> checkpoints) {
+        stride_ = stride;
+        newline_count_ = newline_count;
+        checkpoints_ = std::move(checkpoints);
+    }
+
+    uint32_t stride() const { return stride_; }
+    uint32_t newline_count() const { return newline_count_; }
+    const std::vector<LineCheckpoint>& checkpoints() const { return checkpoints_; }
+
+    /* Records a newline, offset is the start of the following line. */
+    void add_newline(uint32_t offset) {
+        ++newline_count_;
+
+        auto last = checkpoints_.empty() ? 0 : checkpoints_.back().line;
+        if (newline_count_ < last + stride_)
+            return;
+
+        // Full, keep every other checkpoint.
+        if (checkpoints_.size() >= max_checkpoints) {
+            for (size_t i = 1; i < checkpoints_.size(); i += 2)
+                checkpoints_[i / 2] = checkpoints_[i];
+            checkpoints_.resize(checkpoints_.size() / 2);
+            stride_ *= 2;
+
+            if (newline_count_ < checkpoints_.back().line + stride_)
+                return;
+        }
+
+        checkpoints_.push_back({newline_count_, offset});
+    }
+
+    /* Gets the closest checkpoint at or before line. */
+    LineCheckpoint find(uint32_t line) const {
+        auto it = std::upper_bound(
+            checkpoints_.begin(), checkpoints_.end(), line,
+            [](uint32_t l, const LineCheckpoint& cp) { return l < cp.line; });
+
+        if (it == checkpoints_.begin())
+            return {0, 0};
+
+        return *(--it);
+    }
+
+    /* Fixes up the index after [start, end) was replaced with text
+     * that changed the size by delta_size and newlines by delta_lines. */
+    void update(uint32_t start, uint32_t end, int32_t delta_size, int32_t delta_lines) {
+        newline_count_ += delta_lines;
+
+        auto it = checkpoints_.begin();
+        while (it != checkpoints_.end()) {
+            if (it->offset <= start) {
+                ++it;
+            } else if (it->offset <= end) {
+                // The newline before it was replaced.
+                it = checkpoints_.erase(it);
+            } else {
+                it->line += delta_lines;
+                it->offset += delta_size;
+                ++it;
+            }
+        }
+    }
+
+   private:
+    std::vector<LineCheckpoint> checkpoints_{};
+    uint32_t stride_{initial_stride};
+    uint32_t newline_count_{0};
+};
+
 /* Wraps a buffer and provides an API for accessing lines efficiently. */
 template <typename BufferType, uint32_t CacheSize>
 class BufferWrapper {
@@ -184,6 +275,9 @@ class BufferWrapper {
          * If delta_length < 0, the file needs to be truncated and the
          * content after the value needs to be shifted backward. */
         int32_t delta_length = value.length() - range.length();
+        int32_t delta_lines = std::count(value.begin(), value.end(), '\n') -
+                              count_newlines(range.start, range.end);
+
         if (delta_length > 0)
             expand(range.end, delta_length);
         else if (delta_length < 0)
@@ -191,7 +285,10 @@ class BufferWrapper {
 
         write(range.start, value);
         wrapped_->sync();
-        rebuild_cache();
+
+        index_.update(range.start, range.end, delta_length, delta_lines);
+        index_dirty_ = true;
+        load_window(start_line_);
     }
 
    protected:
@@ -202,6 +299,19 @@ class BufferWrapper {
         initialize();
     }
 
+    /* Uses a previously built index instead of scanning the buffer. */
+    void set_buffer(BufferType* buffer, LineIndex index) {
+        wrapped_ = buffer;
+        index_ = std::move(index);
+        index_dirty_ = false;
+        load_window(0);
+    }
+
+    const LineIndex& line_index() const { return index_; }
+
+    /* True if the index changed since it was built or restored. */
+    bool index_dirty() const { return index_dirty_; }
+
    private:
     /* Number of newline offsets to cache. */
     static constexpr Offset max_newlines = CacheSize;
@@ -216,8 +326,48 @@ class BufferWrapper {
         rebuild_cache();
     }
 
+    /* Scans the whole buffer to rebuild the line index. */
     void rebuild_cache() {
+        index_.clear();
+        index_dirty_ = true;
+
+        char buffer[buffer_size];
+        Offset offset = 0;
+        wrapped_->seek(0);
+
+        // Report progress every N lines.
+        constexpr auto report_interval = 100u;
+        auto next_report = report_interval;
+
+        while (offset < size()) {
+            auto result = wrapped_->read(buffer, buffer_size);
+            if (result.is_error() || *result == 0)
+                break;
+
+            for (Offset i = 0; i < *result; ++i) {
+                if (buffer[i] != '\n')
+                    continue;
+
+                index_.add_newline(offset + i + 1);
+
+                if (on_read_progress && index_.newline_count() > next_report) {
+                    on_read_progress(offset + i, size());
+                    next_report = index_.newline_count() + report_interval;
+                }
+            }
+
+            offset += *result;
+        }
+
+        load_window(0);
+    }
+
+    /* Reloads the newline cache starting at line, using
+     * the index to avoid scanning from the beginning. */
+    void load_window(Line line) {
         newlines_.clear();
+        start_line_ = 0;
+        start_offset_ = 0;
 
         // Special case for empty files to keep them consistent.
         if (size() == 0) {
@@ -226,35 +376,22 @@ class BufferWrapper {
             return;
         }
 
-        // TODO: think through this for edit cases.
-        // E.g. don't read to end, maybe could specify
-        // a range to re-read because it should be possible
-        // to tell where the dirty regions are. After the
-        // dirty region, it should be possible to fixup
-        // the line_count data.
-        // TODO: seems like shrink/expand could do this while
-        // they are running.
+        // A trailing partial line is counted as a line too.
+        char last = '\n';
+        read(size() - 1, &last, 1);
+        line_count_ = index_.newline_count() + (last != '\n' ? 1 : 0);
 
-        line_count_ = start_line_;
-        Offset offset = start_offset_;
-
-        // Report progress every N lines.
-        constexpr auto report_interval = 100u;
-        auto result = next_newline(offset);
-        auto next_report = report_interval;
+        line = std::min(line, line_count_ - 1);
+        auto checkpoint = index_.find(line);
+        auto offset = skip_lines(checkpoint.offset, line - checkpoint.line);
 
-        while (result) {
-            ++line_count_;
-            if (newlines_.size() < max_newlines)
-                newlines_.push_back(*result);
-            offset = *result + 1;
+        start_line_ = line;
+        start_offset_ = offset;
 
-            if (on_read_progress && line_count_ > next_report) {
-                on_read_progress(offset, size());
-                next_report = line_count_ + report_interval;
-            }
-
-            result = next_newline(offset);
+        auto result = next_newline(offset);
+        while (result && newlines_.size() < max_newlines) {
+            newlines_.push_back(*result);
+            result = next_newline(*result + 1);
         }
     }
 
@@ -299,6 +436,14 @@ class BufferWrapper {
         if (index)
             return;
 
+        // Far away, reload the cache around the line instead of scrolling.
+        auto cache_end = start_line_ + newlines_.size();
+        if ((line < start_line_ && start_line_ - line > max_newlines) ||
+            (line >= cache_end && line - cache_end > max_newlines)) {
+            load_window(line > max_newlines / 2 ? line - max_newlines / 2 : 0);
+            return;
+        }
+
         if (line < start_line_) {
             while (line < start_line_ && start_offset_ >= 2) {
                 // start_offset_ - 1 should be a newline. Need to
@@ -331,6 +476,45 @@ class BufferWrapper {
         }
     }
 
+    /* Gets the offset after skipping count newlines forward from offset. */
+    Offset skip_lines(Offset offset, Line count) {
+        char buffer[buffer_size];
+        wrapped_->seek(offset);
+
+        while (count > 0) {
+            auto result = wrapped_->read(buffer, buffer_size);
+            if (result.is_error() || *result == 0)
+                break;
+
+            for (Offset i = 0; i < *result; ++i) {
+                if (buffer[i] == '\n' && --count == 0)
+                    return offset + i + 1;
+            }
+
+            offset += *result;
+        }
+
+        return offset;
+    }
+
+    /* Counts the newlines in [start, end). */
+    int32_t count_newlines(Offset start, Offset end) {
+        char buffer[buffer_size];
+        int32_t count = 0;
+        wrapped_->seek(start);
+
+        while (start < end) {
+            auto result = wrapped_->read(buffer, std::min(end - start, buffer_size));
+            if (result.is_error() || *result == 0)
+                break;
+
+            count += std::count(buffer, buffer + *result, '\n');
+            start += *result;
+        }
+
+        return count;
+    }
+
     /* Finding the first newline backward from offset. */
     Optional<Offset> previous_newline(Offset offset) {
         char buffer[buffer_size];
@@ -484,7 +668,82 @@ class BufferWrapper {
 
     LineEnding line_ending_{LineEnding::LF};
     CircularBuffer<Offset, max_newlines + 1> newlines_{};
+
+    /* Sparse line offsets across the whole buffer. */
+    LineIndex index_{};
+    bool index_dirty_{false};
+};
+
+/* Line index sidecar (.IDX) file layout, all little-endian:
+ *
+ *   header          line_index_file_header
+ *   checkpoints     count x LineCheckpoint
+ *
+ * The sidecar is only trusted if the size and FAT modified time of the
+ * text file still match the header. */
+struct line_index_file_header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;
+    uint32_t stride;
+    uint32_t newline_count;
+    uint32_t file_size;
+    uint16_t file_date;
+    uint16_t file_time;
 };
+static_assert(sizeof(line_index_file_header) == 24, "line_index_file_header size changed.");
+
+constexpr uint32_t line_index_magic = 0x494C5050;  // "PPLI"
+constexpr uint16_t line_index_version = 1;
+
+/* Identifies the text file a sidecar was built for. */
+struct line_index_stamp {
+    uint32_t file_size;
+    uint16_t file_date;
+    uint16_t file_time;
+};
+
+/* Reads a sidecar from f. Fails if it is corrupt or stamped for another file version. */
+template <typename F>
+bool read_line_index(F& f, const line_index_stamp& stamp, LineIndex& index) {
+    line_index_file_header header{};
+    auto result = f.read(&header, sizeof(header));
+    if (result.is_error() || *result != sizeof(header))
+        return false;
+
+    if (header.magic != line_index_magic || header.version != line_index_version ||
+        header.count > LineIndex::max_checkpoints || header.stride == 0 ||
+        header.file_size != stamp.file_size ||
+        header.file_date != stamp.file_date || header.file_time != stamp.file_time)
+        return false;
+
+    std::vector<LineCheckpoint> checkpoints(header.count);
+    auto length = header.count * sizeof(LineCheckpoint);
+    result = f.read(checkpoints.data(), length);
+    if (result.is_error() || *result != length)
+        return false;
+
+    index.restore(header.stride, header.newline_count, std::move(checkpoints));
+    return true;
+}
+
+/* Writes index to f as a sidecar stamped for the text file. */
+template <typename F>
+void write_line_index(F& f, const line_index_stamp& stamp, const LineIndex& index) {
+    line_index_file_header header{
+        .magic = line_index_magic,
+        .version = line_index_version,
+        .count = static_cast<uint16_t>(index.checkpoints().size()),
+        .stride = index.stride(),
+        .newline_count = index.newline_count(),
+        .file_size = stamp.file_size,
+        .file_date = stamp.file_date,
+        .file_time = stamp.file_time,
+    };
+
+    f.write(&header, sizeof(header));
+    f.write(index.checkpoints().data(), index.checkpoints().size() * sizeof(LineCheckpoint));
+}
 
 /* A BufferWrapper over a file. */
 class FileWrapper : public BufferWrapper<File, 64> {
@@ -492,10 +751,15 @@ class FileWrapper : public BufferWrapper<File, 64> {
     template <typename T>
     using Result = File::Result<T>;
     using Error = File::Error;
+
+    /* With keep_index, the line index of a large file is read from and
+     * saved to a sidecar so later opens skip the full scan. Apps that
+     * reopen the same files ask for it, e.g. freqman and the text editor. */
     static Result<std::unique_ptr<FileWrapper>> open(
         const std::filesystem::path& path,
         bool create = false,
-        std::function<void(Size, Size)> on_read_progress = nullptr) {
+        std::function<void(Size, Size)> on_read_progress = nullptr,
+        bool keep_index = false) {
         auto fw = std::unique_ptr<FileWrapper>(new FileWrapper());
         auto error = fw->file_.open(path, /*read_only*/ false, create);
 
@@ -505,10 +769,26 @@ class FileWrapper : public BufferWrapper<File, 64> {
         if (on_read_progress)
             fw->on_read_progress = on_read_progress;
 
+        if (keep_index)
+            fw->path_ = path;
+
         fw->initialize();
         return fw;
     }
 
+    ~FileWrapper() {
+        save_index();
+    }
+
+    /* Files at least this large keep their line index in a sidecar file. */
+    static constexpr Size index_min_size = 64 * 1024;
+
+    /* FOO.TXT keeps its index in FOO.TXT.IDX. The whole name is kept so
+     * FOO.TXT and FOO.CSV don't share, and overwrite, one sidecar. */
+    static std::filesystem::path index_path(const std::filesystem::path& path) {
+        return path + u".IDX";
+    }
+
     /* Underlying file. */
     File& file() { return file_; }
 
@@ -523,16 +803,54 @@ class FileWrapper : public BufferWrapper<File, 64> {
             return false;
 
         file_ = std::move(file);
+
+        // Temporary copies don't keep a sidecar.
+        path_ = {};
         return true;
     }
 
    private:
     FileWrapper() {}
     void initialize() {
-        set_buffer(&file_);
+        LineIndex index;
+        if (load_index(index))
+            set_buffer(&file_, std::move(index));
+        else
+            set_buffer(&file_);
+    }
+
+    line_index_stamp stamp() {
+        auto date = file_created_date(path_);
+        return {static_cast<uint32_t>(file_.size()), date.FAT_date, date.FAT_time};
+    }
+
+    bool load_index(LineIndex& index) {
+        if (path_.empty() || file_.size() < index_min_size)
+            return false;
+
+        File f;
+        if (f.open(index_path(path_)))
+            return false;
+
+        return read_line_index(f, stamp(), index);
+    }
+
+    void save_index() {
+        if (path_.empty() || !index_dirty() || file_.size() < index_min_size)
+            return;
+
+        // Stamp the file as it will be after closing.
+        file_.sync();
+
+        File f;
+        if (f.create(index_path(path_)))
+            return;
+
+        write_line_index(f, stamp(), line_index());
     }
 
     File file_{};
+    std::filesystem::path path_{};  // Empty unless the index is kept.
 };
 
 template <uint32_t CacheSize = 64, typename T>
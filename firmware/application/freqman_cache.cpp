@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "freqman_cache.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace freqman_cache_io;
+
+fs::path get_freqman_cache_path(const fs::path& path) {
+    return fs::path{path}.replace_extension(u".FMB");
+}
+
+freqman_cache_record to_freqman_cache_record(const freqman_entry& entry, uint32_t line, uint32_t description) {
+    return {
+        .frequency_a = entry.frequency_a,
+        .frequency_b = entry.frequency_b,
+        .line = line,
+        .description = description,
+        .description_length = static_cast<uint8_t>(std::min(entry.description.size(), freqman_max_desc_size)),
+        .type = entry.type,
+        .modulation = entry.modulation,
+        .bandwidth = entry.bandwidth,
+        .step = entry.step,
+        .tone = entry.tone,
+        .reserved = 0,
+    };
+}
+
+freqman_entry to_freqman_entry(const freqman_cache_record& rec) {
+    return {
+        .frequency_a = rec.frequency_a,
+        .frequency_b = rec.frequency_b,
+        .description = {},
+        .type = rec.type,
+        .modulation = rec.modulation,
+        .bandwidth = rec.bandwidth,
+        .step = rec.step,
+        .tone = rec.tone,
+    };
+}
+
+bool operator<(const freqman_cache_record& lhs, const freqman_cache_record& rhs) {
+    if (lhs.frequency_a != rhs.frequency_a)
+        return lhs.frequency_a < rhs.frequency_a;
+
+    return lhs.line < rhs.line;
+}
+
+static bool compile_cache(const fs::path& path, File& runs, File& descriptions, File& cache) {
+    FreqmanDB db;
+    db.set_read_raw(false);
+    if (!db.open(path))
+        return false;
+
+    freqman_cache_header header{};
+    if (!compile_freqman_cache(db, runs, descriptions, cache, header))
+        return false;
+
+    // Stamp last, a partially written cache stays invalid.
+    File source;
+    if (source.open(path))
+        return false;
+
+    auto stamp = file_created_date(path);
+    header.source_size = source.size();
+    header.source_date = stamp.FAT_date;
+    header.source_time = stamp.FAT_time;
+
+    return write_at(cache, 0, &header, sizeof(header));
+}
+
+bool build_freqman_cache(const fs::path& path, const fs::path& cache_path) {
+    const auto runs_path = cache_path + u"~R";
+    const auto descriptions_path = cache_path + u"~D";
+    bool ok = false;
+
+    {
+        File runs;
+        File descriptions;
+        File cache;
+
+        ok = !runs.create(runs_path) &&
+             !descriptions.create(descriptions_path) &&
+             !cache.create(cache_path) &&
+             compile_cache(path, runs, descriptions, cache);
+    }
+
+    delete_file(runs_path);
+    delete_file(descriptions_path);
+    if (!ok)
+        delete_file(cache_path);
+
+    return ok;
+}
+
+/* FreqmanCache ********************************/
+
+bool FreqmanCache::open(const fs::path& path) {
+    auto cache_path = get_freqman_cache_path(path);
+
+    if (open_cache(path, cache_path))
+        return true;
+
+    close();
+    return build_freqman_cache(path, cache_path) &&
+           open_cache(path, cache_path);
+}
+
+bool FreqmanCache::open_cache(const fs::path& path, const fs::path& cache_path) {
+    close();
+
+    File source;
+    File cache;
+    if (source.open(path) || cache.open(cache_path) || !open_file(std::move(cache)))
+        return false;
+
+    auto stamp = file_created_date(path);
+    if (header_.source_size != source.size() ||
+        header_.source_date != stamp.FAT_date ||
+        header_.source_time != stamp.FAT_time) {
+        close();
+        return false;
+    }
+
+    return true;
+}
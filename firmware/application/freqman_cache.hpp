@@ -0,0 +1,410 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __FREQMAN_CACHE_H__
+#define __FREQMAN_CACHE_H__
+
+#include "file.hpp"
+#include "freqman_db.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/* Compiled freqman (.FMB) file layout, all little-endian:
+ *
+ *   header          freqman_cache_header
+ *   records         count x freqman_cache_record, in text file order
+ *   sorted          count x freqman_cache_record, sorted by frequency_a
+ *   descriptions    description strings in text file order, not terminated
+ *
+ * The cache is built from the text file and rebuilt whenever the size or
+ * FAT modified time of the text file no longer match the header. Entries
+ * that don't parse are not compiled. The header holds the first frequency
+ * of up to max_pages evenly sized pages of the sorted records so a lookup
+ * only has to read the records of one page. Loading a whole list reads
+ * the records and descriptions front to back. */
+
+constexpr uint32_t freqman_cache_magic = 0x42465050;  // "PPFB"
+constexpr uint16_t freqman_cache_version = 2;
+constexpr size_t freqman_cache_max_pages = 64;
+
+/* Entries are sorted in runs of this many records, then merged. */
+constexpr size_t freqman_cache_run_size = 128;
+
+struct freqman_cache_record {
+    int64_t frequency_a;
+    int64_t frequency_b;
+    uint32_t line;         // Index of the entry in text file order.
+    uint32_t description;  // Offset into the descriptions.
+    uint8_t description_length;
+    freqman_type type;
+    freqman_index_t modulation;
+    freqman_index_t bandwidth;
+    freqman_index_t step;
+    freqman_index_t tone;
+    uint16_t reserved;
+};
+static_assert(sizeof(freqman_cache_record) == 32, "freqman_cache_record size changed.");
+
+struct freqman_cache_header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t page_count;
+    uint32_t count;
+    uint32_t page_size;
+    uint32_t sorted_offset;
+    uint32_t descriptions_offset;
+    uint32_t source_size;
+    uint16_t source_date;
+    uint16_t source_time;
+    std::array<int64_t, freqman_cache_max_pages> page_first;
+};
+static_assert(sizeof(freqman_cache_header) == 544, "freqman_cache_header size changed.");
+
+/* Gets the compiled cache path for a freqman text file. */
+std::filesystem::path get_freqman_cache_path(const std::filesystem::path& path);
+
+/* Compiles the freqman text file at path into cache_path. */
+bool build_freqman_cache(const std::filesystem::path& path, const std::filesystem::path& cache_path);
+
+freqman_cache_record to_freqman_cache_record(const freqman_entry& entry, uint32_t line, uint32_t description);
+
+freqman_entry to_freqman_entry(const freqman_cache_record& rec);
+
+/* Orders records by frequency, then by text order. */
+bool operator<(const freqman_cache_record& lhs, const freqman_cache_record& rhs);
+
+namespace freqman_cache_io {
+
+template <typename F>
+bool write_all(F& f, const void* data, File::Size size) {
+    auto result = f.write(data, size);
+    return result.is_ok() && *result == size;
+}
+
+template <typename F>
+bool write_at(F& f, File::Offset offset, const void* data, File::Size size) {
+    if (f.seek(offset).is_error())
+        return false;
+
+    return write_all(f, data, size);
+}
+
+template <typename F>
+bool read_at(F& f, File::Offset offset, void* data, File::Size size) {
+    if (f.seek(offset).is_error())
+        return false;
+
+    auto result = f.read(data, size);
+    return result.is_ok() && *result == size;
+}
+
+} /* namespace freqman_cache_io */
+
+/* Writes the records of entries to cache in text order, and sorted runs
+ * of them to runs. Entries that don't parse are skipped. */
+template <typename Entries, typename F>
+bool compile_freqman_records(Entries& entries, F& runs, F& descriptions, F& cache, uint32_t& count) {
+    using namespace freqman_cache_io;
+
+    std::vector<freqman_cache_record> run;
+    run.reserve(freqman_cache_run_size);
+    uint32_t description_size = 0;
+    count = 0;
+
+    auto flush_run = [&run, &runs]() {
+        std::sort(run.begin(), run.end());
+        auto ok = write_all(runs, run.data(), run.size() * sizeof(freqman_cache_record));
+        run.clear();
+        return ok;
+    };
+
+    if (cache.seek(sizeof(freqman_cache_header)).is_error())
+        return false;
+
+    for (auto entry : entries) {
+        if (entry.type == freqman_type::Unknown)
+            continue;
+
+        auto rec = to_freqman_cache_record(entry, count++, description_size);
+        if (!write_all(cache, &rec, sizeof(rec)) ||
+            !write_all(descriptions, entry.description.data(), rec.description_length))
+            return false;
+
+        description_size += rec.description_length;
+        run.push_back(rec);
+
+        if (run.size() == freqman_cache_run_size && !flush_run())
+            return false;
+    }
+
+    return run.empty() || flush_run();
+}
+
+/* Merges the sorted runs into the sorted records of the cache and fills
+ * in the page index. The smallest head of each run is kept on a heap. */
+template <typename F>
+bool merge_freqman_runs(F& runs, F& cache, freqman_cache_header& header) {
+    using namespace freqman_cache_io;
+
+    const uint32_t count = header.count;
+    const uint32_t run_count = (count + freqman_cache_run_size - 1) / freqman_cache_run_size;
+
+    auto run_length = [count](uint32_t run) {
+        return std::min<uint32_t>(freqman_cache_run_size, count - run * freqman_cache_run_size);
+    };
+
+    // Current record of each run, how many of its records are left and
+    // a min-heap of the runs with records left.
+    std::vector<freqman_cache_record> heads(run_count);
+    std::vector<uint32_t> remaining(run_count);
+    std::vector<uint32_t> heap(run_count);
+
+    auto greater = [&heads](uint32_t lhs, uint32_t rhs) { return heads[rhs] < heads[lhs]; };
+
+    for (uint32_t run = 0; run < run_count; ++run) {
+        remaining[run] = run_length(run);
+        heap[run] = run;
+        auto offset = run * freqman_cache_run_size * sizeof(freqman_cache_record);
+        if (!read_at(runs, offset, &heads[run], sizeof(freqman_cache_record)))
+            return false;
+    }
+    std::make_heap(heap.begin(), heap.end(), greater);
+
+    for (uint32_t index = 0; index < count; ++index) {
+        std::pop_heap(heap.begin(), heap.end(), greater);
+        auto best = heap.back();
+
+        auto& rec = heads[best];
+        if (index % header.page_size == 0)
+            header.page_first[index / header.page_size] = rec.frequency_a;
+
+        if (!write_at(cache, header.sorted_offset + index * sizeof(rec), &rec, sizeof(rec)))
+            return false;
+
+        if (--remaining[best] > 0) {
+            auto position = best * freqman_cache_run_size + run_length(best) - remaining[best];
+            if (!read_at(runs, position * sizeof(rec), &rec, sizeof(rec)))
+                return false;
+            std::push_heap(heap.begin(), heap.end(), greater);
+        } else {
+            heap.pop_back();
+        }
+    }
+
+    return true;
+}
+
+/* Compiles entries into cache, using runs and descriptions as scratch.
+ * Fills in everything in header but the source stamp, the caller
+ * writes the header last so a partial cache stays invalid. */
+template <typename Entries, typename F>
+bool compile_freqman_cache(Entries& entries, F& runs, F& descriptions, F& cache, freqman_cache_header& header) {
+    using namespace freqman_cache_io;
+
+    header = {};
+    header.magic = freqman_cache_magic;
+    header.version = freqman_cache_version;
+
+    if (!compile_freqman_records(entries, runs, descriptions, cache, header.count))
+        return false;
+
+    header.page_size = std::max<uint32_t>(1, (header.count + freqman_cache_max_pages - 1) / freqman_cache_max_pages);
+    header.page_count = (header.count + header.page_size - 1) / header.page_size;
+    header.sorted_offset = sizeof(header) + header.count * sizeof(freqman_cache_record);
+    header.descriptions_offset = header.sorted_offset + header.count * sizeof(freqman_cache_record);
+
+    if (!merge_freqman_runs(runs, cache, header))
+        return false;
+
+    // Copy the descriptions after the records.
+    uint8_t buffer[512];
+    if (descriptions.seek(0).is_error() || cache.seek(header.descriptions_offset).is_error())
+        return false;
+
+    while (true) {
+        auto result = descriptions.read(buffer, sizeof(buffer));
+        if (result.is_error() || !write_all(cache, buffer, *result))
+            return false;
+
+        if (*result < sizeof(buffer))
+            return true;
+    }
+}
+
+/* Read-only access to a compiled freqman file. Only a page of
+ * records is held in memory, entries are read on demand. */
+template <typename F>
+class FreqmanCacheReader {
+   public:
+    using Index = uint32_t;
+
+    /* Takes an open cache file. Fails if it doesn't hold a cache. */
+    bool open_file(F file) {
+        close();
+        file_ = std::move(file);
+
+        if (!freqman_cache_io::read_at(file_, 0, &header_, sizeof(header_)) ||
+            header_.magic != freqman_cache_magic ||
+            header_.version != freqman_cache_version ||
+            header_.page_count > freqman_cache_max_pages) {
+            close();
+            return false;
+        }
+
+        return true;
+    }
+
+    void close() {
+        file_ = F{};
+        header_ = {};
+        page_start_ = invalid_index;
+    }
+
+    const freqman_cache_header& header() const { return header_; }
+    Index entry_count() const { return header_.count; }
+    bool empty() const { return header_.count == 0; }
+
+    /* Gets the entry at index in frequency order. */
+    freqman_entry operator[](Index index) {
+        auto rec = record(index);
+        return rec ? to_entry(*rec) : freqman_entry{};
+    }
+
+    /* Gets the index of the first entry with frequency_a >= frequency. */
+    Index lower_bound(int64_t frequency) {
+        // The first page starting at or above frequency bounds the search
+        // to the end of the page before it.
+        auto first = header_.page_first.begin();
+        Index page = std::lower_bound(first, first + header_.page_count, frequency) - first;
+
+        Index low = page > 0 ? (page - 1) * header_.page_size : 0;
+        Index high = std::min(entry_count(), page * header_.page_size);
+
+        while (low < high) {
+            auto middle = low + (high - low) / 2;
+            auto rec = record(middle);
+            if (!rec)
+                return entry_count();
+
+            if (rec->frequency_a < frequency)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+
+        return low;
+    }
+
+    /* Calls fn for each entry with min <= frequency_a <= max. */
+    template <typename Fn>
+    void for_each_in_range(int64_t min, int64_t max, const Fn& fn) {
+        for (auto index = lower_bound(min); index < entry_count(); ++index) {
+            auto rec = record(index);
+            if (!rec || rec->frequency_a > max)
+                break;
+
+            fn(to_entry(*rec));
+        }
+    }
+
+    /* Calls fn for each entry in text file order until it returns false.
+     * Reads a page of records, then their descriptions in one piece. */
+    template <typename Fn>
+    void for_each_in_file_order(const Fn& fn) {
+        std::string descriptions;
+        page_start_ = invalid_index;
+
+        for (Index start = 0; start < entry_count(); start += records_per_page) {
+            auto length = std::min(records_per_page, entry_count() - start);
+            if (!freqman_cache_io::read_at(file_, sizeof(header_) + start * sizeof(freqman_cache_record),
+                                           page_.data(), length * sizeof(freqman_cache_record)))
+                return;
+
+            auto first = page_[0].description;
+            auto& last = page_[length - 1];
+            descriptions.resize(last.description + last.description_length - first);
+            if (!freqman_cache_io::read_at(file_, header_.descriptions_offset + first,
+                                           &descriptions[0], descriptions.size()))
+                return;
+
+            for (Index i = 0; i < length; ++i) {
+                auto entry = to_freqman_entry(page_[i]);
+                entry.description.assign(descriptions, page_[i].description - first, page_[i].description_length);
+                if (!fn(entry))
+                    return;
+            }
+        }
+    }
+
+   protected:
+    static constexpr Index records_per_page = 16;
+    static constexpr Index invalid_index = static_cast<Index>(-1);
+
+    /* Gets the sorted record at index, reading its page if needed. */
+    const freqman_cache_record* record(Index index) {
+        if (index >= entry_count())
+            return nullptr;
+
+        if (page_start_ == invalid_index || index < page_start_ || index >= page_start_ + records_per_page) {
+            page_start_ = index - index % records_per_page;
+            auto length = std::min(records_per_page, entry_count() - page_start_);
+            if (!freqman_cache_io::read_at(file_, header_.sorted_offset + page_start_ * sizeof(freqman_cache_record),
+                                           page_.data(), length * sizeof(freqman_cache_record))) {
+                page_start_ = invalid_index;
+                return nullptr;
+            }
+        }
+
+        return &page_[index - page_start_];
+    }
+
+    freqman_entry to_entry(const freqman_cache_record& rec) {
+        auto entry = to_freqman_entry(rec);
+        entry.description.resize(rec.description_length);
+        if (!freqman_cache_io::read_at(file_, header_.descriptions_offset + rec.description,
+                                       &entry.description[0], rec.description_length))
+            entry.description.clear();
+
+        return entry;
+    }
+
+    F file_{};
+    freqman_cache_header header_{};
+    std::array<freqman_cache_record, records_per_page> page_{};
+    Index page_start_{invalid_index};  // Index of page_[0] in the sorted records.
+};
+
+/* FreqmanCacheReader over the .FMB beside a freqman text file. */
+class FreqmanCache : public FreqmanCacheReader<File> {
+   public:
+    /* Opens the cache for the freqman text file at path,
+     * building it first if it's missing or out of date. */
+    bool open(const std::filesystem::path& path);
+
+   private:
+    bool open_cache(const std::filesystem::path& path, const std::filesystem::path& cache_path);
+};
+
+#endif /* __FREQMAN_CACHE_H__ */
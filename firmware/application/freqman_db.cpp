@@ -25,6 +25,7 @@
 #include "convert.hpp"
 #include "file.hpp"
 #include "file_reader.hpp"
+#include "freqman_cache.hpp"
 #include "freqman_db.hpp"
 #include "string_format.hpp"
 #include "tone_key.hpp"
@@ -232,7 +233,10 @@ bool load_freqman_file(const std::string& file_stem, freqman_db& db, freqman_loa
 }
 
 void delete_freqman_file(const std::string& file_stem) {
-    delete_file(get_freqman_path(file_stem));
+    auto path = get_freqman_path(file_stem);
+    delete_file(path);
+    delete_file(FileWrapper::index_path(path));
+    delete_file(get_freqman_cache_path(path));
 }
 
 std::string pretty_string(const freqman_entry& entry, size_t max_length) {
@@ -397,7 +401,47 @@ bool parse_freqman_entry(std::string_view str, freqman_entry& entry) {
     return is_valid(entry);
 }
 
+/* Adds the entry if options allow it. Returns false once the db is full. */
+static bool add_loaded_entry(freqman_db& db, freqman_entry& entry, const freqman_load_options& options) {
+    // Filter by entry type.
+    if (entry.type == freqman_type::Unknown ||
+        (entry.type == freqman_type::Single && !options.load_freqs) ||
+        (entry.type == freqman_type::Range && !options.load_ranges) ||
+        (entry.type == freqman_type::HamRadio && !options.load_hamradios) ||
+        (entry.type == freqman_type::Repeater && !options.load_repeaters)) {
+        return true;
+    }
+
+    // Use previous entry's mod/band if current's aren't set.
+    if (!db.empty()) {
+        if (is_invalid(entry.modulation))
+            entry.modulation = db.back()->modulation;
+        if (is_invalid(entry.bandwidth))
+            entry.bandwidth = db.back()->bandwidth;
+    }
+
+    // Move the entry onto the heap and push.
+    db.push_back(std::make_unique<freqman_entry>(std::move(entry)));
+
+    // Limit to max_entries when specified.
+    return options.max_entries == 0 || db.size() < options.max_entries;
+}
+
 bool parse_freqman_file(const fs::path& path, freqman_db& db, freqman_load_options options) {
+    // Prefer the compiled cache, no text parsing needed.
+    FreqmanCache cache;
+    if (cache.open(path)) {
+        db.clear();
+        db.reserve(options.max_entries > 0 ? std::min<size_t>(cache.entry_count(), options.max_entries) : cache.entry_count());
+
+        cache.for_each_in_file_order([&db, &options](freqman_entry& entry) {
+            return add_loaded_entry(db, entry, options);
+        });
+
+        db.shrink_to_fit();
+        return true;
+    }
+
     FreqmanDB freqman_db;
     freqman_db.set_read_raw(false);  // Don't return malformed lines.
     if (!freqman_db.open(path))
@@ -408,28 +452,7 @@ bool parse_freqman_file(const fs::path& path, freqman_db& db, freqman_load_optio
     db.reserve(freqman_db.entry_count());
 
     for (auto entry : freqman_db) {
-        // Filter by entry type.
-        if (entry.type == freqman_type::Unknown ||
-            (entry.type == freqman_type::Single && !options.load_freqs) ||
-            (entry.type == freqman_type::Range && !options.load_ranges) ||
-            (entry.type == freqman_type::HamRadio && !options.load_hamradios) ||
-            (entry.type == freqman_type::Repeater && !options.load_repeaters)) {
-            continue;
-        }
-
-        // Use previous entry's mod/band if current's aren't set.
-        if (!db.empty()) {
-            if (is_invalid(entry.modulation))
-                entry.modulation = db.back()->modulation;
-            if (is_invalid(entry.bandwidth))
-                entry.bandwidth = db.back()->bandwidth;
-        }
-
-        // Move the entry onto the heap and push.
-        db.push_back(std::make_unique<freqman_entry>(std::move(entry)));
-
-        // Limit to max_entries when specified.
-        if (options.max_entries > 0 && db.size() >= options.max_entries)
+        if (!add_loaded_entry(db, entry, options))
             break;
     }
 
@@ -470,7 +493,8 @@ bool is_valid(const freqman_entry& entry) {
 /* FreqmanDB ***********************************/
 
 bool FreqmanDB::open(const std::filesystem::path& path, bool create) {
-    auto result = FileWrapper::open(path, create);
+    // Freqman files are ours, keep their line index between opens.
+    auto result = FileWrapper::open(path, create, nullptr, /*keep_index*/ true);
     if (!result)
         return false;
 
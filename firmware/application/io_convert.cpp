@@ -67,6 +67,15 @@ Optional<File::Error> FileConvertReader::open(const std::filesystem::path& filen
     return file_.open(filename);
 }
 
+Optional<File::Error> FileConvertReader::rewind() {
+    auto result = file_.seek(0);
+    if (result.is_error())
+        return result.error();
+
+    bytes_read_ = 0;
+    return {};
+}
+
 // If C8 conversion enabled, half the number of bytes are read from the file & expanded to fill the whole buffer.
 File::Result<File::Size> FileConvertReader::read(void* const buffer, const File::Size bytes) {
     auto read_result = file_.read(buffer, convert_c8_to_c16 ? bytes / 2 : bytes);
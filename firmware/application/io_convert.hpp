@@ -48,6 +48,9 @@ class FileConvertReader : public stream::Reader {
 
     Optional<File::Error> open(const std::filesystem::path& filename);
 
+    /* Seeks back to the start, for looping without reopening the file. */
+    Optional<File::Error> rewind();
+
     File::Result<File::Size> read(void* const buffer, const File::Size bytes) override;
     const File& file() const& { return file_; }
 
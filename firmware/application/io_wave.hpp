@@ -79,7 +79,7 @@ struct header_t {
 };
 
 struct tags_t {
-    constexpr tags_t(
+    tags_t(
         const std::string& title_str) {
         strcpy(title, title_str.c_str());
         cksize = sizeof(tags_t) - 8;
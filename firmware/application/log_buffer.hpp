@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __LOG_BUFFER_H__
+#define __LOG_BUFFER_H__
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <string_view>
+
+/* Byte ring holding whole log records until they are written out.
+ * One producer appends, one consumer reads contiguous chunks and then
+ * consumes them. Callers serialize access to the indices; the bytes
+ * between read and write are only touched by their owner. */
+template <size_t Capacity>
+class LogBuffer {
+   public:
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of 2");
+
+    size_t size() const { return write_ - read_; }
+    size_t available() const { return Capacity - size(); }
+    bool empty() const { return size() == 0; }
+
+    /* Appends the parts as one record, or nothing if they don't fit. */
+    bool push(std::initializer_list<std::string_view> parts) {
+        size_t length = 0;
+        for (const auto& part : parts)
+            length += part.size();
+
+        if (length > available())
+            return false;
+
+        for (const auto& part : parts)
+            copy_in(part);
+        return true;
+    }
+
+    /* Appends prefix, a space and message as one CRLF terminated line,
+     * or drops it if it doesn't fit. Drops are counted, and the next line
+     * that fits is preceded by a "<prefix> N lines dropped" line so the
+     * gap shows in the log. */
+    bool push_line(std::string_view prefix, std::string_view message) {
+        if (unreported_ > 0) {
+            std::array<char, 32> marker{};
+            if (push({prefix, " ", format_dropped(marker, unreported_), "\r\n"}))
+                unreported_ = 0;
+        }
+
+        if (push({prefix, " ", message, "\r\n"}))
+            return true;
+
+        dropped_++;
+        unreported_++;
+        return false;
+    }
+
+    /* Lines dropped since the buffer was made. */
+    size_t dropped() const { return dropped_; }
+
+    /* Gets the oldest contiguous run of bytes, it may be followed by more
+     * at the start of the buffer. */
+    std::string_view peek() const {
+        const auto start = read_ & mask;
+        return {&data_[start], std::min(size(), Capacity - start)};
+    }
+
+    void consume(size_t count) {
+        read_ += std::min(count, size());
+    }
+
+   private:
+    static constexpr size_t mask = Capacity - 1;
+
+    static std::string_view format_dropped(std::array<char, 32>& out, size_t count) {
+        constexpr std::string_view suffix{" lines dropped"};
+        auto end = out.size() - suffix.size();
+        std::memcpy(&out[end], suffix.data(), suffix.size());
+
+        auto start = end;
+        do {
+            out[--start] = '0' + count % 10;
+            count /= 10;
+        } while (count > 0);
+
+        return {&out[start], out.size() - start};
+    }
+
+    void copy_in(std::string_view part) {
+        const auto start = write_ & mask;
+        const auto first = std::min(part.size(), Capacity - start);
+        std::memcpy(&data_[start], part.data(), first);
+        std::memcpy(&data_[0], part.data() + first, part.size() - first);
+        write_ += part.size();
+    }
+
+    // Free running, wrap is handled by the mask.
+    size_t read_{0};
+    size_t write_{0};
+    size_t dropped_{0};
+    size_t unreported_{0};
+    std::array<char, Capacity> data_{};
+};
+
+#endif /*__LOG_BUFFER_H__*/
@@ -21,20 +21,201 @@
 
 #include "log_file.hpp"
 #include "string_format.hpp"
+#include "memory_stats.hpp"
 
-Optional<File::Error> LogFile::write_entry(const std::string& entry) {
+/* The writer thread runs while any log is open. */
+static MUTEX_DECL(writer_mutex);  // Guards open_logs and writer_thread.
+static BSEMAPHORE_DECL(writer_wakeup, true);
+static Thread* writer_thread = nullptr;
+
+LogFile* LogFile::open_logs = nullptr;
+
+LogFile::LogFile() {
+    chMtxInit(&mutex);
+    chMtxInit(&commit_mutex);
+}
+
+LogFile::~LogFile() {
+    detach();
+    flush();
+}
+
+Optional<File::Error> LogFile::append(const std::filesystem::path& filename) {
+    detach();
+    flush();
+
+    auto result = ensure_directory(filename.parent_path());
+    if (result.code())
+        return {result};
+
+    auto error = file.append(filename);
+    if (!error)
+        attach();
+
+    return error;
+}
+
+Optional<File::Error> LogFile::write_entry(std::string_view entry) {
     return write_entry(rtc_time::now(), entry);
 }
 
-Optional<File::Error> LogFile::write_entry(const rtc::RTC& datetime, const std::string& entry) {
-    std::string timestamp = to_string_timestamp(datetime);
-    return write_line(timestamp + " " + entry);
+Optional<File::Error> LogFile::write_entry(const rtc::RTC& datetime, std::string_view entry) {
+    StringBuffer<16> timestamp;
+    return write_line(append_timestamp(timestamp, datetime), entry);
 }
 
-Optional<File::Error> LogFile::write_line(const std::string& message) {
-    auto error = file.write_line(message);
-    if (!error) {
-        file.sync();
+Optional<File::Error> LogFile::write_line(std::string_view timestamp, std::string_view message) {
+    const size_t length = timestamp.size() + 1 + message.size() + 2;
+    bool queued = false;
+
+    if (length <= buffer_size) {
+        chMtxLock(&mutex);
+        if (buffer.empty())
+            pending_since = chTimeNow();
+        queued = buffer.push_line(timestamp, message);
+        const auto wake = (buffer.size() >= sector_size) || !queued;
+        const auto last_error = error;
+        chMtxUnlock();
+
+        if (wake)
+            chBSemSignal(&writer_wakeup);
+
+        if (!attached)
+            return flush();
+
+        return last_error;
     }
-    return error;
+
+    // Too long to ever fit, write it through behind whatever is queued.
+    flush();
+    chMtxLock(&commit_mutex);
+    for (auto part : {timestamp, std::string_view{" "}, message, std::string_view{"\r\n"}}) {
+        auto result = file.write(part.data(), part.size());
+        if (result.is_error()) {
+            chMtxLock(&mutex);
+            error = result.error();
+            chMtxUnlock();
+            break;
+        }
+    }
+    unsynced += length;
+    chMtxUnlock();
+
+    return flush();
+}
+
+Optional<File::Error> LogFile::flush() {
+    return commit(true, true);
+}
+
+Optional<File::Error> LogFile::commit(bool all, bool sync) {
+    chMtxLock(&commit_mutex);
+
+    while (true) {
+        chMtxLock(&mutex);
+        auto chunk = buffer.peek();
+        chMtxUnlock();
+
+        // Only whole sectors unless asked for everything.
+        if (!all)
+            chunk = chunk.substr(0, chunk.size() - chunk.size() % sector_size);
+        if (chunk.empty())
+            break;
+
+        // The producer doesn't touch queued bytes, no lock needed to write them.
+        auto result = file.write(chunk.data(), chunk.size());
+
+        chMtxLock(&mutex);
+        buffer.consume(chunk.size());
+        if (result.is_error())
+            error = result.error();
+        chMtxUnlock();
+
+        if (result.is_error())
+            break;
+
+        unsynced += chunk.size();
+    }
+
+    const auto now = chTimeNow();
+    if (unsynced > 0 && (sync || unsynced >= sync_bytes || now - last_sync >= MS2ST(sync_interval_ms))) {
+        auto sync_error = file.sync();
+        if (sync_error) {
+            chMtxLock(&mutex);
+            error = sync_error;
+            chMtxUnlock();
+        }
+        unsynced = 0;
+        last_sync = now;
+    }
+
+    chMtxLock(&mutex);
+    const auto result = error;
+    chMtxUnlock();
+
+    chMtxUnlock();
+    return result;
+}
+
+void LogFile::attach() {
+    chMtxLock(&writer_mutex);
+    next_open = open_logs;
+    open_logs = this;
+    attached = true;
+    if (!writer_thread)
+        writer_thread = chThdCreateFromHeap(NULL, 1024, NORMALPRIO - 1, LogFile::writer_fn, nullptr);
+    chMtxUnlock();
+}
+
+void LogFile::detach() {
+    if (!attached)
+        return;
+
+    chMtxLock(&writer_mutex);
+    for (auto link = &open_logs; *link; link = &(*link)->next_open) {
+        if (*link == this) {
+            *link = next_open;
+            break;
+        }
+    }
+    next_open = nullptr;
+    attached = false;
+
+    // The last log out stops the writer.
+    Thread* stopping = nullptr;
+    if (!open_logs) {
+        stopping = writer_thread;
+        writer_thread = nullptr;
+    }
+    chMtxUnlock();
+
+    if (stopping) {
+        chThdTerminate(stopping);
+        chBSemSignal(&writer_wakeup);
+        chThdWait(stopping);
+    }
+}
+
+msg_t LogFile::writer_fn(void*) {
+    chRegSetThreadName("log");
+    memory_stats::set_thread_tag(memory_stats::Tag::File);
+
+    while (!chThdShouldTerminate()) {
+        chBSemWaitTimeout(&writer_wakeup, MS2ST(sync_interval_ms));
+
+        chMtxLock(&writer_mutex);
+        const auto now = chTimeNow();
+        for (auto log = open_logs; log; log = log->next_open) {
+            // A partial sector is committed too once its oldest line has
+            // waited sync_interval_ms, so a slow trickle of lines still
+            // reaches the card.
+            chMtxLock(&log->mutex);
+            const auto stale = !log->buffer.empty() && now - log->pending_since >= MS2ST(sync_interval_ms);
+            chMtxUnlock();
+
+            log->commit(stale, false);
+        }
+        chMtxUnlock();
+    }
+    return 0;
 }
@@ -23,27 +23,73 @@
 #define __LOG_FILE_H__
 
 #include <string>
+#include <string_view>
+
+#include "ch.h"
 
 #include "file.hpp"
+#include "log_buffer.hpp"
 #include "rtc_time.hpp"
 
+/* Appends timestamped lines to a text file. Lines are queued in RAM and a
+ * low priority writer thread, shared by all open logs, commits them in
+ * sector sized batches, so a decoder logging at a high packet rate doesn't
+ * wait on the SD card. */
 class LogFile {
    public:
-    Optional<File::Error> append(const std::filesystem::path& filename) {
-        auto result = ensure_directory(filename.parent_path());
-        if (result.code())
-            return {result};
+    /* When the writer commits to the card: as soon as a sector is queued,
+     * a partial sector once its oldest line has waited sync_interval_ms,
+     * and with an f_sync once either limit is reached. Two sectors of
+     * buffer: one is written while the next fills. */
+    static constexpr size_t buffer_size = 1024;
+    static constexpr size_t sector_size = 512;
+    static constexpr systime_t sync_interval_ms = 2000;
+    static constexpr size_t sync_bytes = 4096;
+
+    LogFile();
+    ~LogFile();
+
+    LogFile(const LogFile&) = delete;
+    LogFile(LogFile&&) = delete;
+    LogFile& operator=(const LogFile&) = delete;
+    LogFile& operator=(LogFile&&) = delete;
+
+    Optional<File::Error> append(const std::filesystem::path& filename);
 
-        return file.append(filename);
-    }
+    /* Queues a line. Returns the last write error, if any. Lines that
+     * don't fit while the card is busy are dropped, and a marker with
+     * the count is logged ahead of the next line that fits. */
+    Optional<File::Error> write_entry(std::string_view entry);
+    Optional<File::Error> write_entry(const rtc::RTC& datetime, std::string_view entry);
 
-    Optional<File::Error> write_entry(const std::string& entry);
-    Optional<File::Error> write_entry(const rtc::RTC& datetime, const std::string& entry);
+    /* Writes out everything queued and syncs, for callers that can't lose
+     * a line (e.g. just before a reset). */
+    Optional<File::Error> flush();
+
+    size_t dropped() const { return buffer.dropped(); }
 
    private:
     File file{};
+    LogBuffer<buffer_size> buffer{};
+    Mutex mutex{};         // Guards the buffer indices and error.
+    Mutex commit_mutex{};  // Serializes writes to file.
+
+    Optional<File::Error> error{};
+    size_t unsynced{0};  // Written since the last sync, guarded by commit_mutex.
+    systime_t last_sync{0};
+    systime_t pending_since{0};  // When the oldest queued line was queued.
+
+    // Open logs, served by the writer thread. Guarded by the writer's mutex.
+    static LogFile* open_logs;
+    LogFile* next_open{nullptr};
+    bool attached{false};
+
+    Optional<File::Error> write_line(std::string_view timestamp, std::string_view message);
+    Optional<File::Error> commit(bool all, bool sync);
+    void attach();
+    void detach();
 
-    Optional<File::Error> write_line(const std::string& message);
+    static msg_t writer_fn(void* arg);
 };
 
 #endif /*__LOG_FILE_H__*/
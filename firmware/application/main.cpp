@@ -140,6 +140,8 @@ Continuous (Fox-oring)
 
 #include <string.h>
 #include "i2cdevmanager.hpp"
+#include "boot.hpp"
+#include "memory_stats.hpp"
 
 #include "rffc507x.hpp" /* c/m, avoiding initial short ON Ant_DC_Bias pulse, from cold reset  */
 rffc507x::RFFC507x first_if;
@@ -162,11 +164,15 @@ static void event_loop() {
     portapack::setEventDispatcherToUSBSerial(&event_dispatcher);
     i2cdev::I2CDevManager::setEventDispatcher(&event_dispatcher);
     system_view.get_navigation_view()->handle_autostart();
+    boot::trace("ui");
     event_dispatcher.run();
 }
 
 int main(void) {
     first_if.init(); /* To avoid initial short Ant_DC_Bias pulse ,we need quick set up GP01_RFF507X =1 */
+    boot::trace("main");
+    chRegSetThreadName("main");
+    memory_stats::set_thread_tag(memory_stats::Tag::UI);
 
     if (config_mode_should_enter()) {
         config_mode_clear();
@@ -34,6 +34,9 @@ const std::string_view sample_rate_name = "sample_rate"sv;
 const std::string_view latitude_name = "latitude"sv;
 const std::string_view longitude_name = "longitude"sv;
 const std::string_view satinuse_name = "satinuse"sv;
+const std::string_view time_index_name = "time_index"sv;
+const std::string_view trim_start_name = "trim_start"sv;
+const std::string_view peak_name = "peak"sv;
 
 fs::path get_metadata_path(const fs::path& capture_path) {
     auto temp = capture_path;
@@ -87,25 +90,8 @@ Optional<capture_metadata> read_metadata_file(const fs::path& path) {
     capture_metadata metadata{};
 
     auto reader = FileLineReader(f);
-    for (const auto& line : reader) {
-        auto cols = split_string(line, '=');
-
-        if (cols.size() != 2)
-            continue;  // Bad line.
-
-        if (cols[0] == center_freq_name)
-            parse_int(cols[1], metadata.center_frequency);
-        else if (cols[0] == sample_rate_name)
-            parse_int(cols[1], metadata.sample_rate);
-        else if (cols[0] == latitude_name)
-            parse_float_meta(cols[1], metadata.latitude);
-        else if (cols[0] == longitude_name)
-            parse_float_meta(cols[1], metadata.longitude);
-        else if (cols[0] == satinuse_name)
-            parse_int(cols[1], metadata.satinuse);
-        else
-            continue;
-    }
+    for (const auto& line : reader)
+        parse_metadata_line(line, metadata);
 
     if (metadata.center_frequency == 0 || metadata.sample_rate == 0)
         return {};  // Parse failed.
@@ -113,6 +99,103 @@ Optional<capture_metadata> read_metadata_file(const fs::path& path) {
     return metadata;
 }
 
+bool parse_metadata_line(std::string_view line, capture_metadata& metadata) {
+    // FileLineReader keeps the line ending.
+    while (!line.empty() && (line.back() == '\n' || line.back() == '\r'))
+        line.remove_suffix(1);
+
+    auto cols = split_string(line, '=');
+
+    if (cols.size() != 2)
+        return false;  // Bad line.
+
+    if (cols[0] == center_freq_name)
+        parse_int(cols[1], metadata.center_frequency);
+    else if (cols[0] == sample_rate_name)
+        parse_int(cols[1], metadata.sample_rate);
+    else if (cols[0] == latitude_name)
+        parse_float_meta(cols[1], metadata.latitude);
+    else if (cols[0] == longitude_name)
+        parse_float_meta(cols[1], metadata.longitude);
+    else if (cols[0] == satinuse_name)
+        parse_int(cols[1], metadata.satinuse);
+    else if (cols[0] == trim_start_name)
+        parse_int(cols[1], metadata.trim_start);
+    else if (cols[0] == peak_name)
+        parse_int(cols[1], metadata.peak);
+    else if (cols[0] == time_index_name) {
+        CaptureTimeMark mark{};
+        if (!metadata.time_index && parse_metadata_time_mark(cols[1], mark))
+            metadata.time_index = mark;
+    } else
+        return false;
+
+    return true;
+}
+
+/* parse_int() reads "x" as 0, the time index fields must be all digits. */
+template <typename T>
+static bool parse_digits(std::string_view str, T& out_val) {
+    if (str.empty())
+        return false;
+
+    for (auto c : str)
+        if (c < '0' || c > '9')
+            return false;
+
+    return parse_int(str, out_val);
+}
+
+bool parse_metadata_time_mark(std::string_view str, CaptureTimeMark& mark) {
+    auto cols = split_string(str, ',');
+    if (cols.size() != 3 || cols[2].size() != 14)
+        return false;
+
+    if (!parse_digits(cols[0], mark.stream_sample) || !parse_digits(cols[1], mark.sample_index))
+        return false;
+
+    // YYYYMMDDhhmmss
+    const auto ts = cols[2];
+    uint16_t year = 0;
+    uint8_t month = 0, day = 0, hour = 0, minute = 0, second = 0;
+    if (!parse_digits(ts.substr(0, 4), year) || !parse_digits(ts.substr(4, 2), month) ||
+        !parse_digits(ts.substr(6, 2), day) || !parse_digits(ts.substr(8, 2), hour) ||
+        !parse_digits(ts.substr(10, 2), minute) || !parse_digits(ts.substr(12, 2), second))
+        return false;
+
+    mark.timestamp = {year, month, day, hour, minute, second};
+    return true;
+}
+
+std::string metadata_time_mark_line(const CaptureTimeMark& mark) {
+    return std::string{time_index_name} + "=" +
+           to_string_dec_uint(mark.stream_sample) + "," +
+           to_string_dec_uint(mark.sample_index) + "," +
+           to_string_timestamp(mark.timestamp);
+}
+
+std::string metadata_trim_line(uint64_t trim_start) {
+    return std::string{trim_start_name} + "=" + to_string_dec_uint(trim_start);
+}
+
+Optional<File::Error> write_metadata_time_mark(File& f, const CaptureTimeMark& mark) {
+    return f.write_line(metadata_time_mark_line(mark));
+}
+
+Optional<File::Error> write_metadata_peak(File& f, uint16_t peak) {
+    return f.write_line(std::string{peak_name} + "=" + to_string_dec_uint(peak));
+}
+
+Optional<File::Error> append_metadata_trim(const fs::path& path, uint64_t trim_start) {
+    File f;
+    auto error = f.append(path);
+
+    if (error)
+        return error;
+
+    return f.write_line(metadata_trim_line(trim_start));
+}
+
 bool parse_float_meta(std::string_view str, float& out_val) {
     out_val = {};
 
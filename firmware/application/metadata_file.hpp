@@ -23,6 +23,7 @@
 #define __METADATA_FILE_HPP__
 
 #include "file.hpp"
+#include "message.hpp"
 #include "optional.hpp"
 #include "rf_path.hpp"
 
@@ -32,6 +33,9 @@ struct capture_metadata {
     float latitude = 0;
     float longitude = 0;
     uint8_t satinuse = 0;
+    uint64_t trim_start = 0;  // Samples cut from the start of the capture after the time index was written.
+    uint16_t peak = 0;        // Largest |I| or |Q| in the capture, 0 if unknown.
+    Optional<CaptureTimeMark> time_index{};  // First time mark of the capture.
 };
 
 std::filesystem::path get_metadata_path(const std::filesystem::path& capture_path);
@@ -39,5 +43,20 @@ std::filesystem::path get_metadata_path(const std::filesystem::path& capture_pat
 Optional<File::Error> write_metadata_file(const std::filesystem::path& path, capture_metadata metadata);
 Optional<capture_metadata> read_metadata_file(const std::filesystem::path& path);
 
+/* Time index lines are "time_index=<file sample>,<baseband sample>,<RTC YYYYMMDDhhmmss>".
+ * The baseband sample is at the capture rate and counts samples dropped on the way to
+ * the file, so decodes and captures of the same stream can be lined up offline. */
+Optional<File::Error> write_metadata_time_mark(File& f, const CaptureTimeMark& mark);
+Optional<File::Error> write_metadata_peak(File& f, uint16_t peak);
+Optional<File::Error> append_metadata_trim(const std::filesystem::path& path, uint64_t trim_start);
+
+/* Lines as written by the functions above, without the line ending. */
+std::string metadata_time_mark_line(const CaptureTimeMark& mark);
+std::string metadata_trim_line(uint64_t trim_start);
+
+/* Parses one "name=value" line into metadata, false if it isn't a known field. */
+bool parse_metadata_line(std::string_view line, capture_metadata& metadata);
+bool parse_metadata_time_mark(std::string_view str, CaptureTimeMark& mark);
+
 bool parse_float_meta(std::string_view str, float& out_val);
 #endif  // __METADATA_FILE_HPP__
\ No newline at end of file
@@ -54,6 +54,7 @@ using asahi_kasei::ak4951::AK4951;
 #include "bitmap.hpp"
 #include "ui_widget.hpp"
 #include "i2cdevmanager.hpp"
+#include "boot.hpp"
 #include "battery.hpp"
 
 namespace portapack {
@@ -512,15 +513,18 @@ init_status_t init() {
 
     portapack::io.init();
     persistent_memory::cache::init();
+    boot::trace("persistent memory");
 
     const auto switches_state = swizzled_switches() & (~(0xC0 | 0x80));
     bool lcd_fast_setup = switches_state == 0 && portapack::display.read_display_status();
 
     if (lcd_fast_setup) {
         initialize_boot_splash_screen();
+        boot::trace("splash screen");
     } else {
         if (check_portapack_cpld() == false)
             return init_status_t::INIT_PORTAPACK_CPLD_FAILED;
+        boot::trace("portapack cpld");
     }
 
     /* Cache some configuration data from persistent memory. */
@@ -537,6 +541,7 @@ init_status_t init() {
     cgu::pll1::disable();
 
     set_cpu_clock_speed();
+    boot::trace("clocks");
 
     if (persistent_memory::config_lcd_inverted_mode()) display.set_inverted(true);
     /* sample max: 1023 sample_t AKA uint16_t
@@ -548,7 +553,11 @@ init_status_t init() {
     if (lcd_fast_setup)
         draw_splash_screen_icon(0, ui::bitmap_icon_memory);
 
-    usb_serial.initialize();
+    // Nothing before the first frame needs the USB shell.
+    boot::defer([]() {
+        usb_serial.initialize();
+        boot::trace("usb serial");
+    });
 
     i2c0.start(i2c_config_fast_clock);
     chThdSleepMilliseconds(10);
@@ -556,6 +565,7 @@ init_status_t init() {
     /* Check if portapack is attached by checking if any of the two audio chips is present. */
     if (lcd_fast_setup == false && is_portapack_present() == false)
         return init_status_t::INIT_NO_PORTAPACK;
+    boot::trace("portapack detect");
 
     if (lcd_fast_setup)
         draw_splash_screen_icon(1, ui::bitmap_icon_remote);
@@ -568,9 +578,11 @@ init_status_t init() {
     clock_manager.enable_if_clocks();
     clock_manager.enable_codec_clocks();
     radio::init();
+    boot::trace("radio");
 
     sdcStart(&SDCD1, nullptr);
     sd_card::poll_inserted();
+    boot::trace("sd card");
 
     chThdSleepMilliseconds(10);
 
@@ -584,6 +596,7 @@ init_status_t init() {
 
         return_code = init_status_t::INIT_HACKRF_CPLD_FAILED;
     }
+    boot::trace("hackrf cpld");
 
     if (lcd_fast_setup)
         draw_splash_screen_icon(3, ui::bitmap_icon_hackrf);
@@ -596,8 +609,14 @@ init_status_t init() {
     chThdSleepMilliseconds(10);
 
     audio::init(portapack_audio_codec());
+    boot::trace("audio");
     battery::BatteryManagement::set_calc_override(persistent_memory::ui_override_batt_calc());
-    i2cdev::I2CDevManager::init();
+
+    // The autoscan competes with init for the I2C bus, add-on devices can wait.
+    boot::defer([]() {
+        i2cdev::I2CDevManager::init();
+        boot::trace("i2c devices");
+    });
 
     if (lcd_fast_setup)
         draw_splash_screen_icon(4, ui::bitmap_icon_speaker);
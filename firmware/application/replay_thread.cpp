@@ -24,6 +24,7 @@
 
 #include "baseband_api.hpp"
 #include "buffer_exchange.hpp"
+#include "memory_stats.hpp"
 
 struct BasebandReplay {
     BasebandReplay(ReplayConfig* const config) {
@@ -42,11 +43,14 @@ ReplayThread::ReplayThread(
     size_t read_size,
     size_t buffer_count,
     bool* ready_signal,
-    std::function<void(uint32_t return_code)> terminate_callback)
-    : config{read_size, buffer_count},
+    std::function<void(uint32_t return_code)> terminate_callback,
+    bool c8,
+    Continuation continuation)
+    : config{read_size, buffer_count, c8},
       reader{std::move(reader)},
       ready_sig{ready_signal},
-      terminate_callback{std::move(terminate_callback)} {
+      terminate_callback{std::move(terminate_callback)},
+      continuation{std::move(continuation)} {
     // Need significant stack for FATFS
     thread = chThdCreateFromHeap(NULL, 1024, NORMALPRIO + 10, ReplayThread::static_fn, this);
 }
@@ -60,6 +64,9 @@ ReplayThread::~ReplayThread() {
 }
 
 msg_t ReplayThread::static_fn(void* arg) {
+    chRegSetThreadName("replay");
+    memory_stats::set_thread_tag(memory_stats::Tag::Radio);
+
     auto obj = static_cast<ReplayThread*>(arg);
     const auto return_code = obj->run();
     if (obj->terminate_callback) {
@@ -80,8 +87,6 @@ uint32_t ReplayThread::run() {
         chThdSleep(100);
     };
 
-    constexpr size_t block_size = 512;
-
     // While empty buffers fifo is not empty...
     while (!buffers.empty()) {
         prefill_buffer = buffers.get_prefill();
@@ -89,27 +94,23 @@ uint32_t ReplayThread::run() {
         if (prefill_buffer == nullptr) {
             buffers.put_app(prefill_buffer);
         } else {
-            size_t blocks = config.read_size / block_size;
-
-            for (size_t c = 0; c < blocks; c++) {
-                auto read_result = reader->read(&((uint8_t*)prefill_buffer->data())[c * block_size], block_size);
-                if (read_result.is_error()) {
-                    return READ_ERROR;
-                }
+            auto read_result = fill(*prefill_buffer, reader, continuation);
+            if (read_result.is_error()) {
+                return READ_ERROR;
             }
 
-            prefill_buffer->set_size(config.read_size);
-
             buffers.put(prefill_buffer);
         }
     };
 
     baseband::set_fifo_data(nullptr);
 
+    // Every buffer handed back by the baseband is refilled right away,
+    // so the reads stay buffer_count buffers ahead of transmission.
     while (!chThdShouldTerminate()) {
         auto buffer = buffers.get();
 
-        auto read_result = reader->read(buffer->data(), buffer->capacity());
+        auto read_result = fill(*buffer, reader, continuation);
         if (read_result.is_error()) {
             return READ_ERROR;
         } else {
@@ -118,10 +119,40 @@ uint32_t ReplayThread::run() {
             }
         }
 
-        buffer->set_size(buffer->capacity());
-
         buffers.put(buffer);
     }
 
     return TERMINATED;
 }
+
+File::Result<File::Size> ReplayThread::fill(
+    StreamBuffer& buffer,
+    std::unique_ptr<stream::Reader>& reader,
+    const Continuation& continuation) {
+    auto data = static_cast<uint8_t*>(buffer.data());
+    File::Size filled = 0;
+    bool continued = false;
+
+    while (filled < buffer.capacity()) {
+        auto read_result = reader->read(&data[filled], buffer.capacity() - filled);
+        if (read_result.is_error())
+            return read_result;
+
+        if (read_result.value() > 0) {
+            filled += read_result.value();
+            continued = false;
+            continue;
+        }
+
+        // Also stops on an empty reader coming right after a continuation.
+        if (continued || !continuation || !continuation(reader))
+            break;
+
+        continued = true;
+        if (filled > 0)
+            break;
+    }
+
+    buffer.set_size(filled);
+    return filled;
+}
@@ -36,12 +36,20 @@
 
 class ReplayThread {
    public:
+    /* Called on the replay thread when the reader runs dry. Rewinds or
+     * replaces reader and returns true to keep the stream going without
+     * restarting the baseband. */
+    using Continuation = std::function<bool(std::unique_ptr<stream::Reader>& reader)>;
+
+    /* c8 streams are sent to proc_replay as is, the reader must not widen them. */
     ReplayThread(
         std::unique_ptr<stream::Reader> reader,
         size_t read_size,
         size_t buffer_count,
         bool* ready_signal,
-        std::function<void(uint32_t return_code)> terminate_callback);
+        std::function<void(uint32_t return_code)> terminate_callback,
+        bool c8 = false,
+        Continuation continuation = {});
     ~ReplayThread();
 
     ReplayThread(const ReplayThread&) = delete;
@@ -56,14 +64,26 @@ class ReplayThread {
     enum replaythread_return {
         READ_ERROR = 0,
         END_OF_FILE,
-        TERMINATED
+        TERMINATED,
+        CONTINUED  // Sent by continuations, the thread keeps running.
     };
 
+    /* Fills buffer with whole-buffer reads so file reads stay large and
+     * sector aligned. At the end of reader the continuation is asked for
+     * the next one. A buffer cut short by the end of a track is passed on
+     * short and the next track starts at a fresh buffer, so its reads are
+     * aligned too. Returns 0 once the stream has ended. */
+    static File::Result<File::Size> fill(
+        StreamBuffer& buffer,
+        std::unique_ptr<stream::Reader>& reader,
+        const Continuation& continuation);
+
    private:
     ReplayConfig config;
     std::unique_ptr<stream::Reader> reader;
     bool* ready_sig;
     std::function<void(uint32_t return_code)> terminate_callback;
+    Continuation continuation;
     Thread* thread{nullptr};
 
     static msg_t static_fn(void* arg);
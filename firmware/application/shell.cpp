@@ -31,6 +31,7 @@
 #include "shell.hpp"
 #include "chprintf.h"
 #include "portapack.hpp"
+#include "memory_stats.hpp"
 
 /**
  * @brief   Shell termination event source.
@@ -148,6 +149,7 @@ static msg_t shell_thread(void* p) {
     char* args[SHELL_MAX_ARGUMENTS + 1];
 
     chRegSetThreadName("shell");
+    memory_stats::set_thread_tag(memory_stats::Tag::Shell);
     chprintf(chp, "\r\nChibiOS/RT Shell\r\n");
     while (TRUE) {
         chprintf(chp, "ch> ");
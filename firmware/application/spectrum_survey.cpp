@@ -0,0 +1,247 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "spectrum_survey.hpp"
+
+namespace fs = std::filesystem;
+
+namespace survey {
+
+size_t encode_row(const uint8_t* row, size_t length, uint8_t* out) {
+    if (length == 0)
+        return 0;
+
+    size_t n = 0;
+    out[n++] = row[0];
+
+    size_t i = 1;
+    while (i < length) {
+        uint8_t delta = row[i] - row[i - 1];
+
+        if (delta != 0) {
+            out[n++] = delta;
+            ++i;
+            continue;
+        }
+
+        // Collapse a run of unchanged values.
+        uint8_t run = 0;
+        while (i < length && row[i] == row[i - 1] && run < UINT8_MAX) {
+            ++run;
+            ++i;
+        }
+        out[n++] = 0;
+        out[n++] = run;
+    }
+
+    return n;
+}
+
+size_t decode_row(const uint8_t* in, size_t in_length, uint8_t* row, size_t length) {
+    if (length == 0)
+        return 0;
+    if (in_length == 0)
+        return 0;
+
+    size_t n = 0;
+    size_t i = 0;
+    row[i++] = in[n++];
+
+    while (i < length) {
+        if (n >= in_length)
+            return 0;
+
+        uint8_t value = in[n++];
+        if (value != 0) {
+            row[i] = row[i - 1] + value;
+            ++i;
+            continue;
+        }
+
+        if (n >= in_length)
+            return 0;
+
+        uint8_t run = in[n++];
+        if (run == 0 || i + run > length)
+            return 0;
+
+        for (; run > 0; --run, ++i)
+            row[i] = row[i - 1];
+    }
+
+    return n;
+}
+
+Optional<File::Error> SpectrumSurvey::start(const fs::path& pattern, const Config& config) {
+    stop();
+
+    pattern_ = pattern;
+    config_ = config;
+    bucket_.reset();
+    bucket_start_ = 0;
+    records_total_ = 0;
+
+    auto error = open_next_file();
+    if (error)
+        return error;
+
+    active_ = true;
+    return {};
+}
+
+void SpectrumSurvey::stop() {
+    if (!active_)
+        return;
+
+    commit_bucket();
+    file_.close();
+    active_ = false;
+}
+
+Optional<File::Error> SpectrumSurvey::end_sweep(uint32_t elapsed_seconds) {
+    if (!active_)
+        return {};
+
+    bucket_.end_sweep();
+
+    if (elapsed_seconds - bucket_start_ < config_.bucket_seconds)
+        return {};
+
+    auto error = commit_bucket();
+
+    // Keep buckets aligned to the survey start even if a sweep ran long.
+    bucket_start_ += ((elapsed_seconds - bucket_start_) / config_.bucket_seconds) * config_.bucket_seconds;
+
+    if (error) {
+        file_.close();
+        active_ = false;
+    }
+
+    return error;
+}
+
+Optional<File::Error> SpectrumSurvey::open_next_file() {
+    file_.close();
+    records_in_file_ = 0;
+
+    auto path = next_filename_matching_pattern(pattern_);
+    if (path.empty())
+        return File::Error{FR_EXIST};
+
+    auto error = ensure_directory(path.parent_path());
+    if (error.code())
+        return error;
+
+    auto create_error = file_.create(path);
+    if (create_error)
+        return create_error;
+
+    survey_file_header header{
+        .magic = file_magic,
+        .version = file_version,
+        .width = width,
+        .f_min = config_.f_min,
+        .f_max = config_.f_max,
+        .bucket_seconds = config_.bucket_seconds,
+        .threshold = config_.threshold,
+        .reserved0 = 0,
+        .index_capacity = index_capacity,
+        .year = config_.year,
+        .month = config_.month,
+        .day = config_.day,
+        .hour = config_.hour,
+        .minute = config_.minute,
+        .second = config_.second,
+        .reserved1 = 0,
+    };
+
+    auto result = file_.write(&header, sizeof(header));
+    if (result.is_error())
+        return result.error();
+
+    // Reserve the record index, zeroed slots mark the end of data.
+    std::array<uint32_t, 64> zeros{};
+    for (size_t i = 0; i < index_capacity; i += zeros.size()) {
+        result = file_.write(zeros.data(), sizeof(zeros));
+        if (result.is_error())
+            return result.error();
+    }
+
+    return file_.sync();
+}
+
+Optional<File::Error> SpectrumSurvey::commit_bucket() {
+    if (bucket_.sweeps() == 0)
+        return {};
+
+    if (records_in_file_ >= index_capacity) {
+        auto error = open_next_file();
+        if (error)
+            return error;
+    }
+
+    std::array<std::array<uint8_t, width>, rows_per_record> rows{};
+    bucket_.get_rows(rows[0].data(), rows[1].data(), rows[2].data());
+
+    std::array<uint8_t, max_encoded_row_size(width) * rows_per_record> payload{};
+    size_t payload_size = 0;
+    for (const auto& row : rows)
+        payload_size += encode_row(row.data(), row.size(), &payload[payload_size]);
+
+    survey_record_header record{
+        .elapsed_seconds = bucket_start_,
+        .sweeps = bucket_.sweeps(),
+        .payload_size = static_cast<uint16_t>(payload_size),
+        .reserved = 0,
+    };
+    bucket_.reset();
+
+    // Append the record.
+    auto record_offset = file_.size();
+    auto result = file_.seek(record_offset);
+    if (result.is_error())
+        return result.error();
+
+    result = file_.write(&record, sizeof(record));
+    if (result.is_error())
+        return result.error();
+
+    result = file_.write(payload.data(), payload_size);
+    if (result.is_error())
+        return result.error();
+
+    // Then publish it in the index.
+    uint32_t offset = record_offset;
+    result = file_.seek(sizeof(survey_file_header) + records_in_file_ * sizeof(uint32_t));
+    if (result.is_error())
+        return result.error();
+
+    result = file_.write(&offset, sizeof(offset));
+    if (result.is_error())
+        return result.error();
+
+    records_in_file_++;
+    records_total_++;
+
+    return file_.sync();
+}
+
+} /* namespace survey */
@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __SPECTRUM_SURVEY_H__
+#define __SPECTRUM_SURVEY_H__
+
+#include "file.hpp"
+#include "optional.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/* Band occupancy survey heatmap (.PHM) file layout, all little-endian:
+ *
+ *   header          survey_file_header
+ *   index           index_capacity x uint32_t record offsets (0 = unused)
+ *   records         survey_record_header + encoded max/mean/occupancy rows
+ *
+ * Each row is delta-coded (first byte raw, then the difference to the
+ * previous byte) and runs of zero deltas are stored as 0x00 <run length>.
+ * Index slots are written as soon as a record is committed so a file cut
+ * short by a power loss stays readable. When the index is full, the
+ * survey rolls over to the next file name. */
+namespace survey {
+
+constexpr uint32_t file_magic = 0x4D485050;  // "PPHM"
+constexpr uint16_t file_version = 2;
+constexpr uint16_t index_capacity = 1024;
+constexpr size_t rows_per_record = 3;
+
+struct survey_file_header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t width;
+    uint64_t f_min;
+    uint64_t f_max;
+    uint32_t bucket_seconds;
+    uint8_t threshold;
+    uint8_t reserved0;
+    uint16_t index_capacity;
+    uint16_t year;
+    uint8_t month;
+    uint8_t day;
+    uint8_t hour;
+    uint8_t minute;
+    uint8_t second;
+    uint8_t reserved1;
+};
+static_assert(sizeof(survey_file_header) == 40, "survey_file_header size changed.");
+
+struct survey_record_header {
+    uint32_t elapsed_seconds;  // Bucket start, relative to header time.
+    uint32_t sweeps;           // Number of sweeps accumulated in bucket.
+    uint16_t payload_size;     // Encoded bytes following this header.
+    uint16_t reserved;
+};
+static_assert(sizeof(survey_record_header) == 12, "survey_record_header size changed.");
+
+/* Worst case encoded size: isolated zero deltas cost two bytes each. */
+constexpr size_t max_encoded_row_size(size_t width) {
+    return width + (width + 1) / 2;
+}
+
+/* Delta + zero-run encodes a row into out. Returns encoded length.
+ * out must hold at least max_encoded_row_size(length) bytes. */
+size_t encode_row(const uint8_t* row, size_t length, uint8_t* out);
+
+/* Decodes an encoded row. Returns number of bytes consumed from in,
+ * or 0 if the data is malformed. */
+size_t decode_row(const uint8_t* in, size_t in_length, uint8_t* row, size_t length);
+
+/* Per-bin statistics over one time bucket. */
+template <size_t N>
+class SurveyBucket {
+   public:
+    void reset() {
+        max_.fill(0);
+        sum_.fill(0);
+        samples_.fill(0);
+        occupied_.fill(0);
+        sweeps_ = 0;
+    }
+
+    /* Counts stop together at max_count, far past any bucket length, so
+     * the sums can't wrap and the ratios stay right. */
+    static constexpr uint32_t max_count = UINT32_MAX / UINT8_MAX;
+
+    void add(size_t index, uint8_t power, uint8_t threshold) {
+        if (index >= N)
+            return;
+
+        if (power > max_[index])
+            max_[index] = power;
+        if (samples_[index] < max_count) {
+            sum_[index] += power;
+            samples_[index]++;
+        }
+        if (sweeps_ < max_count && power >= threshold)
+            occupied_[index]++;
+    }
+
+    /* Marks the end of a sweep across all bins. */
+    void end_sweep() {
+        if (sweeps_ < max_count)
+            sweeps_++;
+    }
+
+    uint32_t sweeps() const { return sweeps_; }
+
+    /* Fills max, mean and occupancy (0-255 == 0-100%) rows. The mean is
+     * over the sweeps that sampled the bin, occupancy over all sweeps. */
+    void get_rows(uint8_t* max_row, uint8_t* mean_row, uint8_t* occupancy_row) const {
+        for (size_t i = 0; i < N; ++i) {
+            max_row[i] = max_[i];
+            mean_row[i] = samples_[i] ? sum_[i] / samples_[i] : 0;
+            occupancy_row[i] = sweeps_ ? (uint64_t{occupied_[i]} * 255u) / sweeps_ : 0;
+        }
+    }
+
+   private:
+    std::array<uint8_t, N> max_{};
+    std::array<uint32_t, N> sum_{};
+    std::array<uint32_t, N> samples_{};
+    std::array<uint32_t, N> occupied_{};
+    uint32_t sweeps_{0};
+};
+
+/* Accumulates Looking Glass sweeps and writes bucketed heatmap records. */
+class SpectrumSurvey {
+   public:
+    static constexpr size_t width = 240;
+
+    struct Config {
+        uint64_t f_min;
+        uint64_t f_max;
+        uint32_t bucket_seconds;
+        uint8_t threshold;
+        uint16_t year;
+        uint8_t month;
+        uint8_t day;
+        uint8_t hour;
+        uint8_t minute;
+        uint8_t second;
+    };
+
+    /* Starts a new survey file, pattern as next_filename_matching_pattern. */
+    Optional<File::Error> start(const std::filesystem::path& pattern, const Config& config);
+
+    /* Commits the current bucket and closes the file. */
+    void stop();
+
+    bool is_active() const { return active_; }
+    uint32_t records_written() const { return records_total_; }
+
+    void add_bin(size_t index, uint8_t power) {
+        if (active_)
+            bucket_.add(index, power, config_.threshold);
+    }
+
+    /* Called once per completed sweep with the seconds since start. */
+    Optional<File::Error> end_sweep(uint32_t elapsed_seconds);
+
+   private:
+    Optional<File::Error> open_next_file();
+    Optional<File::Error> commit_bucket();
+
+    File file_{};
+    std::filesystem::path pattern_{};
+    Config config_{};
+    SurveyBucket<width> bucket_{};
+    uint32_t bucket_start_{0};
+    uint16_t records_in_file_{0};
+    uint32_t records_total_{0};
+    bool active_{false};
+};
+
+} /* namespace survey */
+
+#endif /*__SPECTRUM_SURVEY_H__*/
@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __STRING_BUILDER_H__
+#define __STRING_BUILDER_H__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/* Writes the decimal digits of n backwards ending just before end.
+ * Returns the number of digits written. */
+constexpr size_t format_dec_uint(uint64_t n, char* end) {
+    size_t length = 0;
+    do {
+        *--end = '0' + (n % 10);
+        n /= 10;
+        length++;
+    } while (n != 0);
+    return length;
+}
+
+constexpr char hex_digit(uint8_t value) {
+    return value < 10 ? '0' + value : 'A' + (value - 10);
+}
+
+/* Appends text into a caller provided buffer without allocating.
+ * Anything past the capacity is dropped and the text is always NUL
+ * terminated, so c_str() can be handed to C style APIs. */
+class StringBuilder {
+   public:
+    /* A zero capacity buffer has no room even for the NUL, so it is
+     * never written and c_str() is an empty literal. */
+    constexpr StringBuilder(char* buffer, size_t capacity)
+        : buffer_{capacity > 0 ? buffer : nullptr}, capacity_{capacity > 0 ? capacity - 1 : 0} {
+        terminate();
+    }
+
+    template <size_t N>
+    constexpr StringBuilder(char (&buffer)[N])
+        : StringBuilder{buffer, N} {}
+
+    template <size_t N>
+    constexpr StringBuilder(std::array<char, N>& buffer)
+        : StringBuilder{buffer.data(), N} {}
+
+    StringBuilder(const StringBuilder&) = delete;
+    StringBuilder& operator=(const StringBuilder&) = delete;
+
+    constexpr size_t size() const { return size_; }
+    constexpr size_t capacity() const { return capacity_; }
+    constexpr bool empty() const { return size_ == 0; }
+
+    /* True if something was dropped for lack of room. */
+    constexpr bool truncated() const { return truncated_; }
+
+    constexpr std::string_view view() const { return {buffer_, size_}; }
+    constexpr const char* c_str() const { return buffer_ ? buffer_ : ""; }
+    constexpr operator std::string_view() const { return view(); }
+
+    constexpr void clear() {
+        size_ = 0;
+        truncated_ = false;
+        terminate();
+    }
+
+    constexpr StringBuilder& append(std::string_view text) {
+        for (auto c : text)
+            put(c);
+        terminate();
+        return *this;
+    }
+
+    constexpr StringBuilder& append(const char c, size_t count = 1) {
+        while (count--)
+            put(c);
+        terminate();
+        return *this;
+    }
+
+    /* Right justified to width. Fill pads the digits, the sign goes
+     * in front of them. With no fill, spaces pad in front of the sign. */
+    constexpr StringBuilder& append_dec(int64_t n, size_t width = 0, char fill = '\0') {
+        const bool negative = n < 0;
+        const uint64_t magnitude = negative ? 0 - static_cast<uint64_t>(n) : n;
+        return append_number(magnitude, negative, width, fill);
+    }
+
+    constexpr StringBuilder& append_dec_uint(uint64_t n, size_t width = 0, char fill = ' ') {
+        return append_number(n, false, width, fill);
+    }
+
+    /* Exactly digits hex digits, upper case, most significant first. */
+    constexpr StringBuilder& append_hex(uint64_t n, size_t digits) {
+        for (size_t i = digits; i-- > 0;)
+            put(i < 16 ? hex_digit((n >> (i * 4)) & 0xF) : '0');
+        terminate();
+        return *this;
+    }
+
+    /* Pads with fill or truncates to exactly length characters. */
+    constexpr StringBuilder& resize(size_t length, char fill = ' ') {
+        if (length < size_) {
+            size_ = length;
+            terminate();
+        } else {
+            append(fill, length - size_);
+        }
+        return *this;
+    }
+
+   private:
+    constexpr void put(const char c) {
+        if (size_ < capacity_)
+            buffer_[size_++] = c;
+        else
+            truncated_ = true;
+    }
+
+    constexpr void terminate() {
+        if (buffer_)
+            buffer_[size_] = '\0';
+    }
+
+    constexpr StringBuilder& append_number(uint64_t n, bool negative, size_t width, char fill) {
+        char digits[24]{};
+        auto end = &digits[sizeof(digits)];
+        size_t length = format_dec_uint(n, end);
+
+        if (fill) {
+            const size_t digit_width = width > negative ? width - negative : 0;
+            while (length < digit_width && length < sizeof(digits) - 1)
+                digits[sizeof(digits) - ++length] = fill;
+        }
+
+        if (negative)
+            digits[sizeof(digits) - ++length] = '-';
+
+        if (length < width)
+            append(' ', width - length);
+
+        return append({end - length, length});
+    }
+
+    char* buffer_;
+    size_t capacity_;
+    size_t size_{0};
+    bool truncated_{false};
+};
+
+namespace detail {
+template <size_t N>
+struct StringStorage {
+    char storage[N]{};
+};
+} /* namespace detail */
+
+/* StringBuilder with its own storage, for building on the stack. */
+template <size_t N>
+class StringBuffer : private detail::StringStorage<N>, public StringBuilder {
+   public:
+    constexpr StringBuffer()
+        : StringBuilder{this->storage, N} {}
+};
+
+#endif /*__STRING_BUILDER_H__*/
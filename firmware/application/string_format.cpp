@@ -21,6 +21,8 @@
 
 #include "string_format.hpp"
 
+#include <algorithm>
+
 using namespace std::literals;
 
 /* This takes a pointer to the end of a buffer
@@ -42,25 +44,6 @@ static char* to_string_dec_uint_internal(
     return q;
 }
 
-static char* to_string_dec_uint_pad_internal(
-    char* const term,
-    const uint32_t n,
-    const int32_t l,
-    const char fill) {
-    auto q = to_string_dec_uint_internal(term, n);
-
-    // Fill with padding if needed.
-    // TODO: use std::array instead. There's no
-    // bounds checks on any of this!
-    if (fill) {
-        while ((term - q) < l) {
-            *(--q) = fill;
-        }
-    }
-
-    return q;
-}
-
 static char* to_string_dec_uint_internal(uint64_t n, StringFormatBuffer& buffer, size_t& length) {
     auto end = &buffer.back();
     auto start = to_string_dec_uint_internal(end, n);
@@ -116,49 +99,24 @@ std::string to_string_dec_uint(
     const uint32_t n,
     const int32_t l,
     const char fill) {
-    char p[16];
-    auto term = p + sizeof(p) - 1;
-    auto q = to_string_dec_uint_pad_internal(term, n, l, fill);
-
-    // Right justify.
-    // (This code is redundant and won't do anything if a fill character was specified)
-    while ((term - q) < l) {
-        *(--q) = ' ';
-    }
-
-    return q;
+    StringBuffer<24> s;
+    s.append_dec_uint(n, std::max<int32_t>(l, 0), fill);
+    return std::string{s.view()};
 }
 
 std::string to_string_dec_int(
     const int32_t n,
     const int32_t l,
     const char fill) {
-    const size_t negative = (n < 0) ? 1 : 0;
-    uint32_t n_abs = negative ? -n : n;
-
-    char p[16];
-    auto term = p + sizeof(p) - 1;
-    auto q = to_string_dec_uint_pad_internal(term, n_abs, l - negative, fill);
-
-    // Add sign.
-    if (negative) {
-        *(--q) = '-';
-    }
-
-    // Right justify.
-    // (This code is redundant and won't do anything if a fill character was specified)
-    while ((term - q) < l) {
-        *(--q) = ' ';
-    }
-
-    return q;
+    StringBuffer<24> s;
+    s.append_dec(n, std::max<int32_t>(l, 0), fill);
+    return std::string{s.view()};
 }
 
-std::string to_string_decimal(float decimal, int8_t precision) {
+StringBuilder& append_decimal(StringBuilder& s, float decimal, int8_t precision) {
     double integer_part;
     double fractional_part;
 
-    std::string result;
     if (precision > 9) precision = 9;  // we will convert to uin32_t, and that is the max it can hold.
 
     fractional_part = modf(decimal, &integer_part) * pow(10, precision);
@@ -167,9 +125,12 @@ std::string to_string_decimal(float decimal, int8_t precision) {
         fractional_part = -fractional_part;
     }
 
-    result = to_string_dec_int(integer_part) + "." + to_string_dec_uint(fractional_part, precision, '0');
+    return s.append_dec(static_cast<int64_t>(integer_part)).append('.').append_dec_uint(static_cast<uint32_t>(fractional_part), std::max<int8_t>(precision, 0), '0');
+}
 
-    return result;
+std::string to_string_decimal(float decimal, int8_t precision) {
+    StringBuffer<32> s;
+    return std::string{append_decimal(s, decimal, precision).view()};
 }
 
 std::string to_string_decimal_padding(float decimal, int8_t precision, const int32_t l) {
@@ -198,26 +159,30 @@ std::string to_string_decimal_padding(float decimal, int8_t precision, const int
 }
 
 // right-justified frequency in Hz, always 10 characters
-std::string to_string_freq(const uint64_t f) {
-    std::string final_str{""};
-
+StringBuilder& append_freq(StringBuilder& s, const uint64_t f) {
     if (f < 1000000)
-        final_str = to_string_dec_int(f, 10, ' ');
-    else
-        final_str = to_string_dec_int(f / 1000000, 4) + to_string_dec_int(f % 1000000, 6, '0');
+        return s.append_dec(f, 10, ' ');
 
-    return final_str;
+    return s.append_dec(f / 1000000, 4).append_dec(f % 1000000, 6, '0');
+}
+
+std::string to_string_freq(const uint64_t f) {
+    StringBuffer<24> s;
+    return std::string{append_freq(s, f).view()};
 }
 
 // right-justified frequency in MHz, rounded to 4 decimal places, always 9 characters
+StringBuilder& append_short_freq(StringBuilder& s, const uint64_t f) {
+    return s.append_dec((f + 50) / 1000000, 4).append('.').append_dec(((f + 50) / 100) % 10000, 4, '0');
+}
+
 std::string to_string_short_freq(const uint64_t f) {
-    auto final_str = to_string_dec_int((f + 50) / 1000000, 4) + "." + to_string_dec_int(((f + 50) / 100) % 10000, 4, '0');
-    return final_str;
+    StringBuffer<24> s;
+    return std::string{append_short_freq(s, f).view()};
 }
 
 // non-justified non-padded frequency in MHz, rounded to specified number of decimal places
-std::string to_string_rounded_freq(const uint64_t f, int8_t precision) {
-    std::string final_str{""};
+StringBuilder& append_rounded_freq(StringBuilder& s, const uint64_t f, int8_t precision) {
     static constexpr uint32_t pow10[7] = {
         1,
         10,
@@ -228,17 +193,20 @@ std::string to_string_rounded_freq(const uint64_t f, int8_t precision) {
         1000000,
     };
 
-    if (precision < 1) {
-        final_str = to_string_dec_uint(f / 1000000);
-    } else {
-        if (precision > 6)
-            precision = 6;
+    if (precision < 1)
+        return s.append_dec_uint(f / 1000000);
 
-        uint32_t divisor = pow10[6 - precision];
+    if (precision > 6)
+        precision = 6;
 
-        final_str = to_string_dec_uint((f + (divisor / 2)) / 1000000) + "." + to_string_dec_int(((f + (divisor / 2)) / divisor) % pow10[precision], precision, '0');
-    }
-    return final_str;
+    uint32_t divisor = pow10[6 - precision];
+
+    return s.append_dec_uint((f + (divisor / 2)) / 1000000).append('.').append_dec(((f + (divisor / 2)) / divisor) % pow10[precision], precision, '0');
+}
+
+std::string to_string_rounded_freq(const uint64_t f, int8_t precision) {
+    StringBuffer<32> s;
+    return std::string{append_rounded_freq(s, f, precision).view()};
 }
 
 std::string to_string_time_ms(const uint32_t ms) {
@@ -258,60 +226,61 @@ std::string to_string_time_ms(const uint32_t ms) {
     return final_str;
 }
 
-static char* to_string_hex_internal(char* ptr, uint64_t value, uint8_t length) {
-    if (length == 0)
-        return ptr;
-
-    *(--ptr) = uint_to_char(value & 0xF, 16);
-    return to_string_hex_internal(ptr, value >> 4, length - 1);
-}
-
 std::string to_string_hex(uint64_t value, int32_t length) {
-    constexpr uint8_t buffer_length = 33;
-    char buffer[buffer_length];
+    StringBuffer<33> s;
+    s.append_hex(value, std::clamp<int32_t>(length, 0, 32));
+    return std::string{s.view()};
+}
 
-    char* ptr = &buffer[buffer_length - 1];
-    *ptr = '\0';
+StringBuilder& append_hex_array(StringBuilder& s, const uint8_t* array, size_t length) {
+    for (size_t i = 0; i < length; i++)
+        s.append_hex(array[i], 2);
 
-    length = std::min<uint8_t>(buffer_length - 1, length);
-    return to_string_hex_internal(ptr, value, length);
+    return s;
 }
 
 std::string to_string_hex_array(uint8_t* array, int32_t length) {
-    std::string str_return;
-    str_return.reserve(length * 2);
-
-    for (uint8_t i = 0; i < length; i++)
-        str_return += to_string_hex(array[i], 2);
-
+    std::string str_return(length * 2, '\0');
+    StringBuilder s{str_return.data(), str_return.size() + 1};
+    append_hex_array(s, array, length);
     return str_return;
 }
 
-std::string to_string_datetime(const rtc::RTC& value, const TimeFormat format) {
-    std::string string{""};
-
+StringBuilder& append_datetime(StringBuilder& s, const rtc::RTC& value, const TimeFormat format) {
     if (format == YMDHMS) {
-        string += to_string_dec_uint(value.year(), 4) + "-" +
-                  to_string_dec_uint(value.month(), 2, '0') + "-" +
-                  to_string_dec_uint(value.day(), 2, '0') + " ";
+        s.append_dec_uint(value.year(), 4)
+            .append('-')
+            .append_dec_uint(value.month(), 2, '0')
+            .append('-')
+            .append_dec_uint(value.day(), 2, '0')
+            .append(' ');
     }
 
-    string += to_string_dec_uint(value.hour(), 2, '0') + ":" +
-              to_string_dec_uint(value.minute(), 2, '0');
+    s.append_dec_uint(value.hour(), 2, '0').append(':').append_dec_uint(value.minute(), 2, '0');
 
     if ((format == YMDHMS) || (format == HMS))
-        string += ":" + to_string_dec_uint(value.second(), 2, '0');
+        s.append(':').append_dec_uint(value.second(), 2, '0');
 
-    return string;
+    return s;
+}
+
+std::string to_string_datetime(const rtc::RTC& value, const TimeFormat format) {
+    StringBuffer<24> s;
+    return std::string{append_datetime(s, value, format).view()};
+}
+
+StringBuilder& append_timestamp(StringBuilder& s, const rtc::RTC& value) {
+    return s.append_dec_uint(value.year(), 4, '0')
+        .append_dec_uint(value.month(), 2, '0')
+        .append_dec_uint(value.day(), 2, '0')
+        .append_dec_uint(value.hour(), 2, '0')
+        .append_dec_uint(value.minute(), 2, '0')
+        .append_dec_uint(value.second(), 2, '0');
 }
 
 std::string to_string_timestamp(const rtc::RTC& value) {
-    return to_string_dec_uint(value.year(), 4, '0') +
-           to_string_dec_uint(value.month(), 2, '0') +
-           to_string_dec_uint(value.day(), 2, '0') +
-           to_string_dec_uint(value.hour(), 2, '0') +
-           to_string_dec_uint(value.minute(), 2, '0') +
-           to_string_dec_uint(value.second(), 2, '0');
+    StringBuffer<24> s;
+    return std::string{append_timestamp(s, value).view()};
 }
 
 std::string to_string_FAT_timestamp(const FATTimestamp& timestamp) {
@@ -337,16 +306,19 @@ std::string to_string_file_size(uint32_t file_size) {
     return to_string_dec_uint(file_size) + suffix[suffix_index];
 }
 
-std::string to_string_mac_address(const uint8_t* macAddress, uint8_t length, bool noColon) {
-    std::string string;
-
-    string += to_string_hex(macAddress[0], 2);
-
-    for (int i = 1; i < length; i++) {
-        string += noColon ? to_string_hex(macAddress[i], 2) : ":" + to_string_hex(macAddress[i], 2);
+StringBuilder& append_mac_address(StringBuilder& s, const uint8_t* macAddress, uint8_t length, bool noColon) {
+    for (int i = 0; i < length; i++) {
+        if (i > 0 && !noColon)
+            s.append(':');
+        s.append_hex(macAddress[i], 2);
     }
 
-    return string;
+    return s;
+}
+
+std::string to_string_mac_address(const uint8_t* macAddress, uint8_t length, bool noColon) {
+    StringBuffer<3 * 16> s;
+    return std::string{append_mac_address(s, macAddress, length, noColon).view()};
 }
 
 std::string to_string_formatted_mac_address(const char* macAddress) {
@@ -28,6 +28,7 @@
 #include <string_view>
 
 #include "file.hpp"
+#include "string_builder.hpp"
 
 // BARF! rtc::RTC is leaking everywhere.
 #include "lpc43xx_cpp.hpp"
@@ -65,6 +66,17 @@ std::string to_string_hex(T n) {
     return to_string_hex(n, sizeof(T) * 2);  // Two digits/byte.
 }
 
+/* Appenders for building text in place, the to_string_ versions
+ * below are implemented with them and produce the same text. */
+StringBuilder& append_freq(StringBuilder& s, const uint64_t f);
+StringBuilder& append_short_freq(StringBuilder& s, const uint64_t f);
+StringBuilder& append_rounded_freq(StringBuilder& s, const uint64_t f, int8_t precision);
+StringBuilder& append_datetime(StringBuilder& s, const rtc::RTC& value, const TimeFormat format = YMDHMS);
+StringBuilder& append_timestamp(StringBuilder& s, const rtc::RTC& value);
+StringBuilder& append_mac_address(StringBuilder& s, const uint8_t* macAddress, uint8_t length, bool noColon);
+StringBuilder& append_hex_array(StringBuilder& s, const uint8_t* array, size_t length);
+StringBuilder& append_decimal(StringBuilder& s, float decimal, int8_t precision);
+
 std::string to_string_freq(const uint64_t f);
 std::string to_string_short_freq(const uint64_t f);
 std::string to_string_rounded_freq(const uint64_t f, int8_t precision);
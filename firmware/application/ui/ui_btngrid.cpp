@@ -153,6 +153,12 @@ void BtnGridView::insert_item(const GridItem& new_item, size_t position, bool in
     }
 }
 
+void BtnGridView::repopulate() {
+    menu_items.clear();
+    on_populate();
+    update_items();
+}
+
 void BtnGridView::update_items() {
     size_t i = 0;
     Color bg_color = portapack::persistent_memory::menu_color();
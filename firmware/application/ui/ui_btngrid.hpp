@@ -86,6 +86,9 @@ class BtnGridView : public View {
    protected:
     virtual void on_populate() = 0;
 
+    /* Rebuilds the items while shown, the buttons and focus are kept. */
+    void repopulate();
+
    private:
     int rows_{3};
     void on_tick_second();
@@ -101,7 +101,8 @@ void FrequencyField::getWidgetName(std::string& result) {
 }
 
 void FrequencyField::paint(Painter& painter) {
-    const auto str_value = to_string_short_freq(value_);
+    StringBuffer<16> str_value;
+    append_short_freq(str_value, value_);
     const auto paint_style = has_focus() ? style().invert() : style();
 
     painter.draw_string(
@@ -113,7 +114,7 @@ void FrequencyField::paint(Painter& painter) {
     if (digit_mode_) {
         auto p = screen_pos();
         p += {digit_ * char_width, 0};
-        painter.draw_char(p, *Theme::getInstance()->option_active, str_value[digit_]);
+        painter.draw_char(p, *Theme::getInstance()->option_active, str_value.view()[digit_]);
     }
 }
 
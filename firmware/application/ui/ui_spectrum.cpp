@@ -287,6 +287,29 @@ void WaterfallWidget::on_channel_spectrum(
         pixel_row);
 }
 
+void WaterfallWidget::on_waterfall_rows(WaterfallRowFIFO& fifo) {
+    const auto count = fifo.len();
+    if (count == 0)
+        return;
+
+    constexpr auto row_width = std::tuple_size<decltype(WaterfallRow::index)>::value;
+
+    // Scroll once for everything that piled up since the last frame. Rows are
+    // consumed oldest first, the newest one ends up at the top.
+    display.scroll(count);
+    for (size_t i = 0; i < count; i++) {
+        const auto row = fifo.peek();
+        const auto draw_y = display.scroll_area_y(count - 1 - i);
+
+        display.draw_pixels(
+            {{0, draw_y}, {row_width, 1}},
+            row->index.data(),
+            row_width,
+            spectrum_rgb3_lut.data());
+        fifo.drop();
+    }
+}
+
 void WaterfallWidget::clear() {
     display.fill_rectangle(
         screen_rect(),
@@ -317,7 +340,7 @@ void WaterfallView::on_hide() {
 
 void WaterfallView::start() {
     if (!running_) {
-        baseband::spectrum_streaming_start();
+        baseband::spectrum_streaming_start(/*waterfall_rows*/ true);
         running_ = true;
     }
 }
@@ -365,7 +388,9 @@ void WaterfallView::set_parent_rect(const Rect new_parent_rect) {
 }
 
 void WaterfallView::on_channel_spectrum(const ChannelSpectrum& spectrum) {
-    waterfall_widget.on_channel_spectrum(spectrum);
+    // With a row FIFO the baseband already sent this line pre-folded.
+    if (!row_fifo)
+        waterfall_widget.on_channel_spectrum(spectrum);
     sampling_rate = spectrum.sampling_rate;
     frequency_scale.set_spectrum_sampling_rate(sampling_rate);
     frequency_scale.set_channel_filter(
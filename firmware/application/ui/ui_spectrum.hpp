@@ -116,6 +116,9 @@ class WaterfallWidget : public Widget {
 
     void on_channel_spectrum(const ChannelSpectrum& spectrum);
 
+    /* Draws all pending rows with a single scroll, reading them in place. */
+    void on_waterfall_rows(WaterfallRowFIFO& fifo);
+
    private:
     void clear();
 };
@@ -153,6 +156,7 @@ class WaterfallView : public View {
     bool running_{false};
 
     ChannelSpectrumFIFO* channel_fifo{nullptr};
+    WaterfallRowFIFO* row_fifo{nullptr};
     AudioSpectrum* audio_spectrum_data{nullptr};
     bool audio_spectrum_update{false};
 
@@ -168,6 +172,7 @@ class WaterfallView : public View {
         [this](const Message* const p) {
             const auto message = *reinterpret_cast<const ChannelSpectrumConfigMessage*>(p);
             this->channel_fifo = message.fifo;
+            this->row_fifo = message.row_fifo;
         }};
     MessageHandlerRegistration message_handler_audio_spectrum{
         Message::ID::AudioSpectrum,
@@ -179,6 +184,9 @@ class WaterfallView : public View {
     MessageHandlerRegistration message_handler_frame_sync{
         Message::ID::DisplayFrameSync,
         [this](const Message* const) {
+            if (this->row_fifo) {
+                waterfall_widget.on_waterfall_rows(*row_fifo);
+            }
             if (this->channel_fifo) {
                 ChannelSpectrum channel_spectrum;
                 while (channel_fifo->out(channel_spectrum)) {
@@ -1,5 +1,6 @@
 #include "ui_external_items_menu_loader.hpp"
 
+#include "external_app_catalog.hpp"
 #include "sd_card.hpp"
 #include "file_path.hpp"
 #include "ui_standalone_view.hpp"
@@ -40,59 +41,17 @@ namespace ui {
     if (sd_card::status() != sd_card::Status::Mounted)
         return;
 
-    for (const auto& entry : std::filesystem::directory_iterator(apps_dir, u"*.ppma")) {
-        auto filePath = apps_dir / entry.path();
-        File app;
+    for (const auto& entry : load_external_app_catalog()) {
+        const auto& app = entry.record;
 
-        auto openError = app.open(filePath);
-        if (openError)
+        if (app.kind == external_app_kind::Application) {
+            if (app.header_version != CURRENT_HEADER_VERSION || VERSION_MD5 != app.app_version)
+                continue;
+        } else if (app.header_version > CURRENT_STANDALONE_APPLICATION_API_VERSION)
             continue;
 
-        application_information_t application_information = {};
-
-        auto readResult = app.read(&application_information, sizeof(application_information_t));
-        if (!readResult)
-            continue;
-
-        if (application_information.header_version != CURRENT_HEADER_VERSION)
-            continue;
-
-        bool versionMatches = VERSION_MD5 == application_information.app_version;
-
-        if (versionMatches) {
-            std::string appshortname = filePath.filename().string();
-            if (appshortname.size() >= 5 && appshortname.substr(appshortname.size() - 5) == ".ppma") {
-                // Remove the ".ppma" suffix
-                appshortname = appshortname.substr(0, appshortname.size() - 5);
-            }
-            AppInfoConsole appInfoConsole = {appshortname.c_str(), reinterpret_cast<char*>(&application_information.app_name[0]), application_information.menu_location};
-            callback(appInfoConsole);
-        }
-    }
-
-    for (const auto& entry : std::filesystem::directory_iterator(apps_dir, u"*.ppmp")) {
-        auto filePath = apps_dir / entry.path();
-        File app;
-
-        auto openError = app.open(filePath);
-        if (openError)
-            continue;
-
-        standalone_application_information_t application_information = {};
-
-        auto readResult = app.read(&application_information, sizeof(standalone_application_information_t));
-        if (!readResult)
-            continue;
-
-        if (application_information.header_version > CURRENT_STANDALONE_APPLICATION_API_VERSION)
-            continue;
-
-        std::string appshortname = filePath.filename().string();
-        if (appshortname.size() >= 5 && appshortname.substr(appshortname.size() - 5) == ".ppmp") {
-            // Remove the ".ppmp" suffix
-            appshortname = appshortname.substr(0, appshortname.size() - 5);
-        }
-        AppInfoConsole appInfoConsole = {appshortname.c_str(), reinterpret_cast<char*>(&application_information.app_name[0]), application_information.menu_location};
+        std::string appshortname = entry.call_name();
+        AppInfoConsole appInfoConsole = {appshortname.c_str(), reinterpret_cast<const char*>(&app.app_name[0]), app.menu_location};
         callback(appInfoConsole);
     }
 }
@@ -160,45 +119,45 @@ namespace ui {
     if (sd_card::status() != sd_card::Status::Mounted)
         return external_apps;
 
-    for (const auto& entry : std::filesystem::directory_iterator(apps_dir, u"*.ppma")) {
-        auto filePath = apps_dir / entry.path();
-        File app;
-
-        auto openError = app.open(filePath);
-        if (openError)
-            continue;
-
-        application_information_t application_information = {};
-
-        auto readResult = app.read(&application_information, sizeof(application_information_t));
-        if (!readResult)
-            continue;
+    for (const auto& entry : load_external_app_catalog()) {
+        const auto& app = entry.record;
 
-        if (application_information.menu_location != app_location)
+        if (app.menu_location != app_location)
             continue;
 
-        if (application_information.header_version != CURRENT_HEADER_VERSION)
+        if (app.kind == external_app_kind::Application) {
+            if (app.header_version != CURRENT_HEADER_VERSION)
+                continue;
+        } else if (app.header_version > CURRENT_STANDALONE_APPLICATION_API_VERSION)
             continue;
 
-        bool versionMatches = VERSION_MD5 == application_information.app_version;
+        bool versionMatches = app.kind == external_app_kind::Standalone || VERSION_MD5 == app.app_version;
+        auto filePath = entry.path;
 
         GridItemEx gridItem = {};
-        gridItem.text = reinterpret_cast<char*>(&application_information.app_name[0]);
+        gridItem.text = reinterpret_cast<const char*>(&app.app_name[0]);
+        gridItem.desired_position = app.desired_position;
 
         if (versionMatches) {
-            gridItem.color = Color((uint16_t)application_information.icon_color);
+            gridItem.color = Color((uint16_t)app.icon_color);
 
-            auto dyn_bmp = DynamicBitmap<16, 16>{application_information.bitmap_data};
+            auto dyn_bmp = DynamicBitmap<16, 16>{app.bitmap_data};
             gridItem.bitmap = dyn_bmp.bitmap();
             bitmaps.push_back(std::move(dyn_bmp));
 
-            gridItem.on_select = [&nav, app_location, filePath]() {
-                if (!run_external_app(nav, filePath)) {
-                    nav.display_modal("Error", "The .ppma file in your " + apps_dir.string() + "\nfolder can't be read. Please\nupdate your SD Card content.");
-                }
-            };
-
-            gridItem.desired_position = application_information.desired_menu_position;
+            if (app.kind == external_app_kind::Application) {
+                gridItem.on_select = [&nav, filePath]() {
+                    if (!run_external_app(nav, filePath)) {
+                        nav.display_modal("Error", "The .ppma file in your " + apps_dir.string() + "\nfolder can't be read. Please\nupdate your SD Card content.");
+                    }
+                };
+            } else {
+                gridItem.on_select = [&nav, filePath]() {
+                    if (!run_standalone_app(nav, filePath)) {
+                        nav.display_modal("Error", "The .ppmp file in your " + apps_dir.string() + "\nfolder can't be read. Please\nupdate your SD Card content.");
+                    }
+                };
+            }
         } else {
             gridItem.color = Theme::getInstance()->fg_light->foreground;
 
@@ -207,53 +166,11 @@ namespace ui {
             gridItem.on_select = [&nav]() {
                 nav.display_modal("Error", "The .ppma file in your " + apps_dir.string() + "\nfolder is outdated. Please\nupdate your SD Card content.");
             };
-
-            gridItem.desired_position = application_information.desired_menu_position;
         }
 
         external_apps.push_back(gridItem);
     }
 
-    for (const auto& entry : std::filesystem::directory_iterator(apps_dir, u"*.ppmp")) {
-        auto filePath = apps_dir / entry.path();
-        File app;
-
-        auto openError = app.open(filePath);
-        if (openError)
-            continue;
-
-        standalone_application_information_t application_information = {};
-
-        auto readResult = app.read(&application_information, sizeof(standalone_application_information_t));
-        if (!readResult)
-            continue;
-
-        if (application_information.menu_location != app_location)
-            continue;
-
-        if (application_information.header_version > CURRENT_STANDALONE_APPLICATION_API_VERSION)
-            continue;
-
-        GridItemEx gridItem = {};
-        gridItem.text = reinterpret_cast<char*>(&application_information.app_name[0]);
-
-        gridItem.color = Color((uint16_t)application_information.icon_color);
-
-        auto dyn_bmp = DynamicBitmap<16, 16>{application_information.bitmap_data};
-        gridItem.bitmap = dyn_bmp.bitmap();
-        bitmaps.push_back(std::move(dyn_bmp));
-
-        gridItem.on_select = [&nav, app_location, filePath]() {
-            if (!run_standalone_app(nav, filePath)) {
-                nav.display_modal("Error", "The .ppmp file in your " + apps_dir.string() + "\nfolder can't be read. Please\nupdate your SD Card content.");
-            }
-        };
-
-        gridItem.desired_position = -1;  // No desired position support for standalone apps yet
-
-        external_apps.push_back(gridItem);
-    }
-
     return external_apps;
 }
 
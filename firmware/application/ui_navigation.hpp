@@ -385,6 +385,7 @@ class SystemMenuView : public BtnGridView {
 
    private:
     NavigationView& nav_;
+    bool external_items_deferred{false};
     void on_populate() override;
     void hackrf_mode(NavigationView& nav);
 };
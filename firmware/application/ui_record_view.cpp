@@ -215,6 +215,7 @@ void RecordView::start() {
     }
 
     std::unique_ptr<stream::Writer> writer;
+    std::filesystem::path metadata_path;
     switch (file_type) {
         case FileType::WAV: {
             auto p = std::make_unique<WAVFileWriter>();
@@ -231,8 +232,9 @@ void RecordView::start() {
 
         case FileType::RawS8:
         case FileType::RawS16: {
+            metadata_path = get_metadata_path(base_path);
             const auto metadata_file_error = write_metadata_file(
-                get_metadata_path(base_path), {receiver_model.target_frequency(), sampling_rate, latitude, longitude, satinuse});
+                metadata_path, {receiver_model.target_frequency(), sampling_rate, latitude, longitude, satinuse});
             if (metadata_file_error.is_valid()) {
                 handle_error(metadata_file_error.value());
                 return;
@@ -265,7 +267,8 @@ void RecordView::start() {
             [](File::Error error) {
                 CaptureThreadDoneMessage message{error.code()};
                 EventDispatcher::send_message(message);
-            });
+            },
+            metadata_path);
     }
 
     update_status_display();
@@ -292,7 +295,7 @@ void RecordView::on_tick_second() {
 
 void RecordView::update_status_display() {
     if (is_active()) {
-        const auto dropped_percent = std::min(99U, capture_thread->state().dropped_percent());
+        const auto dropped_percent = std::min<uint32_t>(99U, capture_thread->state().dropped_percent());
         const auto s = to_string_dec_uint(dropped_percent, 2, ' ') + "%";
         text_record_dropped.set(s);
     }
@@ -342,7 +345,8 @@ void RecordView::trim_capture() {
             auto trim_range = iq::compute_trim_range(*info, power_buckets, 7);
 
             trim_ui.show_trimming();
-            iq::trim_capture_with_range(trim_path, trim_range, trim_ui.get_callback(), 1);
+            if (iq::trim_capture_with_range(trim_path, trim_range, trim_ui.get_callback(), 1))
+                append_metadata_trim(get_metadata_path(trim_path), trim_range.start_sample);
         }
 
         trim_ui.clear();
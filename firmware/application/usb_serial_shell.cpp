@@ -36,6 +36,8 @@
 #include "crc.hpp"
 #include "hackrf_cpld_data.hpp"
 #include "performance_counter.hpp"
+#include "boot.hpp"
+#include "memory_stats.hpp"
 
 #include "usb_serial_device_to_host.h"
 #include "i2c_device_to_host.h"
@@ -1168,6 +1170,7 @@ static void cmd_sysinfo(BaseSequentialStream* chp, int argc, char* argv[]) {
         return;
     }
     auto utilisation = get_cpu_utilisation_in_percent();
+    const auto& image_switch = baseband::last_image_switch();
     std::string info =
         "M0 heap: " + to_string_dec_uint(chCoreStatus()) + "\r\n" +
         "M0 stack: " + to_string_dec_uint((uint32_t)get_free_stack_space()) + "\r\n" +
@@ -1176,12 +1179,77 @@ static void cmd_sysinfo(BaseSequentialStream* chp, int argc, char* argv[]) {
         "M4 stack: " + to_string_dec_uint(shared_memory.m4_stack_usage) + "\r\n" +
         "M0 cpu%: " + to_string_dec_uint(shared_memory.m4_performance_counter) + "\r\n" +
         "M4 miss: " + to_string_dec_uint(shared_memory.m4_buffer_missed) + "\r\n" +
+        "M4 image load ms: " + to_string_dec_uint(image_switch.load_ms) + (image_switch.reused ? " (reused)" : "") + "\r\n" +
+        "M4 image ready ms: " + to_string_dec_uint(image_switch.ready_ms) + "\r\n" +
+        "M4 images reused: " + to_string_dec_uint(image_switch.reused_count) + "/" + to_string_dec_uint(image_switch.count) + "\r\n" +
         "uptime: " + to_string_dec_uint(chTimeNow() / 1000) + "\r\n";
 
     fillOBuffer(&((SerialUSBDriver*)chp)->oqueue, (const uint8_t*)info.c_str(), info.length());
     return;
 }
 
+static void cmd_boottime(BaseSequentialStream* chp, int argc, char* argv[]) {
+    const char* usage = "usage: boottime\r\n";
+    (void)argv;
+    if (argc > 0) {
+        chprintf(chp, usage);
+        return;
+    }
+
+    systime_t last = 0;
+    for (size_t i = 0; i < boot::trace_count(); i++) {
+        const auto& entry = boot::trace_entry(i);
+        chprintf(chp, "%6lu ms  +%5lu  %s\r\n",
+                 (unsigned long)(entry.time * 1000 / CH_FREQUENCY),
+                 (unsigned long)((entry.time - last) * 1000 / CH_FREQUENCY),
+                 entry.phase);
+        last = entry.time;
+    }
+}
+
+static void print_memory_stats(BaseSequentialStream* chp, const char* core, const memory_stats::Snapshot& stats) {
+    chprintf(chp, "%s heap %lu: core free %lu, low %lu, freed %lu in %u, largest %lu\r\n", core,
+             (unsigned long)stats.heap_size, (unsigned long)stats.core_free, (unsigned long)stats.core_low,
+             (unsigned long)stats.heap_free, stats.fragments, (unsigned long)stats.largest_free);
+
+    for (size_t i = 0; i < memory_stats::tag_count; i++) {
+        const auto& usage = stats.tags[i];
+        if (usage.peak == 0)
+            continue;
+
+        chprintf(chp, "  %-10s %6lu  peak %6lu\r\n", memory_stats::tag_name(static_cast<memory_stats::Tag>(i)),
+                 (unsigned long)usage.bytes, (unsigned long)usage.peak);
+    }
+
+    for (size_t i = 0; i < stats.stack_count; i++)
+        chprintf(chp, "  stack %-11s free %lu\r\n", stats.stacks[i].name, (unsigned long)stats.stacks[i].free);
+}
+
+static void cmd_memstats(BaseSequentialStream* chp, int argc, char* argv[]) {
+    const char* usage = "usage: memstats [reset]\r\n";
+    const bool reset = argc == 1 && strcmp(argv[0], "reset") == 0;
+    if (argc > 1 || (argc == 1 && !reset)) {
+        chprintf(chp, usage);
+        return;
+    }
+
+    if (reset) {
+        memory_stats::reset_peaks();
+        if (baseband::request_memory_stats(500, true))
+            chprintf(chp, "ok\r\n");
+        else
+            chprintf(chp, "ok, M0 only: M4 not responding\r\n");
+        return;
+    }
+
+    print_memory_stats(chp, "M0", memory_stats::snapshot());
+
+    if (baseband::request_memory_stats())
+        print_memory_stats(chp, "M4", shared_memory.m4_memory);
+    else
+        chprintf(chp, "M4 not responding\r\n");
+}
+
 static void cmd_radioinfo(BaseSequentialStream* chp, int argc, char* argv[]) {
     const char* usage = "usage: radioinfo\r\n";
     (void)argv;
@@ -1398,6 +1466,8 @@ static const ShellCommand commands[] = {
     {"gotenv", cmd_gotenv},
     {"gotlight", cmd_gotlight},
     {"sysinfo", cmd_sysinfo},
+    {"boottime", cmd_boottime},
+    {"memstats", cmd_memstats},
     {"radioinfo", cmd_radioinfo},
     {"pmemreset", cmd_pmemreset},
     {"settingsreset", cmd_settingsreset},
@@ -21,6 +21,7 @@
 
 #include "usb_serial_thread.hpp"
 #include "buffer_exchange.hpp"
+#include "memory_stats.hpp"
 
 // UsbSerialThread //////////////////////////////////////////////////////////
 
@@ -45,6 +46,9 @@ void UsbSerialThread::stop() {
 }
 
 msg_t UsbSerialThread::static_fn(void* arg) {
+    chRegSetThreadName("usb");
+    memory_stats::set_thread_tag(memory_stats::Tag::Shell);
+
     auto obj = static_cast<UsbSerialThread*>(arg);
     obj->run();
     return 0;
@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __AIS_FRAMER_H__
+#define __AIS_FRAMER_H__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "baseband_packet.hpp"
+#include "bit_pattern.hpp"
+#include "crc.hpp"
+
+/* HDLC framing for AIS with soft decision repair. Takes NRZI decoded
+ * bits, each with the magnitude of the symbol that completed it. Frames
+ * that fail the FCS get their least confident symbols flipped, a few at
+ * a time, until the FCS matches. Only frames with a good FCS are handed
+ * on. The packet keeps the end flag bits, like PacketBuilder. */
+class AISFramer {
+   public:
+    using PacketHandler = std::function<void(const baseband::Packet& packet)>;
+
+    /* Weakest symbols that are tried, every combination is checked. */
+    static constexpr size_t max_flips = 4;
+
+    /* Symbols weaker than this fraction of the frame average qualify. */
+    static constexpr float flip_threshold = 0.5f;
+
+    AISFramer(PacketHandler payload_handler)
+        : payload_handler{std::move(payload_handler)} {
+    }
+
+    /* Position of the next bit, stamped on the frame it completes. */
+    void set_sample_index(const uint64_t value) {
+        sample_index = value;
+    }
+
+    void execute(const uint_fast8_t bit, const float confidence) {
+        bit_history.add(bit);
+
+        if (!in_frame) {
+            if (preamble(bit_history, 0))
+                start_frame();
+            return;
+        }
+
+        // A 0 after five 1s is stuffing, and also ends the flag.
+        const bool kept = !unstuff(bit_history, 0);
+        if (kept) {
+            // A symbol error flips the bit it ends and the next one.
+            if (last_kept && packet.size() > 0)
+                add_candidate(packet.size() - 1, last_confidence);
+
+            packet.add(bit);
+            confidence_sum += confidence;
+        }
+        last_kept = kept;
+        last_confidence = confidence;
+
+        if (end(bit_history, 0)) {
+            end_frame();
+        } else if (packet.size() >= packet.capacity()) {
+            in_frame = false;
+        }
+    }
+
+    /* Checks the FCS of a received frame, trailing flag bits included. */
+    static bool fcs_ok(const baseband::Packet& packet) {
+        return syndrome(packet) == 0;
+    }
+
+   private:
+    struct Candidate {
+        uint16_t index;  // First of the two bits the symbol flips.
+        float confidence;
+    };
+
+    // Weakest first. Extra room since the flag bits get dropped at the end.
+    static constexpr size_t max_candidates = max_flips + 8;
+
+    static constexpr size_t fcs_length = 16;
+    static constexpr size_t flag_length = 7;  // Kept bits of the end flag.
+
+    const PacketHandler payload_handler;
+    const BitPattern preamble{0b0101010101111110, 16, 1};
+    const BitPattern unstuff{0b111110, 6};
+    const BitPattern end{0b01111110, 8};
+
+    BitHistory bit_history{};
+    baseband::Packet packet{};
+    bool in_frame{false};
+    bool last_kept{false};
+    float last_confidence{0.0f};
+    float confidence_sum{0.0f};
+
+    std::array<Candidate, max_candidates> candidates{};
+    size_t candidate_count{0};
+    uint64_t sample_index{0};
+
+    void start_frame() {
+        packet.clear();
+        in_frame = true;
+        last_kept = false;
+        confidence_sum = 0.0f;
+        candidate_count = 0;
+    }
+
+    void add_candidate(const size_t index, const float confidence) {
+        size_t i = candidate_count;
+        if (i == max_candidates) {
+            if (confidence >= candidates[i - 1].confidence)
+                return;
+            i--;
+        } else {
+            candidate_count++;
+        }
+
+        for (; i > 0 && candidates[i - 1].confidence > confidence; i--)
+            candidates[i] = candidates[i - 1];
+
+        candidates[i] = {static_cast<uint16_t>(index), confidence};
+    }
+
+    static size_t frame_length(const baseband::Packet& packet) {
+        return packet.size() > flag_length ? packet.size() - flag_length : 0;
+    }
+
+    /* FCS computed over the data XOR the FCS received, 0 if they match.
+     * Bits go in in air order, like ais::Packet::crc_ok. */
+    static uint16_t syndrome(const baseband::Packet& packet) {
+        const auto length = frame_length(packet);
+        if (length <= fcs_length || (length & 7) != 0)
+            return 0xFFFF;
+
+        CRC<16> fcs{0x1021, 0xffff, 0xffff};
+        const auto data_length = length - fcs_length;
+        for (size_t i = 0; i < data_length; i++)
+            fcs.process_bit(packet[i]);
+
+        uint16_t received = 0;
+        for (size_t i = data_length; i < length; i++)
+            received = (received << 1) | packet[i];
+
+        return fcs.checksum() ^ received;
+    }
+
+    /* How flipping one bit changes the syndrome. The CRC is linear, a
+     * data bit contributes a 1 shifted through the rest of the data. */
+    static uint16_t bit_effect(const size_t index, const size_t data_length) {
+        if (index >= data_length)
+            return 1U << (fcs_length - 1 - (index - data_length));
+
+        CRC<16> fcs{0x1021};
+        fcs.process_bit(1);
+        for (size_t i = index + 1; i < data_length; i++)
+            fcs.process_bit(0);
+        return fcs.checksum();
+    }
+
+    bool repair() {
+        const auto length = frame_length(packet);
+        const auto data_length = length - fcs_length;
+        const auto threshold = flip_threshold * confidence_sum / packet.size();
+
+        std::array<uint16_t, max_flips> index{};
+        std::array<uint16_t, max_flips> effect{};
+        size_t count = 0;
+
+        for (size_t i = 0; i < candidate_count && count < max_flips; i++) {
+            const auto& candidate = candidates[i];
+            if (candidate.index + 1 >= length || candidate.confidence >= threshold)
+                continue;
+
+            index[count] = candidate.index;
+            effect[count] = bit_effect(candidate.index, data_length) ^
+                            bit_effect(candidate.index + 1, data_length);
+            count++;
+        }
+
+        const auto target = syndrome(packet);
+        for (uint32_t set = 1; set < (1U << count); set++) {
+            uint16_t combined = 0;
+            for (size_t i = 0; i < count; i++) {
+                if (set & (1U << i))
+                    combined ^= effect[i];
+            }
+
+            if (combined != target)
+                continue;
+
+            for (size_t i = 0; i < count; i++) {
+                if (set & (1U << i)) {
+                    packet.flip(index[i]);
+                    packet.flip(index[i] + 1);
+                }
+            }
+            return true;
+        }
+
+        return false;
+    }
+
+    void end_frame() {
+        in_frame = false;
+
+        const auto length = frame_length(packet);
+        if (length <= fcs_length || (length & 7) != 0)
+            return;
+
+        if (syndrome(packet) == 0 || repair()) {
+            // NOTE: Avoids the std::function nullptr check, see PacketBuilder.
+            if (payload_handler) {
+                packet.set_sample_index(sample_index);
+                payload_handler(packet);
+            }
+        }
+    }
+};
+
+#endif /*__AIS_FRAMER_H__*/
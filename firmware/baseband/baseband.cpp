@@ -23,6 +23,7 @@
 
 #include "lpc43xx_cpp.hpp"
 
+#include "memory_stats.hpp"
 #include "portapack_shared_memory.hpp"
 #include "portapack_dma.hpp"
 
@@ -58,6 +59,8 @@ void __late_init(void) {
      * require the heap.
      */
     chSysInit();
+    chRegSetThreadName("main");
+    memory_stats::set_thread_tag(memory_stats::Tag::Processor);
 
     /* Baseband initialization */
     init();
@@ -77,7 +80,7 @@ void _default_exit(void) {
     ShutdownMessage shutdown_message;
     shared_memory.application_queue.push(shutdown_message);
 
-    shared_memory.baseband_message = nullptr;
+    shared_memory.baseband_queue.flush();
 
     halt();
 }
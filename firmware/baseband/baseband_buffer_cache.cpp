@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "baseband_buffer_cache.hpp"
+
+#include <ch.h>
+
+namespace baseband {
+namespace buffer_cache {
+
+void* allocate(const size_t size, const memory_stats::Tag tag) {
+    memory_stats::TagScope scope{tag};
+    return ::operator new(size);
+}
+
+void* acquire(Slot& slot, const size_t size) {
+    if (size > slot.capacity) {
+        // Free first, the heap can then reuse the old block's space.
+        release(slot);
+        slot.data = allocate(size, slot.tag);
+        slot.capacity = size;
+    }
+
+    return slot.data;
+}
+
+void release(Slot& slot) {
+    ::operator delete(slot.data);
+    slot.data = nullptr;
+    slot.capacity = 0;
+}
+
+SlotBuffer::SlotBuffer(Slot& slot, const size_t size) {
+    if (slot.busy) {
+        memory_stats::TagScope tag{memory_stats::Tag::Stream};
+        fallback_ = std::make_unique<uint8_t[]>(size);
+        data_ = fallback_.get();
+    } else {
+        slot.busy = true;
+        slot_ = &slot;
+        data_ = static_cast<uint8_t*>(acquire(slot, size));
+    }
+}
+
+SlotBuffer::~SlotBuffer() {
+    if (slot_)
+        slot_->busy = false;
+}
+
+} /* namespace buffer_cache */
+} /* namespace baseband */
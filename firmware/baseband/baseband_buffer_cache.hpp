@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __BASEBAND_BUFFER_CACHE_H__
+#define __BASEBAND_BUFFER_CACHE_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "memory_stats.hpp"
+
+/* Long-lived baseband buffers are cached in slots. The blocks come from the
+ * heap, charged to the slot's tag. Each owner reuses its slot's block on
+ * every restart or reconfiguration and only replaces it with a larger one,
+ * so RAM use is fixed by the largest request per slot and the heap doesn't
+ * churn as captures start and filters change. This is not a static arena:
+ * stream and decimator sizes arrive from the M0 at run time, so there is
+ * no build-time layout to size one from. */
+namespace baseband {
+namespace buffer_cache {
+
+struct Slot {
+    memory_stats::Tag tag;  // Charged for the block in memstats.
+    void* data{nullptr};
+    size_t capacity{0};
+    bool busy{false};
+};
+
+/* Allocates size bytes charged to tag, panics when RAM runs out. */
+void* allocate(const size_t size, const memory_stats::Tag tag);
+
+/* Returns the slot's storage for size bytes. A block that is too small is
+ * freed and replaced, its contents are not kept. */
+void* acquire(Slot& slot, const size_t size);
+
+/* Frees the slot's block, for owners that don't live as long as the image. */
+void release(Slot& slot);
+
+template <typename T>
+T* acquire(Slot& slot, const size_t count) {
+    return static_cast<T*>(acquire(slot, count * sizeof(T)));
+}
+
+/* Buffer held in a slot for the buffer's lifetime. While the slot is
+ * taken, e.g. a new stream is built before the old one is released,
+ * the buffer falls back to the heap. */
+class SlotBuffer {
+   public:
+    SlotBuffer(Slot& slot, const size_t size);
+    ~SlotBuffer();
+
+    SlotBuffer(const SlotBuffer&) = delete;
+    SlotBuffer& operator=(const SlotBuffer&) = delete;
+
+    uint8_t* data() const { return data_; }
+
+   private:
+    Slot* slot_{nullptr};
+    std::unique_ptr<uint8_t[]> fallback_{};
+    uint8_t* data_{nullptr};
+};
+
+} /* namespace buffer_cache */
+} /* namespace baseband */
+
+#endif /*__BASEBAND_BUFFER_CACHE_H__*/
@@ -28,31 +28,25 @@
 
 #include "hal.h"
 #include "gpdma.hpp"
+#include "gpdma_lli.hpp"
 
 using namespace lpc43xx;
 
 #include "portapack_dma.hpp"
 
+#include "ring_cursor.hpp"
 #include "thread_wait.hpp"
+#include "utility.hpp"
 
 namespace baseband {
 namespace dma {
 
 constexpr uint32_t gpdma_ahb_master_sgpio = 0;
 constexpr uint32_t gpdma_ahb_master_memory = 1;
-constexpr uint32_t gpdma_ahb_master_lli_fetch = 0;
 
 constexpr uint32_t gpdma_src_peripheral = 0x0;
 constexpr uint32_t gpdma_dest_peripheral = 0x0;
 
-constexpr gpdma::channel::LLIPointer lli_pointer(const void* lli) {
-    return {
-        .lm = gpdma_ahb_master_lli_fetch,
-        .r = 0,
-        .lli = reinterpret_cast<uint32_t>(lli),
-    };
-}
-
 constexpr gpdma::channel::Control control(const baseband::Direction direction, const size_t buffer_words) {
     return {
         .transfersize = buffer_words,
@@ -87,30 +81,18 @@ constexpr gpdma::channel::Config config(const baseband::Direction direction) {
     };
 }
 
-constexpr size_t buffer_samples_log2n = 13;
-constexpr size_t buffer_samples = (1 << buffer_samples_log2n);
-constexpr size_t transfers_per_buffer_log2n = 2;
-constexpr size_t transfers_per_buffer = (1 << transfers_per_buffer_log2n);
-constexpr size_t transfer_samples = buffer_samples / transfers_per_buffer;
-constexpr size_t transfers_mask = transfers_per_buffer - 1;
-
-constexpr size_t buffer_bytes = buffer_samples * sizeof(baseband::sample_t);
-constexpr size_t transfer_bytes = transfer_samples * sizeof(baseband::sample_t);
-
-constexpr size_t msg_count = transfers_per_buffer - 1;
-
-static std::array<gpdma::channel::LLI, transfers_per_buffer> lli_loop;
+static gpdma::lli::Ring<max_ring_length> ring;
+static RingCursor cursor;
+static std::array<Timestamp, max_ring_length> completed_at;
+static size_t block_samples = 0;
 static constexpr auto& gpdma_channel_sgpio = gpdma::channels[portapack::sgpio_gpdma_channel_number];
 
 static ThreadWait thread_wait;
 
-volatile uint32_t buffer_transfered = 0;
-volatile uint32_t buffer_handled = 0;
-
 static void transfer_complete() {
-    const auto next_lli_index = gpdma_channel_sgpio.next_lli() - &lli_loop[0];
-    buffer_transfered++;
-    thread_wait.wake_from_interrupt(next_lli_index);
+    completed_at[cursor.active_index()] = Timestamp::now();
+    cursor.complete();
+    thread_wait.wake_from_interrupt(0);
 }
 
 static void dma_error() {
@@ -134,21 +116,24 @@ void init() {
 
 void configure(
     baseband::sample_t* const buffer_base,
-    const baseband::Direction direction) {
+    const baseband::Direction direction,
+    const RingConfig& ring_config) {
     const auto peripheral = reinterpret_cast<uint32_t>(&LPC_SGPIO->REG_SS[0]);
-    const auto control_value = control(direction, gpdma::buffer_words(transfer_bytes, 4));
-    for (size_t i = 0; i < lli_loop.size(); i++) {
-        const auto memory = reinterpret_cast<uint32_t>(&buffer_base[i * transfer_samples]);
-        lli_loop[i].srcaddr = (direction == Direction::Transmit) ? memory : peripheral;
-        lli_loop[i].destaddr = (direction == Direction::Transmit) ? peripheral : memory;
-        lli_loop[i].lli = lli_pointer(&lli_loop[(i + 1) % lli_loop.size()]);
-        lli_loop[i].control = control_value;
-    }
+    const auto block_bytes = ring_config.block_samples * sizeof(baseband::sample_t);
+    const auto control_value = control(direction, gpdma::buffer_words(block_bytes, 4));
+
+    ring.configure(
+        peripheral, buffer_base,
+        clip(ring_config.length, min_ring_length, max_ring_length),
+        block_bytes, control_value,
+        direction == Direction::Transmit);
+    cursor.reset(ring.size());
+    block_samples = ring_config.block_samples;
 }
 
 void enable(const baseband::Direction direction) {
     const auto gpdma_config = config(direction);
-    gpdma_channel_sgpio.configure(lli_loop[0], gpdma_config);
+    gpdma_channel_sgpio.configure(ring.front(), gpdma_config);
     gpdma_channel_sgpio.enable();
 }
 
@@ -160,22 +145,25 @@ void disable() {
     gpdma_channel_sgpio.disable();
 }
 
-baseband::buffer_t wait_for_buffer() {
-    const auto next_index = thread_wait.sleep();
-    buffer_handled++;
-
-    auto buffer_missed = buffer_transfered - buffer_handled;
-    shared_memory.m4_buffer_missed = buffer_missed;
+Block wait_for_buffer() {
+    // Blocks that completed while the last one was handled are taken
+    // without sleeping, the check is locked against the interrupt.
+    chSysLock();
+    const auto result = cursor.pending() ? 0 : thread_wait.sleepS();
+    chSysUnlock();
 
-    if (next_index >= 0) {
-        const size_t free_index = (next_index + transfers_per_buffer - 2) & transfers_mask;
-        const auto src = lli_loop[free_index].srcaddr;
-        const auto dst = lli_loop[free_index].destaddr;
-        const auto p = (src == reinterpret_cast<uint32_t>(&LPC_SGPIO->REG_SS[0])) ? dst : src;
-        return {reinterpret_cast<sample_t*>(p), transfer_samples};
-    } else {
+    if (result < 0)
         return {};
-    }
+
+    const auto block = cursor.take();
+    shared_memory.m4_buffer_missed = cursor.lost_total();
+
+    return {
+        {reinterpret_cast<sample_t*>(ring.block(block.index)), block_samples},
+        block.sequence * block_samples,
+        block.lost * block_samples,
+        completed_at[block.index],
+    };
 }
 
 } /* namespace dma */
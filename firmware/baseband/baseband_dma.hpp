@@ -23,6 +23,7 @@
 #define __BASEBAND_DMA_H__
 
 #include <cstddef>
+#include <cstdint>
 #include <array>
 
 #include "complex.hpp"
@@ -31,17 +32,36 @@
 namespace baseband {
 namespace dma {
 
+constexpr size_t min_ring_length = 3;
+constexpr size_t max_ring_length = 8;
+
+/* Layout of the sample buffer, which must hold length * block_samples. */
+struct RingConfig {
+    size_t length;         // Blocks in the ring, deeper absorbs more jitter.
+    size_t block_samples;  // Samples per block, as handed to the processor.
+};
+
+constexpr RingConfig default_ring{4, 2048};
+
+struct Block {
+    baseband::buffer_t buffer;
+    uint64_t sample_index;  // Of the first sample, counted from configure().
+    size_t samples_lost;    // Dropped just before this block by an overrun.
+    Timestamp completed;    // RTC when the last sample arrived.
+};
+
 void init();
 void configure(
     baseband::sample_t* const buffer_base,
-    const baseband::Direction direction);
+    const baseband::Direction direction,
+    const RingConfig& ring_config = default_ring);
 
 void enable(const baseband::Direction direction);
 bool is_enabled();
 
 void disable();
 
-baseband::buffer_t wait_for_buffer();
+Block wait_for_buffer();
 
 } /* namespace dma */
 } /* namespace baseband */
@@ -36,6 +36,11 @@ class BasebandProcessor {
 
     virtual void on_message(const Message* const){};
 
+    /* Called before execute() when the processor fell behind and samples
+     * were dropped. sample_index is the first one lost, counted from the
+     * start of streaming, so decoders can resync and captures mark gaps. */
+    virtual void on_overrun(const uint64_t /*sample_index*/, const size_t /*samples_lost*/){};
+
    protected:
     void feed_channel_stats(const buffer_c16_t& channel);
 
@@ -24,6 +24,7 @@
 #include "dsp_types.hpp"
 
 #include "baseband.hpp"
+#include "baseband_buffer_cache.hpp"
 #include "baseband_sgpio.hpp"
 #include "baseband_dma.hpp"
 
@@ -31,6 +32,7 @@
 #include "i2s.hpp"
 using namespace lpc43xx;
 
+#include "memory_stats.hpp"
 #include "portapack_shared_memory.hpp"
 
 #include "utility.hpp"
@@ -38,6 +40,7 @@ using namespace lpc43xx;
 #include <array>
 
 static baseband::SGPIO baseband_sgpio;
+static baseband::buffer_cache::Slot baseband_buffer_slot{memory_stats::Tag::Stream};
 
 WORKING_AREA(baseband_thread_wa, 4096);
 
@@ -76,13 +79,21 @@ void BasebandThread::set_sampling_rate(uint32_t new_sampling_rate) {
     sampling_rate_ = new_sampling_rate;
 }
 
+void BasebandThread::set_ring(const baseband::dma::RingConfig& ring) {
+    ring_ = ring;
+    ring_.length = clip(ring_.length, baseband::dma::min_ring_length, baseband::dma::max_ring_length);
+}
+
 void BasebandThread::run() {
+    chRegSetThreadName("baseband");
+    memory_stats::set_thread_tag(memory_stats::Tag::Stream);
+
     baseband_sgpio.init();
     baseband::dma::init();
 
-    const auto baseband_buffer = std::make_unique<std::array<baseband::sample_t, 8192>>();
-    baseband::dma::configure(baseband_buffer->data(), direction());
-    // baseband::dma::allocate(4, 2048);
+    const auto baseband_buffer = baseband::buffer_cache::acquire<baseband::sample_t>(
+        baseband_buffer_slot, ring_.length * ring_.block_samples);
+    baseband::dma::configure(baseband_buffer, direction(), ring_);
 
     baseband_sgpio.configure(direction());
     baseband::dma::enable(direction());
@@ -90,10 +101,17 @@ void BasebandThread::run() {
 
     while (!chThdShouldTerminate()) {
         // TODO: Place correct sampling rate into buffer returned here:
-        const auto buffer_tmp = baseband::dma::wait_for_buffer();
+        const auto block = baseband::dma::wait_for_buffer();
+        const auto& buffer_tmp = block.buffer;
         if (buffer_tmp) {
+            if (block.samples_lost && baseband_processor_) {
+                baseband_processor_->on_overrun(
+                    block.sample_index - block.samples_lost, block.samples_lost);
+            }
+
             buffer_c8_t buffer{
-                buffer_tmp.p, buffer_tmp.count, sampling_rate_};
+                buffer_tmp.p, buffer_tmp.count, sampling_rate_,
+                block.completed, block.sample_index};
 
             if (shared_memory.request_m4_performance_counter == 0x02) {
                 uint8_t max = shared_memory.m4_performance_counter;
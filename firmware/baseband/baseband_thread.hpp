@@ -25,6 +25,7 @@
 #include "thread_base.hpp"
 #include "message.hpp"
 #include "baseband_processor.hpp"
+#include "baseband_dma.hpp"
 
 #include <ch.h>
 
@@ -59,12 +60,16 @@ class BasebandThread : public ThreadBase {
 
     void set_sampling_rate(uint32_t new_sampling_rate);
 
+    /* Sets the DMA ring layout, only before start(). */
+    void set_ring(const baseband::dma::RingConfig& ring);
+
    private:
     static Thread* thread;
 
     BasebandProcessor* baseband_processor_;
     baseband::Direction direction_;
     uint32_t sampling_rate_;
+    baseband::dma::RingConfig ring_{baseband::dma::default_ring};
     const tprio_t priority_;
 
     void run() override;
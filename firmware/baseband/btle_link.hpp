@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __BTLE_LINK_H__
+#define __BTLE_LINK_H__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/* Bluetooth LE link layer helpers. Bytes go over the air LSB first, so
+ * both the whitening and the CRC are bit reflected and a little-endian
+ * word holds four bytes in air order. */
+namespace btle {
+
+constexpr uint32_t advertising_access_address = 0x8E89BED6;
+constexpr uint32_t advertising_crc_init = 0x555555;
+
+/* Largest PDU: 2 byte header, 255 byte payload, 3 byte CRC. */
+constexpr size_t max_pdu_size = 2 + 255 + 3;
+
+/* Whitening ******************************************************/
+
+/* Whitening stream for a channel, LFSR x^7 + x^4 + 1 seeded with the
+ * channel index. Words are XORed with the PDU in place. */
+class Whitening {
+   public:
+    static constexpr size_t word_count = (max_pdu_size + 3) / 4;
+
+    void configure(const uint8_t channel) {
+        // The 7 bit register sits in the top bits, position 0 always set.
+        uint8_t lfsr = reverse_bits(channel) | 0x02;
+
+        std::array<uint8_t, word_count * 4> bytes{};
+        for (auto& byte : bytes) {
+            for (uint8_t mask = 1; mask != 0; mask <<= 1) {
+                if (lfsr & 0x80) {
+                    lfsr ^= 0x11;
+                    byte |= mask;
+                }
+                lfsr <<= 1;
+            }
+        }
+
+        std::memcpy(words_.data(), bytes.data(), bytes.size());
+    }
+
+    /* XORs size bytes of data with the stream, starting at offset
+     * bytes into it. offset must be a multiple of 4. */
+    void apply(uint8_t* const data, const size_t size, const size_t offset = 0) const {
+        const uint32_t* stream = &words_[offset / 4];
+        size_t i = 0;
+
+        for (; i + 4 <= size; i += 4) {
+            uint32_t word;
+            std::memcpy(&word, data + i, 4);
+            word ^= *stream++;
+            std::memcpy(data + i, &word, 4);
+        }
+
+        const uint32_t last = *stream;
+        for (size_t shift = 0; i < size; i++, shift += 8)
+            data[i] ^= last >> shift;
+    }
+
+   private:
+    static constexpr uint8_t reverse_bits(uint8_t v) {
+        v = (v & 0xF0) >> 4 | (v & 0x0F) << 4;
+        v = (v & 0xCC) >> 2 | (v & 0x33) << 2;
+        v = (v & 0xAA) >> 1 | (v & 0x55) << 1;
+        return v;
+    }
+
+    std::array<uint32_t, word_count> words_{};
+};
+
+/* CRC-24 *********************************************************/
+
+/* x^24 + x^10 + x^9 + x^6 + x^4 + x^3 + x + 1, bit reflected. */
+constexpr uint32_t crc_polynomial = 0xDA6000;
+
+using CRCTables = std::array<std::array<uint32_t, 256>, 4>;
+
+/* Slice-by-4 tables: tables[k][b] is the CRC of byte b followed by k zero bytes. */
+constexpr CRCTables make_crc_tables() {
+    CRCTables tables{};
+    for (uint32_t b = 0; b < 256; b++) {
+        uint32_t crc = b;
+        for (int bit = 0; bit < 8; bit++)
+            crc = (crc & 1) ? (crc >> 1) ^ crc_polynomial : crc >> 1;
+        tables[0][b] = crc;
+    }
+
+    for (size_t k = 1; k < 4; k++) {
+        for (uint32_t b = 0; b < 256; b++) {
+            const auto prev = tables[k - 1][b];
+            tables[k][b] = (prev >> 8) ^ tables[0][prev & 0xFF];
+        }
+    }
+    return tables;
+}
+
+/* Converts a CRC init as written in the spec to the register order used
+ * here by reversing the bits of each byte. */
+constexpr uint32_t reflect_crc_init(const uint32_t init) {
+    uint32_t reflected = 0;
+    for (int bit = 0; bit < 24; bit++) {
+        if (init & (1U << bit))
+            reflected |= 1U << ((bit & ~7) + 7 - (bit & 7));
+    }
+    return reflected;
+}
+
+/* CRC-24 over size bytes, four at a time. */
+inline uint32_t crc24(const uint8_t* data, size_t size, uint32_t crc) {
+    static constexpr CRCTables tables = make_crc_tables();
+
+    for (; size >= 4; size -= 4, data += 4) {
+        uint32_t word;
+        std::memcpy(&word, data, 4);
+        word ^= crc;
+        crc = tables[3][word & 0xFF] ^
+              tables[2][(word >> 8) & 0xFF] ^
+              tables[1][(word >> 16) & 0xFF] ^
+              tables[0][word >> 24];
+    }
+
+    while (size--)
+        crc = (crc >> 8) ^ tables[0][(crc ^ *data++) & 0xFF];
+
+    return crc;
+}
+
+/* True if the CRC that follows size bytes of PDU matches. */
+inline bool crc_valid(const uint8_t* pdu, const size_t size, const uint32_t reflected_init) {
+    const uint32_t received = pdu[size] | (pdu[size + 1] << 8) | (pdu[size + 2] << 16);
+    return crc24(pdu, size, reflected_init) == received;
+}
+
+} /* namespace btle */
+
+#endif /*__BTLE_LINK_H__*/
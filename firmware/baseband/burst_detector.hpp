@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __BURST_DETECTOR_H__
+#define __BURST_DETECTOR_H__
+
+#include "dsp_types.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/* Cheap energy gate in front of a packet demodulator. While the channel is
+ * idle the noise floor is tracked from the block power, much like the OOK
+ * level estimator in SubGhzDProcessor. A burst starts when the mean power
+ * over the last Window samples is more than 2^trigger_shift above the
+ * floor, and lasts until hold_samples go by without that. Averaging keeps
+ * single noise peaks from opening the gate: one sample of Gaussian noise
+ * exceeds 4x the mean power about 2% of the time, a mean of 8 practically
+ * never. Only the blocks inside a burst reach the handler.
+ * A burst longer than max_burst_samples is taken to be a raised floor (a
+ * gain change, say) and the floor is re-learned from it.
+ *
+ * The last Lookback samples of each block are kept, so when a burst starts
+ * the handler sees the lead-in before the block that triggered it. */
+template <typename T, size_t Lookback, size_t Window = 8>
+class BurstDetector {
+    static_assert((Window & (Window - 1)) == 0, "Window must be a power of two");
+
+   public:
+    constexpr BurstDetector(
+        const uint32_t hold_samples,
+        const uint32_t max_burst_samples,
+        const uint32_t trigger_shift = 2,
+        const uint32_t min_threshold = 64)
+        : hold_samples{hold_samples},
+          max_burst_samples{max_burst_samples},
+          trigger_shift{trigger_shift},
+          min_threshold{min_threshold} {
+    }
+
+    bool active() const {
+        return active_;
+    }
+
+    uint32_t noise_floor() const {
+        return noise_floor_;
+    }
+
+    template <typename Handler>
+    void execute(const buffer_t<T>& src, Handler handler) {
+        const uint64_t threshold = std::max<uint64_t>(
+            static_cast<uint64_t>(noise_floor_) << trigger_shift, min_threshold);
+        const uint64_t window_threshold = threshold * Window;
+
+        uint64_t sum = 0;
+        size_t last_hot = src.count;
+        for (size_t i = 0; i < src.count; i++) {
+            const auto p = power(src.p[i]);
+            sum += p;
+
+            // Sliding sum of the last Window powers, across blocks.
+            window_sum = window_sum + p - window[window_index];
+            window[window_index] = p;
+            window_index = (window_index + 1) & (Window - 1);
+
+            if (window_sum > window_threshold)
+                last_hot = i;
+        }
+
+        if (last_hot != src.count) {
+            if (!active_ && lookback_count > 0)
+                handler(buffer_t<T>{lookback.data(), lookback_count, src.sampling_rate, src.timestamp, lookback_index});
+
+            if (!active_)
+                burst_samples = 0;
+
+            active_ = true;
+            quiet_samples = src.count - 1 - last_hot;
+            handler(src);
+        } else if (active_) {
+            handler(src);
+
+            quiet_samples += src.count;
+            if (quiet_samples >= hold_samples)
+                active_ = false;
+        }
+
+        const uint32_t mean = (src.count > 0) ? sum / src.count : noise_floor_;
+        if (active_) {
+            burst_samples += src.count;
+            if (burst_samples >= max_burst_samples) {
+                noise_floor_ = mean;
+                active_ = false;
+            }
+        } else if (mean < noise_floor_) {
+            // Only learn the floor from blocks without a burst in them.
+            // It drops right away and rises slowly.
+            noise_floor_ = mean;
+        } else {
+            noise_floor_ += (mean - noise_floor_) / 16;
+        }
+
+        save_tail(src);
+    }
+
+    void reset() {
+        noise_floor_ = UINT32_MAX;
+        active_ = false;
+        quiet_samples = 0;
+        burst_samples = 0;
+        lookback_count = 0;
+        window.fill(0);
+        window_index = 0;
+        window_sum = 0;
+    }
+
+   private:
+    const uint32_t hold_samples;
+    const uint32_t max_burst_samples;
+    const uint32_t trigger_shift;
+    const uint32_t min_threshold;
+
+    std::array<T, Lookback> lookback{};
+    size_t lookback_count{0};
+    uint64_t lookback_index{0};
+    uint32_t noise_floor_{UINT32_MAX};
+    uint32_t quiet_samples{0};
+    uint32_t burst_samples{0};
+    bool active_{false};
+
+    std::array<uint32_t, Window> window{};
+    size_t window_index{0};
+    uint64_t window_sum{0};
+
+    static uint32_t power(const complex8_t v) {
+        return v.real() * v.real() + v.imag() * v.imag();
+    }
+
+    static uint32_t power(const complex16_t v) {
+        const int32_t re = v.real();
+        const int32_t im = v.imag();
+        return static_cast<uint32_t>(re * re) + static_cast<uint32_t>(im * im);
+    }
+
+    void save_tail(const buffer_t<T>& src) {
+        const size_t n = std::min(src.count, Lookback);
+        std::copy(&src.p[src.count - n], &src.p[src.count], lookback.begin());
+        lookback_count = n;
+        lookback_index = src.sample_index + src.count - n;
+    }
+};
+
+#endif /*__BURST_DETECTOR_H__*/
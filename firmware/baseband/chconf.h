@@ -129,7 +129,7 @@
  * @note    The default is @p TRUE.
  */
 #if !defined(CH_USE_REGISTRY) || defined(__DOXYGEN__)
-#define CH_USE_REGISTRY FALSE
+#define CH_USE_REGISTRY TRUE
 #endif
 
 /**
@@ -452,7 +452,8 @@
     /* Add threads custom fields here.*/ \
     uint32_t switches;                   \
     uint32_t start_ticks;                \
-    uint32_t total_ticks;
+    uint32_t total_ticks;                \
+    uint8_t memory_tag;
 #endif
 
 /**
@@ -469,6 +470,7 @@
         tp->switches = 0;                          \
         tp->start_ticks = 0;                       \
         tp->total_ticks = 0;                       \
+        tp->memory_tag = 0;                        \
     }
 #endif
 
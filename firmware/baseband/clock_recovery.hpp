@@ -23,6 +23,7 @@
 #define __CLOCK_RECOVERY_H__
 
 #include <cstddef>
+#include <cstdint>
 #include <array>
 #include <functional>
 
@@ -30,8 +31,32 @@
 
 namespace clock_recovery {
 
-class GardnerTimingErrorDetector {
+/* Sample, lateness and resampler types of a timing loop. Integer samples
+ * are interpolated and detected in fixed point, their lateness is 64 bits
+ * so the product of two full scale samples can't overflow. */
+template <typename T>
+struct TimingTypes;
+
+template <>
+struct TimingTypes<float> {
+    using sample_t = float;
+    using lateness_t = float;
+    using resampler_t = dsp::interpolation::LinearResampler;
+};
+
+template <>
+struct TimingTypes<int32_t> {
+    using sample_t = int32_t;
+    using lateness_t = int64_t;
+    using resampler_t = dsp::interpolation::FixedLinearResampler;
+};
+
+template <typename T = float>
+class GardnerTimingErrorDetector : public TimingTypes<T> {
    public:
+    using typename TimingTypes<T>::sample_t;
+    using typename TimingTypes<T>::lateness_t;
+
     static constexpr size_t samples_per_symbol{2};
 
     /*
@@ -40,7 +65,7 @@ class GardnerTimingErrorDetector {
         */
     template <typename SymbolHandler>
     void operator()(
-        const float in,
+        const sample_t in,
         SymbolHandler symbol_handler) {
         /* NOTE: Algorithm is sensitive to input magnitude. Timing error value
          * will scale proportionally. Best practice is to use error sign only.
@@ -51,7 +76,7 @@ class GardnerTimingErrorDetector {
 
         if (symbol_phase == 0) {
             const auto symbol = t[0];
-            const float lateness = (t[0] - t[2]) * t[1];
+            const lateness_t lateness = static_cast<lateness_t>(t[0] - t[2]) * t[1];
             symbol_handler(symbol, lateness);
         }
 
@@ -59,10 +84,39 @@ class GardnerTimingErrorDetector {
     }
 
    private:
-    std::array<float, 3> t{};
+    std::array<sample_t, 3> t{};
     size_t symbol_phase{0};
 };
 
+template <typename T = float>
+class MuellerMullerTimingErrorDetector : public TimingTypes<T> {
+   public:
+    using typename TimingTypes<T>::sample_t;
+    using typename TimingTypes<T>::lateness_t;
+
+    static constexpr size_t samples_per_symbol{1};
+
+    /*
+        Expects retimed samples at the symbol rate. Decision-directed, the
+        timing error comes from the current and previous symbols and their
+        hard decisions, so no intermediate sample is needed and there is
+        no multiply.
+        */
+    template <typename SymbolHandler>
+    void operator()(
+        const sample_t in,
+        SymbolHandler symbol_handler) {
+        // Positive when sampling late, as with the Gardner detector.
+        const lateness_t from_last = (in >= 0) ? last : -last;
+        const lateness_t from_in = (last >= 0) ? in : -in;
+        symbol_handler(in, from_last - from_in);
+        last = in;
+    }
+
+   private:
+    sample_t last{0};
+};
+
 class LinearErrorFilter {
    public:
     LinearErrorFilter(
@@ -72,8 +126,9 @@ class LinearErrorFilter {
           error_weight{error_weight} {
     }
 
+    template <typename Lateness>
     float operator()(
-        const float error) {
+        const Lateness error) {
         error_filtered = filter_alpha * error_filtered + (1.0f - filter_alpha) * error;
         return error_filtered * error_weight;
     }
@@ -94,9 +149,10 @@ class FixedErrorFilter {
         : weight_{weight} {
     }
 
+    template <typename Lateness>
     float operator()(
-        const float lateness) const {
-        return (lateness < 0.0f) ? weight() : -weight();
+        const Lateness lateness) const {
+        return (lateness < 0) ? weight() : -weight();
     }
 
     float weight() const {
@@ -107,10 +163,15 @@ class FixedErrorFilter {
     float weight_{1.0f / 16.0f};
 };
 
-template <typename ErrorFilter>
+/* Retimes samples to the symbol rate. The detector picks the sample type,
+ * GardnerTimingErrorDetector<int32_t> runs the resampler and detector in
+ * fixed point. The error filter only runs once per symbol. */
+template <typename ErrorFilter, typename TimingErrorDetector = GardnerTimingErrorDetector<>>
 class ClockRecovery {
    public:
-    using SymbolHandler = std::function<void(const float)>;
+    using sample_t = typename TimingErrorDetector::sample_t;
+    using lateness_t = typename TimingErrorDetector::lateness_t;
+    using SymbolHandler = std::function<void(const sample_t)>;
 
     ClockRecovery(
         const float sampling_rate,
@@ -135,27 +196,27 @@ class ClockRecovery {
     }
 
     void operator()(
-        const float baseband_sample) {
+        const sample_t baseband_sample) {
         resampler(baseband_sample,
-                  [this](const float interpolated_sample) {
+                  [this](const sample_t interpolated_sample) {
                       this->resampler_callback(interpolated_sample);
                   });
     }
 
    private:
-    dsp::interpolation::LinearResampler resampler{};
-    GardnerTimingErrorDetector timing_error_detector{};
+    typename TimingErrorDetector::resampler_t resampler{};
+    TimingErrorDetector timing_error_detector{};
     ErrorFilter error_filter{};
     const SymbolHandler symbol_handler;
 
-    void resampler_callback(const float interpolated_sample) {
+    void resampler_callback(const sample_t interpolated_sample) {
         timing_error_detector(interpolated_sample,
-                              [this](const float symbol, const float lateness) {
+                              [this](const sample_t symbol, const lateness_t lateness) {
                                   this->symbol_callback(symbol, lateness);
                               });
     }
 
-    void symbol_callback(const float symbol, const float lateness) {
+    void symbol_callback(const sample_t symbol, const lateness_t lateness) {
         // NOTE: This check is to avoid std::function nullptr check, which
         // brings in "_ZSt25__throw_bad_function_callv" and a lot of extra code.
         // TODO: Make symbol_handler known at compile time.
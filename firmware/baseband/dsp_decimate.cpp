@@ -233,7 +233,9 @@ buffer_c16_t FIRC8xR16x24FS4Decim4::execute(
     return {
         dst.p,
         count,
-        src.sampling_rate / decimation_factor};
+        src.sampling_rate / decimation_factor,
+        src.timestamp,
+        src.sample_index / decimation_factor};
 }
 
 // FIRC8xR16x24FS4Decim8 //////////////////////////////////////////////////
@@ -286,7 +288,9 @@ buffer_c16_t FIRC8xR16x24FS4Decim8::execute(
     return {
         dst.p,
         count,
-        src.sampling_rate / decimation_factor};
+        src.sampling_rate / decimation_factor,
+        src.timestamp,
+        src.sample_index / decimation_factor};
 }
 
 // FIRC16xR16x16Decim2 ////////////////////////////////////////////////////
@@ -334,7 +338,9 @@ buffer_c16_t FIRC16xR16x16Decim2::execute(
     return {
         dst.p,
         count,
-        src.sampling_rate / decimation_factor};
+        src.sampling_rate / decimation_factor,
+        src.timestamp,
+        src.sample_index / decimation_factor};
 }
 
 // FIRC16xR16x32Decim8 ////////////////////////////////////////////////////
@@ -390,7 +396,9 @@ buffer_c16_t FIRC16xR16x32Decim8::execute(
     return {
         dst.p,
         count,
-        src.sampling_rate / decimation_factor};
+        src.sampling_rate / decimation_factor,
+        src.timestamp,
+        src.sample_index / decimation_factor};
 }
 
 buffer_c16_t Complex8DecimateBy2CIC3::execute(const buffer_c8_t& src, const buffer_c16_t& dst) {
@@ -447,7 +455,7 @@ buffer_c16_t Complex8DecimateBy2CIC3::execute(const buffer_c8_t& src, const buff
     _i1_i0 = i1_i0;
     _q1_q0 = q1_q0;
 
-    return {dst.p, src.count / 2, src.sampling_rate / 2};
+    return {dst.p, src.count / 2, src.sampling_rate / 2, src.timestamp, src.sample_index / 2};
 }
 
 buffer_c16_t TranslateByFSOver4AndDecimateBy2CIC3::execute(const buffer_c8_t& src, const buffer_c16_t& dst) {
@@ -531,7 +539,7 @@ buffer_c16_t TranslateByFSOver4AndDecimateBy2CIC3::execute(const buffer_c8_t& sr
     _q1_i0 = q1_i0;
     _q0_i1 = q0_i1;
 
-    return {dst.p, src.count / 2, src.sampling_rate / 2};
+    return {dst.p, src.count / 2, src.sampling_rate / 2, src.timestamp, src.sample_index / 2};
 }
 
 buffer_c16_t DecimateBy2CIC3::execute(
@@ -582,7 +590,7 @@ buffer_c16_t DecimateBy2CIC3::execute(
     _iq0 = t1;
     _iq1 = t2;
 
-    return {dst.p, src.count / 2, src.sampling_rate / 2};
+    return {dst.p, src.count / 2, src.sampling_rate / 2, src.timestamp, src.sample_index / 2};
 }
 
 void FIR64AndDecimateBy2Real::configure(
@@ -619,14 +627,20 @@ buffer_s16_t FIR64AndDecimateBy2Real::execute(
         *(dst_p++) = t / 65536;
     }
 
-    return {dst.p, src.count / 2, src.sampling_rate / 2};
+    return {dst.p, src.count / 2, src.sampling_rate / 2, src.timestamp, src.sample_index / 2};
+}
+
+FIRAndDecimateComplex::~FIRAndDecimateComplex() {
+    baseband::buffer_cache::release(samples_slot_);
+    baseband::buffer_cache::release(taps_slot_);
 }
 
 void FIRAndDecimateComplex::configure_common(
     const size_t taps_count,
     const size_t decimation_factor) {
-    samples_ = std::make_unique<samples_t>(taps_count);
-    taps_reversed_ = std::make_unique<taps_t>(taps_count);
+    samples_ = baseband::buffer_cache::acquire<sample_t>(samples_slot_, taps_count);
+    taps_reversed_ = baseband::buffer_cache::acquire<tap_t>(taps_slot_, taps_count);
+    std::fill_n(samples_, taps_count, sample_t{0, 0});
     taps_count_ = taps_count;
     decimation_factor_ = decimation_factor;
 }
@@ -642,7 +656,7 @@ buffer_c16_t FIRAndDecimateComplex::execute(
     const size_t output_samples = src.count / decimation_factor_;
 
     void* dst_p = dst.p;
-    const buffer_c16_t result{dst.p, output_samples, output_sampling_rate};
+    const buffer_c16_t result{dst.p, output_samples, output_sampling_rate, src.timestamp, src.sample_index / decimation_factor_};
 
     const void* src_p = src.p;
     size_t outer_count = output_samples;
@@ -757,7 +771,7 @@ buffer_s16_t DecimateBy2CIC4Real::execute(
         *(dst_p++) = t / 16;
     }
 
-    return {dst.p, src.count / 2, src.sampling_rate / 2};
+    return {dst.p, src.count / 2, src.sampling_rate / 2, src.timestamp, src.sample_index / 2};
 }
 
 } /* namespace decimate */
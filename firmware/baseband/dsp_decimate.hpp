@@ -30,6 +30,7 @@
 #include "dsp_types.hpp"
 #include "simd.hpp"
 #include "utility.hpp"
+#include "baseband_buffer_cache.hpp"
 
 namespace dsp {
 namespace decimate {
@@ -199,6 +200,13 @@ class FIRAndDecimateComplex {
 
     using taps_t = tap_t[];
 
+    FIRAndDecimateComplex() = default;
+    ~FIRAndDecimateComplex();
+
+    // The slots own their blocks.
+    FIRAndDecimateComplex(const FIRAndDecimateComplex&) = delete;
+    FIRAndDecimateComplex& operator=(const FIRAndDecimateComplex&) = delete;
+
     /* NOTE! Current code makes an assumption that block of samples to be
      * processed will be a multiple of the taps_count.
      */
@@ -215,10 +223,11 @@ class FIRAndDecimateComplex {
         const buffer_c16_t& dst);
 
    private:
-    using samples_t = sample_t[];
-
-    std::unique_ptr<samples_t> samples_{};
-    std::unique_ptr<taps_t> taps_reversed_{};
+    // Reconfiguring reuses the storage unless the filter grows.
+    baseband::buffer_cache::Slot samples_slot_{memory_stats::Tag::DSP};
+    baseband::buffer_cache::Slot taps_slot_{memory_stats::Tag::DSP};
+    sample_t* samples_{nullptr};
+    tap_t* taps_reversed_{nullptr};
     size_t taps_count_{0};
     size_t decimation_factor_{1};
 
@@ -45,7 +45,7 @@ buffer_f32_t AM::execute(
         *(dst_p++) = __builtin_sqrtf(mag_sq1) * k;
     }
 
-    return {dst.p, src.count, src.sampling_rate};
+    return {dst.p, src.count, src.sampling_rate, src.timestamp, src.sample_index};
 }
 
 buffer_f32_t SSB::execute(
@@ -61,7 +61,7 @@ buffer_f32_t SSB::execute(
         *(dst_p++) = (src_p++)->real() * k;
     }
 
-    return {dst.p, src.count, src.sampling_rate};
+    return {dst.p, src.count, src.sampling_rate, src.timestamp, src.sample_index};
 }
 /*
 static inline float angle_approx_4deg0(const complex32_t t) {
@@ -101,7 +101,7 @@ buffer_f32_t FM::execute(
     }
     z_ = z;
 
-    return {dst.p, src.count, src.sampling_rate};
+    return {dst.p, src.count, src.sampling_rate, src.timestamp, src.sample_index};
 }
 
 buffer_s16_t FM::execute(
@@ -129,7 +129,7 @@ buffer_s16_t FM::execute(
     }
     z_ = z;
 
-    return {dst.p, src.count, src.sampling_rate};
+    return {dst.p, src.count, src.sampling_rate, src.timestamp, src.sample_index};
 }
 
 void FM::configure(const float sampling_rate, const float deviation_hz) {
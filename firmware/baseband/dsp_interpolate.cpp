@@ -0,0 +1,249 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "dsp_interpolate.hpp"
+
+#include "utility.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(LPC43XX_M4) && defined(__ARM_FEATURE_DSP)
+#include <hal.h>
+#endif
+
+namespace dsp {
+namespace interpolate {
+
+// Peak is scaled a bit below full scale, filter overshoot needs the headroom.
+constexpr float peak_target = 112.0f;
+
+#if defined(LPC43XX_M4) && defined(__ARM_FEATURE_DSP)
+static inline int32_t smlad(const uint32_t a, const uint32_t b, const int32_t acc) { return __SMLAD(a, b, acc); }
+static inline int8_t saturate(const int32_t v) { return __SSAT(v, 8); }
+#else
+static inline int32_t smlad(const uint32_t a, const uint32_t b, const int32_t acc) {
+    return acc + static_cast<int16_t>(a & 0xffff) * static_cast<int16_t>(b & 0xffff) +
+           static_cast<int16_t>(a >> 16) * static_cast<int16_t>(b >> 16);
+}
+static inline int8_t saturate(const int32_t v) { return clip<int32_t>(v, -128, 127); }
+#endif
+
+static inline uint32_t load_pair(const int16_t* const p) {
+    uint32_t pair;
+    std::memcpy(&pair, p, sizeof(pair));
+    return pair;
+}
+
+size_t PolyphaseInterpolator::taps_for_budget(const uint32_t output_rate, const uint32_t cycle_budget) {
+    size_t taps_per_phase = 1;
+    while (taps_per_phase < max_taps_per_phase &&
+           uint64_t{output_rate} * cycles_per_output(taps_per_phase * 2) <= cycle_budget)
+        taps_per_phase *= 2;
+    return taps_per_phase;
+}
+
+void PolyphaseInterpolator::configure(const size_t factor, const size_t taps_per_phase) {
+    factor_ = clip<size_t>(factor, 1, max_factor);
+    taps_per_phase_ = 1;
+    while (taps_per_phase_ * 2 <= std::min(taps_per_phase, max_taps_per_phase))
+        taps_per_phase_ *= 2;
+
+    history_re_.fill(0);
+    history_im_.fill(0);
+    build_taps();
+}
+
+void PolyphaseInterpolator::set_peak(const uint16_t peak) {
+    peak_ = peak;
+    build_taps();
+}
+
+void PolyphaseInterpolator::build_taps() {
+    constexpr float pi = 3.14159265358979323846f;
+    const size_t length = factor_ * taps_per_phase_;
+    const float center = (length - 1) / 2.0f;
+    const float gain = (peak_ > 0) ? peak_target / peak_ : 1.0f / 256.0f;
+
+    // Phase p, tap t is prototype tap p + t * factor, newest sample first.
+    std::array<float, max_factor * max_taps_per_phase> h{};
+    float largest_tap = 0.0f;
+    float largest_sum = 0.0f;
+    for (size_t p = 0; p < factor_; p++) {
+        float sum = 0.0f;
+        for (size_t t = 0; t < taps_per_phase_; t++) {
+            const size_t k = p + t * factor_;
+            const float x = (k - center) / factor_;
+            const float sinc = (x == 0.0f) ? 1.0f : std::sin(pi * x) / (pi * x);
+            const float window = 0.5f - 0.5f * std::cos(2.0f * pi * (k + 0.5f) / length);
+            h[p * taps_per_phase_ + t] = sinc * window;
+            sum += sinc * window;
+        }
+
+        float magnitude = 0.0f;
+        for (size_t t = 0; t < taps_per_phase_; t++) {
+            auto& tap = h[p * taps_per_phase_ + t];
+            tap *= gain / sum;
+            largest_tap = std::max(largest_tap, std::fabs(tap));
+            magnitude += std::fabs(tap);
+        }
+        largest_sum = std::max(largest_sum, magnitude);
+    }
+
+    // Most fraction bits that keep every tap in 16 bits and any 16 bit
+    // input, plus the rounding and dither, from overflowing the 32 bit
+    // accumulator.
+    shift_ = 8;
+    while (shift_ < 30 &&
+           std::ldexp(largest_tap, shift_ + 1) < 32767.0f &&
+           std::ldexp(largest_sum, shift_ + 1) * 32768.0f < 2147483647.0f - std::ldexp(1.0f, shift_ + 2))
+        shift_++;
+
+    for (size_t i = 0; i < length; i++)
+        taps_[i] = std::lround(std::ldexp(h[i], shift_));
+}
+
+int32_t PolyphaseInterpolator::triangular_noise() {
+    // xorshift32, the difference of two uniform bytes is +/-1 LSB triangular.
+    noise_ ^= noise_ << 13;
+    noise_ ^= noise_ >> 17;
+    noise_ ^= noise_ << 5;
+    return static_cast<int32_t>(noise_ & 0xff) - static_cast<int32_t>((noise_ >> 8) & 0xff);
+}
+
+int32_t PolyphaseInterpolator::rounding() {
+    // Half an output LSB, plus the dither scaled from 1/256 to shift_ fraction bits.
+    const int32_t round = 1 << (shift_ - 1);
+    return dither_ ? round + triangular_noise() * (1 << (shift_ - 8)) : round;
+}
+
+static complex16_t widen(const complex16_t value) {
+    return value;
+}
+
+static complex16_t widen(const complex8_t value) {
+    return {static_cast<int16_t>(value.real() * 256), static_cast<int16_t>(value.imag() * 256)};
+}
+
+template <size_t N, typename Buffer>
+void PolyphaseInterpolator::filter(const Buffer& src, complex8_t* out) {
+    for (size_t n = 0; n < src.count; n++) {
+        std::copy_backward(history_re_.begin(), history_re_.begin() + N - 1, history_re_.begin() + N);
+        std::copy_backward(history_im_.begin(), history_im_.begin() + N - 1, history_im_.begin() + N);
+        const auto in = widen(src.p[n]);
+        history_re_[0] = in.real();
+        history_im_[0] = in.imag();
+
+        // The history is the same for every phase, keep it packed.
+        uint32_t re_pairs[N / 2];
+        uint32_t im_pairs[N / 2];
+        for (size_t j = 0; j < N / 2; j++) {
+            re_pairs[j] = load_pair(&history_re_[j * 2]);
+            im_pairs[j] = load_pair(&history_im_[j * 2]);
+        }
+
+        const int16_t* h = taps_.data();
+        for (size_t p = 0; p < factor_; p++, h += N) {
+            int32_t re = rounding();
+            int32_t im = rounding();
+            for (size_t j = 0; j < N / 2; j++) {
+                const auto tap_pair = load_pair(&h[j * 2]);
+                re = smlad(re_pairs[j], tap_pair, re);
+                im = smlad(im_pairs[j], tap_pair, im);
+            }
+            *(out++) = {saturate(re >> shift_), saturate(im >> shift_)};
+        }
+    }
+}
+
+template <typename Buffer>
+buffer_c8_t PolyphaseInterpolator::interpolate(
+    const Buffer& src,
+    const buffer_c8_t& dst) {
+    switch (taps_per_phase_) {
+        case 2:
+            filter<2>(src, dst.p);
+            break;
+
+        case 4:
+            filter<4>(src, dst.p);
+            break;
+
+        case 8:
+            filter<8>(src, dst.p);
+            break;
+
+        default: {
+            // Sample hold, no history needed.
+            auto out = dst.p;
+            for (size_t n = 0; n < src.count; n++) {
+                const auto in = widen(src.p[n]);
+                const int32_t re = in.real() * taps_[0];
+                const int32_t im = in.imag() * taps_[0];
+                if (!dither_) {
+                    const int32_t round = rounding();
+                    out = std::fill_n(out, factor_, complex8_t{saturate((re + round) >> shift_), saturate((im + round) >> shift_)});
+                    continue;
+                }
+
+                // Every output gets its own noise.
+                for (size_t p = 0; p < factor_; p++)
+                    *(out++) = {saturate((re + rounding()) >> shift_), saturate((im + rounding()) >> shift_)};
+            }
+            break;
+        }
+    }
+
+    return {
+        dst.p,
+        src.count * factor_,
+        src.sampling_rate * static_cast<uint32_t>(factor_),
+        src.timestamp,
+        src.sample_index * factor_};
+}
+
+buffer_c8_t PolyphaseInterpolator::execute(
+    const buffer_c16_t& src,
+    const buffer_c8_t& dst) {
+    return interpolate(src, dst);
+}
+
+buffer_c8_t PolyphaseInterpolator::execute(
+    const buffer_c8_t& src,
+    const buffer_c8_t& dst) {
+    if (taps_per_phase_ > 1 || peak_ > 0 || dither_)
+        return interpolate(src, dst);
+
+    auto out = dst.p;
+    for (size_t n = 0; n < src.count; n++)
+        out = std::fill_n(out, factor_, src.p[n]);
+
+    return {
+        dst.p,
+        src.count * factor_,
+        src.sampling_rate * static_cast<uint32_t>(factor_),
+        src.timestamp,
+        src.sample_index * factor_};
+}
+
+} /* namespace interpolate */
+} /* namespace dsp */
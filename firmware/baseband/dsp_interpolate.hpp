@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __DSP_INTERPOLATE_H__
+#define __DSP_INTERPOLATE_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+
+#include "dsp_types.hpp"
+
+namespace dsp {
+namespace interpolate {
+
+/* Polyphase FIR interpolator from C16 to C8 for the TX path. The prototype
+ * is a Hann windowed sinc of factor * taps_per_phase taps with its cutoff
+ * at the input Nyquist rate. Each phase sums to unity so DC passes flat.
+ * One tap per phase is a plain sample hold.
+ *
+ * The gain is folded into the taps, and the phases run as dual 16-bit
+ * MACs (SMLAD) on tap pairs like the decimators. */
+class PolyphaseInterpolator {
+   public:
+    static constexpr size_t max_factor = 64;
+    static constexpr size_t max_taps_per_phase = 8;
+
+    /* Estimated M4 cycles per output sample, counted from the Cortex-M4
+     * instruction timings of the kernel: one LDR and two SMLADs per tap
+     * pair with the history pairs held in registers, plus about 8 for the
+     * shift, saturation, packing and the store.
+     * Known limitation: this figure has not been measured on hardware, so
+     * tap counts picked from it are a starting point, not a guarantee. */
+    static constexpr uint32_t cycles_per_output(const size_t taps_per_phase) {
+        return 8 + 3 * taps_per_phase / 2;
+    }
+
+    /* The most taps per phase, a power of two, that interpolate to
+     * output_rate within cycle_budget cycles per second, going by the
+     * cycles_per_output() estimate. */
+    static size_t taps_for_budget(const uint32_t output_rate, const uint32_t cycle_budget);
+
+    /* taps_per_phase is rounded down to a power of two. */
+    void configure(const size_t factor, const size_t taps_per_phase);
+
+    /* Scales so a source peaking at peak (C16 units) uses most of the C8
+     * range. 0 is the plain C16 to C8 shift. */
+    void set_peak(const uint16_t peak);
+
+    /* Adds +/-1 LSB triangular (TPDF) noise before the output is rounded
+     * to C8, trading a little noise floor for less quantization distortion
+     * on quiet sources. */
+    void set_dither(const bool enable) { dither_ = enable; }
+    bool dither() const { return dither_; }
+
+    size_t factor() const { return factor_; }
+    size_t taps_per_phase() const { return taps_per_phase_; }
+
+    /* Output = sum of history * phase taps >> shift(). */
+    const int16_t* phase(const size_t p) const { return &taps_[p * taps_per_phase_]; }
+    size_t shift() const { return shift_; }
+
+    /* dst must hold src.count * factor() samples. */
+    buffer_c8_t execute(
+        const buffer_c16_t& src,
+        const buffer_c8_t& dst);
+
+    /* C8 sources are taken as C16 << 8. At unity gain with a single tap
+     * the samples are copied straight through. */
+    buffer_c8_t execute(
+        const buffer_c8_t& src,
+        const buffer_c8_t& dst);
+
+   private:
+    alignas(4) std::array<int16_t, max_factor * max_taps_per_phase> taps_{};
+    // Newest sample first, real and imaginary apart so pairs can be packed.
+    alignas(4) std::array<int16_t, max_taps_per_phase> history_re_{};
+    alignas(4) std::array<int16_t, max_taps_per_phase> history_im_{};
+    size_t factor_{1};
+    size_t taps_per_phase_{1};
+    uint16_t peak_{0};
+    size_t shift_{8};
+    bool dither_{false};
+    uint32_t noise_{0x9e3779b9};
+
+    void build_taps();
+    int32_t triangular_noise();
+    int32_t rounding();
+
+    template <size_t N, typename Buffer>
+    void filter(const Buffer& src, complex8_t* out);
+
+    template <typename Buffer>
+    buffer_c8_t interpolate(const Buffer& src, const buffer_c8_t& dst);
+};
+
+} /* namespace interpolate */
+} /* namespace dsp */
+
+#endif /*__DSP_INTERPOLATE_H__*/
@@ -23,6 +23,7 @@
 #include "debug.hpp"
 #include "event_m4.hpp"
 #include "lpc43xx_cpp.hpp"
+#include "memory_stats.hpp"
 #include "message_queue.hpp"
 #include "portapack_shared_memory.hpp"
 
@@ -89,22 +90,27 @@ void EventDispatcher::dispatch(const eventmask_t events) {
 }
 
 void EventDispatcher::handle_baseband_queue() {
-    const auto message = shared_memory.baseband_message;
-    if (message) {
-        on_message(message);
-    }
+    shared_memory.baseband_queue.handle([this](const Message* const message) {
+        return on_message(message);
+    });
 }
 
-void EventDispatcher::on_message(const Message* const message) {
+bool EventDispatcher::on_message(const Message* const message) {
     switch (message->id) {
         case Message::ID::Shutdown:
+            // Left pending, the M0 is released once the baseband has halted.
             on_message_shutdown(*reinterpret_cast<const ShutdownMessage*>(message));
-            break;
+            return false;
+
+        case Message::ID::MemoryStatsRequest:
+            if (reinterpret_cast<const MemoryStatsRequestMessage*>(message)->reset_peaks)
+                memory_stats::reset_peaks();
+            shared_memory.m4_memory = memory_stats::snapshot();
+            return true;
 
         default:
             on_message_default(message);
-            shared_memory.baseband_message = nullptr;
-            break;
+            return true;
     }
 }
 
@@ -62,7 +62,7 @@ class EventDispatcher {
 
     void handle_baseband_queue();
 
-    void on_message(const Message* const message);
+    bool on_message(const Message* const message);
     void on_message_shutdown(const ShutdownMessage&);
     void on_message_default(const Message* const message);
 
@@ -1,9 +1,10 @@
 /*
 This is the protocol list handler. It holds an instance of all known protocols.
-So include here the .hpp, and add a new element to the protos vector in the constructor. That's all you need to do here if you wanna add a new proto.
+So include here the .hpp, add its class to storage and point its protos element at it in the constructor. That's all you need to do here if you wanna add a new proto.
     @htotoo
 */
 
+#include <tuple>
 #include <vector>
 #include <memory>
 #include "portapack_shared_memory.hpp"
@@ -60,73 +61,72 @@ So include here the .hpp, and add a new element to the protos vector in the cons
 
 class SubGhzDProtos : public FProtoListGeneral {
    public:
-    SubGhzDProtos(const SubGhzDProtos&) { SubGhzDProtos(); };         // won't use, but makes compiler happy
-    SubGhzDProtos& operator=(const SubGhzDProtos&) { return *this; }  // won't use, but makes compiler happy
+    // protos points into storage.
+    SubGhzDProtos(const SubGhzDProtos&) = delete;
+    SubGhzDProtos& operator=(const SubGhzDProtos&) = delete;
     SubGhzDProtos() {
         // add protos
-        protos[FPS_PRINCETON] = new FProtoSubGhzDPrinceton();
-        protos[FPS_BETT] = new FProtoSubGhzDBett();
-        protos[FPS_CAME] = new FProtoSubGhzDCame();
-        protos[FPS_CAMEATOMO] = new FProtoSubGhzDCameAtomo();
-        protos[FPS_CAMETWEE] = new FProtoSubGhzDCameTwee();
-        protos[FPS_CHAMBCODE] = new FProtoSubGhzDChambCode();
-        protos[FPS_CLEMSA] = new FProtoSubGhzDClemsa();
-        protos[FPS_DOITRAND] = new FProtoSubGhzDDoitrand();
-        protos[FPS_DOOYA] = new FProtoSubGhzDDooya();
-        protos[FPS_FAAC] = new FProtoSubGhzDFaac();
-        protos[FPS_GATETX] = new FProtoSubGhzDGateTx();
-        protos[FPS_HOLTEK] = new FProtoSubGhzDHoltek();
-        protos[FPS_HOLTEKHT12X] = new FProtoSubGhzDHoltekHt12x();
-        protos[FPS_HONEYWELL] = new FProtoSubGhzDHoneywell();
-        protos[FPS_HONEYWELLWDB] = new FProtoSubGhzDHoneywellWdb();
-        protos[FPS_HORMANN] = new FProtoSubGhzDHormann();
-        protos[FPS_IDO] = new FProtoSubGhzDIdo();
-        protos[FPS_INTERTECHNOV3] = new FProtoSubGhzDIntertechnoV3();
-        protos[FPS_KEELOQ] = new FProtoSubGhzDKeeLoq();
-        protos[FPS_KINGGATESSTYLO4K] = new FProtoSubGhzDKinggatesStylo4K();
-        protos[FPS_LINEAR] = new FProtoSubGhzDLinear();
-        protos[FPS_LINEARDELTA3] = new FProtoSubGhzDLinearDelta3();
-        protos[FPS_MAGELLAN] = new FProtoSubGhzDMagellan();
-        protos[FPS_MARANTEC] = new FProtoSubGhzDMarantec();
-        protos[FPS_MASTERCODE] = new FProtoSubGhzDMastercode();
-        protos[FPS_MEGACODE] = new FProtoSubGhzDMegacode();
-        protos[FPS_NERORADIO] = new FProtoSubGhzDNeroRadio();
-        protos[FPS_NERO_SKETCH] = new FProtoSubGhzDNeroSketch();
-        protos[FPS_NICEFLO] = new FProtoSubGhzDNiceflo();
-        protos[FPS_NICEFLORS] = new FProtoSubGhzDNiceflors();
-        protos[FPS_PHOENIXV2] = new FProtoSubGhzDPhoenixV2();
-        protos[FPS_POWERSMART] = new FProtoSubGhzDPowerSmart();
-        protos[FPS_SECPLUSV1] = new FProtoSubGhzDSecPlusV1();
-        protos[FPS_SECPLUSV2] = new FProtoSubGhzDSecPlusV2();
-        protos[FPS_SMC5326] = new FProtoSubGhzDSmc5326();
-        protos[FPS_SOMIFY_KEYTIS] = new FProtoSubGhzDSomifyKeytis();
-        protos[FPS_SOMIFY_TELIS] = new FProtoSubGhzDSomifyTelis();
-        protos[FPS_STARLINE] = new FProtoSubGhzDStarLine();
-        protos[FPS_X10] = new FProtoSubGhzDX10();
+        protos[FPS_PRINCETON] = &std::get<FProtoSubGhzDPrinceton>(storage);
+        protos[FPS_BETT] = &std::get<FProtoSubGhzDBett>(storage);
+        protos[FPS_CAME] = &std::get<FProtoSubGhzDCame>(storage);
+        protos[FPS_CAMEATOMO] = &std::get<FProtoSubGhzDCameAtomo>(storage);
+        protos[FPS_CAMETWEE] = &std::get<FProtoSubGhzDCameTwee>(storage);
+        protos[FPS_CHAMBCODE] = &std::get<FProtoSubGhzDChambCode>(storage);
+        protos[FPS_CLEMSA] = &std::get<FProtoSubGhzDClemsa>(storage);
+        protos[FPS_DOITRAND] = &std::get<FProtoSubGhzDDoitrand>(storage);
+        protos[FPS_DOOYA] = &std::get<FProtoSubGhzDDooya>(storage);
+        protos[FPS_FAAC] = &std::get<FProtoSubGhzDFaac>(storage);
+        protos[FPS_GATETX] = &std::get<FProtoSubGhzDGateTx>(storage);
+        protos[FPS_HOLTEK] = &std::get<FProtoSubGhzDHoltek>(storage);
+        protos[FPS_HOLTEKHT12X] = &std::get<FProtoSubGhzDHoltekHt12x>(storage);
+        protos[FPS_HONEYWELL] = &std::get<FProtoSubGhzDHoneywell>(storage);
+        protos[FPS_HONEYWELLWDB] = &std::get<FProtoSubGhzDHoneywellWdb>(storage);
+        protos[FPS_HORMANN] = &std::get<FProtoSubGhzDHormann>(storage);
+        protos[FPS_IDO] = &std::get<FProtoSubGhzDIdo>(storage);
+        protos[FPS_INTERTECHNOV3] = &std::get<FProtoSubGhzDIntertechnoV3>(storage);
+        protos[FPS_KEELOQ] = &std::get<FProtoSubGhzDKeeLoq>(storage);
+        protos[FPS_KINGGATESSTYLO4K] = &std::get<FProtoSubGhzDKinggatesStylo4K>(storage);
+        protos[FPS_LINEAR] = &std::get<FProtoSubGhzDLinear>(storage);
+        protos[FPS_LINEARDELTA3] = &std::get<FProtoSubGhzDLinearDelta3>(storage);
+        protos[FPS_MAGELLAN] = &std::get<FProtoSubGhzDMagellan>(storage);
+        protos[FPS_MARANTEC] = &std::get<FProtoSubGhzDMarantec>(storage);
+        protos[FPS_MASTERCODE] = &std::get<FProtoSubGhzDMastercode>(storage);
+        protos[FPS_MEGACODE] = &std::get<FProtoSubGhzDMegacode>(storage);
+        protos[FPS_NERORADIO] = &std::get<FProtoSubGhzDNeroRadio>(storage);
+        protos[FPS_NERO_SKETCH] = &std::get<FProtoSubGhzDNeroSketch>(storage);
+        protos[FPS_NICEFLO] = &std::get<FProtoSubGhzDNiceflo>(storage);
+        protos[FPS_NICEFLORS] = &std::get<FProtoSubGhzDNiceflors>(storage);
+        protos[FPS_PHOENIXV2] = &std::get<FProtoSubGhzDPhoenixV2>(storage);
+        protos[FPS_POWERSMART] = &std::get<FProtoSubGhzDPowerSmart>(storage);
+        protos[FPS_SECPLUSV1] = &std::get<FProtoSubGhzDSecPlusV1>(storage);
+        protos[FPS_SECPLUSV2] = &std::get<FProtoSubGhzDSecPlusV2>(storage);
+        protos[FPS_SMC5326] = &std::get<FProtoSubGhzDSmc5326>(storage);
+        protos[FPS_SOMIFY_KEYTIS] = &std::get<FProtoSubGhzDSomifyKeytis>(storage);
+        protos[FPS_SOMIFY_TELIS] = &std::get<FProtoSubGhzDSomifyTelis>(storage);
+        protos[FPS_STARLINE] = &std::get<FProtoSubGhzDStarLine>(storage);
+        protos[FPS_X10] = &std::get<FProtoSubGhzDX10>(storage);
         // protos[FPS_HORMANNBISECURE] = new FProtoSubGhzDHormannBiSecure();  //fm
-        protos[FPS_LEGRAND] = new FProtoSubGhzDLegrand();
-        protos[FPS_GANGQI] = new FProtoSubGhzDGangqi();
-        protos[FPS_MARANTEC24] = new FProtoSubGhzDMarantec24();
+        protos[FPS_LEGRAND] = &std::get<FProtoSubGhzDLegrand>(storage);
+        protos[FPS_GANGQI] = &std::get<FProtoSubGhzDGangqi>(storage);
+        protos[FPS_MARANTEC24] = &std::get<FProtoSubGhzDMarantec24>(storage);
 
         for (uint8_t i = 0; i < FPS_COUNT; ++i) {
             if (protos[i] != NULL) protos[i]->setCallback(callbackTarget);
         }
     }
 
-    ~SubGhzDProtos() {  // not needed for current operation logic, but a bit more elegant :)
-        for (uint8_t i = 0; i < FPS_COUNT; ++i) {
-            if (protos[i] != NULL) {
-                free(protos[i]);
-                protos[i] = NULL;
-            }
-        }
-    };
-
     static void callbackTarget(FProtoSubGhzDBase* instance) {
         SubGhzDDataMessage packet_message{instance->sensorType, instance->data_count_bit, instance->decode_data};
         shared_memory.application_queue.push(packet_message);
     }
 
+    // Replaces the default callback, which sends a SubGhzDDataMessage.
+    void setCallback(SubGhzDProtocolDecoderBaseRxCallback cb) {
+        for (uint8_t i = 0; i < FPS_COUNT; ++i) {
+            if (protos[i] != NULL) protos[i]->setCallback(cb);
+        }
+    }
+
     void feed(bool level, uint32_t duration) {
         for (uint8_t i = 0; i < FPS_COUNT; ++i) {
             if (protos[i] != NULL) protos[i]->feed(level, duration);
@@ -134,6 +134,51 @@ class SubGhzDProtos : public FProtoListGeneral {
     }
 
    protected:
+    // Every protocol lives here, no heap allocation per protocol.
+    std::tuple<
+        FProtoSubGhzDPrinceton,
+        FProtoSubGhzDBett,
+        FProtoSubGhzDCame,
+        FProtoSubGhzDCameAtomo,
+        FProtoSubGhzDCameTwee,
+        FProtoSubGhzDChambCode,
+        FProtoSubGhzDClemsa,
+        FProtoSubGhzDDoitrand,
+        FProtoSubGhzDDooya,
+        FProtoSubGhzDFaac,
+        FProtoSubGhzDGateTx,
+        FProtoSubGhzDHoltek,
+        FProtoSubGhzDHoltekHt12x,
+        FProtoSubGhzDHoneywell,
+        FProtoSubGhzDHoneywellWdb,
+        FProtoSubGhzDHormann,
+        FProtoSubGhzDIdo,
+        FProtoSubGhzDIntertechnoV3,
+        FProtoSubGhzDKeeLoq,
+        FProtoSubGhzDKinggatesStylo4K,
+        FProtoSubGhzDLinear,
+        FProtoSubGhzDLinearDelta3,
+        FProtoSubGhzDMagellan,
+        FProtoSubGhzDMarantec,
+        FProtoSubGhzDMastercode,
+        FProtoSubGhzDMegacode,
+        FProtoSubGhzDNeroRadio,
+        FProtoSubGhzDNeroSketch,
+        FProtoSubGhzDNiceflo,
+        FProtoSubGhzDNiceflors,
+        FProtoSubGhzDPhoenixV2,
+        FProtoSubGhzDPowerSmart,
+        FProtoSubGhzDSecPlusV1,
+        FProtoSubGhzDSecPlusV2,
+        FProtoSubGhzDSmc5326,
+        FProtoSubGhzDSomifyKeytis,
+        FProtoSubGhzDSomifyTelis,
+        FProtoSubGhzDStarLine,
+        FProtoSubGhzDX10,
+        FProtoSubGhzDLegrand,
+        FProtoSubGhzDGangqi,
+        FProtoSubGhzDMarantec24>
+        storage{};
     FProtoSubGhzDBase* protos[FPS_COUNT] = {NULL};
 };
 
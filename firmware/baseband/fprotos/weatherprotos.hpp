@@ -1,6 +1,6 @@
 /*
 This is the protocol list handler. It holds an instance of all known protocols.
-So include here the .hpp, and add a new element to the protos vector in the constructor. That's all you need to do here if you wanna add a new proto.
+So include here the .hpp, add its class to storage and point its protos element at it in the constructor. That's all you need to do here if you wanna add a new proto.
     @htotoo
 */
 
@@ -32,6 +32,7 @@ So include here the .hpp, and add a new element to the protos vector in the cons
 #include "w-bresser_3ch.hpp"
 #include "w-vauno_en8822.hpp"
 
+#include <tuple>
 #include <vector>
 #include <memory>
 #include "portapack_shared_memory.hpp"
@@ -41,36 +42,37 @@ So include here the .hpp, and add a new element to the protos vector in the cons
 
 class WeatherProtos : public FProtoListGeneral {
    public:
-    WeatherProtos(const WeatherProtos&) { WeatherProtos(); };         // won't use, but makes compiler happy
-    WeatherProtos& operator=(const WeatherProtos&) { return *this; }  // won't use, but makes compiler happy
+    // protos points into storage.
+    WeatherProtos(const WeatherProtos&) = delete;
+    WeatherProtos& operator=(const WeatherProtos&) = delete;
     WeatherProtos() {
         // add protos
-        protos[FPW_NexusTH] = new FProtoWeatherNexusTH();
-        protos[FPW_Acurite592TXR] = new FProtoWeatherAcurite592TXR();
-        protos[FPW_Acurite606TX] = new FProtoWeatherAcurite606TX();
-        protos[FPW_Acurite609TX] = new FProtoWeatherAcurite609TX();
-        protos[FPW_Ambient] = new FProtoWeatherAmbient();
-        protos[FPW_AuriolAhfl] = new FProtoWeatherAuriolAhfl();
-        protos[FPW_AuriolTH] = new FProtoWeatherAuriolTh();
-        protos[FPW_GTWT02] = new FProtoWeatherGTWT02();
-        protos[FPW_GTWT03] = new FProtoWeatherGTWT03();
-        protos[FPW_INFACTORY] = new FProtoWeatherInfactory();
-        protos[FPW_LACROSSETX] = new FProtoWeatherLaCrosseTx();
-        protos[FPW_LACROSSETX141thbv2] = new FProtoWeatherLaCrosseTx141thbv2();
-        protos[FPW_OREGON2] = new FProtoWeatherOregon2();
-        protos[FPW_OREGON3] = new FProtoWeatherOregon3();
-        protos[FPW_OREGONv1] = new FProtoWeatherOregonV1();
-        protos[FPW_THERMOPROTX4] = new FProtoWeatherThermoProTx4();
-        protos[FPW_TX_8300] = new FProtoWeatherTX8300();
-        protos[FPW_WENDOX_W6726] = new FProtoWeatherWendoxW6726();
-        protos[FPW_Acurite986] = new FProtoWeatherAcurite986();
-        protos[FPW_KEDSUM] = new FProtoWeatherKedsum();
-        protos[FPW_Acurite5in1] = new FProtoWeatherAcurite5in1();
-        protos[FPW_EmosE601x] = new FProtoWeatherEmosE601x();
-        protos[FPW_SolightTE44] = new FProtoWeatherSolightTE44();
-        protos[FPW_Bresser3CH] = new FProtoWeatheBresser3CH();
+        protos[FPW_NexusTH] = &std::get<FProtoWeatherNexusTH>(storage);
+        protos[FPW_Acurite592TXR] = &std::get<FProtoWeatherAcurite592TXR>(storage);
+        protos[FPW_Acurite606TX] = &std::get<FProtoWeatherAcurite606TX>(storage);
+        protos[FPW_Acurite609TX] = &std::get<FProtoWeatherAcurite609TX>(storage);
+        protos[FPW_Ambient] = &std::get<FProtoWeatherAmbient>(storage);
+        protos[FPW_AuriolAhfl] = &std::get<FProtoWeatherAuriolAhfl>(storage);
+        protos[FPW_AuriolTH] = &std::get<FProtoWeatherAuriolTh>(storage);
+        protos[FPW_GTWT02] = &std::get<FProtoWeatherGTWT02>(storage);
+        protos[FPW_GTWT03] = &std::get<FProtoWeatherGTWT03>(storage);
+        protos[FPW_INFACTORY] = &std::get<FProtoWeatherInfactory>(storage);
+        protos[FPW_LACROSSETX] = &std::get<FProtoWeatherLaCrosseTx>(storage);
+        protos[FPW_LACROSSETX141thbv2] = &std::get<FProtoWeatherLaCrosseTx141thbv2>(storage);
+        protos[FPW_OREGON2] = &std::get<FProtoWeatherOregon2>(storage);
+        protos[FPW_OREGON3] = &std::get<FProtoWeatherOregon3>(storage);
+        protos[FPW_OREGONv1] = &std::get<FProtoWeatherOregonV1>(storage);
+        protos[FPW_THERMOPROTX4] = &std::get<FProtoWeatherThermoProTx4>(storage);
+        protos[FPW_TX_8300] = &std::get<FProtoWeatherTX8300>(storage);
+        protos[FPW_WENDOX_W6726] = &std::get<FProtoWeatherWendoxW6726>(storage);
+        protos[FPW_Acurite986] = &std::get<FProtoWeatherAcurite986>(storage);
+        protos[FPW_KEDSUM] = &std::get<FProtoWeatherKedsum>(storage);
+        protos[FPW_Acurite5in1] = &std::get<FProtoWeatherAcurite5in1>(storage);
+        protos[FPW_EmosE601x] = &std::get<FProtoWeatherEmosE601x>(storage);
+        protos[FPW_SolightTE44] = &std::get<FProtoWeatherSolightTE44>(storage);
+        protos[FPW_Bresser3CH] = &std::get<FProtoWeatheBresser3CH>(storage);
         protos[FPW_Bresser3CH_V1] = nullptr;  // done by FProtoWeatheBresser3CH
-        protos[FPW_Vauno_EN8822] = new FProtoWeatherVaunoEN8822();
+        protos[FPW_Vauno_EN8822] = &std::get<FProtoWeatherVaunoEN8822>(storage);
 
         // set callback for them
         for (uint8_t i = 0; i < FPW_COUNT; ++i) {
@@ -78,20 +80,18 @@ class WeatherProtos : public FProtoListGeneral {
         }
     }
 
-    ~WeatherProtos() {  // not needed for current operation logic, but a bit more elegant :)
-        for (uint8_t i = 0; i < FPW_COUNT; ++i) {
-            if (protos[i] != NULL) {
-                free(protos[i]);
-                protos[i] = NULL;
-            }
-        }
-    };
-
     static void callbackTarget(FProtoWeatherBase* instance) {
         WeatherDataMessage packet_message{instance->getSensorType(), instance->getData()};
         shared_memory.application_queue.push(packet_message);
     }
 
+    // Replaces the default callback, which sends a WeatherDataMessage.
+    void setCallback(SubGhzProtocolDecoderBaseRxCallback cb) {
+        for (uint8_t i = 0; i < FPW_COUNT; ++i) {
+            if (protos[i] != NULL) protos[i]->setCallback(cb);
+        }
+    }
+
     void feed(bool level, uint32_t duration) {
         for (uint8_t i = 0; i < FPW_COUNT; ++i) {
             if (protos[i] != NULL) protos[i]->feed(level, duration);
@@ -99,6 +99,34 @@ class WeatherProtos : public FProtoListGeneral {
     }
 
    protected:
+    // Every protocol lives here, no heap allocation per protocol.
+    std::tuple<
+        FProtoWeatherNexusTH,
+        FProtoWeatherAcurite592TXR,
+        FProtoWeatherAcurite606TX,
+        FProtoWeatherAcurite609TX,
+        FProtoWeatherAmbient,
+        FProtoWeatherAuriolAhfl,
+        FProtoWeatherAuriolTh,
+        FProtoWeatherGTWT02,
+        FProtoWeatherGTWT03,
+        FProtoWeatherInfactory,
+        FProtoWeatherLaCrosseTx,
+        FProtoWeatherLaCrosseTx141thbv2,
+        FProtoWeatherOregon2,
+        FProtoWeatherOregon3,
+        FProtoWeatherOregonV1,
+        FProtoWeatherThermoProTx4,
+        FProtoWeatherTX8300,
+        FProtoWeatherWendoxW6726,
+        FProtoWeatherAcurite986,
+        FProtoWeatherKedsum,
+        FProtoWeatherAcurite5in1,
+        FProtoWeatherEmosE601x,
+        FProtoWeatherSolightTE44,
+        FProtoWeatheBresser3CH,
+        FProtoWeatherVaunoEN8822>
+        storage{};
     FProtoWeatherBase* protos[FPW_COUNT] = {NULL};
 };
 
@@ -19,11 +19,13 @@
  * Boston, MA 02110-1301, USA.
  */
 
+#ifndef __GPDMA_LLI_H__
+#define __GPDMA_LLI_H__
+
 #include <cstdint>
 #include <cstddef>
 
-#include <vector>
-#include <memory>
+#include <array>
 
 #include "gpdma.hpp"
 
@@ -86,7 +88,7 @@ struct ChannelConfig {
 
     constexpr gpdma::channel::Control control(
         const size_t transfer_size,
-        const bool last) {
+        const bool last) const {
         return {
             .transfersize = transfer_size,
             .sbsize = toUType(source.burst_size),
@@ -104,7 +106,7 @@ struct ChannelConfig {
         };
     }
 
-    constexpr gpdma::channel::Config config() {
+    constexpr gpdma::channel::Config config() const {
         return {
             .e = 0,
             .srcperipheral = source.peripheral,
@@ -154,70 +156,58 @@ constexpr ChannelConfig channel_config_rssi{
     {0x0e, BurstSize::Transfer1, TransferWidth::Word, Increment::Yes},
 };
 
-class Chain {
-   public:
-    using chain_t = std::vector<gpdma::channel::LLI>;
-    using chain_p = std::unique_ptr<chain_t>;
-
-    Chain(const ChannelConfig& cc)
-        : chain(std::make_unique<chain_t>(cc.chain.length)) {
-        set_lli_sequential(cc.chain_type);
-        set_source_address()...
-    }
-
-   private:
-    chain_p chain;
-
-    void set_source_peripheral(void* const address) {
-        set_source_address(address, 0);
-    }
-
-    void set_destination_peripheral(void* const address) {
-        set_destination_address(address, 0);
-    }
+constexpr gpdma::channel::LLIPointer lli_pointer(const void* lli) {
+    return {
+        .lm = 0,
+        .r = 0,
+        .lli = reinterpret_cast<uint32_t>(lli),
+    };
+}
 
-    void set_source_address(void* const address, const size_t increment) {
-        size_t offset = 0;
-        for (auto& item : *chain) {
-            item.srcaddr = (uint32_t)address + offset;
-            offset += increment;
+/* Loop of descriptors moving consecutive blocks of one memory buffer
+ * to or from a peripheral register, up to MaxLength blocks deep. */
+template <size_t MaxLength>
+class Ring {
+   public:
+    static constexpr size_t max_length = MaxLength;
+
+    void configure(
+        const uint32_t peripheral,
+        void* const memory,
+        const size_t length,
+        const size_t block_bytes,
+        const gpdma::channel::Control control,
+        const bool to_peripheral) {
+        memory_ = reinterpret_cast<uint32_t>(memory);
+        block_bytes_ = block_bytes;
+        length_ = (length > max_length) ? max_length : length;
+
+        for (size_t i = 0; i < length_; i++) {
+            const auto address = memory_ + i * block_bytes_;
+            items_[i].srcaddr = to_peripheral ? address : peripheral;
+            items_[i].destaddr = to_peripheral ? peripheral : address;
+            items_[i].lli = lli_pointer(&items_[(i + 1) % length_]);
+            items_[i].control = control;
         }
     }
 
-    void set_destination_address(void* const address, const size_t increment) {
-        size_t offset = 0;
-        for (auto& item : *chain) {
-            item.destaddr = (uint32_t)address + offset;
-            offset += increment;
-        }
-    }
+    size_t size() const { return length_; }
 
-    void set_control(const gpdma::channel::Control control) {
-        for (auto& item : *chain) {
-            item.control = control;
-        }
-    }
+    const gpdma::channel::LLI& front() const { return items_[0]; }
 
-    void set_lli_sequential(ChainType chain_type) {
-        for (auto& item : *chain) {
-            item.lli = lli_pointer(&item + 1);
-        }
-        if (chain_type == ChainType::Loop) {
-            chain[chain->size() - 1].lli = lli_pointer(&chain[0]);
-        } else {
-            chain[chain->size() - 1].lli = lli_pointer(nullptr);
-        }
+    void* block(const size_t index) const {
+        return reinterpret_cast<void*>(memory_ + (index % length_) * block_bytes_);
     }
 
-    gpdma::channel::LLIPointer lli_pointer(const void* lli) {
-        return {
-            .lm = 0,
-            .r = 0,
-            .lli = reinterpret_cast<uint32_t>(lli),
-        };
-    }
+   private:
+    std::array<gpdma::channel::LLI, MaxLength> items_{};
+    uint32_t memory_{0};
+    size_t block_bytes_{0};
+    size_t length_{0};
 };
 
 } /* namespace lli */
 } /* namespace gpdma */
 } /* namespace lpc43xx */
+
+#endif /*__GPDMA_LLI_H__*/
@@ -22,6 +22,8 @@
 #ifndef __LINEAR_RESAMPLER_H__
 #define __LINEAR_RESAMPLER_H__
 
+#include <cstdint>
+
 namespace dsp {
 namespace interpolation {
 
@@ -61,6 +63,44 @@ class LinearResampler {
     }
 };
 
+/* LinearResampler on integer samples, with the phase in Q16. The product
+ * of phase and sample delta is taken in 64 bits, one SMULL on the M4. */
+class FixedLinearResampler {
+   public:
+    static constexpr int32_t one = 1 << 16;
+
+    void configure(
+        const float input_rate,
+        const float output_rate) {
+        phase_increment = input_rate / output_rate * one;
+    }
+
+    template <typename InterpolatedSampleHandler>
+    void operator()(
+        const int32_t sample,
+        InterpolatedSampleHandler interpolated_sample_handler) {
+        const int32_t sample_delta = sample - last_sample;
+        while (phase < one) {
+            const int32_t interpolated_value = last_sample + static_cast<int32_t>((static_cast<int64_t>(phase) * sample_delta) >> 16);
+            interpolated_sample_handler(interpolated_value);
+            phase += phase_increment;
+        }
+        last_sample = sample;
+        phase -= one;
+    }
+
+    /* Called once per symbol, so the float multiply stays off the per
+     * sample path. */
+    void advance(const float fraction) {
+        phase += static_cast<int32_t>(fraction * phase_increment);
+    }
+
+   private:
+    int32_t last_sample{0};
+    int32_t phase{0};
+    int32_t phase_increment{0};
+};
+
 } /* namespace interpolation */
 } /* namespace dsp */
 
@@ -22,69 +22,130 @@
 #ifndef __MATCHED_FILTER_H__
 #define __MATCHED_FILTER_H__
 
+#include <array>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <complex>
-#include <memory>
+
+#include "complex.hpp"
+
+#if defined(LPC43XX_M4) && defined(__ARM_FEATURE_DSP)
+#include <hal.h>
+#endif
 
 namespace dsp {
 namespace matched_filter {
 
+namespace detail {
+
+/* Dual 16-bit multiply-accumulates on packed complex16_t words
+ * (real in the low half, imaginary in the high half). */
+#if defined(LPC43XX_M4) && defined(__ARM_FEATURE_DSP)
+static inline int32_t smlad(const uint32_t a, const uint32_t b, const int32_t acc) { return __SMLAD(a, b, acc); }
+static inline int32_t smladx(const uint32_t a, const uint32_t b, const int32_t acc) { return __SMLADX(a, b, acc); }
+static inline int32_t smlsd(const uint32_t a, const uint32_t b, const int32_t acc) { return __SMLSD(a, b, acc); }
+static inline int32_t smlsdx(const uint32_t a, const uint32_t b, const int32_t acc) { return __SMLSDX(a, b, acc); }
+#else
+static inline int32_t lo(const uint32_t v) { return static_cast<int16_t>(v & 0xffff); }
+static inline int32_t hi(const uint32_t v) { return static_cast<int16_t>(v >> 16); }
+static inline int32_t smlad(const uint32_t a, const uint32_t b, const int32_t acc) { return acc + lo(a) * lo(b) + hi(a) * hi(b); }
+static inline int32_t smladx(const uint32_t a, const uint32_t b, const int32_t acc) { return acc + lo(a) * hi(b) + hi(a) * lo(b); }
+static inline int32_t smlsd(const uint32_t a, const uint32_t b, const int32_t acc) { return acc + lo(a) * lo(b) - hi(a) * hi(b); }
+static inline int32_t smlsdx(const uint32_t a, const uint32_t b, const int32_t acc) { return acc + lo(a) * hi(b) - hi(a) * lo(b); }
+#endif
+
+constexpr uint32_t pack(const int16_t re, const int16_t im) {
+    return static_cast<uint16_t>(re) | (static_cast<uint32_t>(static_cast<uint16_t>(im)) << 16);
+}
+
+constexpr int16_t to_q14(const float v) {
+    return static_cast<int16_t>(v * 16384.0f + (v < 0.0f ? -0.5f : 0.5f));
+}
+
+} /* namespace detail */
+
 // This filter contains "magic" (optimizations) that expect the taps to
 // combine a low-pass filter with a complex sinusoid that performs shifting of
 // the input signal to 0Hz/DC. This also means that the taps length must be
 // a multiple of the complex sinusoid period.
+//
+// Taps are held in Q14 and correlated against the int16 samples with dual
+// 16-bit MACs. The taps must have a gain of at most 1.0 (the sum of tap
+// magnitudes), which keeps the 32-bit accumulators from overflowing.
 
+template <size_t N>
 class MatchedFilter {
    public:
-    using sample_t = std::complex<float>;
+    using sample_t = complex16_t;
     using tap_t = std::complex<float>;
 
-    using taps_t = tap_t[];
-
-    template <class T>
-    MatchedFilter(
-        const T& taps,
-        size_t decimation_factor = 1) {
-        configure(taps, decimation_factor);
+    constexpr MatchedFilter(
+        const std::array<tap_t, N>& taps,
+        const size_t decimation_factor = 1)
+        : taps_reversed_{reverse_taps(taps)},
+          decimation_factor_{decimation_factor} {
     }
 
-    template <class T>
-    void configure(
-        const T& taps,
-        size_t decimation_factor) {
-        configure(taps.data(), taps.size(), decimation_factor);
+    bool execute_once(const sample_t input) {
+        // Each sample is written twice so the N most recent are always
+        // contiguous, oldest first, starting at head_.
+        samples_[head_] = input.__rep();
+        samples_[head_ + N] = input.__rep();
+        head_ = (head_ + 1 == N) ? 0 : head_ + 1;
+
+        if (++decimation_phase_ < decimation_factor_)
+            return false;
+        decimation_phase_ = 0;
+
+        const uint32_t* const s = &samples_[head_];
+        int32_t r_n = 0;
+        int32_t r_p = 0;
+        int32_t i_n = 0;
+        int32_t i_p = 0;
+        for (size_t n = 0; n < N; n++) {
+            const auto tap = taps_reversed_[n];
+
+            // N: complex multiply of samples and conjugated taps.
+            // P: complex multiply of samples and taps.
+            r_n = detail::smlad(s[n], tap, r_n);    // sr * tr + si * ti
+            r_p = detail::smlsd(s[n], tap, r_p);    // sr * tr - si * ti
+            i_n = detail::smlsdx(tap, s[n], i_n);   // tr * si - ti * sr
+            i_p = detail::smladx(s[n], tap, i_p);   // sr * ti + si * tr
+        }
+
+        const float mag_n = magnitude(r_n, i_n);
+        const float mag_p = magnitude(r_p, i_p);
+        output = (mag_p - mag_n) * (1.0f / 16384.0f);
+        return true;
     }
 
-    bool execute_once(const sample_t input);
-
     float get_output() const {
         return output;
     }
 
    private:
-    using samples_t = sample_t[];
-
-    std::unique_ptr<samples_t> samples_{};
-    std::unique_ptr<taps_t> taps_reversed_{};
-    size_t taps_count_{0};
-    size_t decimation_factor_{1};
-    size_t decimation_phase{0};
+    std::array<uint32_t, N> taps_reversed_;
+    std::array<uint32_t, N * 2> samples_{};
+    size_t head_{0};
+    const size_t decimation_factor_;
+    size_t decimation_phase_{0};
     float output{0};
 
-    void shift_by_decimation_factor();
-
-    void advance_decimation_phase() {
-        decimation_phase = (decimation_phase + 1) % decimation_factor_;
+    static constexpr std::array<uint32_t, N> reverse_taps(const std::array<tap_t, N>& taps) {
+        std::array<uint32_t, N> result{};
+        for (size_t n = 0; n < N; n++) {
+            const auto& tap = taps[N - 1 - n];
+            result[n] = detail::pack(detail::to_q14(tap.real()), detail::to_q14(tap.imag()));
+        }
+        return result;
     }
 
-    bool is_new_decimation_cycle() const {
-        return (decimation_phase == 0);
+    static float magnitude(const int32_t re, const int32_t im) {
+        const float r = re;
+        const float i = im;
+        return std::sqrt(r * r + i * i);
     }
-
-    void configure(
-        const tap_t* const taps,
-        const size_t taps_count,
-        const size_t decimation_factor);
 };
 
 } /* namespace matched_filter */
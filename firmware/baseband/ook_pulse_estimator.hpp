@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __OOK_PULSE_ESTIMATOR_H__
+#define __OOK_PULSE_ESTIMATOR_H__
+
+#include "dsp_types.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+/* Turns the channel magnitude into OOK pulse and gap durations for the
+ * fprotos decoders. The noise (low) and pulse (high) levels are tracked
+ * separately and the threshold sits halfway between them. */
+class OOKPulseEstimator {
+   public:
+    /* ns_per_sample is the period of the samples passed to execute(). */
+    void configure(const uint32_t ns_per_sample) {
+        nsPerDecSamp = ns_per_sample;
+    }
+
+    /* Calls handler(level, duration_us) each time the level changes. */
+    template <typename Handler>
+    void execute(const buffer_c16_t& src, Handler handler) {
+        for (size_t i = 0; i < src.count; i++) {
+            threshold = (low_estimate + high_estimate) / 2;
+            int32_t const hysteresis = threshold / 8;  // +-12%
+            int16_t re = src.p[i].real();
+            int16_t im = src.p[i].imag();
+            uint32_t mag = ((uint32_t)re * (uint32_t)re) + ((uint32_t)im * (uint32_t)im);
+
+            mag = (mag >> 10);
+            int32_t const ook_low_delta = mag - low_estimate;
+            bool meashl = currentHiLow;
+            if (sig_state == STATE_IDLE) {
+                if (mag > (threshold + hysteresis)) {  // just become high
+                    meashl = true;
+                    sig_state = STATE_PULSE;
+                    numg = 0;
+                } else {
+                    meashl = false;  // still low
+                    low_estimate += ook_low_delta / est_low_ratio;
+                    low_estimate += ((ook_low_delta > 0) ? 1 : -1);  // Hack to compensate for lack of fixed-point scaling
+                    // Calculate default OOK high level estimate
+                    high_estimate = 1.35 * low_estimate;  // Default is a ratio of low level
+                    high_estimate = std::max(high_estimate, min_high_level);
+                    high_estimate = std::min(high_estimate, max_high_level);
+                }
+
+            } else if (sig_state == STATE_PULSE) {
+                ++numg;
+                if (numg > 100) numg = 100;
+                if (mag < (threshold - hysteresis)) {
+                    // check if really a bad value
+                    if (numg < 3) {
+                        // susp
+                        sig_state = STATE_GAP;
+                    } else {
+                        numg = 0;
+                        sig_state = STATE_GAP_START;
+                    }
+                    meashl = false;  // low
+                } else {
+                    high_estimate += mag / est_high_ratio - high_estimate / est_high_ratio;
+                    high_estimate = std::max(high_estimate, min_high_level);
+                    high_estimate = std::min(high_estimate, max_high_level);
+                    meashl = true;  // still high
+                }
+            } else if (sig_state == STATE_GAP_START) {
+                ++numg;
+                if (mag > (threshold + hysteresis)) {  // New pulse?
+                    sig_state = STATE_PULSE;
+                    meashl = true;
+                } else if (numg >= 3) {
+                    sig_state = STATE_GAP;
+                    meashl = false;  // gap
+                }
+            } else if (sig_state == STATE_GAP) {
+                ++numg;
+                if (mag > (threshold + hysteresis)) {  // New pulse?
+                    numg = 0;
+                    sig_state = STATE_PULSE;
+                    meashl = true;
+                } else {
+                    meashl = false;
+                }
+            }
+
+            if (meashl == currentHiLow && currentDuration < 30'000'000)  // allow pass 'end' signal
+            {
+                currentDuration += nsPerDecSamp;
+            } else {  // called on change, so send the last duration and dir.
+                if (currentDuration >= 30'000'000) sig_state = STATE_IDLE;
+                handler(currentHiLow, currentDuration / 1000);
+                currentDuration = nsPerDecSamp;
+                currentHiLow = meashl;
+            }
+        }
+    }
+
+   private:
+    static constexpr int32_t est_high_ratio = 3;          // Slowness of the OOK high level estimator
+    static constexpr int32_t est_low_ratio = 5;           // Slowness of the OOK low level (noise) estimator (very slow)
+    static constexpr uint32_t max_high_level = 450000;
+
+    enum {
+        STATE_IDLE = 0,
+        STATE_PULSE = 1,
+        STATE_GAP_START = 2,
+        STATE_GAP = 3,
+    } sig_state = STATE_IDLE;
+    uint32_t low_estimate = 100;
+    uint32_t high_estimate = 12000;
+    uint32_t min_high_level = 10;
+    uint32_t nsPerDecSamp = 0;
+    uint8_t numg = 0;  // count of matched signals to filter spikes
+
+    uint32_t currentDuration = 0;
+    uint32_t threshold = 0x0630;  // will overwrite after the first iteration
+    bool currentHiLow = false;
+};
+
+#endif /*__OOK_PULSE_ESTIMATOR_H__*/
@@ -69,6 +69,11 @@ class PacketBuilder {
         reset_state();
     }
 
+    /* Position of the next symbol, stamped on the packet it completes. */
+    void set_sample_index(const uint64_t value) {
+        sample_index = value;
+    }
+
     void execute(
         const uint_fast8_t symbol) {
         bit_history.add(symbol);
@@ -91,6 +96,7 @@ class PacketBuilder {
                     // TODO: Make payload_handler known at compile time.
                     if (payload_handler) {
                         packet.set_timestamp(Timestamp::now());
+                        packet.set_sample_index(sample_index);
                         payload_handler(packet);
                     }
                     reset_state();
@@ -126,6 +132,7 @@ class PacketBuilder {
 
     State state{State::Preamble};
     baseband::Packet packet{};
+    uint64_t sample_index{0};
 
     void reset_state() {
         packet.clear();
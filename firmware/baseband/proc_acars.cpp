@@ -57,8 +57,14 @@ void ACARSProcessor::execute(const buffer_c8_t& buffer) {
     auto audio = demod.execute(decimator_out, audio_buffer);
     audio_output.write(audio);
 
-    for (size_t i = 0; i < decimator_out.count; i++) {
-        if (mf.execute_once(decimator_out.p[i])) {
+    burst_detector.execute(decimator_out, [this](const buffer_c16_t& burst) {
+        this->demodulate(burst);
+    });
+}
+
+void ACARSProcessor::demodulate(const buffer_c16_t& buffer) {
+    for (size_t i = 0; i < buffer.count; i++) {
+        if (mf.execute_once(buffer.p[i])) {
             clock_recovery(mf.get_output());
         }
     }
@@ -92,7 +98,7 @@ void ACARSProcessor::reset() {
 }
 
 void ACARSProcessor::consume_symbol(const float raw_symbol) {
-    const uint_fast8_t sliced_symbol = (raw_symbol >= 0.0f) ? 1 : 0;
+    const auto sliced_symbol = slicer(raw_symbol);
 
     add_bit(sliced_symbol);
     if (curr_state == WSYN && decode_count_bit == 8) {
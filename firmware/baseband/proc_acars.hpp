@@ -39,6 +39,7 @@
 
 #include "channel_decimator.hpp"
 #include "matched_filter.hpp"
+#include "burst_detector.hpp"
 
 #include "clock_recovery.hpp"
 #include "symbol_coding.hpp"
@@ -129,7 +130,11 @@ class ACARSProcessor : public BasebandProcessor {
 
     dsp::decimate::FIRC8xR16x24FS4Decim8 decim_0{};  // Translate already done here !
     dsp::decimate::FIRC16xR16x32Decim8 decim_1{};
-    dsp::matched_filter::MatchedFilter mf{rect_taps_38k4_4k8_1t_2k4_p, 8};
+    // Only the data path is gated, the audio keeps running.
+    BurstDetector<complex16_t, 32> burst_detector{1536, 76800};
+
+    dsp::matched_filter::MatchedFilter<16> mf{rect_taps_38k4_4k8_1t_2k4_p, 8};
+    symbol_coding::Slicer slicer{};
 
     clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> clock_recovery{
         4800,
@@ -138,6 +143,7 @@ class ACARSProcessor : public BasebandProcessor {
         [this](const float symbol) { this->consume_symbol(symbol); }};
 
     uint16_t update_crc(uint8_t dataByte);
+    void demodulate(const buffer_c16_t& buffer);
     void consume_symbol(const float symbol);
     void payload_handler();
     void add_bit(uint8_t bit);
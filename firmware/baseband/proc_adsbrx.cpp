@@ -55,6 +55,7 @@ void ADSBRXProcessor::execute(const buffer_c8_t& buffer) {
             // 1 bit == 2 samples, transition defines bit value.
             if ((sample_count & 1) == 1) {
                 if (bit_count >= msg_len) {
+                    frame.set_sample_index(buffer.sample_index + i);
                     const ADSBFrameMessage message(frame, amp);
                     shared_memory.application_queue.push(message);
                     decoding = false;
@@ -25,55 +25,126 @@
 #include "portapack_shared_memory.hpp"
 
 #include "dsp_fir_taps.hpp"
+#include "dsp_window.hpp"
 
 #include "event_m4.hpp"
 
-AISProcessor::AISProcessor() {
-    decim_0.configure(taps_11k0_decim_0.taps);
+#include <cmath>
+
+/* Q15 cosine over one period, for the channel mixers. */
+static constexpr size_t mixer_table_bits = 10;
+static constexpr size_t mixer_table_size = 1 << mixer_table_bits;
+
+static constexpr std::array<int16_t, mixer_table_size> make_mixer_table() {
+    std::array<int16_t, mixer_table_size> table{};
+    for (size_t i = 0; i < mixer_table_size; i++) {
+        const double v = dsp::window::cos(2.0 * 3.14159265358979323846 * i / mixer_table_size) * 32767.0;
+        table[i] = static_cast<int16_t>(v < 0 ? v - 0.5 : v + 0.5);
+    }
+    return table;
+}
+
+static constexpr auto mixer_table = make_mixer_table();
+
+AISChannel::AISChannel(AISFramer::PacketHandler payload_handler)
+    : framer{std::move(payload_handler)} {
     decim_1.configure(taps_11k0_decim_1.taps);
-    baseband_thread.start();
 }
 
-void AISProcessor::execute(const buffer_c8_t& buffer) {
-    /* 2.4576MHz, 2048 samples */
+void AISChannel::configure(const int32_t offset, const uint32_t sampling_rate) {
+    // Shifts by -offset to bring the channel to DC.
+    phase = 0;
+    phase_inc = static_cast<uint32_t>(static_cast<int64_t>(-offset) * (1LL << 32) / sampling_rate);
+}
 
-    const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
-    const auto decim_1_out = decim_1.execute(decim_0_out, dst_buffer);
-    const auto decimator_out = decim_1_out;
+buffer_c16_t AISChannel::execute(const buffer_c16_t& src) {
+    constexpr auto shift = 32 - mixer_table_bits;
+    constexpr auto quarter = mixer_table_size / 4;
 
-    /* 38.4kHz, 32 samples */
-    feed_channel_stats(decimator_out);
+    for (size_t i = 0; i < src.count; i++) {
+        const auto index = phase >> shift;
+        const int32_t c = mixer_table[index];
+        const int32_t s = mixer_table[(index - quarter) & (mixer_table_size - 1)];
+        const int32_t re = src.p[i].real();
+        const int32_t im = src.p[i].imag();
 
-    for (size_t i = 0; i < decimator_out.count; i++) {
-        if (mf.execute_once(decimator_out.p[i])) {
+        // A full scale input at 45 degrees would wrap without saturation.
+        dst[i] = {
+            static_cast<int16_t>(__SSAT((re * c - im * s) >> 15, 16)),
+            static_cast<int16_t>(__SSAT((re * s + im * c) >> 15, 16))};
+        phase += phase_inc;
+    }
+
+    /* 307.2kHz, 256 samples -> 38.4kHz, 32 samples */
+    const auto out = decim_1.execute({dst.data(), src.count, src.sampling_rate, src.timestamp, src.sample_index}, dst_buffer);
+
+    // Frames are stamped with the baseband sample of their last symbol.
+    for (size_t i = 0; i < out.count; i++) {
+        if (mf.execute_once(out.p[i])) {
+            framer.set_sample_index((out.sample_index + i) * decimation_factor);
             clock_recovery(mf.get_output());
         }
     }
+
+    return out;
 }
 
-void AISProcessor::consume_symbol(
-    const float raw_symbol) {
-    const uint_fast8_t sliced_symbol = (raw_symbol >= 0.0f) ? 1 : 0;
-    const auto decoded_symbol = nrzi_decode(sliced_symbol);
+void AISChannel::consume_symbol(const float raw_symbol) {
+    framer.execute(nrzi_decode(slicer(raw_symbol)), std::fabs(raw_symbol));
+}
+
+AISProcessor::AISProcessor() {
+    decim_0.configure(taps_ais_dual_decim_0.taps);
+    channel_a.configure(0, channel_fs);
+    baseband_thread.start();
+}
+
+void AISProcessor::execute(const buffer_c8_t& buffer) {
+    /* 2.4576MHz, 2048 samples */
 
-    packet_builder.execute(decoded_symbol);
+    const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
+
+    /* 307.2kHz, 256 samples */
+    const auto channel_out = channel_a.execute(decim_0_out);
+    if (dual_channel)
+        channel_b.execute(decim_0_out);
+
+    feed_channel_stats(channel_out);
 }
 
 void AISProcessor::payload_handler(
     const baseband::Packet& packet) {
-    const AISPacketMessage message{packet};
+    // The framer runs on host tests too, so the RTC is read here.
+    AISPacketMessage message{packet};
+    message.packet.set_timestamp(Timestamp::now());
     shared_memory.application_queue.push(message);
 }
 
 void AISProcessor::on_message(const Message* const message) {
-    if (message->id == Message::ID::AudioBeep)
-        on_beep_message(*reinterpret_cast<const AudioBeepMessage*>(message));
+    switch (message->id) {
+        case Message::ID::AudioBeep:
+            on_beep_message(*reinterpret_cast<const AudioBeepMessage*>(message));
+            break;
+
+        case Message::ID::AISConfigure:
+            configure(*reinterpret_cast<const AISConfigureMessage*>(message));
+            break;
+
+        default:
+            break;
+    }
 }
 
 void AISProcessor::on_beep_message(const AudioBeepMessage& message) {
     audio::dma::beep_start(message.freq, message.sample_rate, message.duration_ms);
 }
 
+void AISProcessor::configure(const AISConfigureMessage& message) {
+    dual_channel = message.dual_channel;
+    channel_a.configure(dual_channel ? -dual_channel_offset : 0, channel_fs);
+    channel_b.configure(dual_channel_offset, channel_fs);
+}
+
 int main() {
     audio::dma::init_audio_out();
     EventDispatcher event_dispatcher{std::make_unique<AISProcessor>()};
@@ -31,53 +31,85 @@
 
 #include "clock_recovery.hpp"
 #include "symbol_coding.hpp"
-#include "packet_builder.hpp"
+#include "ais_framer.hpp"
 #include "baseband_packet.hpp"
 
 #include "message.hpp"
 
+#include <array>
 #include <cstdint>
 #include <cstddef>
-#include <bitset>
 
 #include "ais_baseband.hpp"
 
-class AISProcessor : public BasebandProcessor {
+/* One AIS channel: shifted to DC from the wideband signal, then decimated,
+ * demodulated and framed on its own. */
+class AISChannel {
    public:
-    AISProcessor();
+    AISChannel(AISFramer::PacketHandler payload_handler);
 
-    void execute(const buffer_c8_t& buffer) override;
+    /* offset is where the channel sits in the wideband signal. */
+    void configure(const int32_t offset, const uint32_t sampling_rate);
 
-   private:
-    static constexpr size_t baseband_fs = 2457600;
+    /* Takes 256 samples at 307.2kHz, returns the channel at 38.4kHz. */
+    buffer_c16_t execute(const buffer_c16_t& src);
 
-    std::array<complex16_t, 512> dst{};
+   private:
+    std::array<complex16_t, 256> dst{};
     const buffer_c16_t dst_buffer{
         dst.data(),
         dst.size()};
 
-    dsp::decimate::FIRC8xR16x24FS4Decim8 decim_0{};
+    uint32_t phase{0};
+    uint32_t phase_inc{0};
+
     dsp::decimate::FIRC16xR16x32Decim8 decim_1{};
-    dsp::matched_filter::MatchedFilter mf{baseband::ais::square_taps_38k4_1t_p, 2};
+    // Includes the processor's decim_0 ahead of the channels.
+    static constexpr size_t decimation_factor =
+        dsp::decimate::FIRC8xR16x24FS4Decim8::decimation_factor *
+        dsp::decimate::FIRC16xR16x32Decim8::decimation_factor;
+    dsp::matched_filter::MatchedFilter<4> mf{baseband::ais::square_taps_38k4_1t_p, 2};
 
     clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> clock_recovery{
         19200,
         9600,
         {0.0555f},
         [this](const float symbol) { this->consume_symbol(symbol); }};
+    symbol_coding::Slicer slicer{};
     symbol_coding::NRZIDecoder nrzi_decode{};
-    PacketBuilder<BitPattern, BitPattern, BitPattern> packet_builder{
-        {0b0101010101111110, 16, 1},
-        {0b111110, 6},
-        {0b01111110, 8},
-        [this](const baseband::Packet& packet) {
-            this->payload_handler(packet);
-        }};
+    AISFramer framer;
 
     void consume_symbol(const float symbol);
+};
+
+class AISProcessor : public BasebandProcessor {
+   public:
+    AISProcessor();
+
+    void execute(const buffer_c8_t& buffer) override;
+
+   private:
+    static constexpr size_t baseband_fs = 2457600;
+    static constexpr uint32_t channel_fs = baseband_fs / 8;
+
+    // 161.975MHz and 162.025MHz around a 162.000MHz center.
+    static constexpr int32_t dual_channel_offset = 25000;
+
+    std::array<complex16_t, 512> dst{};
+    const buffer_c16_t dst_buffer{
+        dst.data(),
+        dst.size()};
+
+    dsp::decimate::FIRC8xR16x24FS4Decim8 decim_0{};
+
+    bool dual_channel{false};
+    AISChannel channel_a{[this](const baseband::Packet& packet) { this->payload_handler(packet); }};
+    AISChannel channel_b{[this](const baseband::Packet& packet) { this->payload_handler(packet); }};
+
     void payload_handler(const baseband::Packet& packet);
     void on_message(const Message* const message);
     void on_beep_message(const AudioBeepMessage& message);
+    void configure(const AISConfigureMessage& message);
 
     /* NB: Threads should be the last members in the class definition. */
     BasebandThread baseband_thread{
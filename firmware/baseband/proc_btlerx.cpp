@@ -27,73 +27,8 @@
 
 #include "event_m4.hpp"
 
-uint32_t BTLERxProcessor::crc_init_reorder(uint32_t crc_init) {
-    int i;
-    uint32_t crc_init_tmp, crc_init_input, crc_init_input_tmp;
-
-    crc_init_input_tmp = crc_init;
-    crc_init_input = 0;
-
-    crc_init_input = crc_init_input_tmp & 0xFF;
-
-    crc_init_input_tmp = (crc_init_input_tmp >> 8);
-    crc_init_input = ((crc_init_input << 8) | (crc_init_input_tmp & 0xFF));
-
-    crc_init_input_tmp = (crc_init_input_tmp >> 8);
-    crc_init_input = ((crc_init_input << 8) | (crc_init_input_tmp & 0xFF));
-
-    crc_init_input = (crc_init_input << 1);
-    crc_init_tmp = 0;
-
-    for (i = 0; i < 24; i++) {
-        crc_init_input = (crc_init_input >> 1);
-        crc_init_tmp = ((crc_init_tmp << 1) | (crc_init_input & 0x01));
-    }
-
-    return (crc_init_tmp);
-}
-
-uint_fast32_t BTLERxProcessor::crc_update(uint_fast32_t crc, const void* data, size_t data_len) {
-    const unsigned char* d = (const unsigned char*)data;
-    unsigned int tbl_idx;
-
-    while (data_len--) {
-        tbl_idx = (crc ^ *d) & 0xff;
-        crc = (crc_table[tbl_idx] ^ (crc >> 8)) & 0xffffff;
-
-        d++;
-    }
-
-    return crc & 0xffffff;
-}
-
-uint_fast32_t BTLERxProcessor::crc24_byte(uint8_t* byte_in, int num_byte, uint32_t init_hex) {
-    uint_fast32_t crc = init_hex;
-
-    crc = crc_update(crc, byte_in, num_byte);
-
-    return (crc);
-}
-
-bool BTLERxProcessor::crc_check(uint8_t* tmp_byte, int body_len, uint32_t crc_init) {
-    int crc24_checksum;
-
-    crc24_checksum = crc24_byte(tmp_byte, body_len, crc_init);  // 0x555555 --> 0xaaaaaa. maybe because byte order
-    checksumReceived = 0;
-    checksumReceived = ((checksumReceived << 8) | tmp_byte[body_len + 2]);
-    checksumReceived = ((checksumReceived << 8) | tmp_byte[body_len + 1]);
-    checksumReceived = ((checksumReceived << 8) | tmp_byte[body_len + 0]);
-
-    return (crc24_checksum != checksumReceived);
-}
-
-void BTLERxProcessor::scramble_byte(uint8_t* byte_in, int num_byte, const uint8_t* scramble_table_byte, uint8_t* byte_out) {
-    int i;
-
-    for (i = 0; i < num_byte; i++) {
-        byte_out[i] = byte_in[i] ^ scramble_table_byte[i];
-    }
-}
+#include <algorithm>
+#include <climits>
 
 int BTLERxProcessor::verify_payload_byte(int num_payload_byte, ADV_PDU_TYPE pdu_type) {
     // Should at least have 6 bytes for the MAC Address.
@@ -122,207 +57,145 @@ int BTLERxProcessor::verify_payload_byte(int num_payload_byte, ADV_PDU_TYPE pdu_
     return 0;
 }
 
-void BTLERxProcessor::handleBeginState() {
-    int num_symbol_left = dst_buffer.count / SAMPLE_PER_SYMBOL;  // One buffer sample consist of I and Q.
-
-    static uint8_t demod_buf_access[SAMPLE_PER_SYMBOL][LEN_DEMOD_BUF_ACCESS];
-
-    uint32_t uint32_tmp = DEFAULT_ACCESS_ADDR;
-    uint8_t accessAddrBits[LEN_DEMOD_BUF_ACCESS];
-
-    uint32_t accesssAddress = 0;
+/* Sign of the phase step between two samples, scaled down to 16 bits.
+ * At 2 samples per symbol a symbol spans two of these. */
+static int32_t discriminate(const complex16_t a, const complex16_t b) {
+    const int64_t cross = (int64_t)a.real() * b.imag() - (int64_t)b.real() * a.imag();
+    return std::clamp<int64_t>(cross >> 15, INT16_MIN, INT16_MAX);
+}
 
-    // Filling up addressBits with the access address we are looking to find.
-    for (int i = 0; i < 32; i++) {
-        accessAddrBits[i] = 0x01 & uint32_tmp;
-        uint32_tmp = (uint32_tmp >> 1);
+int32_t BTLERxProcessor::correlate(const Correlator& correlator) const {
+    int32_t score = 0;
+    for (size_t i = 0; i < access_address_bits; i++) {
+        const auto soft = correlator.soft[(correlator.next + i) % access_address_bits];
+        score += (btle::advertising_access_address & (1U << i)) ? soft : -soft;
     }
+    return score;
+}
 
-    const int demod_buf_len = LEN_DEMOD_BUF_ACCESS;  // For AA
-    int demod_buf_offset = 0;
-    int hit_idx = (-1);
-    bool unequal_flag = false;
-
-    memset(demod_buf_access, 0, SAMPLE_PER_SYMBOL * demod_buf_len);
-
-    for (int i = 0; i < num_symbol_left * SAMPLE_PER_SYMBOL; i += SAMPLE_PER_SYMBOL) {
-        int sp = ((demod_buf_offset - demod_buf_len + 1) & (demod_buf_len - 1));
-
-        for (int j = 0; j < SAMPLE_PER_SYMBOL; j++) {
-            // Sample and compare with the adjacent next sample.
-            int I0 = dst_buffer.p[i + j].real();
-            int Q0 = dst_buffer.p[i + j].imag();
-            int I1 = dst_buffer.p[i + j + 1].real();
-            int Q1 = dst_buffer.p[i + j + 1].imag();
-
-            int phase_idx = j;
-
-            demod_buf_access[phase_idx][demod_buf_offset] = (I0 * Q1 - I1 * Q0) > 0 ? 1 : 0;
-
-            int k = sp;
-            unequal_flag = false;
-
-            accesssAddress = 0;
-
-            for (int p = 0; p < demod_buf_len; p++) {
-                if (demod_buf_access[phase_idx][k] != accessAddrBits[p]) {
-                    unequal_flag = true;
-                    hit_idx = (-1);
-                    break;
-                }
-
-                accesssAddress = (accesssAddress & (~(1 << p))) | (demod_buf_access[phase_idx][k] << p);
-
-                k = ((k + 1) & (demod_buf_len - 1));
-            }
-
-            if (unequal_flag == false) {
-                hit_idx = (i + j - (demod_buf_len - 1) * SAMPLE_PER_SYMBOL);
-                break;
-            }
-        }
-
-        if (unequal_flag == false) {
-            break;
+void BTLERxProcessor::search(const size_t phase, const int32_t soft) {
+    auto& correlator = correlators[phase];
+    correlator.bits = (correlator.bits >> 1) | ((soft > 0 ? 1U : 0U) << 31);
+    correlator.soft[correlator.next] = soft;
+    correlator.next = (correlator.next + 1) % access_address_bits;
+
+    const auto errors = __builtin_popcount(correlator.bits ^ btle::advertising_access_address);
+    if (errors <= (int)access_address_max_errors) {
+        // Neighbouring phases usually match too, keep the strongest.
+        const auto score = correlate(correlator);
+        if (candidate_wait == 0 || score > candidate_score) {
+            candidate_phase = phase;
+            candidate_score = score;
         }
 
-        demod_buf_offset = ((demod_buf_offset + 1) & (demod_buf_len - 1));
+        if (candidate_wait == 0)
+            candidate_wait = samples_per_symbol;
     }
 
-    if (hit_idx == -1) {
-        // Process more samples.
-        return;
+    if (candidate_wait > 0 && --candidate_wait == 0) {
+        lock_phase = candidate_phase;
+        state = State::Receive;
+        pdu_size = 0;
+        pdu_expected = 0;
+        pdu_byte = 0;
+        pdu_bit = 0;
     }
-
-    symbols_eaten += hit_idx;
-
-    symbols_eaten += (8 * NUM_ACCESS_ADDR_BYTE * SAMPLE_PER_SYMBOL);  // move to the beginning of PDU header
-
-    num_symbol_left = num_symbol_left - symbols_eaten;
-
-    parseState = Parse_State_PDU_Header;
 }
 
-void BTLERxProcessor::handlePDUHeaderState() {
-    int num_demod_byte = 2;  // PDU header has 2 octets
-
-    symbols_eaten += 8 * num_demod_byte * SAMPLE_PER_SYMBOL;
+void BTLERxProcessor::reset_search() {
+    state = State::Search;
+    candidate_wait = 0;
+    for (auto& correlator : correlators)
+        correlator.bits = 0;
+}
 
-    if (symbols_eaten > (int)dst_buffer.count) {
+void BTLERxProcessor::receive_bit(const bool bit) {
+    pdu_byte |= bit << pdu_bit;
+    if (++pdu_bit < 8)
         return;
-    }
 
-    // Jump back down to the beginning of PDU header.
-    sample_idx = symbols_eaten - (8 * num_demod_byte * SAMPLE_PER_SYMBOL);
-
-    packet_index = 0;
-
-    for (int i = 0; i < num_demod_byte; i++) {
-        rb_buf[packet_index] = 0;
-
-        for (int j = 0; j < 8; j++) {
-            int I0 = dst_buffer.p[sample_idx].real();
-            int Q0 = dst_buffer.p[sample_idx].imag();
-            int I1 = dst_buffer.p[sample_idx + 1].real();
-            int Q1 = dst_buffer.p[sample_idx + 1].imag();
+    pdu[pdu_size++] = pdu_byte;
+    pdu_byte = 0;
+    pdu_bit = 0;
+    on_pdu_byte();
+}
 
-            bit_decision = (I0 * Q1 - I1 * Q0) > 0 ? 1 : 0;
-            rb_buf[packet_index] = rb_buf[packet_index] | (bit_decision << j);
+void BTLERxProcessor::on_pdu_byte() {
+    if (pdu_size == 2) {
+        uint8_t header[2] = {pdu[0], pdu[1]};
+        whitening.apply(header, sizeof(header));
 
-            sample_idx += SAMPLE_PER_SYMBOL;
+        // Not a valid advertising payload.
+        const size_t payload_len = header[1] & 0x3F;
+        if ((payload_len < 6) || (payload_len > 37)) {
+            reset_search();
+            return;
         }
 
-        packet_index++;
-    }
-
-    scramble_byte(rb_buf, num_demod_byte, scramble_table[channel_number], rb_buf);
-
-    pdu_type = (ADV_PDU_TYPE)(rb_buf[0] & 0x0F);
-    // uint8_t tx_add = ((rb_buf[0] & 0x40) != 0);
-    // uint8_t rx_add = ((rb_buf[0] & 0x80) != 0);
-    payload_len = (rb_buf[1] & 0x3F);
-
-    // Not a valid Advertise Payload.
-    if ((payload_len < 6) || (payload_len > 37)) {
-        parseState = Parse_State_Begin;
-        return;
-    } else {
-        parseState = Parse_State_PDU_Payload;
+        pdu_expected = 2 + payload_len + 3;
+    } else if (pdu_size == pdu_expected) {
+        whitening.apply(pdu.data(), pdu_size);
+        publish_packet();
+        reset_search();
     }
 }
 
-void BTLERxProcessor::handlePDUPayloadState() {
-    int i;
-    int num_demod_byte = (payload_len + 3);
-    symbols_eaten += 8 * num_demod_byte * SAMPLE_PER_SYMBOL;
+void BTLERxProcessor::publish_packet() {
+    const uint8_t pdu_type = pdu[0] & 0x0F;
+    const uint8_t payload_len = pdu[1] & 0x3F;
 
-    if (symbols_eaten > (int)dst_buffer.count) {
+    // Checking CRC and excluding Reserved PDU types.
+    if (pdu_type >= RESERVED0 ||
+        !btle::crc_valid(pdu.data(), payload_len + 2, crc_init) ||
+        verify_payload_byte(payload_len, (ADV_PDU_TYPE)pdu_type) != 0)
         return;
-    }
-
-    for (i = 0; i < num_demod_byte; i++) {
-        rb_buf[packet_index] = 0;
 
-        for (int j = 0; j < 8; j++) {
-            int I0 = dst_buffer.p[sample_idx].real();
-            int Q0 = dst_buffer.p[sample_idx].imag();
-            int I1 = dst_buffer.p[sample_idx + 1].real();
-            int Q1 = dst_buffer.p[sample_idx + 1].imag();
+    blePacketData.max_dB = max_dB;
 
-            bit_decision = (I0 * Q1 - I1 * Q0) > 0 ? 1 : 0;
-            rb_buf[packet_index] = rb_buf[packet_index] | (bit_decision << j);
+    blePacketData.type = pdu_type;
+    blePacketData.size = payload_len;
 
-            sample_idx += SAMPLE_PER_SYMBOL;
-        }
+    blePacketData.macAddress[0] = pdu[7];
+    blePacketData.macAddress[1] = pdu[6];
+    blePacketData.macAddress[2] = pdu[5];
+    blePacketData.macAddress[3] = pdu[4];
+    blePacketData.macAddress[4] = pdu[3];
+    blePacketData.macAddress[5] = pdu[2];
 
-        packet_index++;
+    // Skip Header Byte and MAC Address
+    int i;
+    for (i = 0; i < payload_len - 6; i++) {
+        blePacketData.data[i] = pdu[8 + i];
     }
 
-    scramble_byte(rb_buf + 2, num_demod_byte, scramble_table[channel_number] + 2, rb_buf + 2);
-
-    // Check CRC
-    bool crc_flag = crc_check(rb_buf, payload_len + 2, crc_init_internal);
-    // pkt_count++;
-
-    // This should be the flag that determines if the data should be sent to the application layer.
-    bool sendPacket = false;
-
-    // Checking CRC and excluding Reserved PDU types.
-    if (pdu_type < RESERVED0 && !crc_flag) {
-        if (verify_payload_byte(payload_len, (ADV_PDU_TYPE)pdu_type) == 0) {
-            sendPacket = true;
-        }
-
-        // TODO: Make this a packet builder function?
-        if (sendPacket) {
-            blePacketData.max_dB = max_dB;
+    blePacketData.dataLen = i;
+    blePacketData.sampleIndex = sample_index;
 
-            blePacketData.type = pdu_type;
-            blePacketData.size = payload_len;
+    BLEPacketMessage data_message{&blePacketData};
 
-            blePacketData.macAddress[0] = rb_buf[7];
-            blePacketData.macAddress[1] = rb_buf[6];
-            blePacketData.macAddress[2] = rb_buf[5];
-            blePacketData.macAddress[3] = rb_buf[4];
-            blePacketData.macAddress[4] = rb_buf[3];
-            blePacketData.macAddress[5] = rb_buf[2];
-
-            // Skip Header Byte and MAC Address
-            uint8_t startIndex = 8;
+    shared_memory.application_queue.push(data_message);
+}
 
-            for (i = 0; i < payload_len - 6; i++) {
-                blePacketData.data[i] = rb_buf[startIndex++];
-            }
+void BTLERxProcessor::demodulate(const buffer_c16_t& buffer) {
+    for (size_t i = 0; i < buffer.count; i++) {
+        const auto sample = buffer.p[i];
+        sample_index = (buffer.sample_index + i) * decim_0.decimation_factor;
+        const auto step = discriminate(last_sample, sample);
+        last_sample = sample;
 
-            blePacketData.dataLen = i;
+        // A symbol spans two phase steps, average them so each bit decision
+        // (and each correlator input) integrates the whole symbol.
+        const auto soft = (step + last_step) >> 1;
+        last_step = step;
 
-            BLEPacketMessage data_message{&blePacketData};
+        const auto phase = sample_phase;
+        sample_phase = (sample_phase + 1) % samples_per_symbol;
 
-            shared_memory.application_queue.push(data_message);
-        }
+        if (state == State::Search)
+            search(phase, soft);
+        else if (phase == lock_phase)
+            receive_bit(soft > 0);
     }
-
-    parseState = Parse_State_Begin;
 }
 
 void BTLERxProcessor::execute(const buffer_c8_t& buffer) {
@@ -344,25 +217,13 @@ void BTLERxProcessor::execute(const buffer_c8_t& buffer) {
     const float max_squared_f = max_squared;
     max_dB = mag2_to_dbv_norm(max_squared_f * (1.0f / (32768.0f * 32768.0f)));
 
-    // 4Mhz 2048 samples
-    // Decimated by 4 to achieve 2048/4 = 512 samples at 1 sample per symbol.
-    decim_0.execute(buffer, dst_buffer);
-    feed_channel_stats(dst_buffer);
-
-    symbols_eaten = 0;
+    // 8MHz 2048 samples
+    // Decimated by 4 to achieve 2048/4 = 512 samples at 2 samples per symbol.
+    // Packets may span buffers, the demodulator keeps its state.
+    const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
+    feed_channel_stats(decim_0_out);
 
-    // Handle parsing based on parseState
-    if (parseState == Parse_State_Begin) {
-        handleBeginState();
-    }
-
-    if (parseState == Parse_State_PDU_Header) {
-        handlePDUHeaderState();
-    }
-
-    if (parseState == Parse_State_PDU_Payload) {
-        handlePDUPayloadState();
-    }
+    demodulate(decim_0_out);
 }
 
 void BTLERxProcessor::on_message(const Message* const message) {
@@ -371,12 +232,11 @@ void BTLERxProcessor::on_message(const Message* const message) {
 }
 
 void BTLERxProcessor::configure(const BTLERxConfigureMessage& message) {
-    channel_number = message.channel_number;
-    decim_0.configure(taps_BTLE_1M_PHY_decim_0.taps);
+    whitening.configure(message.channel_number);
+    decim_0.configure(taps_BTLE_1M_PHY_decim_8M.taps);
+    reset_search();
 
     configured = true;
-
-    crc_init_internal = crc_init_reorder(crc_initalVale);
 }
 
 int main() {
@@ -26,10 +26,14 @@
 #include "event_m4.hpp"
 #include "utility.hpp"
 
+#include <algorithm>
+#include <cstdlib>
+
 using namespace dsp::decimate;
 
 CaptureProcessor::CaptureProcessor() {
     channel_spectrum.set_decimation_factor(1);
+    baseband_thread.set_ring(ring);
     baseband_thread.start();
 }
 
@@ -43,6 +47,9 @@ void CaptureProcessor::execute(const buffer_c8_t& buffer) {
         if (written != bytes_to_write) {
             // TODO: Send an error message to the app?
         }
+
+        update_time_marks(out_buffer);
+        update_peak(out_buffer);
     }
 
     feed_channel_stats(out_buffer);
@@ -55,6 +62,50 @@ void CaptureProcessor::execute(const buffer_c8_t& buffer) {
     }
 }
 
+void CaptureProcessor::update_time_marks(const buffer_c16_t& buffer) {
+    // The mark is for the sample after this buffer, which is where the
+    // buffer's RTC reading applies and where any dropped tail ends.
+    const uint64_t sample_index = buffer.sample_index + buffer.count;
+    const uint64_t stream_sample = stream->bytes_written() / sizeof(*buffer.p);
+    const uint64_t offset = sample_index - stream_sample;
+
+    const auto rtc = buffer.timestamp.tv_time;
+    const bool rtc_tick = (rtc != time_mark_rtc) && ((rtc & 0x3f) % 10 == 0);
+    time_mark_rtc = rtc;
+
+    if (time_marked && offset == time_mark_offset && !rtc_tick)
+        return;
+
+    stream->post_time_mark({stream_sample, sample_index, buffer.timestamp});
+    time_mark_offset = offset;
+    time_marked = true;
+}
+
+void CaptureProcessor::update_peak(const buffer_c16_t& buffer) {
+    int32_t peak = 0;
+    for (size_t i = 0; i < buffer.count; i++) {
+        peak = std::max<int32_t>(peak, std::abs(buffer.p[i].real()));
+        peak = std::max<int32_t>(peak, std::abs(buffer.p[i].imag()));
+    }
+
+    stream->post_peak(std::min<int32_t>(peak, INT16_MAX));
+}
+
+void CaptureProcessor::on_overrun(const uint64_t, const size_t samples_lost) {
+    if (!stream)
+        return;
+
+    // Fill the gap with silence so the file keeps its timing.
+    auto gap = samples_lost / (decim_0.decimation_factor() * decim_1.decimation_factor());
+    dst.fill({0, 0});
+    while (gap > 0) {
+        const auto bytes = std::min(gap, dst.size()) * sizeof(dst[0]);
+        if (stream->write(dst.data(), bytes) != bytes)
+            break;
+        gap -= bytes / sizeof(dst[0]);
+    }
+}
+
 void CaptureProcessor::on_signal_message(const RequestSignalMessage& message) {
     if (message.signal == RequestSignalMessage::Signal::BeepStopRequest) {
         audio::dma::beep_stop();
@@ -163,10 +214,12 @@ void CaptureProcessor::sample_rate_config(const SampleRateConfigMessage& message
 }
 
 void CaptureProcessor::capture_config(const CaptureConfigMessage& message) {
-    if (message.config)
+    if (message.config) {
         stream = std::make_unique<StreamInput>(message.config);
-    else
+        time_marked = false;
+    } else {
         stream.reset();
+    }
 }
 
 int main() {
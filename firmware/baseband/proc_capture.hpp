@@ -45,7 +45,7 @@ class NoopDecim {
     template <typename Buffer>
     Buffer execute(const Buffer& src, const Buffer&) {
         // TODO: should this copy to 'dst'?
-        return {src.p, src.count, src.sampling_rate};
+        return src;
     }
 };
 
@@ -91,10 +91,16 @@ class CaptureProcessor : public BasebandProcessor {
 
     void execute(const buffer_c8_t& buffer) override;
     void on_message(const Message* const message) override;
+    void on_overrun(const uint64_t sample_index, const size_t samples_lost) override;
 
    private:
+    /* Deeper than the default so waterfall FFTs and stream stalls don't drop samples. */
+    static constexpr baseband::dma::RingConfig ring{8, 2048};
+
     void on_signal_message(const RequestSignalMessage& message);
     void on_beep_message(const AudioBeepMessage& message);
+    void update_time_marks(const buffer_c16_t& buffer);
+    void update_peak(const buffer_c16_t& buffer);
 
     size_t baseband_fs = 3072000;  // aka: sample_rate
     static constexpr auto spectrum_rate_hz = 50.0f;
@@ -121,6 +127,11 @@ class CaptureProcessor : public BasebandProcessor {
 
     std::unique_ptr<StreamInput> stream{};
 
+    // Stream samples lag the sample counter by this much since the last mark.
+    uint64_t time_mark_offset = 0;
+    uint32_t time_mark_rtc = 0;
+    bool time_marked = false;
+
     SpectrumCollector channel_spectrum{};
     size_t spectrum_interval_samples = 0;
     size_t spectrum_samples = 0;
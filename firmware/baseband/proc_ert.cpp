@@ -26,44 +26,37 @@
 #include "portapack_shared_memory.hpp"
 
 #include "event_m4.hpp"
+#include "utility.hpp"
 
-float ERTProcessor::abs(const complex8_t& v) {
-    // const int16_t r = v.real() - offset_i;
-    // const int16_t i = v.imag() - offset_q;
-    // const uint32_t r2 = r * r;
-    // const uint32_t i2 = i * i;
-    // const uint32_t r2_i2 = r2 + i2;
-    // return std::sqrt(static_cast<float>(r2_i2));
-    const float r = static_cast<float>(v.real()) - offset_i;
-    const float i = static_cast<float>(v.imag()) - offset_q;
-    const float r2 = r * r;
-    const float i2 = i * i;
-    const float r2_i2 = r2 + i2;
-    return std::sqrt(r2_i2);
+int32_t ERTProcessor::abs(const complex8_t& v) const {
+    return fast_int_magnitude(v.imag() - offset_q, v.real() - offset_i);
 }
 
 void ERTProcessor::execute(const buffer_c8_t& buffer) {
     /* 4.194304MHz, 2048 samples */
 
-    const complex8_t* src = &buffer.p[0];
-    const complex8_t* const src_end = &buffer.p[buffer.count];
-
-    average_i += src->real();
-    average_q += src->imag();
+    average_i += buffer.p[0].real();
+    average_q += buffer.p[0].imag();
     average_count++;
     if (average_count == average_window) {
-        offset_i = static_cast<float>(average_i) / average_window;
-        offset_q = static_cast<float>(average_q) / average_window;
+        offset_i = average_i / static_cast<int32_t>(average_window);
+        offset_q = average_q / static_cast<int32_t>(average_window);
         average_i = 0;
         average_q = 0;
         average_count = 0;
     }
 
-    const float gain = 128 * samples_per_symbol;
-    const float k = 1.0f / gain;
+    burst_detector.execute(buffer, [this](const buffer_c8_t& burst) {
+        this->demodulate(burst);
+    });
+}
+
+void ERTProcessor::demodulate(const buffer_c8_t& buffer) {
+    const complex8_t* src = &buffer.p[0];
+    const complex8_t* const src_end = &buffer.p[buffer.count];
 
     while (src < src_end) {
-        float sum = 0.0f;
+        int32_t sum = 0;
         for (size_t i = 0; i < (samples_per_symbol / 2); i++) {
             sum += abs(*(src++));
         }
@@ -72,7 +65,7 @@ void ERTProcessor::execute(const buffer_c8_t& buffer) {
 
         sum_period[2] = sum_period[1];
         sum_period[1] = sum_period[0];
-        sum_period[0] = (sum_half_period[0] + sum_half_period[1]) * k;
+        sum_period[0] = sum_half_period[0] + sum_half_period[1];
 
         manchester[2] = manchester[1];
         manchester[1] = manchester[0];
@@ -80,13 +73,19 @@ void ERTProcessor::execute(const buffer_c8_t& buffer) {
 
         const auto data = manchester[0] - manchester[2];
 
+        // No decimation, the burst's index is already in baseband samples.
+        const auto sample_index = buffer.sample_index + (src - buffer.p);
+        scm_builder.set_sample_index(sample_index);
+        scmplus_builder.set_sample_index(sample_index);
+        idm_builder.set_sample_index(sample_index);
+
         clock_recovery(data);
     }
 }
 
 void ERTProcessor::consume_symbol(
-    const float raw_symbol) {
-    const uint_fast8_t sliced_symbol = (raw_symbol >= 0.0f) ? 1 : 0;
+    const int32_t raw_symbol) {
+    const auto sliced_symbol = slicer(raw_symbol);
     scm_builder.execute(sliced_symbol);
     scmplus_builder.execute(sliced_symbol);
     idm_builder.execute(sliced_symbol);
@@ -94,18 +93,27 @@ void ERTProcessor::consume_symbol(
 
 void ERTProcessor::scm_handler(
     const baseband::Packet& packet) {
+    if (!symbol_coding::is_manchester(packet))
+        return;
+
     const ERTPacketMessage message{ert::Packet::Type::SCM, packet};
     shared_memory.application_queue.push(message);
 }
 
 void ERTProcessor::scmplus_handler(
     const baseband::Packet& packet) {
+    if (!symbol_coding::is_manchester(packet))
+        return;
+
     const ERTPacketMessage message{ert::Packet::Type::SCMPLUS, packet};
     shared_memory.application_queue.push(message);
 }
 
 void ERTProcessor::idm_handler(
     const baseband::Packet& packet) {
+    if (!symbol_coding::is_manchester(packet))
+        return;
+
     const ERTPacketMessage message{ert::Packet::Type::IDM, packet};
     shared_memory.application_queue.push(message);
 }
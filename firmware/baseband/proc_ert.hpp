@@ -28,6 +28,7 @@
 #include "rssi_thread.hpp"
 
 #include "channel_decimator.hpp"
+#include "burst_detector.hpp"
 
 #include "clock_recovery.hpp"
 #include "symbol_coding.hpp"
@@ -36,25 +37,11 @@
 
 #include "message.hpp"
 
+#include <array>
 #include <cstdint>
 #include <cstddef>
 #include <bitset>
 
-// ''.join(['%d%d' % (c, 1-c) for c in map(int, bin(0x1f2a60)[2:].zfill(21))])
-constexpr uint64_t scm_preamble_and_sync_manchester{0b101010101001011001100110010110100101010101};
-constexpr size_t scm_preamble_and_sync_length{42 - 10};
-constexpr size_t scm_payload_length_max{150};
-
-// ''.join(['%d%d' % (c, 1-c) for c in map(int, bin(0x16a3)[2:].zfill(16))])
-constexpr uint64_t scmplus_preamble_and_sync_manchester{0b01010110011010011001100101011010};
-constexpr size_t scmplus_preamble_and_sync_length{32 - 0};
-constexpr size_t scmplus_payload_length_max{224};
-
-// ''.join(['%d%d' % (c, 1-c) for c in map(int, bin(0x555516a3)[2:].zfill(32))])
-constexpr uint64_t idm_preamble_and_sync_manchester{0b0110011001100110011001100110011001010110011010011001100101011010};
-constexpr size_t idm_preamble_and_sync_length{64 - 16};
-constexpr size_t idm_payload_length_max{1408};
-
 class ERTProcessor : public BasebandProcessor {
    public:
     void execute(const buffer_c8_t& buffer) override;
@@ -68,59 +55,66 @@ class ERTProcessor : public BasebandProcessor {
     const size_t samples_per_symbol = channel_sampling_rate / symbol_rate;
     const float clock_recovery_rate = symbol_rate * 2;
 
-    clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> clock_recovery{
+    // The Manchester energy detector is all integer, so is its timing.
+    clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter, clock_recovery::GardnerTimingErrorDetector<int32_t>> clock_recovery{
         clock_recovery_rate,
         symbol_rate,
         {1.0f / 18.0f},
-        [this](const float symbol) { this->consume_symbol(symbol); }};
+        [this](const int32_t symbol) { this->consume_symbol(symbol); }};
+    symbol_coding::BasicSlicer<int32_t> slicer{};
+
+    // Lead-in is a whole number of half symbols, as demodulate() expects.
+    // Bursts end after 2ms without signal.
+    BurstDetector<complex8_t, 256> burst_detector{8192, 4194304};
 
     PacketBuilder<BitPattern, NeverMatch, FixedLength> scm_builder{
-        {scm_preamble_and_sync_manchester, scm_preamble_and_sync_length, 1},
+        {ert::scm_preamble_and_sync_manchester, ert::scm_preamble_and_sync_length, 1},
         {},
-        {scm_payload_length_max},
+        {ert::scm_payload_length_max},
         [this](const baseband::Packet& packet) {
             this->scm_handler(packet);
         }};
 
     PacketBuilder<BitPattern, NeverMatch, FixedLength> scmplus_builder{
-        {scmplus_preamble_and_sync_manchester, scmplus_preamble_and_sync_length, 1},
+        {ert::scmplus_preamble_and_sync_manchester, ert::scmplus_preamble_and_sync_length, 1},
         {},
-        {scmplus_payload_length_max},
+        {ert::scmplus_payload_length_max},
         [this](const baseband::Packet& packet) {
             this->scmplus_handler(packet);
         }};
 
     PacketBuilder<BitPattern, NeverMatch, FixedLength> idm_builder{
-        {idm_preamble_and_sync_manchester, idm_preamble_and_sync_length, 1},
+        {ert::idm_preamble_and_sync_manchester, ert::idm_preamble_and_sync_length, 1},
         {},
-        {idm_payload_length_max},
+        {ert::idm_payload_length_max},
         [this](const baseband::Packet& packet) {
             this->idm_handler(packet);
         }};
 
-    void consume_symbol(const float symbol);
+    void demodulate(const buffer_c8_t& buffer);
+    void consume_symbol(const int32_t symbol);
     void scm_handler(const baseband::Packet& packet);
     void scmplus_handler(const baseband::Packet& packet);
     void idm_handler(const baseband::Packet& packet);
     void on_message(const Message* const msg);
     void on_beep_message(const AudioBeepMessage& message);
 
-    float sum_half_period[2];
-    float sum_period[3];
-    float manchester[3];
+    std::array<int32_t, 2> sum_half_period{};
+    std::array<int32_t, 3> sum_period{};
+    std::array<int32_t, 3> manchester{};
 
     const size_t average_window{2048};
     int32_t average_i{0};
     int32_t average_q{0};
     size_t average_count{0};
-    float offset_i{0.0f};
-    float offset_q{0.0f};
+    int32_t offset_i{0};
+    int32_t offset_q{0};
 
     /* NB: Threads should be the last members in the class definition. */
     BasebandThread baseband_thread{baseband_sampling_rate, this, baseband::Direction::Receive};
     RSSIThread rssi_thread{};
 
-    float abs(const complex8_t& v);
+    int32_t abs(const complex8_t& v) const;
 };
 
 #endif /*__PROC_ERT_H__*/
@@ -69,7 +69,7 @@ class NoopDecim {
     template <typename Buffer>
     Buffer execute(const Buffer& src, const Buffer&) {
         // TODO: should this copy to 'dst'?
-        return {src.p, src.count, src.sampling_rate};
+        return src;
     }
 };
 
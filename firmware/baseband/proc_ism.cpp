@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "proc_ism.hpp"
+
+#include "portapack_shared_memory.hpp"
+
+#include "dsp_fir_taps.hpp"
+
+#include "event_m4.hpp"
+#include "utility.hpp"
+
+uint64_t ISMProcessor::pulse_sample_index = 0;
+
+ISMProcessor::ISMProcessor() {
+    decim_0.configure(taps_200k_decim_0.taps);
+    decim_1.configure(taps_200k_decim_1.taps);
+
+    pulse_estimator.configure(1'000'000'000 / channel_fs);
+    weather_protos.setCallback(weather_callback);
+    subghzd_protos.setCallback(subghzd_callback);
+
+    baseband_thread.start();
+}
+
+void ISMProcessor::execute(const buffer_c8_t& buffer) {
+    /* 4.194304MHz, 2048 samples */
+
+    const auto decim_0_out = decim_0.execute(buffer, dst_buffer);
+    const auto decimator_out = decim_1.execute(decim_0_out, dst_buffer);
+
+    /* 524.288kHz, 256 samples */
+    feed_channel_stats(decimator_out);
+
+    if (enabled(ism::Protocol::Weather) || enabled(ism::Protocol::SubGhzD)) {
+        pulse_sample_index = (decimator_out.sample_index + decimator_out.count) * decimation_factor;
+        pulse_estimator.execute(decimator_out, [this](const bool level, const uint32_t duration) {
+            if (this->enabled(ism::Protocol::Weather))
+                this->weather_protos.feed(level, duration);
+            if (this->enabled(ism::Protocol::SubGhzD))
+                this->subghzd_protos.feed(level, duration);
+        });
+    }
+
+    if (enabled(ism::Protocol::TPMS) || enabled(ism::Protocol::ERT)) {
+        burst_detector.execute(decimator_out, [this](const buffer_c16_t& burst) {
+            this->demodulate_burst(burst);
+        });
+    }
+}
+
+void ISMProcessor::demodulate_burst(const buffer_c16_t& buffer) {
+    if (enabled(ism::Protocol::TPMS))
+        demodulate_tpms(buffer);
+    if (enabled(ism::Protocol::ERT))
+        demodulate_ert(buffer);
+}
+
+void ISMProcessor::demodulate_tpms(const buffer_c16_t& buffer) {
+    for (size_t i = 0; i < buffer.count; i++) {
+        const auto sample_index = (buffer.sample_index + i) * decimation_factor;
+        tpms_fsk_19k2_schrader.set_sample_index(sample_index);
+        tpms_ook_8k192_schrader.set_sample_index(sample_index);
+        tpms_ook_8k4_schrader.set_sample_index(sample_index);
+
+        if (tpms_fsk_mf.execute_once(buffer.p[i])) {
+            tpms_fsk_19k2_clock_recovery(tpms_fsk_mf.get_output());
+        }
+
+        if (++tpms_ook_phase < tpms_ook_decimation)
+            continue;
+        tpms_ook_phase = 0;
+
+        tpms_ook_history = (tpms_ook_history << 1) | tpms_ook_slicer(buffer.p[i]);
+
+        tpms_ook_8k192_clock_recovery(tpms_ook_history, [this](const bool symbol) {
+            this->tpms_ook_8k192_schrader.execute(symbol);
+        });
+        tpms_ook_8k4_clock_recovery(tpms_ook_history, [this](const bool symbol) {
+            this->tpms_ook_8k4_schrader.execute(symbol);
+        });
+    }
+}
+
+void ISMProcessor::demodulate_ert(const buffer_c16_t& buffer) {
+    // Same Manchester energy detector as ERTProcessor, on the channel
+    // instead of the raw samples so there's no DC offset to remove.
+    for (size_t i = 0; i < buffer.count; i++) {
+        ert_sum += fast_int_magnitude(buffer.p[i].imag(), buffer.p[i].real());
+
+        if (++ert_sum_count < ert_half_symbol)
+            continue;
+
+        ert_sum_half_period[1] = ert_sum_half_period[0];
+        ert_sum_half_period[0] = ert_sum;
+        ert_sum = 0;
+        ert_sum_count = 0;
+
+        ert_sum_period[2] = ert_sum_period[1];
+        ert_sum_period[1] = ert_sum_period[0];
+        ert_sum_period[0] = ert_sum_half_period[0] + ert_sum_half_period[1];
+
+        ert_manchester[2] = ert_manchester[1];
+        ert_manchester[1] = ert_manchester[0];
+        ert_manchester[0] = ert_sum_period[2] - ert_sum_period[0];
+
+        const auto sample_index = (buffer.sample_index + i) * decimation_factor;
+        ert_scm.set_sample_index(sample_index);
+        ert_scmplus.set_sample_index(sample_index);
+        ert_idm.set_sample_index(sample_index);
+
+        ert_clock_recovery(ert_manchester[0] - ert_manchester[2]);
+    }
+}
+
+void ISMProcessor::ert_symbol(const int32_t raw_symbol) {
+    const auto sliced_symbol = ert_slicer(raw_symbol);
+    ert_scm.execute(sliced_symbol);
+    ert_scmplus.execute(sliced_symbol);
+    ert_idm.execute(sliced_symbol);
+}
+
+void ISMProcessor::weather_callback(FProtoWeatherBase* instance) {
+    ISMPacketMessage message{ism::Protocol::Weather, instance->getSensorType(), 0, instance->getData()};
+    message.packet.set_sample_index(pulse_sample_index);
+    shared_memory.application_queue.push(message);
+}
+
+void ISMProcessor::subghzd_callback(FProtoSubGhzDBase* instance) {
+    ISMPacketMessage message{ism::Protocol::SubGhzD, instance->sensorType, instance->data_count_bit, instance->decode_data};
+    message.packet.set_sample_index(pulse_sample_index);
+    shared_memory.application_queue.push(message);
+}
+
+void ISMProcessor::on_message(const Message* const message) {
+    if (message->id == Message::ID::ISMConfigure)
+        configure(*reinterpret_cast<const ISMConfigureMessage*>(message));
+}
+
+void ISMProcessor::configure(const ISMConfigureMessage& message) {
+    decoders = message.decoders;
+    burst_detector.reset();
+}
+
+int main() {
+    EventDispatcher event_dispatcher{std::make_unique<ISMProcessor>()};
+    event_dispatcher.run();
+    return 0;
+}
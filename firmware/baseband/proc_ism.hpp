@@ -0,0 +1,232 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __PROC_ISM_H__
+#define __PROC_ISM_H__
+
+#include "baseband_processor.hpp"
+#include "baseband_thread.hpp"
+#include "rssi_thread.hpp"
+
+#include "dsp_decimate.hpp"
+#include "dsp_window.hpp"
+#include "matched_filter.hpp"
+#include "burst_detector.hpp"
+#include "ook_pulse_estimator.hpp"
+
+#include "clock_recovery.hpp"
+#include "symbol_coding.hpp"
+#include "packet_builder.hpp"
+#include "baseband_packet.hpp"
+#include "ook.hpp"
+
+#include "message.hpp"
+
+#include "fprotos/weatherprotos.hpp"
+
+#pragma GCC push_options
+#pragma GCC optimize("Os")
+#include "fprotos/subghzdprotos.hpp"
+#pragma GCC pop_options
+
+#include <array>
+#include <complex>
+#include <cstdint>
+#include <cstddef>
+
+/* Translate+rectangular filter, one symbol long, for an FSK tone at
+ * +deviation. Same shape as rect_taps_307k2_38k4_1t_19k2_p. */
+template <size_t N>
+constexpr std::array<std::complex<float>, N> make_translate_taps(const double fs, const double deviation) {
+    constexpr double pi = 3.14159265358979323846;
+    std::array<std::complex<float>, N> taps{};
+    for (size_t n = 0; n < N; n++) {
+        const double x = 2.0 * pi * deviation * n / fs;
+        taps[n] = {static_cast<float>(dsp::window::cos(x) / N),
+                   static_cast<float>(dsp::window::cos(x - pi / 2) / N)};
+    }
+    return taps;
+}
+
+/* Runs the TPMS, ERT, weather station and SubGhzD decoders together on
+ * one channel, so a single receiver catches all of them. The channel is
+ * decimated once and fanned out. The pulse decoders are cheap and see
+ * every sample. The TPMS and ERT demodulators only run during bursts. */
+class ISMProcessor : public BasebandProcessor {
+   public:
+    ISMProcessor();
+
+    void execute(const buffer_c8_t& buffer) override;
+    void on_message(const Message* const message) override;
+
+   private:
+    static constexpr size_t baseband_fs = 4194304;
+    static constexpr size_t decimation_factor =
+        dsp::decimate::FIRC8xR16x24FS4Decim4::decimation_factor *
+        dsp::decimate::FIRC16xR16x16Decim2::decimation_factor;
+    static constexpr uint32_t channel_fs = baseband_fs / decimation_factor;
+
+    std::array<complex16_t, 512> dst{};
+    const buffer_c16_t dst_buffer{
+        dst.data(),
+        dst.size()};
+
+    dsp::decimate::FIRC8xR16x24FS4Decim4 decim_0{};
+    dsp::decimate::FIRC16xR16x16Decim2 decim_1{};
+
+    uint8_t decoders{ism::all_decoders};
+
+    // Lead-in covers the matched filter and a few ERT half symbols.
+    // Bursts end after 5ms without signal.
+    BurstDetector<complex16_t, 64> burst_detector{2624, channel_fs};
+
+    /* TPMS, same packets as TPMSProcessor ***********************************/
+
+    static constexpr size_t tpms_fsk_decimation = 8;
+    static constexpr uint32_t tpms_fsk_fs = channel_fs / tpms_fsk_decimation;
+    static constexpr size_t tpms_ook_decimation = 4;
+    static constexpr uint32_t tpms_ook_fs = channel_fs / tpms_ook_decimation;
+
+    static constexpr auto tpms_fsk_taps = make_translate_taps<27>(channel_fs, 38400);
+    dsp::matched_filter::MatchedFilter<27> tpms_fsk_mf{tpms_fsk_taps, tpms_fsk_decimation};
+    symbol_coding::Slicer tpms_fsk_slicer{};
+
+    clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> tpms_fsk_19k2_clock_recovery{
+        tpms_fsk_fs,
+        19200,
+        {0.0555f},
+        [this](const float raw_symbol) {
+            this->tpms_fsk_19k2_schrader.execute(this->tpms_fsk_slicer(raw_symbol));
+        }};
+    PacketBuilder<BitPattern, NeverMatch, FixedLength> tpms_fsk_19k2_schrader{
+        {0b010101010101010101010101010110, 30, 1},
+        {},
+        {160},
+        [](const baseband::Packet& packet) {
+            const ISMPacketMessage message{tpms::SignalType::FSK_19k2_Schrader, packet};
+            shared_memory.application_queue.push(message);
+        }};
+
+    OOKSlicerMagSquaredInt tpms_ook_slicer{tpms_ook_fs / 8400 + 1};
+    uint32_t tpms_ook_history{0};
+    size_t tpms_ook_phase{0};
+
+    OOKClockRecovery tpms_ook_8k192_clock_recovery{tpms_ook_fs / 8192.0f};
+    PacketBuilder<BitPattern, NeverMatch, FixedLength> tpms_ook_8k192_schrader{
+        {0b010101010101010101011110, 24, 0},
+        {},
+        {37 * 2},
+        [](const baseband::Packet& packet) {
+            const ISMPacketMessage message{tpms::SignalType::OOK_8k192_Schrader, packet};
+            shared_memory.application_queue.push(message);
+        }};
+
+    OOKClockRecovery tpms_ook_8k4_clock_recovery{tpms_ook_fs / 8400.0f};
+    PacketBuilder<BitPattern, NeverMatch, FixedLength> tpms_ook_8k4_schrader{
+        {0b01010101010101010101010101100101, 32, 0},
+        {},
+        {76 * 2},
+        [](const baseband::Packet& packet) {
+            const ISMPacketMessage message{tpms::SignalType::OOK_8k4_Schrader, packet};
+            shared_memory.application_queue.push(message);
+        }};
+
+    /* ERT ******************************************************************/
+
+    static constexpr uint32_t ert_symbol_rate = 32768;
+    static constexpr size_t ert_half_symbol = channel_fs / ert_symbol_rate / 2;
+
+    int32_t ert_sum{0};
+    size_t ert_sum_count{0};
+    std::array<int32_t, 2> ert_sum_half_period{};
+    std::array<int32_t, 3> ert_sum_period{};
+    std::array<int32_t, 3> ert_manchester{};
+    symbol_coding::BasicSlicer<int32_t> ert_slicer{};
+
+    clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter, clock_recovery::GardnerTimingErrorDetector<int32_t>> ert_clock_recovery{
+        ert_symbol_rate * 2,
+        ert_symbol_rate,
+        {1.0f / 18.0f},
+        [this](const int32_t symbol) { this->ert_symbol(symbol); }};
+
+    PacketBuilder<BitPattern, NeverMatch, FixedLength> ert_scm{
+        {ert::scm_preamble_and_sync_manchester, ert::scm_preamble_and_sync_length, 1},
+        {},
+        {ert::scm_payload_length_max},
+        [](const baseband::Packet& packet) {
+            if (!symbol_coding::is_manchester(packet))
+                return;
+            const ISMPacketMessage message{ert::Packet::Type::SCM, packet};
+            shared_memory.application_queue.push(message);
+        }};
+
+    PacketBuilder<BitPattern, NeverMatch, FixedLength> ert_scmplus{
+        {ert::scmplus_preamble_and_sync_manchester, ert::scmplus_preamble_and_sync_length, 1},
+        {},
+        {ert::scmplus_payload_length_max},
+        [](const baseband::Packet& packet) {
+            if (!symbol_coding::is_manchester(packet))
+                return;
+            const ISMPacketMessage message{ert::Packet::Type::SCMPLUS, packet};
+            shared_memory.application_queue.push(message);
+        }};
+
+    PacketBuilder<BitPattern, NeverMatch, FixedLength> ert_idm{
+        {ert::idm_preamble_and_sync_manchester, ert::idm_preamble_and_sync_length, 1},
+        {},
+        {ert::idm_payload_length_max},
+        [](const baseband::Packet& packet) {
+            if (!symbol_coding::is_manchester(packet))
+                return;
+            const ISMPacketMessage message{ert::Packet::Type::IDM, packet};
+            shared_memory.application_queue.push(message);
+        }};
+
+    /* Weather and SubGhzD **************************************************/
+
+    OOKPulseEstimator pulse_estimator{};
+    WeatherProtos weather_protos{};
+    SubGhzDProtos subghzd_protos{};
+
+    bool enabled(const ism::Protocol protocol) const {
+        return decoders & ism::decoder_bit(protocol);
+    }
+
+    void demodulate_burst(const buffer_c16_t& buffer);
+    void demodulate_tpms(const buffer_c16_t& buffer);
+    void demodulate_ert(const buffer_c16_t& buffer);
+    void ert_symbol(const int32_t raw_symbol);
+    void configure(const ISMConfigureMessage& message);
+
+    // The pulse decoders don't report where a packet ended, so their
+    // packets are stamped with the end of the buffer they completed in.
+    static uint64_t pulse_sample_index;
+
+    static void weather_callback(FProtoWeatherBase* instance);
+    static void subghzd_callback(FProtoSubGhzDBase* instance);
+
+    /* NB: Threads should be the last members in the class definition. */
+    BasebandThread baseband_thread{
+        baseband_fs, this, baseband::Direction::Receive, /*auto_start*/ false};
+    RSSIThread rssi_thread{};
+};
+
+#endif /*__PROC_ISM_H__*/
@@ -300,6 +300,9 @@ void CodewordExtractor::pad_idle() {
 void POCSAGProcessor::execute(const buffer_c8_t& buffer) {
     if (!configured) return;
 
+    // Batches complete while this buffer's bits are extracted.
+    buffer_end_index = buffer.sample_index + buffer.count;
+
     // buffer has 2048 samples
     // decim0 out: 2048/8 = 256 samples
     // decim1 out: 256/8 = 32 samples
@@ -411,6 +414,7 @@ void POCSAGProcessor::send_stats() const {
 void POCSAGProcessor::send_packet() {
     packet.set_flag(pocsag::PacketFlag::NORMAL);
     packet.set_timestamp(Timestamp::now());
+    packet.set_sample_index(buffer_end_index);
     packet.set_bitrate(bit_extractor.baud_rate());
     packet.set(word_extractor.batch());
 
@@ -252,6 +252,9 @@ class POCSAGProcessor : public BasebandProcessor {
     /* Holds the data sent to the app. */
     pocsag::POCSAGPacket packet{};
 
+    /* Baseband sample after the buffer being decoded, stamped on packets. */
+    uint64_t buffer_end_index = 0;
+
     /* Used to keep track of how many samples were processed
      * between status update messages. */
     uint32_t samples_processed = 0;
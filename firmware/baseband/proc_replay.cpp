@@ -54,14 +54,11 @@ void ReplayProcessor::execute(const buffer_c8_t& buffer) {
     // Wrap the IQ data array in a buffer with the correct sample_rate.
     buffer_c16_t iq_buffer{iq.data(), iq.size(), baseband_fs / interpolation_factor};
 
-    // The IQ data in stream is C16 format and needs to be converted to C8 (N * 2).
-    // The data also needs to be interpolated so the effective sample rate is closer
-    // to 4Mhz. Because interpolation repeats a sample multiple times, fewer bytes
-    // are needed from the source stream in order to fill the buffer (count / oversample).
-    // Together the C16->C8 conversion and the interpolation give the number of
-    // bytes that need to be read from the source stream.
+    // The IQ data in stream is C16 or C8 and is interpolated to C8 at the
+    // baseband rate, so only count / oversample samples are read per buffer.
+    const size_t sample_size = c8 ? sizeof(buffer_c8_t::Type) : sizeof(buffer_c16_t::Type);
     const size_t samples_to_read = buffer.count / interpolation_factor;
-    const size_t bytes_to_read = samples_to_read * sizeof(buffer_c16_t::Type);
+    const size_t bytes_to_read = samples_to_read * sample_size;
 
 #if BUFFER_SIZE_ASSERT
     // Verify the output buffer size is divisible by the interpolation factor.
@@ -73,30 +70,17 @@ void ReplayProcessor::execute(const buffer_c8_t& buffer) {
         chDbgPanic("IQ buf ovf.");
 #endif
 
-    // Read the C16 IQ data from the source stream.
+    // Read the IQ data from the source stream.
     size_t current_bytes_read = stream->read(iq_buffer.p, bytes_to_read);
 
     // Compute the number of samples were actually read from the source.
-    size_t samples_read = current_bytes_read / sizeof(buffer_c16_t::Type);
+    size_t samples_read = current_bytes_read / sample_size;
 
-    // Write converted source samples to the output buffer with interpolation.
-    for (auto i = 0u; i < samples_read; ++i) {
-        int8_t re_out = iq_buffer.p[i].real() >> 8;
-        int8_t im_out = iq_buffer.p[i].imag() >> 8;
-        auto out_value = buffer_c8_t::Type{re_out, im_out};
-
-        // Interpolate sample.
-        for (auto j = 0u; j < interpolation_factor; ++j) {
-            size_t index = i * interpolation_factor + j;
-            buffer.p[index] = out_value;
-
-#if BUFFER_SIZE_ASSERT
-            // Verify the index is within bounds.
-            if (index >= buffer.count)
-                chDbgPanic("Output bounds");
-#endif
-        }
-    }
+    auto iq_c8 = reinterpret_cast<complex8_t*>(iq_buffer.p);
+    if (c8)
+        interpolator.execute(buffer_c8_t{iq_c8, samples_read, iq_buffer.sampling_rate}, buffer);
+    else
+        interpolator.execute({iq_buffer.p, samples_read, iq_buffer.sampling_rate}, buffer);
 
     // Update tracking stats.
     bytes_read += current_bytes_read;
@@ -104,6 +88,13 @@ void ReplayProcessor::execute(const buffer_c8_t& buffer) {
 
     if (spectrum_samples >= spectrum_interval_samples) {
         spectrum_samples -= spectrum_interval_samples;
+
+        // Only widened for the spectrum, back to front as it's in place.
+        if (c8) {
+            for (size_t i = samples_read; i-- > 0;)
+                iq_buffer.p[i] = {static_cast<int16_t>(iq_c8[i].real() * 256), static_cast<int16_t>(iq_c8[i].imag() * 256)};
+        }
+
         channel_spectrum.feed(
             iq_buffer, channel_filter_low_f,
             channel_filter_high_f, channel_filter_transition);
@@ -126,6 +117,10 @@ void ReplayProcessor::on_message(const Message* const message) {
             sample_rate_config(*reinterpret_cast<const SampleRateConfigMessage*>(message));
             break;
 
+        case Message::ID::ReplayGainConfig:
+            replay_gain_config(*reinterpret_cast<const ReplayGainConfigMessage*>(message));
+            break;
+
         case Message::ID::ReplayConfig:
             configured = false;
             bytes_read = 0;
@@ -148,10 +143,20 @@ void ReplayProcessor::sample_rate_config(const SampleRateConfigMessage& message)
     baseband_thread.set_sampling_rate(baseband_fs);
 
     spectrum_interval_samples = baseband_fs / spectrum_rate_hz;
+
+    interpolator.configure(
+        toUType(oversample_rate),
+        dsp::interpolate::PolyphaseInterpolator::taps_for_budget(baseband_fs, interpolator_cycle_budget));
+}
+
+void ReplayProcessor::replay_gain_config(const ReplayGainConfigMessage& message) {
+    interpolator.set_peak(message.peak);
+    interpolator.set_dither(message.dither);
 }
 
 void ReplayProcessor::replay_config(const ReplayConfigMessage& message) {
     if (message.config) {
+        c8 = message.config->c8;
         stream = std::make_unique<StreamOutput>(message.config);
 
         // Tell application that the buffers and FIFO pointers are ready, prefill
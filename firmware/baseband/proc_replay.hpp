@@ -26,6 +26,7 @@
 #include "baseband_processor.hpp"
 #include "baseband_thread.hpp"
 
+#include "dsp_interpolate.hpp"
 #include "spectrum_collector.hpp"
 
 #include "stream_output.hpp"
@@ -45,8 +46,17 @@ class ReplayProcessor : public BasebandProcessor {
     static constexpr auto spectrum_rate_hz = 50.0f;
 
     // Holds the read IQ data chunk from the file to send.
+    // C8 streams use the front of it as complex8_t.
     std::array<complex16_t, 512> iq{};
 
+    // M4 cycles per second given to interpolation, about 30% of the
+    // 200 MHz core. By the cycles_per_output() estimate this buys 4 taps
+    // per phase at 4 MHz and 8 up to 3 MHz. The estimate is unmeasured,
+    // a known limitation: check the M4 load in the DFU menu on hardware
+    // before raising the budget.
+    static constexpr uint32_t interpolator_cycle_budget = 60'000'000;
+    dsp::interpolate::PolyphaseInterpolator interpolator{};
+
     int32_t channel_filter_low_f = 0;
     int32_t channel_filter_high_f = 0;
     int32_t channel_filter_transition = 0;
@@ -58,11 +68,13 @@ class ReplayProcessor : public BasebandProcessor {
     size_t spectrum_samples = 0;
 
     bool configured{false};
+    bool c8{false};
     uint32_t bytes_read{0};
     OversampleRate oversample_rate = OversampleRate::x8;
 
     void sample_rate_config(const SampleRateConfigMessage& message);
     void replay_config(const ReplayConfigMessage& message);
+    void replay_gain_config(const ReplayGainConfigMessage& message);
 
     TXProgressMessage txprogress_message{};
     RequestSignalMessage sig_message{RequestSignalMessage::Signal::FillRequest};
@@ -46,8 +46,18 @@ void SondeProcessor::execute(const buffer_c8_t& buffer) {
     /* 38.4kHz, 32 samples */
     feed_channel_stats(decimator_out);
 
-    for (size_t i = 0; i < decimator_out.count; i++) {
-        if (mf.execute_once(decimator_out.p[i])) {
+    burst_detector.execute(decimator_out, [this](const buffer_c16_t& burst) {
+        this->demodulate(burst);
+    });
+}
+
+void SondeProcessor::demodulate(const buffer_c16_t& buffer) {
+    for (size_t i = 0; i < buffer.count; i++) {
+        const auto sample_index = (buffer.sample_index + i) * decimation_factor;
+        packet_builder_fsk_9600_Meteomodem.set_sample_index(sample_index);
+        packet_builder_fsk_4800_Vaisala.set_sample_index(sample_index);
+
+        if (mf.execute_once(buffer.p[i])) {
             clock_recovery_fsk_9600(mf.get_output());
             clock_recovery_fsk_4800(mf.get_output());
         }
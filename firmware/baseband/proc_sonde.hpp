@@ -80,6 +80,7 @@
 
 #include "channel_decimator.hpp"
 #include "matched_filter.hpp"
+#include "burst_detector.hpp"
 
 #include "clock_recovery.hpp"
 #include "symbol_coding.hpp"
@@ -127,7 +128,17 @@ class SondeProcessor : public BasebandProcessor {
 
     dsp::decimate::FIRC8xR16x24FS4Decim8 decim_0{};
     dsp::decimate::FIRC16xR16x32Decim8 decim_1{};
-    dsp::matched_filter::MatchedFilter mf{baseband::ais::square_taps_38k4_1t_p, 2};
+    static constexpr size_t decimation_factor =
+        dsp::decimate::FIRC8xR16x24FS4Decim8::decimation_factor *
+        dsp::decimate::FIRC16xR16x32Decim8::decimation_factor;
+
+    // A frame lasts up to ~0.6s, the sondes are quiet in between.
+    BurstDetector<complex16_t, 32> burst_detector{768, 38400};
+
+    dsp::matched_filter::MatchedFilter<4> mf{baseband::ais::square_taps_38k4_1t_p, 2};
+
+    symbol_coding::Slicer slicer_fsk_9600{};
+    symbol_coding::Slicer slicer_fsk_4800{};
 
     // Actually 4800bits/s but the Manchester coding doubles the symbol rate
     clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> clock_recovery_fsk_9600{
@@ -135,7 +146,7 @@ class SondeProcessor : public BasebandProcessor {
         9600,
         {0.0555f},
         [this](const float raw_symbol) {
-            const uint_fast8_t sliced_symbol = (raw_symbol >= 0.0f) ? 1 : 0;
+            const auto sliced_symbol = this->slicer_fsk_9600(raw_symbol);
             this->packet_builder_fsk_9600_Meteomodem.execute(sliced_symbol);
         }};
     PacketBuilder<BitPattern, NeverMatch, FixedLength> packet_builder_fsk_9600_Meteomodem{
@@ -152,7 +163,7 @@ class SondeProcessor : public BasebandProcessor {
         4800,
         {0.0555f},
         [this](const float raw_symbol) {
-            const uint_fast8_t sliced_symbol = (raw_symbol >= 0.0f) ? 1 : 0;
+            const auto sliced_symbol = this->slicer_fsk_4800(raw_symbol);
             this->packet_builder_fsk_4800_Vaisala.execute(sliced_symbol);
         }};
     PacketBuilder<BitPattern, NeverMatch, FixedLength> packet_builder_fsk_4800_Vaisala{
@@ -170,6 +181,7 @@ class SondeProcessor : public BasebandProcessor {
         baseband_fs, this, baseband::Direction::Receive, /*auto_start*/ false};
     RSSIThread rssi_thread{};
 
+    void demodulate(const buffer_c16_t& buffer);
     void on_signal_message(const RequestSignalMessage& message);
     void on_beep_message(const AudioBeepMessage& message);
     void on_pitch_rssi_config(const PitchRSSIConfigureMessage& message);
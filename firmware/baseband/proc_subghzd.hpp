@@ -31,34 +31,20 @@
 #include "rssi_thread.hpp"
 #include "message.hpp"
 #include "dsp_decimate.hpp"
+#include "ook_pulse_estimator.hpp"
 
 #pragma GCC push_options
 #pragma GCC optimize("Os")
 #include "fprotos/subghzdprotos.hpp"
 #pragma GCC pop_options
 
-#define OOK_EST_HIGH_RATIO 3  // Constant for slowness of OOK high level estimator
-#define OOK_EST_LOW_RATIO 5   // Constant for slowness of OOK low level (noise) estimator (very slow)
-#define OOK_MAX_HIGH_LEVEL 450000
-
 class SubGhzDProcessor : public BasebandProcessor {
    public:
     void execute(const buffer_c8_t& buffer) override;
     void on_message(const Message* const message) override;
 
    private:
-    enum {
-        STATE_IDLE = 0,
-        STATE_PULSE = 1,
-        STATE_GAP_START = 2,
-        STATE_GAP = 3,
-    } sig_state = STATE_IDLE;
-    uint32_t low_estimate = 100;
-    uint32_t high_estimate = 12000;
-    uint32_t min_high_level = 10;
-    uint8_t numg = 0;        // count of matched signals to filter spikes
     size_t baseband_fs = 0;  // will be set later by configure message
-    uint32_t nsPerDecSamp = 0;
 
     /* Array Buffer aux. used in decim0 and decim1 IQ c16 signed  data ; (decim0 defines the max length of the array) */
     std::array<complex16_t, 512> dst{};  // decim0 /4 ,  2048/4 = 512 complex I,Q
@@ -70,12 +56,11 @@ class SubGhzDProcessor : public BasebandProcessor {
     dsp::decimate::FIRC8xR16x24FS4Decim4 decim_0{};
     dsp::decimate::FIRC16xR16x16Decim2 decim_1{};
 
-    uint32_t currentDuration = 0;
-    uint32_t threshold = 0x0630;
-    bool currentHiLow = false;
+    OOKPulseEstimator pulse_estimator{};
     bool configured{false};
 
-    FProtoListGeneral* protoList = new SubGhzDProtos();  // holds all the protocols we can parse
+    SubGhzDProtos protos{};  // holds all the protocols we can parse
+    FProtoListGeneral* protoList = &protos;
     void configure(const SubGhzFPRxConfigureMessage& message);
 
     /* NB: Threads should be the last members in the class definition. */
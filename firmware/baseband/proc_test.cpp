@@ -43,6 +43,8 @@ void TestProcessor::execute(const buffer_c8_t& buffer) {
     feed_channel_stats(decimator_out);
 
     for (size_t i = 0; i < decimator_out.count; i++) {
+        packet_builder_fsk_9600_CC1101.set_sample_index((decimator_out.sample_index + i) * decimation_factor);
+
         if (mf.execute_once(decimator_out.p[i])) {
             clock_recovery_fsk_9600(mf.get_output());
         }
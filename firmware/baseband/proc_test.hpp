@@ -59,14 +59,18 @@ class TestProcessor : public BasebandProcessor {
 
     dsp::decimate::FIRC8xR16x24FS4Decim8 decim_0{};
     dsp::decimate::FIRC16xR16x32Decim8 decim_1{};
-    dsp::matched_filter::MatchedFilter mf{baseband::ais::square_taps_38k4_1t_p, 2};
+    static constexpr size_t decimation_factor =
+        dsp::decimate::FIRC8xR16x24FS4Decim8::decimation_factor *
+        dsp::decimate::FIRC16xR16x32Decim8::decimation_factor;
+    dsp::matched_filter::MatchedFilter<4> mf{baseband::ais::square_taps_38k4_1t_p, 2};
+    symbol_coding::Slicer slicer{};
 
     clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> clock_recovery_fsk_9600{
         38400,
         19192,
         {0.00555f},
         [this](const float raw_symbol) {
-            const uint_fast8_t sliced_symbol = (raw_symbol >= 0.0f) ? 1 : 0;
+            const auto sliced_symbol = this->slicer(raw_symbol);
             this->packet_builder_fsk_9600_CC1101.execute(sliced_symbol);
         }};
     PacketBuilder<BitPattern, NeverMatch, FixedLength> packet_builder_fsk_9600_CC1101{
@@ -42,16 +42,28 @@ void TPMSProcessor::execute(const buffer_c8_t& buffer) {
     /* 307.2kHz, 256 samples */
     feed_channel_stats(decimator_out);
 
-    for (size_t i = 0; i < decimator_out.count; i++) {
-        if (mf_38k4_1t_19k2.execute_once(decimator_out.p[i])) {
+    burst_detector.execute(decimator_out, [this](const buffer_c16_t& burst) {
+        this->demodulate(burst);
+    });
+}
+
+void TPMSProcessor::demodulate(const buffer_c16_t& buffer) {
+    // Packets are stamped with the baseband sample of their last symbol.
+    for (size_t i = 0; i < buffer.count; i++) {
+        if (mf_38k4_1t_19k2.execute_once(buffer.p[i])) {
+            packet_builder_fsk_19k2_schrader.set_sample_index((buffer.sample_index + i) * decimation_factor);
             clock_recovery_fsk_19k2(mf_38k4_1t_19k2.get_output());
         }
     }
 
-    for (size_t i = 0; i < decimator_out.count; i += channel_decimation) {
-        const auto sliced = ook_slicer_5sps(decimator_out.p[i]);
+    for (size_t i = 0; i < buffer.count; i += channel_decimation) {
+        const auto sliced = ook_slicer_5sps(buffer.p[i]);
         slicer_history = (slicer_history << 1) | sliced;
 
+        const auto sample_index = (buffer.sample_index + i) * decimation_factor;
+        packet_builder_ook_8k192_schrader.set_sample_index(sample_index);
+        packet_builder_ook_8k4_schrader.set_sample_index(sample_index);
+
         clock_recovery_ook_8k192(slicer_history, [this](const bool symbol) {
             this->packet_builder_ook_8k192_schrader.execute(symbol);
         });
@@ -29,6 +29,7 @@
 
 #include "channel_decimator.hpp"
 #include "matched_filter.hpp"
+#include "burst_detector.hpp"
 
 #include "clock_recovery.hpp"
 #include "symbol_coding.hpp"
@@ -82,15 +83,23 @@ class TPMSProcessor : public BasebandProcessor {
 
     dsp::decimate::FIRC8xR16x24FS4Decim4 decim_0{};
     dsp::decimate::FIRC16xR16x16Decim2 decim_1{};
+    static constexpr size_t decimation_factor =
+        dsp::decimate::FIRC8xR16x24FS4Decim4::decimation_factor *
+        dsp::decimate::FIRC16xR16x16Decim2::decimation_factor;
 
-    dsp::matched_filter::MatchedFilter mf_38k4_1t_19k2{rect_taps_307k2_38k4_1t_19k2_p, 8};
+    // Lead-in covers the matched filter and the OOK slicer. Bursts end
+    // after 5ms without signal, packets are shorter than 10ms.
+    BurstDetector<complex16_t, 64> burst_detector{1536, 307200};
+
+    dsp::matched_filter::MatchedFilter<16> mf_38k4_1t_19k2{rect_taps_307k2_38k4_1t_19k2_p, 8};
+    symbol_coding::Slicer slicer_fsk_19k2{};
 
     clock_recovery::ClockRecovery<clock_recovery::FixedErrorFilter> clock_recovery_fsk_19k2{
         38400,
         19200,
         {0.0555f},
         [this](const float raw_symbol) {
-            const uint_fast8_t sliced_symbol = (raw_symbol >= 0.0f) ? 1 : 0;
+            const auto sliced_symbol = this->slicer_fsk_19k2(raw_symbol);
             this->packet_builder_fsk_19k2_schrader.execute(sliced_symbol);
         }};
     PacketBuilder<BitPattern, NeverMatch, FixedLength> packet_builder_fsk_19k2_schrader{
@@ -140,6 +149,7 @@ class TPMSProcessor : public BasebandProcessor {
             shared_memory.application_queue.push(message);
         }};
 
+    void demodulate(const buffer_c16_t& buffer);
     void on_message(const Message* const message);
     void on_beep_message(const AudioBeepMessage& message);
 
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __RING_CURSOR_H__
+#define __RING_CURSOR_H__
+
+#include <cstddef>
+#include <cstdint>
+
+/* Tracks the blocks of a looping DMA ring. The interrupt counts blocks
+ * as they complete, the thread takes them in order. If the thread falls
+ * so far behind that the DMA could reach the oldest pending block while
+ * it is being handled, the thread skips to the newest one and the
+ * skipped blocks are reported as lost. */
+class RingCursor {
+   public:
+    struct Block {
+        size_t index;       // Position in the ring.
+        uint64_t sequence;  // Blocks completed before this one.
+        uint32_t lost;      // Blocks skipped just before this one.
+    };
+
+    void reset(const size_t length) {
+        length_ = length;
+        completed_ = 0;
+        handled_ = 0;
+        lost_total_ = 0;
+    }
+
+    /* Position of the block the DMA is working on. */
+    size_t active_index() const {
+        return completed_ % length_;
+    }
+
+    /* Called from the DMA interrupt. */
+    void complete() {
+        completed_ = completed_ + 1;
+    }
+
+    bool pending() const {
+        return completed_ != static_cast<uint32_t>(handled_);
+    }
+
+    /* Takes the next block, pending() must be true. */
+    Block take() {
+        const uint32_t pending = completed_ - static_cast<uint32_t>(handled_);
+        // Keep at least one whole block between the DMA and the block handed out.
+        const uint32_t lost = (pending + 1 >= length_) ? pending - 1 : 0;
+
+        handled_ += lost;
+        lost_total_ += lost;
+        const Block block{static_cast<size_t>(handled_ % length_), handled_, lost};
+        handled_++;
+        return block;
+    }
+
+    uint32_t lost_total() const { return lost_total_; }
+
+   private:
+    size_t length_{1};
+    volatile uint32_t completed_{0};
+    uint64_t handled_{0};
+    uint32_t lost_total_{0};
+};
+
+#endif /*__RING_CURSOR_H__*/
@@ -54,6 +54,8 @@ void RSSIThread::start() {
 }
 
 void RSSIThread::run() {
+    chRegSetThreadName("rssi");
+
     rf::rssi::init();
     rf::rssi::dma::allocate(4, 400);
 
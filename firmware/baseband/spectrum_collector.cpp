@@ -23,11 +23,32 @@
 
 #include "dsp_fft.hpp"
 
+#include "baseband_buffer_cache.hpp"
 #include "utility.hpp"
 #include "event_m4.hpp"
 #include "portapack_shared_memory.hpp"
 
 #include <algorithm>
+#include <cmath>
+#include <new>
+
+/* Bit-reverse copy with a time-domain window applied on the way. Both
+ * halves of a packed complex16 sample are scaled by the Q15 coefficient
+ * using the dual 16-bit multiplies. */
+template <typename T, size_t N>
+static void fft_swap_windowed(const buffer_c16_t& src, std::array<T, N>& dst, const dsp::window::Table<N>& window) {
+    static_assert(power_of_two(N), "only defined for N == power of two");
+    const auto p = reinterpret_cast<const uint32_t*>(src.p);
+
+    for (size_t i = 0; i < N; i++) {
+        const size_t i_rev = __RBIT(i) >> (32 - log_2(N));
+        const uint32_t iq = p[i];
+        const uint32_t w = static_cast<uint16_t>(window[i]);
+        dst[i_rev] = {
+            static_cast<typename T::value_type>(static_cast<int32_t>(__SMULBB(iq, w)) >> 15),
+            static_cast<typename T::value_type>(static_cast<int32_t>(__SMULTB(iq, w)) >> 15)};
+    }
+}
 
 void SpectrumCollector::on_message(const Message* const message) {
     switch (message->id) {
@@ -45,22 +66,45 @@ void SpectrumCollector::on_message(const Message* const message) {
 }
 
 void SpectrumCollector::set_state(const SpectrumStreamingConfigMessage& message) {
+    if (message.mode != SpectrumStreamingConfigMessage::Mode::Stopped) {
+        window = dsp::window::table<fft_size>(message.window);
+        window_type = message.window;
+
+        // Holds and averages survive a restart; an explicit configure starts them over.
+        if (message.mode == SpectrumStreamingConfigMessage::Mode::Configure ||
+            message.detector != detector.mode() ||
+            std::max<uint8_t>(message.detector_count, 1) != detector.count())
+            detector.configure(message.detector, message.detector_count);
+
+        // Keep levels comparable to the legacy Hamming window whatever window is used.
+        window_gain_db = 0.0f;
+        if (window_type == dsp::window::Type::Rectangular)
+            window_gain_db = 20.0f * log10f(hamming_coherent_gain);
+        else if (window)
+            window_gain_db = 20.0f * log10f(hamming_coherent_gain / window->gain());
+    }
+
     if (message.mode == SpectrumStreamingConfigMessage::Mode::Running) {
+        // Kept for the life of the image.
+        if (message.waterfall_rows && !rows)
+            rows = new (baseband::buffer_cache::allocate(sizeof(WaterfallRows), memory_stats::Tag::Stream)) WaterfallRows{};
         start();
-    } else {
+    } else if (message.mode == SpectrumStreamingConfigMessage::Mode::Stopped) {
         stop();
     }
 }
 
 void SpectrumCollector::start() {
     streaming = true;
-    ChannelSpectrumConfigMessage message{&fifo};
+    ChannelSpectrumConfigMessage message{&fifo, rows ? &rows->fifo : nullptr};
     shared_memory.application_queue.push(message);
 }
 
 void SpectrumCollector::stop() {
     streaming = false;
     fifo.reset_in();
+    if (rows)
+        rows->fifo.reset_in();
 }
 
 void SpectrumCollector::set_decimation_factor(
@@ -93,7 +137,10 @@ void SpectrumCollector::feed(
 void SpectrumCollector::post_message(const buffer_c16_t& data) {
     // Called from baseband processing thread.
     if (streaming && !channel_spectrum_request_update) {
-        fft_swap(data, channel_spectrum);
+        if (window)
+            fft_swap_windowed(data, channel_spectrum, *window);
+        else
+            fft_swap(data, channel_spectrum);
         channel_spectrum_sampling_rate = data.sampling_rate;
         channel_spectrum_request_update = true;
         EventDispatcher::events_flag(EVT_MASK_SPECTRUM);
@@ -128,6 +175,17 @@ static typename T::value_type spectrum_window_blackman_3(const T& s, const size_
     return s[i] * alpha - (s[(i - 1) & mask] + s[(i + 1) & mask]) * beta + (s[(i - 2) & mask] + s[(i + 2) & mask]) * gamma;
 };
 
+void SpectrumCollector::post_waterfall_row(const ChannelSpectrum& spectrum) {
+    // Fold the FFT output so DC is centered, dropping the outermost bins.
+    constexpr size_t half = std::tuple_size<decltype(WaterfallRow::index)>::value / 2;
+    constexpr size_t bins = std::tuple_size<decltype(ChannelSpectrum::db)>::value;
+
+    WaterfallRow row;
+    std::copy(&spectrum.db[bins - half], &spectrum.db[bins], &row.index[0]);
+    std::copy(&spectrum.db[0], &spectrum.db[half], &row.index[half]);
+    rows->fifo.in(row);
+}
+
 void SpectrumCollector::update() {
     // Called from idle thread (after EVT_MASK_SPECTRUM is flagged)
     if (streaming && channel_spectrum_request_update) {
@@ -140,14 +198,22 @@ void SpectrumCollector::update() {
         spectrum.channel_filter_high_frequency = channel_filter_high_frequency;
         spectrum.channel_filter_transition = channel_filter_transition;
         for (size_t i = 0; i < spectrum.db.size(); i++) {
-            const auto corrected_sample = spectrum_window_hamming_3(channel_spectrum, i);
+            // Time-domain windows were applied before the FFT.
+            const auto corrected_sample = (window_type == dsp::window::Type::Hamming3)
+                                              ? spectrum_window_hamming_3(channel_spectrum, i)
+                                              : spectrum_window_none(channel_spectrum, i);
             const auto mag2 = magnitude_squared(corrected_sample * (1.0f / 32768.0f));
-            const float db = mag2_to_dbv_norm(mag2);
+            const float db = mag2_to_dbv_norm(mag2) + window_gain_db;
             constexpr float mag_scale = 5.0f;
-            const unsigned int v = (db * mag_scale) + 255.0f;
-            spectrum.db[i] = std::max(0U, std::min(255U, v));
+            const int v = (db * mag_scale) + 255.0f;
+            spectrum.db[i] = std::max(0, std::min(255, v));
+        }
+
+        if (detector.apply(spectrum.db)) {
+            fifo.in(spectrum);
+            if (rows)
+                post_waterfall_row(spectrum);
         }
-        fifo.in(spectrum);
     }
 
     channel_spectrum_request_update = false;
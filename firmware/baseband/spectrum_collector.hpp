@@ -34,6 +34,8 @@
 #include <array>
 
 #include "message.hpp"
+#include "dsp_window.hpp"
+#include "spectrum_detector.hpp"
 
 class SpectrumCollector {
    public:
@@ -48,19 +50,34 @@ class SpectrumCollector {
         const int32_t filter_transition);
 
    private:
-    BlockDecimator<complex16_t, 256> channel_spectrum_decimator{1};
+    static constexpr size_t fft_size = 256;
+    static constexpr float hamming_coherent_gain = 0.54f;
+
+    BlockDecimator<complex16_t, fft_size> channel_spectrum_decimator{1};
     ChannelSpectrum fifo_data[1 << ChannelSpectrumConfigMessage::fifo_k]{};
     ChannelSpectrumFIFO fifo{fifo_data, ChannelSpectrumConfigMessage::fifo_k};
 
+    /* Only allocated once an app asks for waterfall rows. */
+    struct WaterfallRows {
+        WaterfallRow data[1 << ChannelSpectrumConfigMessage::row_fifo_k]{};
+        WaterfallRowFIFO fifo{data, ChannelSpectrumConfigMessage::row_fifo_k};
+    };
+    WaterfallRows* rows{nullptr};
+
     volatile bool channel_spectrum_request_update{false};
     bool streaming{false};
-    std::array<std::complex<float>, 256> channel_spectrum{};
+    std::array<std::complex<float>, fft_size> channel_spectrum{};
+    dsp::window::Type window_type{dsp::window::Type::Hamming3};
+    const dsp::window::Table<fft_size>* window{nullptr};
+    float window_gain_db{0.0f};
+    SpectrumDetector<fft_size> detector{};
     uint32_t channel_spectrum_sampling_rate{0};
     int32_t channel_filter_low_frequency{0};
     int32_t channel_filter_high_frequency{0};
     int32_t channel_filter_transition{0};
 
     void post_message(const buffer_c16_t& data);
+    void post_waterfall_row(const ChannelSpectrum& spectrum);
 
     void set_state(const SpectrumStreamingConfigMessage& message);
     void start();
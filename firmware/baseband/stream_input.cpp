@@ -24,16 +24,19 @@
 #include "lpc43xx_cpp.hpp"
 using namespace lpc43xx;
 
+// One stream runs at a time, its buffers are kept for the next one.
+static baseband::buffer_cache::Slot buffers_slot{memory_stats::Tag::Stream};
+
 StreamInput::StreamInput(CaptureConfig* const config)
     : fifo_buffers_empty{buffers_empty.data(), buffer_count_max_log2},
       fifo_buffers_full{buffers_full.data(), buffer_count_max_log2},
       config{config},
-      data{std::make_unique<uint8_t[]>(config->write_size * config->buffer_count)} {
+      data{buffers_slot, config->write_size * config->buffer_count} {
     config->fifo_buffers_empty = &fifo_buffers_empty;
     config->fifo_buffers_full = &fifo_buffers_full;
 
     for (size_t i = 0; i < config->buffer_count; i++) {
-        buffers[i] = {&(data.get()[i * config->write_size]), config->write_size};
+        buffers[i] = {&(data.data()[i * config->write_size]), config->write_size};
         fifo_buffers_empty.in(&buffers[i]);
     }
 }
@@ -73,3 +76,18 @@ size_t StreamInput::write(const void* const data, const size_t length) {
 
     return written;
 }
+
+uint64_t StreamInput::bytes_written() const {
+    return config->baseband_bytes_received - config->baseband_bytes_dropped;
+}
+
+void StreamInput::post_time_mark(const CaptureTimeMark& mark) {
+    const uint32_t n = config->time_marks_written;
+    config->time_marks[n % CaptureConfig::time_marks_count] = mark;
+    config->time_marks_written = n + 1;
+}
+
+void StreamInput::post_peak(const uint16_t peak) {
+    if (peak > config->peak)
+        config->peak = peak;
+}
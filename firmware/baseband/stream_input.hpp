@@ -24,6 +24,7 @@
 
 #include "message.hpp"
 #include "fifo.hpp"
+#include "baseband_buffer_cache.hpp"
 
 #include <cstdint>
 #include <cstddef>
@@ -41,6 +42,15 @@ class StreamInput {
 
     size_t write(const void* const data, const size_t length);
 
+    /* Bytes that made it into the stream so far. */
+    uint64_t bytes_written() const;
+
+    /* Hands a time mark to the application side of the stream. */
+    void post_time_mark(const CaptureTimeMark& mark);
+
+    /* Raises the stream's recorded peak to at least peak. */
+    void post_peak(const uint16_t peak);
+
    private:
     static constexpr size_t buffer_count_max_log2 = 3;
     static constexpr size_t buffer_count_max = 1U << buffer_count_max_log2;
@@ -52,7 +62,7 @@ class StreamInput {
     std::array<StreamBuffer*, buffer_count_max> buffers_full{};
     StreamBuffer* active_buffer{nullptr};
     CaptureConfig* const config{nullptr};
-    std::unique_ptr<uint8_t[]> data{};
+    baseband::buffer_cache::SlotBuffer data;
 };
 
 #endif /*__STREAM_INPUT_H__*/
@@ -25,17 +25,20 @@
 #include "lpc43xx_cpp.hpp"
 using namespace lpc43xx;
 
+// One stream runs at a time, its buffers are kept for the next one.
+static baseband::buffer_cache::Slot buffers_slot{memory_stats::Tag::Stream};
+
 StreamOutput::StreamOutput(ReplayConfig* const config)
     : fifo_buffers_empty{buffers_empty.data(), buffer_count_max_log2},
       fifo_buffers_full{buffers_full.data(), buffer_count_max_log2},
       config{config},
-      data{std::make_unique<uint8_t[]>(config->read_size * config->buffer_count)} {
+      data{buffers_slot, config->read_size * config->buffer_count} {
     config->fifo_buffers_empty = &fifo_buffers_empty;
     config->fifo_buffers_full = &fifo_buffers_full;
 
     for (size_t i = 0; i < config->buffer_count; i++) {
         // Set buffers to point consecutively in previously allocated unique_ptr "data"
-        buffers[i] = {&(data.get()[i * config->read_size]), config->read_size};
+        buffers[i] = {&(data.data()[i * config->read_size]), config->read_size};
         // Put all buffer pointers in the "empty buffer" FIFO
         fifo_buffers_empty.in(&buffers[i]);
     }
@@ -25,6 +25,7 @@
 
 #include "message.hpp"
 #include "fifo.hpp"
+#include "baseband_buffer_cache.hpp"
 
 #include <cstdint>
 #include <cstddef>
@@ -53,7 +54,7 @@ class StreamOutput {
     std::array<StreamBuffer*, buffer_count_max> buffers_full{};
     StreamBuffer* active_buffer{nullptr};
     ReplayConfig* const config{nullptr};
-    std::unique_ptr<uint8_t[]> data{};
+    baseband::buffer_cache::SlotBuffer data;
 };
 
 #endif /*__STREAM_OUTPUT_H__*/
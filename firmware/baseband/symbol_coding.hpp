@@ -27,6 +27,34 @@
 
 namespace symbol_coding {
 
+/* Hard decision on a soft symbol, with optional hysteresis around the
+ * threshold so noise near zero doesn't toggle the output. */
+template <typename T>
+class BasicSlicer {
+   public:
+    constexpr BasicSlicer(
+        const T threshold = 0,
+        const T hysteresis = 0)
+        : threshold{threshold},
+          hysteresis{hysteresis} {
+    }
+
+    uint_fast8_t operator()(const T symbol) {
+        if (symbol >= threshold + hysteresis)
+            last = 1;
+        else if (symbol < threshold - hysteresis)
+            last = 0;
+        return last;
+    }
+
+   private:
+    const T threshold;
+    const T hysteresis;
+    uint_fast8_t last{0};
+};
+
+using Slicer = BasicSlicer<float>;
+
 class NRZIDecoder {
    public:
     uint_fast8_t operator()(const uint_fast8_t symbol) {
@@ -39,6 +67,61 @@ class NRZIDecoder {
     uint_fast8_t last{0};
 };
 
+/* Takes Manchester chips in pairs, the first chip of a packet first.
+ * sense picks the chip that carries the bit, as in ::ManchesterDecoder on
+ * the M0: 0 for the first (10 is a one), 1 for the second (IEEE 802.3,
+ * 01 is a one). A pair without a transition is a coding violation. */
+class ManchesterChipDecoder {
+   public:
+    struct Bit {
+        uint_fast8_t value;
+        bool error;
+    };
+
+    constexpr ManchesterChipDecoder(const size_t sense = 0)
+        : sense{sense} {
+    }
+
+    /* Returns true on every second chip, with the pair's bit in out. */
+    bool operator()(const uint_fast8_t chip, Bit& out) {
+        if (!have_first) {
+            first = chip & 1;
+            have_first = true;
+            return false;
+        }
+
+        have_first = false;
+        out.value = sense ? (chip & 1) : first;
+        out.error = first == (chip & 1);
+        return true;
+    }
+
+    /* Drops a pending chip, to realign on the next one. */
+    void reset() {
+        have_first = false;
+    }
+
+   private:
+    const size_t sense;
+    uint_fast8_t first{0};
+    bool have_first{false};
+};
+
+/* True unless more than a quarter of the chip pairs in packet break the
+ * Manchester coding. A sync pattern matched on noise breaks it all
+ * through the payload, a weak real packet only in places. */
+template <typename Packet>
+bool is_manchester(const Packet& packet) {
+    ManchesterChipDecoder decode{};
+    ManchesterChipDecoder::Bit bit{};
+    size_t violations = 0;
+    for (size_t i = 0; i < packet.size(); i++) {
+        if (decode(packet[i], bit) && bit.error)
+            violations++;
+    }
+    return violations * 4 <= packet.size() / 2;
+}
+
 class ACARSDecoder {
    public:
     uint_fast8_t operator()(const uint_fast8_t symbol) {
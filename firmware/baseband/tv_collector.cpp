@@ -50,7 +50,7 @@ void TvCollector::on_message(const Message* const message) {
 void TvCollector::set_state(const SpectrumStreamingConfigMessage& message) {
     if (message.mode == SpectrumStreamingConfigMessage::Mode::Running) {
         start();
-    } else {
+    } else if (message.mode == SpectrumStreamingConfigMessage::Mode::Stopped) {
         stop();
     }
 }
@@ -61,6 +61,14 @@ class ADSBFrame {
         return rx_timestamp;
     }
 
+    // Baseband sample the frame ended on, see baseband::Packet.
+    void set_sample_index(uint64_t value) {
+        sample_index = value;
+    }
+    uint64_t get_sample_index() const {
+        return sample_index;
+    }
+
     void clear() {
         index = 0;
         memset(raw_data, 0, 14);
@@ -106,6 +114,7 @@ class ADSBFrame {
     alignas(4) uint8_t index{0};
     alignas(4) uint8_t raw_data[14]{};  // 112 bits at most
     uint32_t rx_timestamp{};
+    uint64_t sample_index{};
 
     uint32_t compute_CRC() {
         uint8_t adsb_crc[14] = {0};  // Temp buffer
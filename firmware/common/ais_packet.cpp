@@ -130,6 +130,10 @@ Timestamp Packet::received_at() const {
     return packet_.timestamp();
 }
 
+uint64_t Packet::sample_index() const {
+    return packet_.sample_index();
+}
+
 uint32_t Packet::message_id() const {
     return field_.read(0, 6);
 }
@@ -107,6 +107,7 @@ class Packet {
     bool is_valid() const;
 
     Timestamp received_at() const;
+    uint64_t sample_index() const;
 
     uint32_t message_id() const;
     MMSI user_id() const;
@@ -39,12 +39,28 @@ class Packet {
         return timestamp_;
     }
 
+    /* Baseband sample the packet ended on, as counted by the baseband
+     * thread, so decodes can be lined up with captures of the stream. */
+    void set_sample_index(const uint64_t value) {
+        sample_index_ = value;
+    }
+
+    uint64_t sample_index() const {
+        return sample_index_;
+    }
+
     void add(const bool symbol) {
         if (count < capacity()) {
             data[count++] = symbol;
         }
     }
 
+    void flip(const size_t index) {
+        if (index < size()) {
+            data.flip(index);
+        }
+    }
+
     uint_fast8_t operator[](const size_t index) const {
         return (index < size()) ? data[index] : 0;
     }
@@ -64,6 +80,7 @@ class Packet {
    private:
     std::bitset<2560> data{};
     Timestamp timestamp_{};
+    uint64_t sample_index_{0};
     size_t count{0};
 };
 
@@ -54,12 +54,16 @@ struct buffer_t {
     const size_t count;
     const uint32_t sampling_rate;
     const Timestamp timestamp;
+    /* Position of p[0] in the stream, in samples at sampling_rate, counted
+     * from the start of streaming. Samples dropped by overruns are counted. */
+    const uint64_t sample_index;
 
     constexpr buffer_t()
         : p{nullptr},
           count{0},
           sampling_rate{0},
-          timestamp{} {
+          timestamp{},
+          sample_index{0} {
     }
 
     constexpr buffer_t(
@@ -67,18 +71,21 @@ struct buffer_t {
         : p{other.p},
           count{other.count},
           sampling_rate{other.sampling_rate},
-          timestamp{other.timestamp} {
+          timestamp{other.timestamp},
+          sample_index{other.sample_index} {
     }
 
     constexpr buffer_t(
         T* const p,
         const size_t count,
         const uint32_t sampling_rate = 0,
-        const Timestamp timestamp = {})
+        const Timestamp timestamp = {},
+        const uint64_t sample_index = 0)
         : p{p},
           count{count},
           sampling_rate{sampling_rate},
-          timestamp{timestamp} {
+          timestamp{timestamp},
+          sample_index{sample_index} {
     }
 
     operator bool() const {
@@ -20,6 +20,7 @@
  */
 
 #include "chibios_cpp.hpp"
+#include "memory_stats.hpp"
 
 #include <cstdint>
 
@@ -29,6 +30,7 @@ void* operator new(size_t size) {
     void* p = chHeapAlloc(0x0, size);
     if (p == nullptr)
         chDbgPanic("Out of Memory");
+    memory_stats::track_alloc(p);
     return p;
 }
 
@@ -36,14 +38,17 @@ void* operator new[](size_t size) {
     void* p = chHeapAlloc(0x0, size);
     if (p == nullptr)
         chDbgPanic("Out of Memory");
+    memory_stats::track_alloc(p);
     return p;
 }
 
 void operator delete(void* p) noexcept {
+    memory_stats::track_free(p);
     chHeapFree(p);
 }
 
 void operator delete[](void* p) noexcept {
+    memory_stats::track_free(p);
     chHeapFree(p);
 }
 
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __COMMAND_QUEUE_H__
+#define __COMMAND_QUEUE_H__
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+#include "message.hpp"
+#include "fifo.hpp"
+
+#include <ch.h>
+
+/* Commands from the M0 to the baseband. Messages are copied into the queue
+ * so the sender doesn't have to wait for the M4 to pick them up. Each push
+ * returns a token that can be polled to find out when the command has been
+ * handled. A command of a coalesced type is dropped unhandled if a newer
+ * one of the same type is already queued behind it. */
+class CommandQueue {
+   public:
+    using Token = uint32_t;
+
+    CommandQueue() = delete;
+    CommandQueue(const CommandQueue&) = delete;
+    CommandQueue(CommandQueue&&) = delete;
+
+    CommandQueue(
+        uint8_t* const data,
+        size_t k)
+        : fifo{data, k} {
+        chMtxInit(&mutex_write);
+    }
+
+    /* Only the newest queued command of these types is handled, they each
+     * carry the complete state they configure. SpectrumStreamingConfig is
+     * left out, a Configure doesn't carry the run state a queued Running or
+     * Stopped would set. */
+    static constexpr std::array<Message::ID, 7> coalesced_ids{
+        Message::ID::AMConfigure,
+        Message::ID::NBFMConfigure,
+        Message::ID::WFMConfigure,
+        Message::ID::SampleRateConfig,
+        Message::ID::WidebandSpectrumConfig,
+        Message::ID::PitchRSSIConfigure,
+        Message::ID::SigGenTone,
+    };
+
+    /* Called on the M0. Returns false if there is no room for the message.
+     * Otherwise token is set to the value to poll with is_complete(). */
+    template <typename T>
+    bool push(const T& message, Token& token) {
+        static_assert(sizeof(T) <= Message::MAX_SIZE, "Message::MAX_SIZE too small for message type");
+        static_assert(std::is_base_of<Message, T>::value, "type is not based on Message");
+
+        chMtxLock(&mutex_write);
+
+        /* Only the M4 frees space, so once there is room in_r() can't fail.
+         * The token is recorded before the message is visible to the M4,
+         * else it could compare the message against a stale latest[] and
+         * drop it as superseded. */
+        const bool queued = fifo.has_room_r(sizeof(message));
+        if (queued) {
+            token = submitted + 1;
+
+            const auto slot = coalesce_slot(message.id);
+            if (slot < coalesced_ids.size())
+                latest[slot] = token;
+
+            fifo.in_r(&message, sizeof(message));
+            submitted = token;
+        }
+
+        chMtxUnlock();
+        return queued;
+    }
+
+    bool is_complete(const Token token) const {
+        return !is_after(token, completed);
+    }
+
+    bool is_idle() const {
+        return completed == submitted;
+    }
+
+    /* Called on the M4. Handles every queued command in one go. The handler
+     * returns false to stop, leaving that command pending. */
+    template <typename HandlerFn>
+    void handle(HandlerFn handler) {
+        std::array<uint8_t, Message::MAX_SIZE> message_buffer;
+        Message* const message = reinterpret_cast<Message*>(message_buffer.data());
+
+        while (fifo.peek_r(message_buffer.data(), message_buffer.size())) {
+            const Token token = completed + 1;
+            const auto slot = coalesce_slot(message->id);
+            const bool superseded = (slot < coalesced_ids.size()) && is_after(latest[slot], token);
+
+            if (!superseded && !handler(message))
+                return;
+
+            fifo.skip();
+            completed = token;
+        }
+    }
+
+    /* Called on the M4 when it halts, completes whatever is left. */
+    void flush() {
+        fifo.reset_out();
+        completed = submitted;
+    }
+
+    /* Called on the M0 while the M4 is stopped. The next token issued is
+     * last + 1. */
+    void reset(const Token last = 0) {
+        fifo.reset();
+        submitted = last;
+        completed = last;
+        for (auto& token : latest)
+            token = 0;
+    }
+
+   private:
+    FIFO<uint8_t> fifo;
+    Mutex mutex_write{};
+    volatile Token submitted{0};
+    volatile Token completed{0};
+    std::array<volatile Token, coalesced_ids.size()> latest{};
+
+    /* Tokens wrap, a is newer than b if it is less than half the range
+     * ahead of it. */
+    static constexpr bool is_after(const Token a, const Token b) {
+        return static_cast<int32_t>(a - b) > 0;
+    }
+
+    static constexpr size_t coalesce_slot(const Message::ID id) {
+        size_t slot = 0;
+        while (slot < coalesced_ids.size() && coalesced_ids[slot] != id)
+            slot++;
+        return slot;
+    }
+};
+
+#endif /*__COMMAND_QUEUE_H__*/
@@ -196,6 +196,39 @@ constexpr fir_taps_real<24> taps_11k0_decim_0{
     }},
 };
 
+// IFIR image-reject filter: fs=2457600, pass=30000, stop=277200, decim=8, fout=307200
+constexpr fir_taps_real<24> taps_ais_dual_decim_0{
+    .low_frequency_normalized = -30000.0f / 2457600.0f,
+    .high_frequency_normalized = 30000.0f / 2457600.0f,
+    .transition_normalized = 247200.0f / 2457600.0f,
+    .taps = {{
+        20,
+        75,
+        182,
+        358,
+        617,
+        958,
+        1368,
+        1817,
+        2263,
+        2659,
+        2955,
+        3113,
+        3113,
+        2955,
+        2659,
+        2263,
+        1817,
+        1368,
+        958,
+        617,
+        358,
+        182,
+        75,
+        20,
+    }},
+};
+
 // IFIR prototype filter: fs=384000, pass=5500, stop=42500, decim=8, fout=48000
 constexpr fir_taps_real<32> taps_11k0_decim_1{
     .low_frequency_normalized = -5500.0f / 384000.0f,
@@ -1303,6 +1336,44 @@ static constexpr fir_taps_real<24> taps_BTLE_1M_PHY_decim_0 = {
     }},
 };
 
+// IFIR image-reject filter: fs=8000000, pass=500000, stop=1500000, decim=4, fout=2000000
+// 1M PHY at 2 samples per symbol, used by the BTLE RX processor.
+// Equiripple, passband flat to 0.01 dB, stopband below -60 dB from 1.5 MHz, so
+// nothing folds onto the +-500 kHz channel after decimation.
+static constexpr fir_taps_real<24> taps_BTLE_1M_PHY_decim_8M = {
+    .low_frequency_normalized = -500000.0f / 8000000.0f,
+    .high_frequency_normalized = 500000.0f / 8000000.0f,
+    .transition_normalized = 1000000.0f / 8000000.0f,
+    .taps = {{
+
+        61,
+        139,
+        169,
+        34,
+        -316,
+        -746,
+        -910,
+        -393,
+        1020,
+        3115,
+        5242,
+        6585,
+        6585,
+        5242,
+        3115,
+        1020,
+        -393,
+        -910,
+        -746,
+        -316,
+        34,
+        169,
+        139,
+        61,
+
+    }},
+};
+
 // IFIR image-reject filter: fs=4000000, pass=920000, stop=1350000, decim=4, fout=1000000
 // Alternative filter, Note : in local test, it improves slightly the sensitivity compared to above filter, but it should have aliasing if co-adjacent channels.
 // Then , we leave that filter in the code ,as experimental , but it should not be set up as default one.
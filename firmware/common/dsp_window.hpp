@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __DSP_WINDOW_H__
+#define __DSP_WINDOW_H__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "spectrum_modes.hpp"
+
+namespace dsp {
+namespace window {
+
+/* Generalized cosine window: a0 - a1 cos(x) + a2 cos(2x) - a3 cos(3x) + a4 cos(4x). */
+struct Coefficients {
+    double a0;
+    double a1;
+    double a2;
+    double a3;
+    double a4;
+};
+
+constexpr Coefficients hann{0.5, 0.5, 0.0, 0.0, 0.0};
+constexpr Coefficients blackman_harris{0.35875, 0.48829, 0.14128, 0.01168, 0.0};
+constexpr Coefficients flat_top{0.21557895, 0.41663158, 0.277263158, 0.083578947, 0.006947368};
+
+/* Compile-time cosine, std::cos isn't constexpr. */
+constexpr double cos(double x) {
+    constexpr double pi = 3.14159265358979323846;
+    while (x > pi) x -= 2.0 * pi;
+    while (x < -pi) x += 2.0 * pi;
+
+    const double x2 = x * x;
+    double term = 1.0;
+    double sum = 1.0;
+    for (int n = 1; n <= 12; n++) {
+        term *= -x2 / ((2 * n - 1) * (2 * n));
+        sum += term;
+    }
+    return sum;
+}
+
+/* Periodic (DFT-even) window of length N in Q15. Only the first half is
+ * stored, w[n] == w[N - n]. */
+template <size_t N>
+class Table {
+   public:
+    static_assert(N >= 2 && (N % 2) == 0, "Window length must be even");
+
+    constexpr Table(const Coefficients& c)
+        : half{}, coherent_gain{static_cast<float>(c.a0)} {
+        constexpr double pi = 3.14159265358979323846;
+        for (size_t n = 0; n <= N / 2; n++) {
+            const double x = 2.0 * pi * n / N;
+            const double w = c.a0 - c.a1 * cos(x) + c.a2 * cos(2 * x) - c.a3 * cos(3 * x) + c.a4 * cos(4 * x);
+            const double q = w * 32767.0;
+            half[n] = (q >= 32767.0) ? 32767 : (q <= -32768.0) ? -32768
+                                                                : static_cast<int16_t>(q < 0 ? q - 0.5 : q + 0.5);
+        }
+    }
+
+    constexpr int16_t operator[](const size_t n) const {
+        return half[(n <= N / 2) ? n : N - n];
+    }
+
+    /* Mean of the window, the amplitude a full-scale tone is reduced by. */
+    constexpr float gain() const {
+        return coherent_gain;
+    }
+
+   private:
+    std::array<int16_t, N / 2 + 1> half;
+    float coherent_gain;
+};
+
+/* Returns the time-domain table for type, nullptr if none applies. */
+template <size_t N>
+const Table<N>* table(const Type type) {
+    static constexpr Table<N> hann_table{hann};
+    static constexpr Table<N> blackman_harris_table{blackman_harris};
+    static constexpr Table<N> flat_top_table{flat_top};
+
+    switch (type) {
+        case Type::Hann:
+            return &hann_table;
+        case Type::BlackmanHarris:
+            return &blackman_harris_table;
+        case Type::FlatTop:
+            return &flat_top_table;
+        default:
+            return nullptr;
+    }
+}
+
+} /* namespace window */
+} /* namespace dsp */
+
+#endif /*__DSP_WINDOW_H__*/
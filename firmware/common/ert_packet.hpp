@@ -42,6 +42,21 @@ constexpr CommodityType invalid_commodity_type = -1;
 constexpr Consumption invalid_consumption = 0;
 constexpr TamperFlags invalid_tamper_flags = 0;
 
+// ''.join(['%d%d' % (c, 1-c) for c in map(int, bin(0x1f2a60)[2:].zfill(21))])
+constexpr uint64_t scm_preamble_and_sync_manchester{0b101010101001011001100110010110100101010101};
+constexpr size_t scm_preamble_and_sync_length{42 - 10};
+constexpr size_t scm_payload_length_max{150};
+
+// ''.join(['%d%d' % (c, 1-c) for c in map(int, bin(0x16a3)[2:].zfill(16))])
+constexpr uint64_t scmplus_preamble_and_sync_manchester{0b01010110011010011001100101011010};
+constexpr size_t scmplus_preamble_and_sync_length{32 - 0};
+constexpr size_t scmplus_payload_length_max{224};
+
+// ''.join(['%d%d' % (c, 1-c) for c in map(int, bin(0x555516a3)[2:].zfill(32))])
+constexpr uint64_t idm_preamble_and_sync_manchester{0b0110011001100110011001100110011001010110011010011001100101011010};
+constexpr size_t idm_preamble_and_sync_length{64 - 16};
+constexpr size_t idm_payload_length_max{1408};
+
 class Packet {
    public:
     enum class Type : uint32_t {
@@ -65,6 +80,7 @@ class Packet {
     bool is_valid() const;
 
     Timestamp received_at() const;
+    uint64_t sample_index() const;
 
     Type type() const;
     ID id() const;
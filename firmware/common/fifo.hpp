@@ -94,8 +94,12 @@ class FIFO {
         return len;
     }
 
+    bool has_room_r(const size_t len) const {
+        return (len + recsize()) <= unused();
+    }
+
     size_t in_r(const void* const buf, const size_t len) {
-        if ((len + recsize()) > unused()) {
+        if (!has_room_r(len)) {
             return 0;
         }
 
@@ -123,6 +127,26 @@ class FIFO {
         return len;
     }
 
+    /* Returns the oldest element in place, or nullptr if empty.
+     * Lets a consumer read large elements without copying them out. */
+    const T* peek() const {
+        if (is_empty()) {
+            return nullptr;
+        }
+
+        return &_data[_out & mask()];
+    }
+
+    /* Releases the element returned by peek(). */
+    void drop() {
+        if (is_empty()) {
+            return;
+        }
+
+        smp_wmb();
+        _out += 1;
+    }
+
     bool skip() {
         if (is_empty()) {
             return false;
@@ -172,7 +196,11 @@ class FIFO {
     }
 
     void smp_wmb() {
+#if defined(__arm__)
         __DMB();
+#else
+        __sync_synchronize();  // Host builds.
+#endif
     }
 
     size_t peek_n() {
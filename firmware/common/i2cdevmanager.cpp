@@ -40,7 +40,7 @@ uint16_t I2CDevManager::scan_interval = 0;
 bool I2CDevManager::force_scan = false;
 Thread* I2CDevManager::thread;
 std::vector<I2DevListElement> I2CDevManager::devlist;
-Mutex I2CDevManager::mutex_list{};
+Mutex I2CDevManager::mutex_list = _MUTEX_DATA(I2CDevManager::mutex_list);  // Usable before init().
 EventDispatcher* I2CDevManager::_eventDispatcher;
 
 /*
@@ -294,7 +294,6 @@ bool I2CDevManager::scan() {
 }
 
 void I2CDevManager::create_thread() {
-    chMtxInit(&mutex_list);
     thread = chThdCreateFromHeap(NULL, 2048, NORMALPRIO, I2CDevManager::timer_fn, nullptr);
 }
 
@@ -629,6 +629,16 @@ void ILI9341::draw_pixels(
     io.lcd_write_pixels(colors, count);
 }
 
+void ILI9341::draw_pixels(
+    const ui::Rect r,
+    const uint8_t* const indexes,
+    const size_t count,
+    const ui::Color* const lut) {
+    chDbgAssert(static_cast<size_t>(r.width() * r.height()) <= count, "draw_pixels", "rect larger than count");
+    lcd_start_ram_write(r);
+    io.lcd_write_pixels(indexes, count, lut);
+}
+
 void ILI9341::read_pixels(
     const ui::Rect r,
     ui::ColorRGB888* const colors,
@@ -143,6 +143,7 @@ class ILI9341 {
     constexpr ui::Rect screen_rect() const { return {0, 0, width(), height()}; }
 
     void draw_pixels(const ui::Rect r, const ui::Color* const colors, const size_t count);
+    void draw_pixels(const ui::Rect r, const uint8_t* const indexes, const size_t count, const ui::Color* const lut);
     void read_pixels(const ui::Rect r, ui::ColorRGB888* const colors, const size_t count);
 
    private:
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "memory_stats.hpp"
+
+#include "chibios_cpp.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include <ch.h>
+
+namespace memory_stats {
+
+/* Heap block sizes are multiples of MEM_ALIGN_SIZE, the tag is cleared
+ * before the block goes back to the heap. */
+static_assert(tag_count <= MEM_ALIGN_SIZE, "Not enough spare bits for the allocation tag.");
+
+static MemoryHeap* heap = nullptr;  // Owner of the first tracked block, the default heap.
+static Accounting accounting{};
+
+static const char* const tag_names[tag_count] = {
+    "other",
+    "ui",
+    "file",
+    "radio",
+    "shell",
+    "processor",
+    "stream",
+    "dsp",
+};
+
+const char* tag_name(Tag tag) {
+    return tag_names[static_cast<size_t>(tag) & (tag_count - 1)];
+}
+
+static union heap_header* header_of(void* p) {
+    return reinterpret_cast<union heap_header*>(p) - 1;
+}
+
+void set_thread_tag(Tag tag) {
+    chThdSelf()->memory_tag = static_cast<uint8_t>(tag);
+}
+
+TagScope::TagScope(Tag tag)
+    : previous_{chThdSelf()->memory_tag} {
+    set_thread_tag(tag);
+}
+
+TagScope::~TagScope() {
+    chThdSelf()->memory_tag = previous_;
+}
+
+void track_alloc(void* p) {
+    // Constructors can run before the kernel has a current thread.
+    const auto thread = chThdSelf();
+    const auto tag = static_cast<Tag>(thread ? thread->memory_tag : 0);
+    auto hp = header_of(p);
+
+    chSysLock();
+    if (!heap)
+        heap = hp->h.u.heap;
+
+    accounting.allocated(tag, hp->h.size + sizeof(union heap_header), chCoreStatus());
+    hp->h.size = with_tag(hp->h.size, tag);
+    chSysUnlock();
+}
+
+void track_free(void* p) {
+    if (!p)
+        return;
+
+    auto hp = header_of(p);
+
+    chSysLock();
+    const auto tag = tag_of(hp->h.size);
+    hp->h.size = without_tag(hp->h.size);
+
+    accounting.freed(tag, hp->h.size + sizeof(union heap_header));
+    chSysUnlock();
+}
+
+static size_t largest_heap_block() {
+    size_t largest = 0;
+    if (!heap)
+        return largest;
+
+    chMtxLock(&heap->h_mtx);
+    for (auto qp = heap->h_free.h.u.next; qp; qp = qp->h.u.next)
+        largest = std::max(largest, qp->h.size);
+    chMtxUnlock();
+
+    return largest;
+}
+
+/* The fill pattern is left untouched below the deepest the stack got. */
+static uint32_t stack_free(const Thread* tp) {
+    auto p = reinterpret_cast<const uint8_t*>(tp->p_stklimit);
+    const auto start = p;
+    while (*p == CH_STACK_FILL_VALUE)
+        p++;
+
+    return p - start;
+}
+
+static void thread_name(const Thread* tp, char (&name)[sizeof(StackUsage::name)]) {
+    if (tp->p_name) {
+        strncpy(name, tp->p_name, sizeof(name) - 1);
+    } else if (tp == chSysGetIdleThread()) {
+        strncpy(name, "idle", sizeof(name) - 1);
+    } else {
+        // Unnamed threads go by their working area address.
+        auto address = reinterpret_cast<uintptr_t>(tp);
+        for (size_t i = 0; i < 8; i++)
+            name[i] = "0123456789abcdef"[(address >> (28 - i * 4)) & 0xf];
+    }
+}
+
+Snapshot snapshot() {
+    Snapshot s{};
+
+    s.heap_size = chibios::heap_size();
+    s.core_free = chCoreStatus();
+    s.core_low = accounting.core_low(s.core_free);
+    size_t heap_free = 0;
+    s.fragments = chHeapStatus(NULL, &heap_free);
+    s.heap_free = heap_free;
+
+    // A new block is carved from the core if no freed block fits.
+    const auto core_block = s.core_free > sizeof(union heap_header) ? s.core_free - sizeof(union heap_header) : 0;
+    s.largest_free = std::max<size_t>(largest_heap_block(), core_block);
+
+    chSysLock();
+    for (size_t i = 0; i < tag_count; i++)
+        s.tags[i] = accounting.usage(static_cast<Tag>(i));
+    chSysUnlock();
+
+    for (auto tp = chRegFirstThread(); tp; tp = chRegNextThread(tp)) {
+        if (s.stack_count == max_stacks)
+            continue;
+
+        auto& stack = s.stacks[s.stack_count++];
+        thread_name(tp, stack.name);
+        stack.free = stack_free(tp);
+    }
+
+    return s;
+}
+
+void reset_peaks() {
+    chSysLock();
+    accounting.reset_peaks(chCoreStatus());
+    chSysUnlock();
+}
+
+} /* namespace memory_stats */
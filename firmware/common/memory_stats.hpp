@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __MEMORY_STATS_H__
+#define __MEMORY_STATS_H__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+/* Heap and stack instrumentation, the same on both cores. Heap blocks
+ * carry the allocation tag of the thread that allocated them, so live
+ * bytes and peaks can be reported per subsystem without any extra
+ * memory per block. */
+namespace memory_stats {
+
+enum class Tag : uint8_t {
+    Other = 0,
+    UI = 1,         // M0 main thread, views and widgets.
+    File = 2,       // M0 file writers and readers.
+    Radio = 3,      // M0 capture and replay threads.
+    Shell = 4,      // M0 USB serial shell.
+    Processor = 5,  // M4 baseband processor and its configuration.
+    Stream = 6,     // M4 sample buffers and stream FIFOs.
+    DSP = 7,        // M4 filters and decoders.
+};
+constexpr size_t tag_count = 8;
+static_assert((tag_count & (tag_count - 1)) == 0, "tag_count must be a power of two.");
+
+/* A live heap block keeps its tag in the low bits of its size, which are
+ * always clear as sizes are multiples of the heap alignment. */
+constexpr size_t tag_mask = tag_count - 1;
+
+constexpr size_t with_tag(const size_t size, const Tag tag) {
+    return size | static_cast<size_t>(tag);
+}
+
+constexpr Tag tag_of(const size_t size) {
+    return static_cast<Tag>(size & tag_mask);
+}
+
+constexpr size_t without_tag(const size_t size) {
+    return size & ~tag_mask;
+}
+
+const char* tag_name(Tag tag);
+
+struct TagUsage {
+    uint32_t bytes;  // Live, block headers included.
+    uint32_t peak;
+};
+
+/* The bookkeeping behind track_alloc() and track_free(), apart from the
+ * kernel. Not locked, the caller holds the system lock. */
+class Accounting {
+   public:
+    void allocated(const Tag tag, const uint32_t bytes, const uint32_t core_free) {
+        auto& usage = tags_[static_cast<size_t>(tag) & tag_mask];
+        usage.bytes += bytes;
+        usage.peak = std::max(usage.peak, usage.bytes);
+        core_low_ = std::min(core_low_, core_free);
+    }
+
+    /* Blocks allocated before tracking started can't take a tag below 0. */
+    void freed(const Tag tag, const uint32_t bytes) {
+        auto& usage = tags_[static_cast<size_t>(tag) & tag_mask];
+        usage.bytes -= std::min(usage.bytes, bytes);
+    }
+
+    void reset_peaks(const uint32_t core_free) {
+        for (auto& usage : tags_)
+            usage.peak = usage.bytes;
+        core_low_ = core_free;
+    }
+
+    const TagUsage& usage(const Tag tag) const {
+        return tags_[static_cast<size_t>(tag) & tag_mask];
+    }
+
+    /* Lowest core_free seen, no more than the current one. */
+    uint32_t core_low(const uint32_t core_free) const {
+        return std::min(core_low_, core_free);
+    }
+
+   private:
+    TagUsage tags_[tag_count]{};
+    uint32_t core_low_{UINT32_MAX};
+};
+
+struct StackUsage {
+    char name[12];
+    uint32_t free;  // Bytes never written since the thread started.
+};
+
+constexpr size_t max_stacks = 8;
+
+/* POD, the M4 publishes its copy in SharedMemory. */
+struct Snapshot {
+    uint32_t heap_size;
+    uint32_t core_free;     // Never handed out yet.
+    uint32_t core_low;      // Lowest core_free seen, the high-water mark.
+    uint32_t heap_free;     // Freed blocks waiting for reuse.
+    uint32_t largest_free;  // Largest allocation that would succeed now.
+    uint16_t fragments;
+    uint16_t stack_count;
+    TagUsage tags[tag_count];
+    StackUsage stacks[max_stacks];
+};
+
+/* Sets the tag of the calling thread's allocations. */
+void set_thread_tag(Tag tag);
+
+/* Tags the calling thread's allocations while in scope. */
+class TagScope {
+   public:
+    explicit TagScope(Tag tag);
+    ~TagScope();
+
+    TagScope(const TagScope&) = delete;
+    TagScope& operator=(const TagScope&) = delete;
+
+   private:
+    uint8_t previous_;
+};
+
+/* Called by operator new/delete, track_free before the block is freed. */
+void track_alloc(void* p);
+void track_free(void* p);
+
+Snapshot snapshot();
+
+/* Starts the peaks over from the current usage. */
+void reset_peaks();
+
+} /* namespace memory_stats */
+
+#endif /*__MEMORY_STATS_H__*/
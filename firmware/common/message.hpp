@@ -41,6 +41,7 @@
 #include "jammer.hpp"
 #include "dsp_fir_taps.hpp"
 #include "dsp_iir.hpp"
+#include "spectrum_modes.hpp"
 #include "fifo.hpp"
 
 #include "utility.hpp"
@@ -127,6 +128,11 @@ class Message {
         FreqChangeCommand = 70,
         I2CDevListChanged = 71,
         LightData = 72,
+        AISConfigure = 73,
+        ISMPacket = 74,
+        ISMConfigure = 75,
+        MemoryStatsRequest = 76,
+        ReplayGainConfig = 77,
         MAX
     };
 
@@ -256,15 +262,28 @@ class SpectrumStreamingConfigMessage : public Message {
     enum class Mode : uint32_t {
         Stopped = 0,
         Running = 1,
+        Configure = 2,  // Apply window/detector without changing run state.
     };
 
     constexpr SpectrumStreamingConfigMessage(
-        Mode mode)
+        Mode mode,
+        dsp::window::Type window = dsp::window::Type::Hamming3,
+        SpectrumDetectorMode detector = SpectrumDetectorMode::Sample,
+        uint8_t detector_count = 1,
+        bool waterfall_rows = false)
         : Message{ID::SpectrumStreamingConfig},
-          mode{mode} {
+          mode{mode},
+          window{window},
+          detector{detector},
+          detector_count{detector_count},
+          waterfall_rows{waterfall_rows} {
     }
 
     Mode mode{Mode::Stopped};
+    dsp::window::Type window{dsp::window::Type::Hamming3};
+    SpectrumDetectorMode detector{SpectrumDetectorMode::Sample};
+    uint8_t detector_count{1};
+    bool waterfall_rows{false};  // Also stream folded rows, see WaterfallRow.
 };
 
 class WidebandSpectrumConfigMessage : public Message {
@@ -307,17 +326,29 @@ struct ChannelSpectrum {
 
 using ChannelSpectrumFIFO = FIFO<ChannelSpectrum>;
 
+/* One waterfall line, already folded to screen width with the DC bin
+ * centered. Values are indexes into the spectrum color LUT. */
+struct WaterfallRow {
+    std::array<uint8_t, 240> index{{0}};
+};
+
+using WaterfallRowFIFO = FIFO<WaterfallRow>;
+
 class ChannelSpectrumConfigMessage : public Message {
    public:
     static constexpr size_t fifo_k = 2;
+    static constexpr size_t row_fifo_k = 3;
 
     constexpr ChannelSpectrumConfigMessage(
-        ChannelSpectrumFIFO* fifo)
+        ChannelSpectrumFIFO* fifo,
+        WaterfallRowFIFO* row_fifo = nullptr)
         : Message{ID::ChannelSpectrumConfig},
-          fifo{fifo} {
+          fifo{fifo},
+          row_fifo{row_fifo} {
     }
 
     ChannelSpectrumFIFO* fifo{nullptr};
+    WaterfallRowFIFO* row_fifo{nullptr};
 };
 
 class AISPacketMessage : public Message {
@@ -331,6 +362,18 @@ class AISPacketMessage : public Message {
     baseband::Packet packet;
 };
 
+class AISConfigureMessage : public Message {
+   public:
+    constexpr AISConfigureMessage(
+        const bool dual_channel)
+        : Message{ID::AISConfigure},
+          dual_channel{dual_channel} {
+    }
+
+    /* Decode 87B and 88B together from a 162.000MHz center. */
+    const bool dual_channel;
+};
+
 class TPMSPacketMessage : public Message {
    public:
     constexpr TPMSPacketMessage(
@@ -443,6 +486,7 @@ struct BlePacketData {
     uint8_t macAddress[6];
     uint8_t data[40];
     uint8_t dataLen;
+    uint64_t sampleIndex;  // Baseband sample the packet ended on.
 };
 
 class BLEPacketMessage : public Message {
@@ -474,6 +518,19 @@ class ShutdownMessage : public Message {
     }
 };
 
+/* Asks the M4 to publish memory_stats::snapshot() in shared memory,
+ * optionally starting its peaks over first. */
+class MemoryStatsRequestMessage : public Message {
+   public:
+    constexpr MemoryStatsRequestMessage(
+        const bool reset_peaks = false)
+        : Message{ID::MemoryStatsRequest},
+          reset_peaks{reset_peaks} {
+    }
+
+    const bool reset_peaks;
+};
+
 class ERTPacketMessage : public Message {
    public:
     constexpr ERTPacketMessage(
@@ -616,6 +673,7 @@ class StreamBuffer {
     uint8_t* data_;
     size_t used_;
     size_t capacity_;
+    size_t read_offset_;  // Reads start at the front, also when not full.
 
    public:
     constexpr StreamBuffer(
@@ -623,7 +681,8 @@ class StreamBuffer {
         const size_t capacity = 0)
         : data_{static_cast<uint8_t*>(data)},
           used_{0},
-          capacity_{capacity} {
+          capacity_{capacity},
+          read_offset_{0} {
     }
 
     size_t write(const void* p, const size_t count) {
@@ -635,7 +694,8 @@ class StreamBuffer {
 
     size_t read(void* p, const size_t count) {
         const auto copy_size = std::min(used_, count);
-        memcpy(p, &data_[capacity_ - used_], copy_size);
+        memcpy(p, &data_[read_offset_], copy_size);
+        read_offset_ += copy_size;
         used_ -= copy_size;
         return copy_size;
     }
@@ -662,20 +722,38 @@ class StreamBuffer {
 
     void set_size(const size_t value) {
         used_ = value;
+        read_offset_ = 0;
     }
 
     void empty() {
         used_ = 0;
+        read_offset_ = 0;
     }
 };
 
+/* Ties a sample of the capture stream to the baseband sample counter and
+ * the RTC. Marks are posted at the start, every 10 RTC seconds and after
+ * any gap in the stream. */
+struct CaptureTimeMark {
+    uint64_t stream_sample;  // Samples written to the stream before the marked one.
+    uint64_t sample_index;   // The marked sample on the baseband counter, at the stream rate.
+    Timestamp timestamp;     // RTC when the marked sample arrived.
+};
+
 struct CaptureConfig {
+    static constexpr size_t time_marks_count = 8;
+
     const size_t write_size;
     const size_t buffer_count;
     uint64_t baseband_bytes_received;
     uint64_t baseband_bytes_dropped;
     FIFO<StreamBuffer*>* fifo_buffers_empty;
     FIFO<StreamBuffer*>* fifo_buffers_full;
+    /* Written by the M4, mark n goes to time_marks[n % time_marks_count]. */
+    std::array<CaptureTimeMark, time_marks_count> time_marks;
+    volatile uint32_t time_marks_written;
+    /* Largest |I| or |Q| written to the stream, sets the replay gain. */
+    volatile uint16_t peak;
 
     constexpr CaptureConfig(
         const size_t write_size,
@@ -685,7 +763,10 @@ struct CaptureConfig {
           baseband_bytes_received{0},
           baseband_bytes_dropped{0},
           fifo_buffers_empty{nullptr},
-          fifo_buffers_full{nullptr} {
+          fifo_buffers_full{nullptr},
+          time_marks{},
+          time_marks_written{0},
+          peak{0} {
     }
 
     size_t dropped_percent() const {
@@ -693,7 +774,7 @@ struct CaptureConfig {
             return 0;
         } else {
             const size_t percent = baseband_bytes_dropped * 100U / baseband_bytes_received;
-            return std::max(1U, percent);
+            return std::max<size_t>(1, percent);
         }
     }
 };
@@ -712,15 +793,19 @@ class CaptureConfigMessage : public Message {
 struct ReplayConfig {
     const size_t read_size;
     const size_t buffer_count;
+    /* Stream holds C8 samples, proc_replay sends them without widening to C16. */
+    const bool c8;
     uint64_t baseband_bytes_received;
     FIFO<StreamBuffer*>* fifo_buffers_empty;
     FIFO<StreamBuffer*>* fifo_buffers_full;
 
     constexpr ReplayConfig(
         const size_t read_size,
-        const size_t buffer_count)
+        const size_t buffer_count,
+        const bool c8 = false)
         : read_size{read_size},
           buffer_count{buffer_count},
+          c8{c8},
           baseband_bytes_received{0},
           fifo_buffers_empty{nullptr},
           fifo_buffers_full{nullptr} {
@@ -738,6 +823,20 @@ class ReplayConfigMessage : public Message {
     ReplayConfig* const config;
 };
 
+class ReplayGainConfigMessage : public Message {
+   public:
+    constexpr ReplayGainConfigMessage(
+        const uint16_t peak,
+        const bool dither)
+        : Message{ID::ReplayGainConfig},
+          peak{peak},
+          dither{dither} {
+    }
+
+    const uint16_t peak;  // Largest I or Q in the source, 0 if unknown.
+    const bool dither;    // TPDF dither before rounding to C8.
+};
+
 class TXProgressMessage : public Message {
    public:
     constexpr TXProgressMessage()
@@ -786,6 +885,11 @@ class BTLERxConfigureMessage : public Message {
         : Message{ID::BTLERxConfigure},
           channel_number(channel_number) {
     }
+
+    // Radio settings the processor expects, 2 samples per symbol after decimation.
+    static constexpr uint32_t sampling_rate = 8'000'000;
+    static constexpr uint32_t baseband_bandwidth = 6'000'000;
+
     const uint8_t channel_number;
 };
 
@@ -1290,6 +1394,78 @@ class SubGhzDDataMessage : public Message {
     uint64_t data = 0;
 };
 
+namespace ism {
+
+enum class Protocol : uint8_t {
+    TPMS = 0,
+    ERT = 1,
+    Weather = 2,
+    SubGhzD = 3,
+    count
+};
+
+constexpr uint8_t decoder_bit(const Protocol protocol) {
+    return 1 << static_cast<uint8_t>(protocol);
+}
+
+constexpr uint8_t all_decoders = (1 << static_cast<uint8_t>(Protocol::count)) - 1;
+
+} /* namespace ism */
+
+/* A decode from the multi-protocol ISM image. TPMS and ERT carry the raw
+ * packet, with type holding the tpms::SignalType or ert::Packet::Type.
+ * Weather and SubGhzD carry the fprotos sensor type and decoded data. */
+class ISMPacketMessage : public Message {
+   public:
+    constexpr ISMPacketMessage(
+        const tpms::SignalType signal_type,
+        const baseband::Packet& packet)
+        : Message{ID::ISMPacket},
+          protocol{ism::Protocol::TPMS},
+          type{static_cast<uint8_t>(signal_type)},
+          packet{packet} {
+    }
+
+    constexpr ISMPacketMessage(
+        const ert::Packet::Type type,
+        const baseband::Packet& packet)
+        : Message{ID::ISMPacket},
+          protocol{ism::Protocol::ERT},
+          type{static_cast<uint8_t>(type)},
+          packet{packet} {
+    }
+
+    constexpr ISMPacketMessage(
+        const ism::Protocol protocol,
+        const uint8_t sensor_type,
+        const uint16_t bits,
+        const uint64_t data)
+        : Message{ID::ISMPacket},
+          protocol{protocol},
+          type{sensor_type},
+          bits{bits},
+          data{data} {
+    }
+
+    ism::Protocol protocol;
+    uint8_t type;
+    uint16_t bits{0};
+    uint64_t data{0};
+    baseband::Packet packet{};
+};
+
+class ISMConfigureMessage : public Message {
+   public:
+    constexpr ISMConfigureMessage(
+        const uint8_t decoders)
+        : Message{ID::ISMConfigure},
+          decoders{decoders} {
+    }
+
+    /* Bitmask of ism::decoder_bit(), the others are skipped. */
+    const uint8_t decoders;
+};
+
 class GPSPosDataMessage : public Message {
    public:
     constexpr GPSPosDataMessage(
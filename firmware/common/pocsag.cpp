@@ -22,13 +22,6 @@
 
 #include "pocsag.hpp"
 
-#include "baseband_api.hpp"
-#include "portapack.hpp"
-using namespace portapack;
-
-#include "string_format.hpp"
-#include "utility.hpp"
-
 namespace pocsag {
 
 std::string bitrate_str(BitRate bitrate) {
@@ -57,32 +50,8 @@ std::string flag_str(PacketFlag packetflag) {
     }
 }
 
-void insert_BCH(BCHCode& BCH_code, uint32_t* codeword) {
-    uint32_t parity = 0;
-    int data[21];
-    int bit;
-    int* bb;
-    size_t c;
-
-    for (c = 0; c < 21; c++) {
-        bit = (((*codeword) << c) & 0x80000000U) ? 1 : 0;
-        if (bit) parity++;
-        data[c] = bit;
-    }
-
-    bb = BCH_code.encode(data);
-
-    // Make sure ECC bits are cleared
-    (*codeword) &= 0xFFFFF801;
-
-    for (c = 0; c < 10; c++) {
-        bit = bb[c];
-        (*codeword) |= (bit << (10 - c));
-        if (bit) parity++;
-    }
-
-    // Even parity
-    (*codeword) |= (parity & 1);
+void insert_BCH(uint32_t* codeword) {
+    *codeword = bch::encode(*codeword);
 }
 
 uint32_t get_digit_code(char code) {
@@ -111,7 +80,7 @@ uint32_t get_digit_code(char code) {
     return code;
 }
 
-void pocsag_encode(const MessageType type, BCHCode& BCH_code, const uint32_t function, const std::string message, const uint32_t address, std::vector<uint32_t>& codewords) {
+void pocsag_encode(const MessageType type, const uint32_t function, const std::string message, const uint32_t address, std::vector<uint32_t>& codewords) {
     size_t b, c, address_slot;
     size_t bit_idx, char_idx = 0;
     uint32_t codeword, digit_code;
@@ -130,7 +99,7 @@ void pocsag_encode(const MessageType type, BCHCode& BCH_code, const uint32_t fun
     // Function
     codeword |= (function << 11);
 
-    insert_BCH(BCH_code, &codeword);
+    insert_BCH(&codeword);
 
     // Address batch
     codewords.push_back(POCSAG_SYNCWORD);
@@ -177,7 +146,7 @@ void pocsag_encode(const MessageType type, BCHCode& BCH_code, const uint32_t fun
 
                     codeword &= 0x7FFFF800;  // Trim data
                     codeword |= 0x80000000;  // Message type
-                    insert_BCH(BCH_code, &codeword);
+                    insert_BCH(&codeword);
 
                     codewords.push_back(codeword);
 
@@ -208,7 +177,7 @@ void pocsag_encode(const MessageType type, BCHCode& BCH_code, const uint32_t fun
                     } while (bit_idx > 11);
 
                     codeword |= 0x80000000;  // Message type
-                    insert_BCH(BCH_code, &codeword);
+                    insert_BCH(&codeword);
 
                     codewords.push_back(codeword);
 
@@ -225,145 +194,41 @@ void pocsag_encode(const MessageType type, BCHCode& BCH_code, const uint32_t fun
     } while (char_idx < message_size);
 }
 
-// ----------------------------------------------------------------------------
-// EccContainer
-// ----------------------------------------------------------------------------
-EccContainer::EccContainer() {
-    setup_ecc();
-}
-
-void EccContainer::setup_ecc() {
-    unsigned int srr = 0x3b4;
-    unsigned int i, n, j, k;
-
-    /* calculate all information needed to implement error correction */
-    // Note : this is only for 31,21 code used in pocsag & flex
-    //        one should probably also make use of 32nd parity bit
-    for (i = 0; i <= 20; i++) {
-        ecs[i] = srr;
-        if ((srr & 0x01) != 0)
-            srr = (srr >> 1) ^ 0x3B4;
-        else
-            srr = srr >> 1;
+uint16_t correct_batch(batch_t& codewords) {
+    // Most batches are clean, find the ones that aren't first.
+    uint16_t damaged = 0;
+    for (size_t i = 0; i < batch_size; i++) {
+        if (!bch::valid(codewords[i]))
+            damaged |= 1U << i;
     }
 
-    /* bch holds a syndrome look-up table telling which bits to correct */
-    // first 5 bits hold location of first error; next 5 bits hold location
-    // of second error; bits 12 & 13 tell how many bits are bad
-    for (i = 0; i < 1024; i++) bch[i] = 0;
-
-    /* two errors in data */
-    for (n = 0; n <= 20; n++) {
-        for (i = 0; i <= 20; i++) {
-            j = (i << 5) + n;
-            k = ecs[n] ^ ecs[i];
-            bch[k] = j + 0x2000;
-        }
-    }
-
-    /* one error in data */
-    for (n = 0; n <= 20; n++) {
-        k = ecs[n];
-        j = n + (0x1f << 5);
-        bch[k] = j + 0x1000;
-    }
-
-    /* one error in data and one error in ecc portion */
-    for (n = 0; n <= 20; n++) {
-        for (i = 0; i < 10; i++) /* ecc screwed up bit */
-        {
-            k = ecs[n] ^ (1 << i);
-            j = n + (0x1f << 5);
-            bch[k] = j + 0x2000;
-        }
-    }
+    uint16_t failed = 0;
+    for (size_t i = 0; damaged != 0; i++, damaged >>= 1) {
+        if ((damaged & 1) == 0)
+            continue;
 
-    /* one error in ecc */
-    for (n = 0; n < 10; n++) {
-        k = 1 << n;
-        bch[k] = 0x3ff + 0x1000;
+        if (bch::correct(codewords[i]) == bch::uncorrectable)
+            failed |= 1U << i;
     }
 
-    /* two errors in ecc */
-    for (n = 0; n < 10; n++) {
-        for (i = 0; i < 10; i++) {
-            if (i != n) {
-                k = (1 << n) ^ (1 << i);
-                bch[k] = 0x3ff + 0x2000;
-            }
-        }
-    }
+    return failed;
 }
 
-int EccContainer::error_correct(uint32_t& val) {
-    int i, synd, errl, acc, pari, ecc, b1, b2;
-
-    errl = 0;
-    pari = 0;
-
-    ecc = 0;
-    for (i = 31; i >= 11; --i) {
-        if (val & (1 << i)) {
-            ecc = ecc ^ ecs[31 - i];
-            pari = pari ^ 0x01;
-        }
-    }
-
-    acc = 0;
-    for (i = 10; i >= 1; --i) {
-        acc = acc << 1;
-        if (val & (1 << i)) {
-            acc = acc ^ 0x01;
-        }
-    }
-
-    synd = ecc ^ acc;
-
-    errl = 0;
-
-    if (synd != 0) /* if nonzero syndrome we have error */
-    {
-        if (bch[synd] != 0) /* check for correctable error */
-        {
-            b1 = bch[synd] & 0x1f;
-            b2 = bch[synd] >> 5;
-            b2 = b2 & 0x1f;
-
-            if (b2 != 0x1f) {
-                val ^= 0x01 << (31 - b2);
-                ecc = ecc ^ ecs[b2];
-            }
-
-            if (b1 != 0x1f) {
-                val ^= 0x01 << (31 - b1);
-                ecc = ecc ^ ecs[b1];
-            }
+bool pocsag_decode_batch(const POCSAGPacket& batch, POCSAGState& state) {
+    state.output.clear();
 
-            errl = bch[synd] >> 12;
-        } else {
-            errl = 3;
-        }
+    // Correct the whole batch up front, later calls continue in it.
+    if (state.codeword_index == 0) {
+        for (size_t i = 0; i < batch_size; i++)
+            state.codewords[i] = batch[i];
 
-        if (errl == 1) pari = pari ^ 0x01;
+        state.failed = correct_batch(state.codewords);
     }
 
-    if (errl == 4) errl = 3;
-
-    return errl;
-}
-
-bool pocsag_decode_batch(const POCSAGPacket& batch, POCSAGState& state) {
-    constexpr uint8_t codeword_max = 16;
-    state.output.clear();
-
-    while (state.codeword_index < codeword_max) {
-        auto codeword = batch[state.codeword_index];
+    while (state.codeword_index < batch_size) {
+        auto codeword = state.codewords[state.codeword_index];
         bool is_address = (codeword & 0x80000000U) == 0;
-
-        // Error correct twice. First time to fix any errors it can,
-        // second time to count number of errors that couldn't be fixed.
-        state.ecc->error_correct(codeword);
-        auto error_count = state.ecc->error_correct(codeword);
+        uint32_t error_count = (state.failed & (1U << state.codeword_index)) ? bch::uncorrectable : 0;
 
         switch (state.mode) {
             case STATE_CLEAR:
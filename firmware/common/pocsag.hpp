@@ -31,7 +31,11 @@
 #define POCSAG_BATCH_LENGTH (17 * 32)
 
 #include "pocsag_packet.hpp"
-#include "bch_code.hpp"
+#include "pocsag_bch.hpp"
+
+#include <array>
+#include <string>
+#include <vector>
 
 namespace pocsag {
 
@@ -56,29 +60,9 @@ enum MessageType : uint32_t {
     ALPHANUMERIC
 };
 
-/* Holds error correction arrays. This allows the arrays to
- * be freed when POCSAG is not running, saving ~4kb of RAM. */
-class EccContainer {
-   public:
-    EccContainer();
-
-    EccContainer(const EccContainer&) = delete;
-    EccContainer(EccContainer&&) = delete;
-    EccContainer& operator=(const EccContainer&) = delete;
-    EccContainer& operator=(EccContainer&&) = delete;
-
-    int error_correct(uint32_t& val);
-
-   private:
-    void setup_ecc();
-
-    /* error correction sequence */
-    uint32_t ecs[32];
-    uint32_t bch[1025];
-};
-
 struct POCSAGState {
-    EccContainer* ecc = nullptr;
+    batch_t codewords{};  // Corrected copy of the batch.
+    uint16_t failed = 0;  // Codewords that couldn't be corrected.
     uint8_t codeword_index = 0;
     uint32_t function = 0;
     uint32_t address = 0;
@@ -100,9 +84,13 @@ const pocsag::BitRate pocsag_bitrates[4] = {
 std::string bitrate_str(BitRate bitrate);
 std::string flag_str(PacketFlag packetflag);
 
-void insert_BCH(BCHCode& BCH_code, uint32_t* codeword);
+void insert_BCH(uint32_t* codeword);
 uint32_t get_digit_code(char code);
-void pocsag_encode(const MessageType type, BCHCode& BCH_code, const uint32_t function, const std::string message, const uint32_t address, std::vector<uint32_t>& codewords);
+void pocsag_encode(const MessageType type, const uint32_t function, const std::string message, const uint32_t address, std::vector<uint32_t>& codewords);
+
+/* Error corrects every codeword of the batch in place. Returns a mask of
+ * the codewords that couldn't be corrected, bit n for codeword n. */
+uint16_t correct_batch(batch_t& codewords);
 
 // Returns true if the batch has more to process.
 bool pocsag_decode_batch(const POCSAGPacket& batch, POCSAGState& state);
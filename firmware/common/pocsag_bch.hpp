@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __POCSAG_BCH_H__
+#define __POCSAG_BCH_H__
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/* BCH(31,21) code with even parity used by POCSAG codewords.
+ *
+ *   bit 31..11  21 data bits, MSB first
+ *   bit 10..1   10 check bits, data * x^10 mod g(x)
+ *   bit 0       even parity over the whole codeword
+ *
+ * The syndrome is linear in the codeword, so it's a XOR of one table
+ * entry per nibble. Encoding is the syndrome of the data bits, and one
+ * syndrome-indexed table corrects up to two bit errors. All tables are
+ * built at compile time and live in flash. */
+namespace pocsag {
+namespace bch {
+
+constexpr uint32_t generator = 0x769;  // x^10 + x^9 + x^8 + x^6 + x^5 + x^3 + 1
+constexpr uint32_t data_mask = 0xFFFFF800;
+constexpr size_t syndrome_count = 1024;
+
+/* Returned by correct() when the codeword has too many errors. */
+constexpr int uncorrectable = 3;
+
+/* Remainder of bits 31..1 divided by the generator, one bit at a time. */
+constexpr uint32_t remainder(uint32_t codeword) {
+    uint32_t r = codeword >> 1;
+    for (int bit = 30; bit >= 10; bit--) {
+        if (r & (1U << bit))
+            r ^= generator << (bit - 10);
+    }
+    return r;
+}
+
+/* No popcount on the M0, fold instead. */
+constexpr uint32_t parity(uint32_t x) {
+    x ^= x >> 16;
+    x ^= x >> 8;
+    x ^= x >> 4;
+    x ^= x >> 2;
+    x ^= x >> 1;
+    return x & 1;
+}
+
+using SyndromeTable = std::array<std::array<uint16_t, 16>, 8>;
+
+constexpr SyndromeTable make_syndrome_table() {
+    SyndromeTable table{};
+    for (size_t nibble = 0; nibble < 8; nibble++) {
+        for (uint32_t value = 0; value < 16; value++)
+            table[nibble][value] = remainder(value << (nibble * 4));
+    }
+    return table;
+}
+
+/* Error positions by syndrome: bit index of the first error in
+ * bits 4..0, of the second in bits 9..5. 0 if not correctable. */
+using CorrectionTable = std::array<uint16_t, syndrome_count>;
+
+constexpr CorrectionTable make_correction_table() {
+    CorrectionTable table{};
+    for (uint32_t first = 1; first < 32; first++) {
+        table[remainder(1U << first)] = first;
+        for (uint32_t second = first + 1; second < 32; second++)
+            table[remainder((1U << first) | (1U << second))] = first | (second << 5);
+    }
+    return table;
+}
+
+inline uint32_t syndrome(const uint32_t codeword) {
+    static constexpr SyndromeTable table = make_syndrome_table();
+
+    uint32_t s = 0;
+    for (size_t nibble = 0; nibble < 8; nibble++)
+        s ^= table[nibble][(codeword >> (nibble * 4)) & 0xF];
+    return s;
+}
+
+/* True if the codeword has no detectable errors. */
+inline bool valid(const uint32_t codeword) {
+    return syndrome(codeword) == 0 && parity(codeword) == 0;
+}
+
+/* Fills in the check and parity bits of the data bits in codeword. */
+inline uint32_t encode(const uint32_t codeword) {
+    const uint32_t data = codeword & data_mask;
+    const uint32_t coded = data | (syndrome(data) << 1);
+    return coded | parity(coded);
+}
+
+/* Corrects up to two bit errors in place and returns how many were
+ * fixed, or uncorrectable. The parity bit catches three bit errors that
+ * the syndrome alone would miscorrect; such codewords are left as is. */
+inline int correct(uint32_t& codeword) {
+    static constexpr CorrectionTable table = make_correction_table();
+
+    const auto s = syndrome(codeword);
+    auto odd = parity(codeword);
+
+    if (s == 0) {
+        if (odd == 0)
+            return 0;
+
+        codeword ^= 1;  // Just the parity bit.
+        return 1;
+    }
+
+    const auto positions = table[s];
+    if (positions == 0)
+        return uncorrectable;
+
+    const uint32_t second = positions >> 5;
+    uint32_t mask = 1U << (positions & 0x1F);
+    int errors = 1;
+    if (second != 0) {
+        mask |= 1U << second;
+        errors = 2;
+    }
+
+    odd ^= errors & 1;
+    if (odd != 0) {
+        // One more error, fine only if that's the parity bit.
+        if (errors == 2)
+            return uncorrectable;
+
+        mask |= 1;
+        errors = 2;
+    }
+
+    codeword ^= mask;
+    return errors;
+}
+
+} /* namespace bch */
+} /* namespace pocsag */
+
+#endif /*__POCSAG_BCH_H__*/
@@ -59,6 +59,15 @@ class POCSAGPacket {
         return timestamp_;
     }
 
+    /* Baseband sample the batch was sent on, see baseband::Packet. */
+    void set_sample_index(const uint64_t value) {
+        sample_index_ = value;
+    }
+
+    uint64_t sample_index() const {
+        return sample_index_;
+    }
+
     void set(size_t index, uint32_t data) {
         if (index < batch_size)
             codewords[index] = data;
@@ -99,6 +108,7 @@ class POCSAGPacket {
     PacketFlag flag_{NORMAL};
     batch_t codewords{};
     Timestamp timestamp_{};
+    uint64_t sample_index_{0};
 };
 
 } /* namespace pocsag */
@@ -196,6 +196,13 @@ class IO {
         }
     }
 
+    /* Expands palette indexes through lut while writing, no pixel buffer needed. */
+    void lcd_write_pixels(const uint8_t* const indexes, size_t n, const ui::Color* const lut) {
+        for (size_t i = 0; i < n; i++) {
+            lcd_write_data(lut[indexes[i]].v);
+        }
+    }
+
     void lcd_read_bytes(uint8_t* byte, size_t byte_count) {
         size_t word_count = byte_count / 2;
         while (word_count) {
@@ -27,6 +27,8 @@
 #include <cstddef>
 
 #include "message_queue.hpp"
+#include "command_queue.hpp"
+#include "memory_stats.hpp"
 
 struct JammerChannel {
     bool enabled;
@@ -50,12 +52,14 @@ struct ToneData {
 struct SharedMemory {
     static constexpr size_t application_queue_k = 11;
     static constexpr size_t app_local_queue_k = 11;
+    static constexpr size_t baseband_queue_k = 11;
 
     uint8_t application_queue_data[1 << application_queue_k]{0};
     uint8_t app_local_queue_data[1 << app_local_queue_k]{0};
-    const Message* volatile baseband_message{nullptr};
+    uint8_t baseband_queue_data[1 << baseband_queue_k]{0};
     MessageQueue application_queue{application_queue_data, application_queue_k};
     MessageQueue app_local_queue{app_local_queue_data, app_local_queue_k};
+    CommandQueue baseband_queue{baseband_queue_data, baseband_queue_k};
 
     char m4_panic_msg[32]{0};
 
@@ -74,7 +78,10 @@ struct SharedMemory {
     uint8_t volatile m4_performance_counter{0};
     uint16_t volatile m4_stack_usage{0};
     uint32_t volatile m4_heap_usage{0};
-    uint16_t volatile m4_buffer_missed{0};
+    uint32_t volatile m4_buffer_missed{0};
+
+    // Filled by the M4 on MemoryStatsRequestMessage.
+    memory_stats::Snapshot m4_memory{};
 };
 
 extern SharedMemory& shared_memory;
@@ -77,6 +77,10 @@ Timestamp Packet::received_at() const {
     return packet_.timestamp();
 }
 
+uint64_t Packet::sample_index() const {
+    return packet_.sample_index();
+}
+
 Packet::Type Packet::type() const {
     return type_;
 }
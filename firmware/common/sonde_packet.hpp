@@ -59,6 +59,7 @@ class Packet {
     size_t length() const;
 
     Timestamp received_at() const;
+    uint64_t sample_index() const;
 
     Type type() const;
     std::string type_string() const;
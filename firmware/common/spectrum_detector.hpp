@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __SPECTRUM_DETECTOR_H__
+#define __SPECTRUM_DETECTOR_H__
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "spectrum_modes.hpp"
+
+/* Per-bin video detector for dB spectrum frames, integer only. */
+template <size_t N>
+class SpectrumDetector {
+   public:
+    void configure(const SpectrumDetectorMode mode, const uint8_t count) {
+        mode_ = mode;
+        count_ = std::max<uint8_t>(count, 1);
+        reset();
+    }
+
+    void reset() {
+        frames_ = 0;
+    }
+
+    SpectrumDetectorMode mode() const { return mode_; }
+    uint8_t count() const { return count_; }
+
+    /* Feeds one frame. Returns true if db now holds a frame to publish. */
+    bool apply(std::array<uint8_t, N>& db) {
+        const bool first = (frames_ == 0);
+
+        switch (mode_) {
+            case SpectrumDetectorMode::AverageExponential:
+                // Accumulator is Q8 so small steps aren't lost to rounding.
+                for (size_t i = 0; i < N; i++) {
+                    const int32_t x = db[i] << 8;
+                    if (first)
+                        acc_[i] = x;
+                    else
+                        acc_[i] += (x - static_cast<int32_t>(acc_[i])) / count_;
+                    db[i] = (acc_[i] + 0x80) >> 8;
+                }
+                frames_ = 1;
+                return true;
+
+            case SpectrumDetectorMode::AverageLinear:
+                for (size_t i = 0; i < N; i++)
+                    acc_[i] = (first ? 0 : acc_[i]) + db[i];
+
+                if (++frames_ < count_)
+                    return false;
+
+                for (size_t i = 0; i < N; i++)
+                    db[i] = acc_[i] / count_;
+                frames_ = 0;
+                return true;
+
+            case SpectrumDetectorMode::MaxHold:
+                for (size_t i = 0; i < N; i++) {
+                    acc_[i] = first ? db[i] : std::max<uint16_t>(acc_[i], db[i]);
+                    db[i] = acc_[i];
+                }
+                frames_ = 1;
+                return true;
+
+            case SpectrumDetectorMode::MinHold:
+                for (size_t i = 0; i < N; i++) {
+                    acc_[i] = first ? db[i] : std::min<uint16_t>(acc_[i], db[i]);
+                    db[i] = acc_[i];
+                }
+                frames_ = 1;
+                return true;
+
+            case SpectrumDetectorMode::Sample:
+            default:
+                return true;
+        }
+    }
+
+   private:
+    // 255 frames * 255 still fits for linear averaging.
+    std::array<uint16_t, N> acc_{};
+    SpectrumDetectorMode mode_{SpectrumDetectorMode::Sample};
+    uint8_t count_{1};
+    uint8_t frames_{0};
+};
+
+#endif /*__SPECTRUM_DETECTOR_H__*/
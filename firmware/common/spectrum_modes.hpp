@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __SPECTRUM_MODES_H__
+#define __SPECTRUM_MODES_H__
+
+#include <cstdint>
+
+/* Spectrum processing choices carried by SpectrumStreamingConfigMessage.
+ * Kept apart from the DSP code so message users don't pull it in.
+ */
+
+namespace dsp {
+namespace window {
+
+enum class Type : uint8_t {
+    Hamming3 = 0,  // Legacy 3-point Hamming applied in the frequency domain.
+    Rectangular = 1,
+    Hann = 2,
+    BlackmanHarris = 3,
+    FlatTop = 4,
+};
+
+} /* namespace window */
+} /* namespace dsp */
+
+enum class SpectrumDetectorMode : uint8_t {
+    Sample = 0,              // Every frame as computed.
+    AverageExponential = 1,  // Running average, alpha = 1 / count.
+    AverageLinear = 2,       // Mean of count frames, one output per count frames.
+    MaxHold = 3,             // Highest value seen since reset.
+    MinHold = 4,             // Lowest value seen since reset.
+};
+
+#endif /*__SPECTRUM_MODES_H__*/
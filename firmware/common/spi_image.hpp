@@ -119,6 +119,7 @@ constexpr image_tag_t image_tag_usb_sd{'P', 'U', 'S', 'B'};
 constexpr image_tag_t image_tag_weather{'P', 'W', 'T', 'H'};
 constexpr image_tag_t image_tag_subghzd{'P', 'S', 'G', 'D'};
 constexpr image_tag_t image_tag_protoview{'P', 'P', 'V', 'W'};
+constexpr image_tag_t image_tag_ism{'P', 'I', 'S', 'M'};
 
 constexpr image_tag_t image_tag_noop{'P', 'N', 'O', 'P'};
 
@@ -145,13 +146,13 @@ struct region_t {
 };
 
 const region_t images{
-    .offset = reinterpret_cast<uint32_t>(&_textend),
-    .size = portapack::memory::map::spifi_cached.size() - reinterpret_cast<uint32_t>(&_textend),
+    .offset = reinterpret_cast<uintptr_t>(&_textend),
+    .size = portapack::memory::map::spifi_cached.size() - reinterpret_cast<uintptr_t>(&_textend),
 };
 
 const region_t application{
     .offset = 0x00000,
-    .size = reinterpret_cast<uint32_t>(&_textend),
+    .size = reinterpret_cast<uintptr_t>(&_textend),
 };
 
 } /* namespace spi_flash */
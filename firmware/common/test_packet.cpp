@@ -37,6 +37,10 @@ Timestamp Packet::received_at() const {
     return packet_.timestamp();
 }
 
+uint64_t Packet::sample_index() const {
+    return packet_.sample_index();
+}
+
 FormattedSymbols Packet::symbols_formatted() const {
     return format_symbols(decoder_);
 }
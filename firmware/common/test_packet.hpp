@@ -46,6 +46,7 @@ class Packet {
     bool is_valid() const;
 
     Timestamp received_at() const;
+    uint64_t sample_index() const;
 
     uint32_t value() const;
     uint32_t alt() const;
@@ -23,13 +23,17 @@
 
 int ThreadWait::sleep() {
     chSysLock();
-    thread_to_wake = chThdSelf();
-    chSchGoSleepS(THD_STATE_SUSPENDED);
-    const auto result = chThdSelf()->p_u.rdymsg;
+    const auto result = sleepS();
     chSysUnlock();
     return result;
 }
 
+int ThreadWait::sleepS() {
+    thread_to_wake = chThdSelf();
+    chSchGoSleepS(THD_STATE_SUSPENDED);
+    return chThdSelf()->p_u.rdymsg;
+}
+
 bool ThreadWait::wake_from_interrupt(const int value) {
     if (thread_to_wake) {
         thread_to_wake->p_u.rdymsg = value;
@@ -27,6 +27,10 @@
 class ThreadWait {
    public:
     int sleep();
+
+    /* As sleep(), called with the system locked so a condition can be
+     * checked before sleeping without missing a wake. */
+    int sleepS();
     bool wake_from_interrupt(const int value);
 
    private:
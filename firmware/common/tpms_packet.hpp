@@ -145,6 +145,7 @@ class Packet {
 
     SignalType signal_type() const { return signal_type_; }
     Timestamp received_at() const;
+    uint64_t sample_index() const;
 
     FormattedSymbols symbols_formatted() const;
 
@@ -53,6 +53,11 @@ bool Rect::contains(const Point p) const {
            (p.x() < right()) && (p.y() < bottom());
 }
 
+bool Rect::contains(const Rect& o) const {
+    return (o.left() >= left()) && (o.top() >= top()) &&
+           (o.right() <= right()) && (o.bottom() <= bottom());
+}
+
 Rect Rect::intersect(const Rect& o) const {
     const auto x1 = std::max(left(), o.left());
     const auto x2 = std::min(right(), o.right());
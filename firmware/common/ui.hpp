@@ -350,6 +350,7 @@ struct Rect {
     }
 
     bool contains(const Point p) const;
+    bool contains(const Rect& o) const;
 
     Rect intersect(const Rect& o) const;
 
@@ -26,6 +26,8 @@
 #include "portapack.hpp"
 using namespace portapack;
 
+#include <algorithm>
+
 namespace ui {
 
 Style Style::invert() const {
@@ -37,7 +39,7 @@ Style Style::invert() const {
 
 int Painter::draw_char(Point p, const Style& style, char c) {
     const auto glyph = style.font.glyph(c);
-    display.draw_glyph(p, glyph, style.foreground, style.background);
+    draw_clipped(p, glyph.size(), glyph.pixels(), style.foreground, style.background);
     return glyph.advance().x();
 }
 
@@ -67,7 +69,7 @@ int Painter::draw_string(
                 escape = true;
             } else {
                 const auto glyph = font.glyph(c);
-                display.draw_glyph(p, glyph, pen, background);
+                draw_clipped(p, glyph.size(), glyph.pixels(), pen, background);
                 const auto advance = glyph.advance();
                 p += advance;
                 width += advance.x();
@@ -83,15 +85,46 @@ void Painter::draw_bitmap(Point p, const Bitmap& bitmap, Color foreground, Color
     if ((background.v == ui::Color::white().v) && (foreground.to_greyscale() > 146))
         foreground = foreground.dark();
 
-    display.draw_bitmap(p, bitmap.size, bitmap.data, foreground, background);
+    draw_clipped(p, bitmap.size, bitmap.data, foreground, background);
+}
+
+void Painter::draw_clipped(Point p, Size size, const uint8_t* pixels, Color foreground, Color background) {
+    const Rect r{p, size};
+    if (clip_.is_empty() || clip_.contains(r)) {
+        display.draw_bitmap(p, size, pixels, foreground, background);
+        return;
+    }
+
+    // Only the part inside the clip, a row (or chunk of one) per window.
+    const auto visible = r.intersect(clip_);
+    const bool transparent = background.v == Color::magenta().v;
+    std::array<Color, 32> line;
+
+    for (int y = visible.top(); y < visible.bottom(); ++y) {
+        for (int x0 = visible.left(); x0 < visible.right(); x0 += line.size()) {
+            const int n = std::min<int>(line.size(), visible.right() - x0);
+
+            for (int k = 0; k < n; ++k) {
+                const size_t i = (y - p.y()) * size.width() + (x0 + k - p.x());
+                const bool set = pixels[i >> 3] & (1U << (i & 0x7));
+                if (!transparent)
+                    line[k] = set ? foreground : background;
+                else if (set)
+                    display.draw_pixel({x0 + k, y}, foreground);
+            }
+
+            if (!transparent)
+                display.draw_pixels({x0, y, n, 1}, line.data(), n);
+        }
+    }
 }
 
 void Painter::draw_hline(Point p, int width, Color c) {
-    display.fill_rectangle({p, {width, 1}}, c);
+    fill_rectangle({p, {width, 1}}, c);
 }
 
 void Painter::draw_vline(Point p, int height, Color c) {
-    display.fill_rectangle({p, {1, height}}, c);
+    fill_rectangle({p, {1, height}}, c);
 }
 
 void Painter::draw_rectangle(Rect r, Color c) {
@@ -102,20 +135,209 @@ void Painter::draw_rectangle(Rect r, Color c) {
 }
 
 void Painter::fill_rectangle(Rect r, Color c) {
-    display.fill_rectangle(r, c);
+    if (!clip_.is_empty())
+        r = r.intersect(clip_);
+
+    fill_unoccluded(r, c, false);
 }
 
 void Painter::fill_rectangle_unrolled8(Rect r, Color c) {
-    display.fill_rectangle_unrolled8(r, c);
+    if (!clip_.is_empty())
+        r = r.intersect(clip_);
+
+    fill_unoccluded(r, c, true);
+}
+
+/* Fills r minus the exclusions. r is cut into horizontal slabs at the
+ * top and bottom edges of the exclusions it overlaps. Each slab fills
+ * the gaps between them, and a gap continuing the same columns as one
+ * in the slab above extends it instead of starting a new window. */
+void Painter::fill_unoccluded(Rect r, Color c, bool unrolled) {
+    if (r.is_empty())
+        return;
+
+    auto fill = [c, unrolled](const Rect& band) {
+        if (unrolled)
+            display.fill_rectangle_unrolled8(band, c);
+        else
+            display.fill_rectangle(band, c);
+    };
+
+    std::array<Rect, max_exclusions> holes;
+    size_t hole_count = 0;
+    for (size_t i = 0; i < exclusion_count_; ++i) {
+        const auto overlap = r.intersect(exclusions_[i]);
+        if (!overlap.is_empty())
+            holes[hole_count++] = overlap;
+    }
+
+    if (hole_count == 0) {
+        fill(r);
+        return;
+    }
+
+    std::array<int, max_exclusions * 2 + 2> edges;
+    size_t edge_count = 0;
+    edges[edge_count++] = r.top();
+    edges[edge_count++] = r.bottom();
+    for (size_t i = 0; i < hole_count; ++i) {
+        edges[edge_count++] = holes[i].top();
+        edges[edge_count++] = holes[i].bottom();
+    }
+    std::sort(edges.begin(), edges.begin() + edge_count);
+    edge_count = std::unique(edges.begin(), edges.begin() + edge_count) - edges.begin();
+
+    // Holes sorted by left edge, so each slab walks them left to right.
+    std::sort(holes.begin(), holes.begin() + hole_count,
+              [](const Rect& a, const Rect& b) { return a.left() < b.left(); });
+
+    // Gaps of the slab above, not filled yet since they may grow.
+    std::array<Rect, max_exclusions + 1> open;
+    size_t open_count = 0;
+
+    for (size_t e = 0; e + 1 < edge_count; ++e) {
+        const int top = edges[e];
+        const int bottom = edges[e + 1];
+
+        std::array<Rect, max_exclusions + 1> next;
+        size_t next_count = 0;
+        auto add_gap = [&](int left, int right) {
+            if (right <= left)
+                return;
+
+            for (size_t i = 0; i < open_count; ++i) {
+                auto& g = open[i];
+                if (!g.is_empty() && g.left() == left && g.right() == right) {
+                    next[next_count++] = {left, g.top(), right - left, bottom - g.top()};
+                    g = {};
+                    return;
+                }
+            }
+            next[next_count++] = {left, top, right - left, bottom - top};
+        };
+
+        int x = r.left();
+        for (size_t i = 0; i < hole_count; ++i) {
+            const auto& h = holes[i];
+            if (h.top() <= top && h.bottom() >= bottom) {
+                add_gap(x, h.left());
+                x = std::max(x, h.right());
+            }
+        }
+        add_gap(x, r.right());
+
+        // Gaps that didn't continue are done.
+        for (size_t i = 0; i < open_count; ++i) {
+            if (!open[i].is_empty())
+                fill(open[i]);
+        }
+
+        open = next;
+        open_count = next_count;
+    }
+
+    for (size_t i = 0; i < open_count; ++i)
+        fill(open[i]);
 }
 
 void Painter::paint_widget_tree(Widget* w) {
     if (ui::is_dirty()) {
+        ui::DamageRects damage;
+        auto count = ui::damage_take(damage);
+        for (size_t i = 0; i < count; ++i)
+            paint_damage(w, damage[i]);
+
         paint_widget(w);
         ui::dirty_clear();
     }
 }
 
+/* Repaints the area uncovered by a hidden widget. */
+void Painter::paint_damage(Widget* w, Rect damage) {
+    if (w->hidden() || w->dirty())
+        return;
+
+    // Descend into the topmost child covering the damage, unless
+    // another child drawn above it overlaps the damage too.
+    const auto& children = w->children();
+    for (auto it = children.rbegin(); it != children.rend(); ++it) {
+        auto child = *it;
+        if (child->hidden())
+            continue;
+
+        const auto r = child->screen_rect();
+        if (r.contains(damage)) {
+            paint_damage(child, damage);
+            return;
+        }
+
+        if (!r.intersect(damage).is_empty())
+            break;
+    }
+
+    // Leaves simply repaint, containers repaint the damage only.
+    if (children.empty()) {
+        w->set_dirty();
+        return;
+    }
+
+    clip_ = damage;
+    exclude_opaque_children(w);
+    w->paint(*this);
+    exclusion_count_ = 0;
+    clip_ = {};
+
+    for (auto child : children) {
+        if (!child->hidden() && !child->screen_rect().intersect(damage).is_empty())
+            child->set_dirty();
+    }
+}
+
+void Painter::exclude_opaque_children(const Widget* w) {
+    exclusion_count_ = 0;
+    const auto& children = w->children();
+    for (size_t i = 0; i < children.size(); ++i) {
+        if (exclusion_count_ == exclusions_.size())
+            break;
+
+        const auto child = children[i];
+        if (!child->hidden() && child->opaque()) {
+            exclusions_[exclusion_count_] = child->screen_rect();
+            exclusion_owners_[exclusion_count_] = i;
+            ++exclusion_count_;
+        }
+    }
+}
+
+/* Marks the children covered by a later, opaque sibling, using the
+ * opaque children already collected by exclude_opaque_children(). */
+Painter::OccludedSet Painter::occluded_children(const Widget* w) const {
+    OccludedSet occluded{};
+    const auto& children = w->children();
+
+    for (size_t e = 0; e < exclusion_count_; ++e) {
+        const auto& cover = exclusions_[e];
+        const auto last = std::min<size_t>(exclusion_owners_[e], occluded.size());
+        for (size_t i = 0; i < last; ++i) {
+            if (!occluded[i] && cover.contains(children[i]->screen_rect()))
+                occluded[i] = true;
+        }
+    }
+
+    return occluded;
+}
+
+/* Updates visibility of a subtree without painting it. */
+static void set_visible_tree(Widget* w) {
+    if (w->hidden()) {
+        w->visible(false);
+    } else {
+        w->visible(true);
+        for (const auto child : w->children())
+            set_visible_tree(child);
+    }
+}
+
 void Painter::paint_widget(Widget* w) {
     if (w->hidden()) {
         // Mark widget (and all children) as invisible.
@@ -124,20 +346,34 @@ void Painter::paint_widget(Widget* w) {
         // Mark this widget as visible and recurse.
         w->visible(true);
 
-        if (w->dirty()) {
+        const auto& children = w->children();
+        const bool repaint = w->dirty();
+
+        // Opaque children paint over their area, don't clear it first,
+        // and hide the siblings they cover.
+        exclude_opaque_children(w);
+        const auto occluded = occluded_children(w);
+
+        if (repaint)
             w->paint(*this);
-            // Force-paint all children.
-            for (const auto child : w->children()) {
+        exclusion_count_ = 0;
+
+        for (size_t i = 0; i < children.size(); ++i) {
+            const auto child = children[i];
+
+            // Force-paint all children of a repainted widget.
+            if (repaint)
                 child->set_dirty();
+
+            // Covered by a sibling, leave it dirty until uncovered.
+            if (i < occluded.size() && occluded[i])
+                set_visible_tree(child);
+            else
                 paint_widget(child);
-            }
-            w->set_clean();
-        } else {
-            // Selectively paint all children.
-            for (const auto child : w->children()) {
-                paint_widget(child);
-            }
         }
+
+        if (repaint)
+            w->set_clean();
     }
 }
 
@@ -25,6 +25,8 @@
 #include "ui.hpp"
 #include "ui_text.hpp"
 
+#include <array>
+#include <bitset>
 #include <string_view>
 
 namespace ui {
@@ -86,7 +88,24 @@ class Painter {
     void draw_vline(Point p, int height, Color c);
 
    private:
+    /* While painting a dirty widget, fills skip the areas of its opaque
+     * children. While repairing damage, drawing is clipped to clip_. */
+    static constexpr size_t max_exclusions = 16;
+
+    /* Children past the first 64 are never treated as occluded. */
+    using OccludedSet = std::bitset<64>;
+
     void paint_widget(Widget* w);
+    void paint_damage(Widget* w, Rect damage);
+    void exclude_opaque_children(const Widget* w);
+    OccludedSet occluded_children(const Widget* w) const;
+    void fill_unoccluded(Rect r, Color c, bool unrolled);
+    void draw_clipped(Point p, Size size, const uint8_t* pixels, Color foreground, Color background);
+
+    Rect clip_{};
+    std::array<Rect, max_exclusions> exclusions_{};
+    std::array<size_t, max_exclusions> exclusion_owners_{};  // Child index of each exclusion.
+    size_t exclusion_count_{0};
 };
 
 } /* namespace ui */
@@ -54,6 +54,43 @@ bool is_dirty() {
     return ui_dirty;
 }
 
+static DamageRects damage_rects{};
+static size_t damage_count = 0;
+
+void damage_add(Rect r) {
+    if (r.is_empty())
+        return;
+
+    // Merge with anything overlapping, which may overlap others in turn.
+    for (size_t i = 0; i < damage_count;) {
+        if (r.intersect(damage_rects[i]).is_empty()) {
+            ++i;
+            continue;
+        }
+
+        r += damage_rects[i];
+        damage_rects[i] = damage_rects[--damage_count];
+        i = 0;
+    }
+
+    // Full, collapse to a single bounding rectangle.
+    if (damage_count == damage_rects.size()) {
+        for (auto& d : damage_rects)
+            r += d;
+        damage_count = 0;
+    }
+
+    damage_rects[damage_count++] = r;
+    dirty_set();
+}
+
+size_t damage_take(DamageRects& rects) {
+    auto count = damage_count;
+    std::copy(damage_rects.begin(), damage_rects.begin() + count, rects.begin());
+    damage_count = 0;
+    return count;
+}
+
 /* Widget ****************************************************************/
 
 const std::vector<Widget*> Widget::no_children{};
@@ -124,10 +161,9 @@ void Widget::hidden(bool hide) {
 
         // If parent is hidden, either of these is a no-op.
         if (hide) {
-            // TODO: Instead of dirtying parent entirely, dirty only children
-            // that overlap with this widget.
-
-            // parent()->dirty_overlapping_children_in_rect(parent_rect());
+            // Repaint only what was under this widget.
+            if (parent_ && flags.visible)
+                damage_add(screen_rect());
 
             /* TODO: Notify self and all non-hidden children that they're
              * now effectively hidden?
@@ -378,7 +414,8 @@ Text::Text(
 }
 
 void Text::set(std::string_view value) {
-    text = std::string{value};
+    // Reuses the existing allocation when the new text fits.
+    text.assign(value);
     set_dirty();
 }
 
@@ -394,15 +431,18 @@ void Text::paint(Painter& painter) {
     auto max_len = (unsigned)rect.width() / s.font.char_width();
     auto text_view = std::string_view{text};
 
-    painter.fill_rectangle(rect, s.background);
-
     if (text_view.length() > max_len)
         text_view = text_view.substr(0, max_len);
 
-    painter.draw_string(
+    // Glyphs paint their own background, only clear around them.
+    auto width = painter.draw_string(
         rect.location(),
         s,
         text_view);
+    auto height = std::min<int>(s.font.line_height(), rect.height());
+
+    painter.fill_rectangle({rect.left() + width, rect.top(), rect.width() - width, height}, s.background);
+    painter.fill_rectangle({rect.left(), rect.top() + height, rect.width(), rect.height() - height}, s.background);
 }
 
 /* Labels ****************************************************************/
@@ -674,7 +714,7 @@ void Console::clear(bool clear_buffer = false) {
     pos = {0, 0};
 }
 
-void Console::write(std::string message) {
+void Console::write(std::string_view message) {
     bool escape = false;
 
     if (!hidden() && visible()) {
@@ -712,9 +752,10 @@ void Console::write(std::string message) {
                 }
             }
         }
-        buffer = message;
+        if (message.data() != buffer.data())
+            buffer.assign(message);
     } else {
-        if (buffer.size() < 256) buffer += message;
+        if (buffer.size() < 256) buffer.append(message);
     }
 }
 
@@ -725,8 +766,16 @@ void Console::getWidgetName(std::string& result) {
     result = "Console";
 }
 
-void Console::writeln(std::string message) {
-    write(message + "\n");
+void Console::writeln(std::string_view message) {
+    write(message);
+
+    // Same as writing the newline with the message, without copying it.
+    if (!hidden() && visible()) {
+        crlf();
+        buffer.push_back('\n');
+    } else if (buffer.size() < 256) {
+        buffer.push_back('\n');
+    }
 }
 
 void Console::paint(Painter&) {
@@ -2713,7 +2762,7 @@ VuMeter::VuMeter(
       LEDs_{LEDs},
       show_max_{show_max} {
     // set_focusable(false);
-    LED_height = std::max(1UL, parent_rect.size().height() / LEDs);
+    LED_height = std::max<uint32_t>(1, parent_rect.size().height() / LEDs);
     split = 256 / LEDs;
 }
 
@@ -35,6 +35,7 @@
 
 #include "ui/ui_font_fixed_5x8.hpp"
 
+#include <array>
 #include <functional>
 #include <memory>
 #include <string>
@@ -47,6 +48,15 @@ void dirty_set();
 void dirty_clear();
 bool is_dirty();
 
+/* Screen areas uncovered since the last paint, e.g. by hiding a widget.
+ * Overlapping rectangles are merged as they are added. */
+constexpr size_t max_damage_rects = 8;
+using DamageRects = std::array<Rect, max_damage_rects>;
+
+void damage_add(Rect r);
+/* Moves the pending damage into rects, returns the count. */
+size_t damage_take(DamageRects& rects);
+
 class Context {
    public:
     FocusManager& focus_manager() {
@@ -100,6 +110,10 @@ class Widget {
 
     virtual void paint(Painter& painter) = 0;
 
+    /* True if paint() covers every pixel of screen_rect(). The parent
+     * skips filling under opaque children and they hide what's below. */
+    virtual bool opaque() const { return false; }
+
     virtual void on_show() { return; };
     virtual void on_hide() { return; };
 
@@ -196,6 +210,7 @@ class Rectangle : public Widget {
     }
 
     void paint(Painter& painter) override;
+    bool opaque() const override { return !_outline; }
 
     void set_color(const Color c);
     void set_outline(const bool outline);
@@ -217,6 +232,7 @@ class Text : public Widget {
     void set(std::string_view value);
 
     void paint(Painter& painter) override;
+    bool opaque() const override { return true; }
     void getAccessibilityText(std::string& result) override;
     void getWidgetName(std::string& result) override;
 
@@ -259,6 +275,7 @@ class LiveDateTime : public Widget {
     ~LiveDateTime();
 
     void paint(Painter& painter) override;
+    bool opaque() const override { return true; }
 
     void set_hide_clock(bool new_value);
     void set_seconds_enabled(bool new_value);
@@ -326,6 +343,7 @@ class ProgressBar : public Widget {
     void set_value(const uint32_t value);
 
     void paint(Painter& painter) override;
+    bool opaque() const override { return true; }
     void getAccessibilityText(std::string& result) override;
     void getWidgetName(std::string& result) override;
 
@@ -353,8 +371,8 @@ class Console : public Widget {
     Console(Rect parent_rect);
 
     void clear(bool clear_buffer);
-    void write(std::string message);
-    void writeln(std::string message);
+    void write(std::string_view message);
+    void writeln(std::string_view message);
 
     void paint(Painter&) override;
 
@@ -436,6 +454,7 @@ class Button : public Widget {
     std::string text() const;
 
     void paint(Painter& painter) override;
+    bool opaque() const override { return true; }
 
     void on_focus() override;
     bool on_key(const KeyEvent key) override;
@@ -986,6 +1005,7 @@ class Waveform : public Widget {
     void set_cursor(const uint32_t i, const int16_t position);
 
     void paint(Painter& painter) override;
+    bool opaque() const override { return true; }
 
    private:
     const Color cursor_colors[2] = {Theme::getInstance()->fg_cyan->foreground, Theme::getInstance()->fg_magenta->foreground};
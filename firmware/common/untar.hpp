@@ -164,7 +164,7 @@ class UnTar {
                     first_read = false;
                 }
                 if (app_file) {
-                    app_checksum += simple_checksum((uint32_t)buff, bytes_read);
+                    app_checksum += simple_checksum((uintptr_t)buff, bytes_read);
                 }
                 auto fwres = f.write(buff, bytes_read);
                 if (!fwres.is_ok()) {
@@ -72,9 +72,20 @@ FRESULT f_truncate(FIL*) {
 FRESULT f_unlink(const TCHAR*) {
     return FR_OK;
 }
+FRESULT f_utime(const TCHAR*, const FILINFO*) {
+    return FR_OK;
+}
 FRESULT f_write(FIL*, const void*, UINT, UINT*) {
     return FR_OK;
 }
 
+/* ChibiOS stubs, the tests are single threaded. */
+#include "ch.h"
+void chMtxInit(Mutex*) {}
+void chMtxLock(Mutex*) {}
+Mutex* chMtxUnlock(void) {
+    return nullptr;
+}
+
 /* Debug */
 void __debug_log(const std::string&) {}
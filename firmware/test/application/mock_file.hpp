@@ -36,6 +36,7 @@ class MockFile {
     template <typename T>
     using Result = File::Result<T>;
 
+    MockFile() {}
     MockFile(std::string data)
         : data_{std::move(data)} {}
 
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "command_queue.hpp"
+
+#include <vector>
+
+namespace {
+
+/* Owns the ring the queue lives in, the way shared memory does. */
+template <size_t K>
+struct Queue {
+    std::array<uint8_t, 1 << K> data{};
+    CommandQueue queue{data.data(), K};
+
+    CommandQueue::Token push_tone(const uint32_t tone) {
+        CommandQueue::Token token = 0;
+        REQUIRE(queue.push(SigGenToneMessage{tone}, token));
+        return token;
+    }
+
+    CommandQueue::Token push_request() {
+        CommandQueue::Token token = 0;
+        REQUIRE(queue.push(MemoryStatsRequestMessage{}, token));
+        return token;
+    }
+
+    /* Handles everything, recording the tone of each SigGenTone and 0
+     * for anything else. */
+    std::vector<uint32_t> handle_all() {
+        std::vector<uint32_t> handled;
+        queue.handle([&handled](const Message* const message) {
+            if (message->id == Message::ID::SigGenTone)
+                handled.push_back(static_cast<const SigGenToneMessage*>(message)->tone_delta);
+            else
+                handled.push_back(0);
+            return true;
+        });
+        return handled;
+    }
+};
+
+}  // namespace
+
+TEST_SUITE_BEGIN("CommandQueue");
+
+TEST_CASE("Tokens complete in the order commands are handled.") {
+    Queue<8> q;
+    const auto first = q.push_request();
+    const auto second = q.push_request();
+
+    CHECK(second == first + 1);
+    CHECK_FALSE(q.queue.is_complete(first));
+    CHECK_FALSE(q.queue.is_idle());
+
+    // Stopping leaves the command and everything behind it pending.
+    size_t calls = 0;
+    q.queue.handle([&calls](const Message*) { return calls++ == 0; });
+    CHECK(calls == 2);
+    CHECK(q.queue.is_complete(first));
+    CHECK_FALSE(q.queue.is_complete(second));
+
+    CHECK(q.handle_all() == std::vector<uint32_t>{0});
+    CHECK(q.queue.is_complete(second));
+    CHECK(q.queue.is_idle());
+}
+
+TEST_CASE("Only the newest queued command of a coalesced type is handled.") {
+    Queue<8> q;
+    const auto stale = q.push_tone(1);
+    q.push_request();
+    q.push_tone(2);
+
+    CHECK(q.handle_all() == std::vector<uint32_t>{0, 2});
+    // The dropped command still completes.
+    CHECK(q.queue.is_complete(stale));
+    CHECK(q.queue.is_idle());
+
+    // Once handled, the next one of that type isn't held against it.
+    q.push_tone(3);
+    CHECK(q.handle_all() == std::vector<uint32_t>{3});
+}
+
+TEST_CASE("A spectrum Configure doesn't drop a queued start or stop.") {
+    using Mode = SpectrumStreamingConfigMessage::Mode;
+    Queue<8> q;
+    CommandQueue::Token token = 0;
+    REQUIRE(q.queue.push(SpectrumStreamingConfigMessage{Mode::Running}, token));
+    REQUIRE(q.queue.push(SpectrumStreamingConfigMessage{Mode::Configure}, token));
+    REQUIRE(q.queue.push(SpectrumStreamingConfigMessage{Mode::Stopped}, token));
+    REQUIRE(q.queue.push(SpectrumStreamingConfigMessage{Mode::Configure}, token));
+
+    std::vector<Mode> handled;
+    q.queue.handle([&handled](const Message* const message) {
+        handled.push_back(static_cast<const SpectrumStreamingConfigMessage*>(message)->mode);
+        return true;
+    });
+    CHECK(handled == std::vector<Mode>{Mode::Running, Mode::Configure, Mode::Stopped, Mode::Configure});
+    CHECK(q.queue.is_idle());
+}
+
+TEST_CASE("A full queue refuses the push and leaves the token alone.") {
+    Queue<6> q;
+    size_t queued = 0;
+    CommandQueue::Token token = 0;
+    while (q.queue.push(SigGenToneMessage{static_cast<uint32_t>(queued + 1)}, token))
+        queued++;
+
+    REQUIRE(queued > 0);
+    const auto last = token;
+    CHECK_FALSE(q.queue.push(SigGenToneMessage{99}, token));
+    CHECK(token == last);
+
+    // The refused command didn't supersede the queued ones.
+    CHECK(q.handle_all() == std::vector<uint32_t>{static_cast<uint32_t>(queued)});
+    CHECK(q.queue.is_complete(last));
+    CHECK(q.queue.is_idle());
+}
+
+TEST_CASE("Tokens compare across the wrap.") {
+    Queue<8> q;
+    q.queue.reset(UINT32_MAX - 1);
+
+    const auto before = q.push_tone(1);
+    const auto at_zero = q.push_tone(2);
+    const auto after = q.push_tone(3);
+    CHECK(before == UINT32_MAX);
+    CHECK(at_zero == 0);
+    CHECK(after == 1);
+
+    CHECK_FALSE(q.queue.is_complete(before));
+    CHECK_FALSE(q.queue.is_complete(at_zero));
+
+    CHECK(q.handle_all() == std::vector<uint32_t>{3});
+    CHECK(q.queue.is_complete(before));
+    CHECK(q.queue.is_complete(at_zero));
+    CHECK(q.queue.is_complete(after));
+    CHECK_FALSE(q.queue.is_complete(after + 1));
+    CHECK(q.queue.is_idle());
+}
+
+TEST_SUITE_END();
@@ -460,4 +460,219 @@ SCENARIO("It calls on_read_progress while reading.") {
     }
 }
 
-TEST_SUITE_END();
\ No newline at end of file
+TEST_SUITE_END();
+
+TEST_SUITE_BEGIN("Test LineIndex");
+
+TEST_CASE("It keeps a checkpoint every stride lines.") {
+    LineIndex index;
+    for (uint32_t i = 1; i <= 100; ++i)
+        index.add_newline(i * 10);
+
+    CHECK_EQ(index.newline_count(), 100);
+    REQUIRE_EQ(index.checkpoints().size(), 100 / LineIndex::initial_stride);
+    CHECK_EQ(index.checkpoints()[0].line, LineIndex::initial_stride);
+    CHECK_EQ(index.checkpoints()[0].offset, LineIndex::initial_stride * 10);
+}
+
+TEST_CASE("It doubles the stride when full.") {
+    LineIndex index;
+    auto lines = LineIndex::max_checkpoints * LineIndex::initial_stride * 3;
+    for (uint32_t i = 1; i <= lines; ++i)
+        index.add_newline(i);
+
+    CHECK(index.checkpoints().size() <= LineIndex::max_checkpoints);
+    CHECK_EQ(index.stride(), LineIndex::initial_stride * 4);
+    for (auto& cp : index.checkpoints())
+        CHECK_EQ(cp.line % index.stride(), 0);
+}
+
+TEST_CASE("find() returns the closest checkpoint at or before line.") {
+    LineIndex index;
+    for (uint32_t i = 1; i <= 100; ++i)
+        index.add_newline(i * 10);
+
+    auto cp = index.find(10);
+    CHECK_EQ(cp.line, 0);
+    CHECK_EQ(cp.offset, 0);
+
+    cp = index.find(70);
+    CHECK_EQ(cp.line, 64);
+    CHECK_EQ(cp.offset, 640);
+}
+
+TEST_CASE("update() shifts and drops checkpoints after an edit.") {
+    LineIndex index;
+    index.restore(2, 6, {{2, 20}, {4, 40}, {6, 60}});
+
+    // Replace [15, 45) with text holding one newline fewer, 5 bytes longer.
+    index.update(15, 45, 5, -1);
+
+    REQUIRE_EQ(index.checkpoints().size(), 1);
+    CHECK_EQ(index.checkpoints()[0].line, 5);
+    CHECK_EQ(index.checkpoints()[0].offset, 65);
+    CHECK_EQ(index.newline_count(), 5);
+}
+
+TEST_SUITE_END();
+
+TEST_SUITE_BEGIN("Test BufferWrapper with LineIndex");
+
+static std::string numbered_lines(uint32_t count) {
+    std::string content;
+    for (uint32_t i = 0; i < count; ++i)
+        content += "line" + std::to_string(i) + "\n";
+    return content;
+}
+
+SCENARIO("Jumping far in a large file.") {
+    GIVEN("A file with many lines") {
+        MockFile f{numbered_lines(1000)};
+        auto w = wrap_buffer<8>(f);
+
+        CHECK_EQ(w.line_count(), 1000);
+
+        WHEN("Reading a line far past the cache") {
+            auto str = w.get_text(900, 0, 20);
+
+            THEN("It should read the line.") {
+                REQUIRE(str);
+                CHECK_EQ(*str, "line900\n");
+            }
+
+            THEN("It should reload the cache around the line.") {
+                CHECK(w.start_line() <= 900);
+                CHECK(w.start_line() + 8 > 900);
+            }
+        }
+
+        WHEN("Jumping back to the start") {
+            w.get_text(900, 0, 20);
+            auto str = w.get_text(3, 0, 20);
+
+            REQUIRE(str);
+            CHECK_EQ(*str, "line3\n");
+        }
+    }
+}
+
+SCENARIO("Editing keeps the index consistent.") {
+    GIVEN("A file with many lines") {
+        MockFile f{numbered_lines(500)};
+        auto w = wrap_buffer<8>(f);
+
+        WHEN("Inserting and deleting lines near the start") {
+            w.insert_line(10);
+            w.insert_line(10);
+            w.delete_line(2);
+            w.replace_range({0, 0}, "a\nb\nc\n");
+
+            THEN("It should match a freshly scanned buffer.") {
+                MockFile copy{f.data_};
+                auto fresh = wrap_buffer<8>(copy);
+
+                REQUIRE_EQ(w.line_count(), fresh.line_count());
+                for (uint32_t line : {0u, 3u, 12u, 13u, 250u, 400u, 503u})
+                    CHECK_EQ(*w.get_text(line, 0, 20), *fresh.get_text(line, 0, 20));
+            }
+        }
+
+        WHEN("Replacing a range spanning checkpoints") {
+            auto start = w.line_range(30)->start;
+            auto end = w.line_range(100)->start;
+            w.replace_range({start, end}, "x\ny");
+
+            THEN("It should match a freshly scanned buffer.") {
+                MockFile copy{f.data_};
+                auto fresh = wrap_buffer<8>(copy);
+
+                REQUIRE_EQ(w.line_count(), 431);
+                REQUIRE_EQ(w.line_count(), fresh.line_count());
+                for (uint32_t line : {29u, 30u, 31u, 200u, 430u})
+                    CHECK_EQ(*w.get_text(line, 0, 20), *fresh.get_text(line, 0, 20));
+            }
+        }
+    }
+}
+
+TEST_SUITE_END();
+
+TEST_SUITE_BEGIN("Test line index sidecar");
+
+static LineIndex make_line_index(uint32_t lines) {
+    LineIndex index;
+    for (uint32_t i = 1; i <= lines; ++i)
+        index.add_newline(i * 10);
+    return index;
+}
+
+SCENARIO("Saving and loading a line index.") {
+    GIVEN("A saved index") {
+        auto saved = make_line_index(1000);
+        line_index_stamp stamp{10000, 0x5A21, 0x8C40};
+        MockFile f{""};
+        write_line_index(f, stamp, saved);
+
+        WHEN("Reading it back for the same file") {
+            LineIndex index;
+            f.seek(0);
+            auto ok = read_line_index(f, stamp, index);
+
+            THEN("It should restore the same index.") {
+                REQUIRE(ok);
+                CHECK_EQ(index.stride(), saved.stride());
+                CHECK_EQ(index.newline_count(), 1000);
+                REQUIRE_EQ(index.checkpoints().size(), saved.checkpoints().size());
+                CHECK_EQ(index.find(700).line, saved.find(700).line);
+                CHECK_EQ(index.find(700).offset, saved.find(700).offset);
+            }
+        }
+
+        WHEN("The file size changed") {
+            LineIndex index;
+            f.seek(0);
+            auto ok = read_line_index(f, {10001, 0x5A21, 0x8C40}, index);
+
+            THEN("It should be ignored.") {
+                CHECK_FALSE(ok);
+                CHECK_EQ(index.newline_count(), 0);
+            }
+        }
+
+        WHEN("The file was modified") {
+            LineIndex index;
+            f.seek(0);
+
+            THEN("It should be ignored.") {
+                CHECK_FALSE(read_line_index(f, {10000, 0x5A21, 0x8C41}, index));
+            }
+        }
+
+        WHEN("The sidecar is truncated") {
+            LineIndex index;
+            f.data_.resize(f.data_.size() - 1);
+            f.seek(0);
+
+            THEN("It should be ignored.") {
+                CHECK_FALSE(read_line_index(f, stamp, index));
+            }
+        }
+
+        WHEN("The sidecar is from another format") {
+            LineIndex index;
+            f.data_[0] ^= 0xFF;
+            f.seek(0);
+
+            THEN("It should be ignored.") {
+                CHECK_FALSE(read_line_index(f, stamp, index));
+            }
+        }
+    }
+}
+
+TEST_CASE("It should name the sidecar after the whole file name.") {
+    CHECK_EQ(FileWrapper::index_path(u"/FREQMAN/BIG.TXT"), std::filesystem::path{u"/FREQMAN/BIG.TXT.IDX"});
+    CHECK_NE(FileWrapper::index_path(u"/LOGS/BIG.TXT"), FileWrapper::index_path(u"/LOGS/BIG.CSV"));
+}
+
+TEST_SUITE_END();
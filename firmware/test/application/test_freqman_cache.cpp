@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "freqman_cache.hpp"
+#include "mock_file.hpp"
+
+#include <algorithm>
+#include <vector>
+
+TEST_SUITE_BEGIN("Freqman cache");
+
+TEST_CASE("It gets the cache path next to the text file.") {
+    auto path = get_freqman_cache_path(u"FREQMAN/AIRBAND.TXT");
+    CHECK(path == std::filesystem::path{u"FREQMAN/AIRBAND.FMB"});
+}
+
+TEST_CASE("It converts an entry to a record.") {
+    freqman_entry entry{
+        .frequency_a = 123'000'000,
+        .frequency_b = 124'000'000,
+        .description = std::string(40, 'x'),
+        .type = freqman_type::Range,
+        .modulation = 1,
+        .bandwidth = 2,
+        .step = 3,
+        .tone = 4,
+    };
+
+    auto rec = to_freqman_cache_record(entry, 7, 99);
+    CHECK_EQ(rec.frequency_a, 123'000'000);
+    CHECK_EQ(rec.frequency_b, 124'000'000);
+    CHECK_EQ(rec.line, 7);
+    CHECK_EQ(rec.description, 99);
+    CHECK_EQ(rec.description_length, freqman_max_desc_size);
+    CHECK(rec.type == freqman_type::Range);
+    CHECK_EQ(rec.modulation, 1);
+    CHECK_EQ(rec.bandwidth, 2);
+    CHECK_EQ(rec.step, 3);
+    CHECK_EQ(rec.tone, 4);
+}
+
+TEST_CASE("Records sort by frequency then text order.") {
+    std::vector<freqman_cache_record> records{
+        {.frequency_a = 300, .line = 0},
+        {.frequency_a = 100, .line = 2},
+        {.frequency_a = 100, .line = 1},
+        {.frequency_a = 200, .line = 3},
+    };
+
+    std::sort(records.begin(), records.end());
+
+    CHECK_EQ(records[0].line, 1);
+    CHECK_EQ(records[1].line, 2);
+    CHECK_EQ(records[2].line, 3);
+    CHECK_EQ(records[3].line, 0);
+}
+
+static std::vector<freqman_entry> make_entries(size_t count) {
+    uint32_t seed = 1234;  // Fixed LCG so runs are repeatable.
+
+    std::vector<freqman_entry> entries;
+    for (size_t i = 0; i < count; ++i) {
+        entries.push_back({
+            .frequency_a = ((seed = seed * 1664525 + 1013904223) >> 16) % 100 * 1'000'000ll,
+            .frequency_b = 0,
+            .description = "E" + std::to_string(i),
+            .type = freqman_type::Single,
+        });
+    }
+
+    return entries;
+}
+
+/* Compiles entries into a mock cache and opens it. */
+static bool open_mock_cache(std::vector<freqman_entry>& entries, FreqmanCacheReader<MockFile>& reader) {
+    MockFile runs;
+    MockFile descriptions;
+    MockFile cache;
+    freqman_cache_header header{};
+
+    if (!compile_freqman_cache(entries, runs, descriptions, cache, header) ||
+        !freqman_cache_io::write_at(cache, 0, &header, sizeof(header)))
+        return false;
+
+    return reader.open_file(std::move(cache));
+}
+
+SCENARIO("Compiling a list larger than a run.") {
+    GIVEN("Entries out of frequency order") {
+        auto entries = make_entries(freqman_cache_run_size * 3 + 17);
+        entries[5].type = freqman_type::Unknown;  // Doesn't parse, not compiled.
+        FreqmanCacheReader<MockFile> cache;
+        REQUIRE(open_mock_cache(entries, cache));
+
+        THEN("It should skip the entries that don't parse.") {
+            CHECK_EQ(cache.entry_count(), entries.size() - 1);
+        }
+
+        THEN("It should merge the runs in frequency then text order.") {
+            for (uint32_t i = 1; i < cache.entry_count(); ++i) {
+                auto previous = cache[i - 1];
+                auto current = cache[i];
+                REQUIRE(previous.frequency_a <= current.frequency_a);
+                if (previous.frequency_a == current.frequency_a)
+                    REQUIRE(std::stoi(previous.description.substr(1)) < std::stoi(current.description.substr(1)));
+            }
+        }
+
+        THEN("It should index the first frequency of each page.") {
+            auto& header = cache.header();
+            REQUIRE(header.page_count > 1);
+            REQUIRE(header.page_count <= freqman_cache_max_pages);
+            for (uint32_t page = 0; page < header.page_count; ++page)
+                CHECK_EQ(header.page_first[page], cache[page * header.page_size].frequency_a);
+        }
+
+        THEN("It should stream the entries in text file order.") {
+            std::vector<std::string> descriptions;
+            cache.for_each_in_file_order([&descriptions](const freqman_entry& entry) {
+                descriptions.push_back(entry.description);
+                return true;
+            });
+
+            REQUIRE_EQ(descriptions.size(), cache.entry_count());
+            CHECK_EQ(descriptions[4], "E4");
+            CHECK_EQ(descriptions[5], "E6");
+            CHECK_EQ(descriptions.back(), entries.back().description);
+        }
+
+        THEN("It should stop streaming when asked to.") {
+            size_t calls = 0;
+            cache.for_each_in_file_order([&calls](const freqman_entry&) {
+                return ++calls < 20;
+            });
+
+            CHECK_EQ(calls, 20);
+        }
+    }
+}
+
+SCENARIO("Querying a frequency range.") {
+    GIVEN("A compiled list") {
+        auto entries = make_entries(500);
+        FreqmanCacheReader<MockFile> cache;
+        REQUIRE(open_mock_cache(entries, cache));
+
+        auto count_between = [&entries](int64_t min, int64_t max) {
+            return std::count_if(entries.begin(), entries.end(), [min, max](const freqman_entry& entry) {
+                return entry.frequency_a >= min && entry.frequency_a <= max;
+            });
+        };
+
+        THEN("lower_bound should find the first entry at or above the frequency.") {
+            for (int64_t mhz : {0, 1, 37, 50, 99, 100}) {
+                auto index = cache.lower_bound(mhz * 1'000'000);
+                if (index > 0)
+                    CHECK(cache[index - 1].frequency_a < mhz * 1'000'000);
+                if (index < cache.entry_count())
+                    CHECK(cache[index].frequency_a >= mhz * 1'000'000);
+            }
+        }
+
+        THEN("for_each_in_range should visit exactly the entries in range.") {
+            for (auto range : {std::pair<int64_t, int64_t>{10'000'000, 20'000'000}, {0, 0}, {98'500'000, 200'000'000}}) {
+                long visited = 0;
+                cache.for_each_in_range(range.first, range.second, [&](const freqman_entry& entry) {
+                    CHECK(entry.frequency_a >= range.first);
+                    CHECK(entry.frequency_a <= range.second);
+                    ++visited;
+                });
+                CHECK_EQ(visited, count_between(range.first, range.second));
+            }
+        }
+    }
+}
+
+TEST_CASE("It rejects a file that isn't a cache.") {
+    FreqmanCacheReader<MockFile> cache;
+    CHECK_FALSE(cache.open_file(MockFile{std::string(sizeof(freqman_cache_header), 'x')}));
+    CHECK(cache.empty());
+}
+
+TEST_SUITE_END();
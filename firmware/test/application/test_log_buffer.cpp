@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "log_buffer.hpp"
+
+#include <string>
+
+namespace {
+
+template <size_t N>
+std::string drain(LogBuffer<N>& buffer) {
+    std::string out;
+    while (!buffer.empty()) {
+        auto chunk = buffer.peek();
+        out.append(chunk);
+        buffer.consume(chunk.size());
+    }
+    return out;
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("log buffer");
+
+TEST_CASE("Records are pushed whole or not at all.") {
+    LogBuffer<16> buffer;
+
+    CHECK(buffer.push({"hello", " ", "world"}));
+    CHECK(buffer.size() == 11);
+    CHECK(buffer.peek() == "hello world");
+
+    CHECK_FALSE(buffer.push({"123456"}));
+    CHECK(buffer.size() == 11);
+
+    CHECK(buffer.push({"12345"}));
+    CHECK(buffer.available() == 0);
+}
+
+TEST_CASE("Consumed bytes make room for more.") {
+    LogBuffer<16> buffer;
+
+    REQUIRE(buffer.push({"0123456789"}));
+    buffer.consume(8);
+    CHECK(buffer.peek() == "89");
+    CHECK(buffer.available() == 14);
+
+    buffer.consume(100);
+    CHECK(buffer.empty());
+}
+
+TEST_CASE("A record across the end is read in two chunks.") {
+    LogBuffer<16> buffer;
+
+    REQUIRE(buffer.push({"0123456789AB"}));
+    buffer.consume(12);
+    REQUIRE(buffer.push({"abcdefgh"}));
+
+    std::string out;
+    while (!buffer.empty()) {
+        auto chunk = buffer.peek();
+        out.append(chunk);
+        buffer.consume(chunk.size());
+    }
+
+    CHECK(out == "abcdefgh");
+}
+
+TEST_CASE("Dropped lines are reported ahead of the next line that fits.") {
+    LogBuffer<64> buffer;
+    const std::string long_line(50, 'x');
+
+    REQUIRE(buffer.push_line("t0", long_line));
+    CHECK_FALSE(buffer.push_line("t1", "0123456789"));
+    CHECK_FALSE(buffer.push_line("t2", "0123456789"));
+    CHECK(buffer.dropped() == 2);
+
+    drain(buffer);
+    REQUIRE(buffer.push_line("t3", "next"));
+    CHECK(drain(buffer) == "t3 2 lines dropped\r\nt3 next\r\n");
+
+    // Reported once.
+    REQUIRE(buffer.push_line("t4", "more"));
+    CHECK(drain(buffer) == "t4 more\r\n");
+    CHECK(buffer.dropped() == 2);
+}
+
+TEST_CASE("The drop marker waits until it fits.") {
+    LogBuffer<32> buffer;
+
+    REQUIRE(buffer.push_line("t", std::string(24, 'x')));
+    CHECK_FALSE(buffer.push_line("t", "ab"));
+
+    // Room for the next line but not the marker ahead of it.
+    buffer.consume(10);
+    CHECK(buffer.push_line("t", "a"));
+    drain(buffer);
+
+    REQUIRE(buffer.push_line("t", "b"));
+    CHECK(drain(buffer) == "t 1 lines dropped\r\nt b\r\n");
+}
+
+TEST_SUITE_END();
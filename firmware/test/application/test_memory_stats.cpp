@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "memory_stats.hpp"
+
+using namespace memory_stats;
+
+TEST_SUITE_BEGIN("memory_stats");
+
+TEST_CASE("The tag round trips through the low bits of a block size.") {
+    // Heap block sizes are multiples of the 8 byte alignment.
+    for (size_t size = 0; size <= 4096; size += 8) {
+        for (size_t t = 0; t < tag_count; t++) {
+            const auto tag = static_cast<Tag>(t);
+            const auto packed = with_tag(size, tag);
+            CHECK(tag_of(packed) == tag);
+            CHECK(without_tag(packed) == size);
+        }
+    }
+
+    // An untagged block reads back as Other with its size intact.
+    CHECK(tag_of(24) == Tag::Other);
+    CHECK(without_tag(24) == 24);
+}
+
+TEST_CASE("Each tag keeps its own live bytes and peak.") {
+    Accounting accounting{};
+
+    accounting.allocated(Tag::UI, 100, 5000);
+    accounting.allocated(Tag::UI, 60, 4900);
+    accounting.allocated(Tag::File, 40, 4800);
+    accounting.freed(Tag::UI, 100);
+
+    CHECK(accounting.usage(Tag::UI).bytes == 60);
+    CHECK(accounting.usage(Tag::UI).peak == 160);
+    CHECK(accounting.usage(Tag::File).bytes == 40);
+    CHECK(accounting.usage(Tag::File).peak == 40);
+    CHECK(accounting.usage(Tag::Radio).peak == 0);
+
+    // Falling back below the peak and rising again keeps the old peak.
+    accounting.allocated(Tag::UI, 50, 4900);
+    CHECK(accounting.usage(Tag::UI).peak == 160);
+    accounting.allocated(Tag::UI, 100, 4800);
+    CHECK(accounting.usage(Tag::UI).peak == 210);
+}
+
+TEST_CASE("Freeing an untracked block doesn't wrap the live bytes.") {
+    Accounting accounting{};
+    accounting.allocated(Tag::Shell, 32, 1000);
+    accounting.freed(Tag::Shell, 64);
+
+    CHECK(accounting.usage(Tag::Shell).bytes == 0);
+    CHECK(accounting.usage(Tag::Shell).peak == 32);
+}
+
+TEST_CASE("The core low water mark follows the lowest core_free seen.") {
+    Accounting accounting{};
+    CHECK(accounting.core_low(3000) == 3000);
+
+    accounting.allocated(Tag::DSP, 16, 2000);
+    accounting.allocated(Tag::DSP, 16, 2500);
+    CHECK(accounting.core_low(2500) == 2000);
+    // Never above what is free right now.
+    CHECK(accounting.core_low(1500) == 1500);
+}
+
+TEST_CASE("Resetting the peaks starts over from the current usage.") {
+    Accounting accounting{};
+    accounting.allocated(Tag::Stream, 400, 1000);
+    accounting.freed(Tag::Stream, 300);
+    accounting.reset_peaks(1600);
+
+    CHECK(accounting.usage(Tag::Stream).bytes == 100);
+    CHECK(accounting.usage(Tag::Stream).peak == 100);
+    CHECK(accounting.core_low(1600) == 1600);
+
+    accounting.allocated(Tag::Stream, 50, 1550);
+    CHECK(accounting.usage(Tag::Stream).peak == 150);
+    CHECK(accounting.core_low(1550) == 1550);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "metadata_file.hpp"
+
+TEST_SUITE_BEGIN("Metadata file");
+
+TEST_CASE("A time index line should round trip.") {
+    // Past 32 bits, a long capture at 20Msps gets there in 4 minutes.
+    const CaptureTimeMark mark{5'000'000'123ull, 6'000'000'456ull, {2025, 3, 9, 23, 5, 7}};
+
+    const auto line = metadata_time_mark_line(mark);
+    CHECK_EQ(line, "time_index=5000000123,6000000456,20250309230507");
+
+    capture_metadata metadata{};
+    REQUIRE(parse_metadata_line(line + "\r\n", metadata));
+    REQUIRE(metadata.time_index);
+    CHECK_EQ(metadata.time_index->stream_sample, mark.stream_sample);
+    CHECK_EQ(metadata.time_index->sample_index, mark.sample_index);
+    CHECK_EQ(metadata.time_index->timestamp.year(), 2025);
+    CHECK_EQ(metadata.time_index->timestamp.month(), 3);
+    CHECK_EQ(metadata.time_index->timestamp.day(), 9);
+    CHECK_EQ(metadata.time_index->timestamp.hour(), 23);
+    CHECK_EQ(metadata.time_index->timestamp.minute(), 5);
+    CHECK_EQ(metadata.time_index->timestamp.second(), 7);
+}
+
+TEST_CASE("Only the first time index should be kept.") {
+    capture_metadata metadata{};
+    REQUIRE(parse_metadata_line(metadata_time_mark_line({10, 20, {2025, 1, 1, 0, 0, 0}}), metadata));
+    REQUIRE(parse_metadata_line(metadata_time_mark_line({30, 40, {2025, 1, 1, 0, 0, 1}}), metadata));
+    REQUIRE(metadata.time_index);
+    CHECK_EQ(metadata.time_index->stream_sample, 10);
+    CHECK_EQ(metadata.time_index->sample_index, 20);
+}
+
+TEST_CASE("A malformed time index should be ignored.") {
+    capture_metadata metadata{};
+    parse_metadata_line("time_index=10,20", metadata);
+    parse_metadata_line("time_index=10,20,2025", metadata);
+    parse_metadata_line("time_index=x,20,20250101000000", metadata);
+    CHECK_FALSE(metadata.time_index);
+}
+
+TEST_CASE("A trim start line should round trip.") {
+    const uint64_t trim_start = 7'000'000'001ull;
+
+    const auto line = metadata_trim_line(trim_start);
+    CHECK_EQ(line, "trim_start=7000000001");
+
+    capture_metadata metadata{};
+    REQUIRE(parse_metadata_line(line + "\n", metadata));
+    CHECK_EQ(metadata.trim_start, trim_start);
+}
+
+TEST_CASE("Unknown lines should be skipped.") {
+    capture_metadata metadata{};
+    CHECK_FALSE(parse_metadata_line("colour=blue", metadata));
+    CHECK_FALSE(parse_metadata_line("no equals sign", metadata));
+    CHECK(parse_metadata_line("sample_rate=500000", metadata));
+    CHECK_EQ(metadata.sample_rate, 500000);
+}
+
+TEST_SUITE_END();
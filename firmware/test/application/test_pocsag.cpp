@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "pocsag.hpp"
+
+#include <chrono>
+
+using namespace pocsag;
+
+TEST_SUITE_BEGIN("POCSAG BCH");
+
+TEST_CASE("Sync and idle words should be valid codewords.") {
+    CHECK(bch::valid(POCSAG_SYNCWORD));
+    CHECK(bch::valid(POCSAG_IDLEWORD));
+    CHECK_EQ(bch::encode(POCSAG_SYNCWORD & bch::data_mask), POCSAG_SYNCWORD);
+    CHECK_EQ(bch::encode(POCSAG_IDLEWORD & bch::data_mask), POCSAG_IDLEWORD);
+}
+
+TEST_CASE("Encoded codewords should have a zero syndrome and even parity.") {
+    for (uint32_t data = 0; data < (1U << 21); data += 4099) {
+        auto codeword = bch::encode(data << 11);
+        CHECK_EQ(bch::syndrome(codeword), 0);
+        CHECK_EQ(bch::parity(codeword), 0);
+    }
+}
+
+TEST_CASE("correct should fix any one or two bit errors.") {
+    for (uint32_t first = 0; first < 32; first++) {
+        for (uint32_t second = first; second < 32; second++) {
+            auto errors = (1U << first) | (1U << second);
+            auto codeword = POCSAG_IDLEWORD ^ errors;
+
+            CHECK_EQ(bch::correct(codeword), first == second ? 1 : 2);
+            CHECK_EQ(codeword, POCSAG_IDLEWORD);
+        }
+    }
+}
+
+TEST_CASE("correct should reject three bit errors.") {
+    for (uint32_t first = 0; first < 32; first++) {
+        for (uint32_t second = first + 1; second < 32; second++) {
+            for (uint32_t third = second + 1; third < 32; third++) {
+                auto codeword = POCSAG_SYNCWORD ^ (1U << first) ^ (1U << second) ^ (1U << third);
+                auto received = codeword;
+
+                CHECK_EQ(bch::correct(codeword), bch::uncorrectable);
+                CHECK_EQ(codeword, received);
+            }
+        }
+    }
+}
+
+TEST_CASE("correct_batch should report uncorrectable codewords.") {
+    batch_t batch;
+    batch.fill(POCSAG_IDLEWORD);
+    batch[2] ^= 0x00000003;
+    batch[7] ^= 0x80000000;
+    batch[9] ^= 0x00070000;
+
+    CHECK_EQ(correct_batch(batch), 1U << 9);
+    CHECK_EQ(batch[2], POCSAG_IDLEWORD);
+    CHECK_EQ(batch[7], POCSAG_IDLEWORD);
+}
+
+TEST_SUITE_END();
+
+TEST_SUITE_BEGIN("POCSAG decode");
+
+namespace {
+
+/* Encodes a message and returns the first batch after the sync word. */
+POCSAGPacket encode_batch(MessageType type, const std::string& message, uint32_t address) {
+    std::vector<uint32_t> codewords;
+    pocsag_encode(type, 0, message, address, codewords);
+
+    POCSAGPacket packet;
+    const size_t first = POCSAG_PREAMBLE_LENGTH / 32 + 1;
+    for (size_t i = 0; i < batch_size; i++)
+        packet.set(i, first + i < codewords.size() ? codewords[first + i] : POCSAG_IDLEWORD);
+    return packet;
+}
+
+}  // namespace
+
+TEST_CASE("Decode should recover a message with bit errors.") {
+    constexpr uint32_t address = 1234560;  // Frame 0.
+    auto packet = encode_batch(ALPHANUMERIC, "HELLO", address);
+
+    // Two errors in every codeword.
+    for (size_t i = 0; i < batch_size; i++)
+        packet.set(i, packet[i] ^ (0x00100001U << (i % 8)));
+
+    // Decoding stops at the idle word after the message.
+    POCSAGState state;
+    CHECK(pocsag_decode_batch(packet, state));
+
+    CHECK_EQ(state.address, address);
+    CHECK_EQ(state.errors, 0);
+    CHECK_EQ(state.output.substr(0, 5), "HELLO");
+}
+
+TEST_CASE("Decode should count uncorrectable codewords.") {
+    auto packet = encode_batch(ALPHANUMERIC, "HELLO", 1234560);
+    packet.set(1, packet[1] ^ 0x00000700);
+
+    POCSAGState state;
+    CHECK(pocsag_decode_batch(packet, state));
+    CHECK_EQ(state.errors, bch::uncorrectable);
+}
+
+TEST_CASE("Benchmark batch correction.") {
+    constexpr size_t batches = 20000;
+    batch_t received;
+    for (size_t i = 0; i < batch_size; i++)
+        received[i] = bch::encode(i * 0x9E3779B9U) ^ (0x00010001U << (i % 15));
+
+    uint32_t failed = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t n = 0; n < batches; n++) {
+        auto batch = received;
+        failed |= correct_batch(batch);
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    CHECK_EQ(failed, 0);
+    MESSAGE("corrected ", batches * batch_size / elapsed / 1e6, " M codewords/s with 2 bit errors each");
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "spectrum_survey.hpp"
+
+#include <array>
+
+using namespace survey;
+
+TEST_SUITE_BEGIN("spectrum_survey");
+
+TEST_CASE("encode_row should collapse flat runs.") {
+    std::array<uint8_t, 8> row{10, 10, 10, 10, 10, 10, 10, 10};
+    std::array<uint8_t, max_encoded_row_size(8)> out{};
+
+    auto n = encode_row(row.data(), row.size(), out.data());
+    REQUIRE_EQ(n, 3);
+    CHECK_EQ(out[0], 10);
+    CHECK_EQ(out[1], 0);
+    CHECK_EQ(out[2], 7);
+}
+
+TEST_CASE("encode_row should store deltas modulo 256.") {
+    std::array<uint8_t, 3> row{200, 10, 250};
+    std::array<uint8_t, max_encoded_row_size(3)> out{};
+
+    auto n = encode_row(row.data(), row.size(), out.data());
+    REQUIRE_EQ(n, 3);
+    CHECK_EQ(out[0], 200);
+    CHECK_EQ(out[1], 66);
+    CHECK_EQ(out[2], 240);
+}
+
+TEST_CASE("decode_row should round trip encode_row.") {
+    std::array<uint8_t, 240> row{};
+    for (size_t i = 0; i < row.size(); ++i)
+        row[i] = (i % 7 == 0) ? i : row[i > 0 ? i - 1 : 0];
+
+    std::array<uint8_t, max_encoded_row_size(240)> encoded{};
+    auto n = encode_row(row.data(), row.size(), encoded.data());
+    REQUIRE(n <= encoded.size());
+
+    std::array<uint8_t, 240> decoded{};
+    CHECK_EQ(decode_row(encoded.data(), n, decoded.data(), decoded.size()), n);
+    CHECK(decoded == row);
+}
+
+TEST_CASE("encode_row should split runs longer than 255.") {
+    std::array<uint8_t, 300> row{};
+    std::array<uint8_t, max_encoded_row_size(300)> encoded{};
+
+    auto n = encode_row(row.data(), row.size(), encoded.data());
+    REQUIRE_EQ(n, 5);
+
+    std::array<uint8_t, 300> decoded{};
+    decoded.fill(1);
+    CHECK_EQ(decode_row(encoded.data(), n, decoded.data(), decoded.size()), n);
+    CHECK(decoded == row);
+}
+
+TEST_CASE("decode_row should reject truncated input.") {
+    std::array<uint8_t, 2> encoded{5, 0};
+    std::array<uint8_t, 4> decoded{};
+    CHECK_EQ(decode_row(encoded.data(), encoded.size(), decoded.data(), decoded.size()), 0);
+}
+
+TEST_CASE("SurveyBucket should compute max, mean and occupancy.") {
+    SurveyBucket<2> bucket{};
+    bucket.add(0, 100, 150);
+    bucket.add(1, 200, 150);
+    bucket.end_sweep();
+    bucket.add(0, 50, 150);
+    bucket.add(1, 100, 150);
+    bucket.end_sweep();
+
+    std::array<uint8_t, 2> max{};
+    std::array<uint8_t, 2> mean{};
+    std::array<uint8_t, 2> occupancy{};
+    bucket.get_rows(max.data(), mean.data(), occupancy.data());
+
+    CHECK_EQ(bucket.sweeps(), 2);
+    CHECK_EQ(max[0], 100);
+    CHECK_EQ(max[1], 200);
+    CHECK_EQ(mean[0], 75);
+    CHECK_EQ(mean[1], 150);
+    CHECK_EQ(occupancy[0], 0);
+    CHECK_EQ(occupancy[1], 127);
+}
+
+TEST_CASE("SurveyBucket should leave unsampled sweeps out of the mean.") {
+    SurveyBucket<2> bucket{};
+    bucket.add(0, 100, 150);
+    bucket.add(1, 200, 150);
+    bucket.end_sweep();
+    bucket.add(1, 200, 150);  // Bin 0 filtered out this sweep.
+    bucket.end_sweep();
+
+    std::array<uint8_t, 2> max{};
+    std::array<uint8_t, 2> mean{};
+    std::array<uint8_t, 2> occupancy{};
+    bucket.get_rows(max.data(), mean.data(), occupancy.data());
+
+    CHECK_EQ(mean[0], 100);
+    CHECK_EQ(mean[1], 200);
+    CHECK_EQ(occupancy[0], 0);
+    CHECK_EQ(occupancy[1], 255);
+}
+
+TEST_CASE("SurveyBucket should count past 65535 sweeps.") {
+    // An hour bucket at 60 sweeps per second.
+    constexpr uint32_t sweeps = 60 * 60 * 60;
+    SurveyBucket<2> bucket{};
+    for (uint32_t i = 0; i < sweeps; ++i) {
+        bucket.add(0, 200, 150);
+        bucket.add(1, (i % 4 == 0) ? 200 : 100, 150);
+        bucket.end_sweep();
+    }
+
+    std::array<uint8_t, 2> max{};
+    std::array<uint8_t, 2> mean{};
+    std::array<uint8_t, 2> occupancy{};
+    bucket.get_rows(max.data(), mean.data(), occupancy.data());
+
+    CHECK_EQ(bucket.sweeps(), sweeps);
+    CHECK_EQ(mean[0], 200);
+    CHECK_EQ(mean[1], 125);
+    CHECK_EQ(occupancy[0], 255);
+    CHECK_EQ(occupancy[1], 63);
+}
+
+TEST_SUITE_END();
@@ -142,3 +142,62 @@ TEST_CASE("trim returns empty for only whitespace.") {
 TEST_CASE("trim empty returns empty.") {
     CHECK(trim("").empty());
 }
+
+TEST_CASE("StringBuilder pads like the to_string helpers.") {
+    StringBuffer<32> s;
+    s.append_dec(-5, 5).append('|').append_dec(-5, 5, '0').append('|').append_dec_uint(7, 3, '0');
+    CHECK(s.view() == "   -5|-0005|007");
+
+    s.clear();
+    s.append_hex(0xABC, 4).append(':').append_hex(0x1F, 1);
+    CHECK(s.view() == "0ABC:F");
+}
+
+TEST_CASE("StringBuilder drops what doesn't fit.") {
+    char buffer[6];
+    StringBuilder s{buffer};
+
+    s.append("abc").append_dec_uint(12345);
+    CHECK(s.view() == "abc12");
+    CHECK(s.truncated());
+    CHECK(std::string{s.c_str()} == "abc12");
+
+    s.resize(2);
+    CHECK(s.view() == "ab");
+}
+
+TEST_CASE("StringBuilder with no capacity never writes.") {
+    char buffer[1] = {'x'};
+    StringBuilder s{buffer, 0};
+
+    s.append("abc").append_dec_uint(1).resize(4).clear();
+    CHECK(s.empty());
+    CHECK(s.view().empty());
+    CHECK(std::string{s.c_str()}.empty());
+    CHECK(buffer[0] == 'x');
+}
+
+TEST_CASE("StringBuilder works at compile time.") {
+    constexpr auto length = [] {
+        StringBuffer<16> s;
+        s.append_dec(-1234, 8);
+        return s.size();
+    }();
+    static_assert(length == 8, "append_dec should be constexpr");
+}
+
+TEST_CASE("append_ helpers match the to_string_ helpers.") {
+    StringBuffer<32> s;
+    append_short_freq(s, 433'920'000);
+    CHECK(s.view() == to_string_short_freq(433'920'000));
+
+    uint8_t mac[] = {0x01, 0xAB, 0xFF};
+    s.clear();
+    append_mac_address(s, mac, 3, false);
+    CHECK(s.view() == "01:AB:FF");
+
+    s.clear();
+    append_decimal(s, -12.5f, 3);
+    CHECK(s.view() == to_string_decimal(-12.5f, 3));
+    CHECK(s.view() == "-12.500");
+}
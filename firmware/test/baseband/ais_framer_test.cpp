@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "ais_framer.hpp"
+#include "ais_packet.hpp"
+#include "doctest.h"
+
+#include <vector>
+
+/* Builds the NRZI decoded bit stream of a frame carrying data. */
+static std::vector<uint8_t> make_frame(const std::vector<uint8_t>& data) {
+    CRC<16> fcs{0x1021, 0xffff, 0xffff};
+    for (auto bit : data)
+        fcs.process_bit(bit);
+
+    auto payload = data;
+    for (int i = 15; i >= 0; i--)
+        payload.push_back((fcs.checksum() >> i) & 1);
+
+    std::vector<uint8_t> bits;
+    for (int i = 0; i < 24; i++)
+        bits.push_back(i & 1);
+    for (auto bit : {0, 1, 1, 1, 1, 1, 1, 0})
+        bits.push_back(bit);
+
+    int ones = 0;
+    for (auto bit : payload) {
+        bits.push_back(bit);
+        ones = bit ? ones + 1 : 0;
+        if (ones == 5) {
+            bits.push_back(0);
+            ones = 0;
+        }
+    }
+
+    for (auto bit : {0, 1, 1, 1, 1, 1, 1, 0})
+        bits.push_back(bit);
+    return bits;
+}
+
+static std::vector<uint8_t> make_data() {
+    std::vector<uint8_t> data;
+    uint32_t lfsr = 0xACE1;
+    for (int i = 0; i < 168; i++) {
+        lfsr = (lfsr >> 1) ^ ((lfsr & 1) ? 0xB400 : 0);
+        data.push_back(lfsr & 1);
+    }
+    // Message type 1.
+    for (int i = 0; i < 6; i++)
+        data[i] = (i == 5);
+    return data;
+}
+
+struct Receiver {
+    std::vector<baseband::Packet> packets;
+    AISFramer framer{[this](const baseband::Packet& packet) { packets.push_back(packet); }};
+
+    void feed(const std::vector<uint8_t>& bits, const std::vector<float>& confidence) {
+        for (size_t i = 0; i < bits.size(); i++)
+            framer.execute(bits[i], confidence[i]);
+    }
+};
+
+TEST_CASE("AIS framer delivers a clean frame with a good FCS") {
+    const auto data = make_data();
+    const auto bits = make_frame(data);
+
+    Receiver rx;
+    rx.feed(bits, std::vector<float>(bits.size(), 1.0f));
+
+    REQUIRE(rx.packets.size() == 1);
+    const auto& packet = rx.packets[0];
+    CHECK(packet.size() == data.size() + 16 + 7);
+    CHECK(AISFramer::fcs_ok(packet));
+
+    const ais::Packet ais_packet{packet};
+    CHECK(ais_packet.is_valid());
+    for (size_t i = 0; i < data.size(); i++)
+        CHECK(packet[i] == data[i]);
+}
+
+TEST_CASE("AIS framer flips a weak symbol to fix the FCS") {
+    const auto data = make_data();
+    auto bits = make_frame(data);
+    std::vector<float> confidence(bits.size(), 1.0f);
+
+    // One symbol error flips the decoded bit it ends and the one after.
+    const size_t error = 32 + 60;
+    bits[error] ^= 1;
+    bits[error + 1] ^= 1;
+    confidence[error] = 0.1f;
+
+    Receiver rx;
+    rx.feed(bits, confidence);
+
+    REQUIRE(rx.packets.size() == 1);
+    CHECK(AISFramer::fcs_ok(rx.packets[0]));
+    for (size_t i = 0; i < data.size(); i++)
+        CHECK(rx.packets[0][i] == data[i]);
+}
+
+TEST_CASE("AIS framer drops a frame when the bad symbol looked confident") {
+    auto bits = make_frame(make_data());
+    bits[32 + 60] ^= 1;
+    bits[32 + 61] ^= 1;
+
+    Receiver rx;
+    rx.feed(bits, std::vector<float>(bits.size(), 1.0f));
+    CHECK(rx.packets.empty());
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "btle_link.hpp"
+#include "dsp_fir_taps.hpp"
+#include "doctest.h"
+
+#include <array>
+#include <cmath>
+
+using namespace btle;
+
+/* One bit at a time, straight from the spec. */
+static uint32_t crc24_bitwise(const uint8_t* data, size_t size, uint32_t crc) {
+    while (size--) {
+        crc ^= *data++;
+        for (int bit = 0; bit < 8; bit++)
+            crc = (crc & 1) ? (crc >> 1) ^ crc_polynomial : crc >> 1;
+    }
+    return crc;
+}
+
+/* Magnitude response of a real FIR in dB, relative to its DC gain. */
+template <size_t N>
+static double response_db(const fir_taps_real<N>& filter, const double f, const double fs) {
+    double re = 0, im = 0, dc = 0;
+    for (size_t i = 0; i < N; i++) {
+        const double w = 2 * M_PI * f / fs * i;
+        re += filter.taps[i] * std::cos(w);
+        im -= filter.taps[i] * std::sin(w);
+        dc += filter.taps[i];
+    }
+    return 20 * std::log10(std::sqrt(re * re + im * im) / dc);
+}
+
+TEST_CASE("8 MHz decimation taps meet their pass and stop bands") {
+    constexpr double fs = 8000000;
+    for (double f = 0; f <= 500000; f += 50000)
+        CHECK(std::abs(response_db(taps_BTLE_1M_PHY_decim_8M, f, fs)) < 0.1);
+    for (double f = 1500000; f <= fs / 2; f += 50000)
+        CHECK(response_db(taps_BTLE_1M_PHY_decim_8M, f, fs) < -55);
+}
+
+TEST_CASE("whitening stream matches the known sequence") {
+    Whitening whitening;
+    std::array<uint8_t, 4> data{};
+
+    whitening.configure(0);
+    whitening.apply(data.data(), data.size());
+    CHECK(data == std::array<uint8_t, 4>{64, 178, 188, 195});
+
+    data = {};
+    whitening.configure(1);
+    whitening.apply(data.data(), data.size());
+    CHECK(data == std::array<uint8_t, 4>{137, 64, 178, 188});
+
+    data = {};
+    whitening.configure(37);
+    whitening.apply(data.data(), data.size());
+    CHECK(data == std::array<uint8_t, 4>{141, 210, 87, 161});
+}
+
+TEST_CASE("whitening is undone by applying it again") {
+    Whitening whitening;
+    whitening.configure(38);
+
+    std::array<uint8_t, 11> data{};
+    for (size_t i = 0; i < data.size(); i++)
+        data[i] = i * 17;
+    const auto original = data;
+
+    whitening.apply(data.data(), data.size());
+    CHECK(data != original);
+    whitening.apply(data.data(), data.size());
+    CHECK(data == original);
+}
+
+TEST_CASE("whitening offset continues the stream") {
+    Whitening whitening;
+    whitening.configure(39);
+
+    std::array<uint8_t, 9> whole{};
+    whitening.apply(whole.data(), whole.size());
+
+    std::array<uint8_t, 5> tail{};
+    whitening.apply(tail.data(), tail.size(), 4);
+    for (size_t i = 0; i < tail.size(); i++)
+        CHECK(tail[i] == whole[4 + i]);
+}
+
+TEST_CASE("crc24 matches the bitwise CRC for every length") {
+    std::array<uint8_t, 40> data{};
+    for (size_t i = 0; i < data.size(); i++)
+        data[i] = i * 37 + 11;
+
+    const auto init = reflect_crc_init(advertising_crc_init);
+    for (size_t size = 0; size <= data.size(); size++)
+        CHECK(crc24(data.data(), size, init) == crc24_bitwise(data.data(), size, init));
+}
+
+TEST_CASE("crc_valid checks the trailing CRC") {
+    std::array<uint8_t, 12> pdu{0x40, 0x06, 1, 2, 3, 4, 5, 6};
+    const auto init = reflect_crc_init(advertising_crc_init);
+    const auto crc = crc24(pdu.data(), 8, init);
+    pdu[8] = crc;
+    pdu[9] = crc >> 8;
+    pdu[10] = crc >> 16;
+
+    CHECK(crc_valid(pdu.data(), 8, init));
+    pdu[3] ^= 0x10;
+    CHECK_FALSE(crc_valid(pdu.data(), 8, init));
+}
+
+TEST_CASE("reflect_crc_init reverses the bits of each byte") {
+    static_assert(reflect_crc_init(0x555555) == 0xAAAAAA, "");
+    CHECK(reflect_crc_init(0x123456) == 0x482C6A);
+}
@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "burst_detector.hpp"
+#include "doctest.h"
+
+#include <cmath>
+#include <vector>
+
+using Detector = BurstDetector<complex16_t, 4>;
+
+/* Gaussian noise from a fixed seed, by summing uniforms. */
+class Noise {
+   public:
+    explicit Noise(uint32_t seed)
+        : state{seed} {}
+
+    int16_t operator()(const float sigma) {
+        float sum = 0;
+        for (int i = 0; i < 12; i++)
+            sum += uniform();
+        return static_cast<int16_t>(std::lround((sum - 6.0f) * sigma));
+    }
+
+   private:
+    uint32_t state;
+
+    float uniform() {
+        state = state * 1664525 + 1013904223;
+        return (state >> 8) * (1.0f / (1 << 24));
+    }
+};
+
+/* Runs one block of constant level, returns the samples the handler saw. */
+static std::vector<complex16_t> feed(Detector& detector, const int16_t level, const size_t count = 16) {
+    std::vector<complex16_t> block(count, complex16_t{level, level});
+    std::vector<complex16_t> seen;
+    detector.execute(buffer_c16_t{block.data(), block.size()}, [&seen](const buffer_c16_t& burst) {
+        seen.insert(seen.end(), burst.p, burst.p + burst.count);
+    });
+    return seen;
+}
+
+TEST_CASE("noise alone is gated off") {
+    Detector detector{32, 1024};
+    for (int i = 0; i < 10; i++)
+        CHECK(feed(detector, 100).empty());
+    CHECK_FALSE(detector.active());
+    CHECK(detector.noise_floor() == 100 * 100 * 2);
+}
+
+TEST_CASE("random noise peaks don't open the gate") {
+    Detector detector{32, 1 << 20};
+    Noise noise{12345};
+    std::vector<complex16_t> block(256);
+    size_t passed = 0;
+
+    for (int n = 0; n < 400; n++) {
+        for (auto& v : block)
+            v = {noise(100.0f), noise(100.0f)};
+        detector.execute(buffer_c16_t{block.data(), block.size()}, [&passed](const buffer_c16_t& burst) {
+            passed += burst.count;
+        });
+        CHECK_FALSE(detector.active());
+    }
+
+    CHECK(passed == 0);
+    // 2 sigma^2, give or take the spread of a block mean.
+    CHECK(detector.noise_floor() > 17000);
+    CHECK(detector.noise_floor() < 23000);
+}
+
+TEST_CASE("ISM gate duty-cycles the demodulators") {
+    // As configured in ISMProcessor: 524.288 kHz channel, 256 sample blocks.
+    constexpr uint32_t channel_fs = 524288;
+    BurstDetector<complex16_t, 64> detector{2624, channel_fs};
+    Noise noise{777};
+    std::vector<complex16_t> block(256);
+    size_t blocks_passed = 0;
+
+    auto run = [&](const size_t blocks, const int16_t carrier) {
+        for (size_t n = 0; n < blocks; n++) {
+            for (auto& v : block)
+                v = {static_cast<int16_t>(carrier + noise(100.0f)), noise(100.0f)};
+            detector.execute(buffer_c16_t{block.data(), block.size()}, [&blocks_passed](const buffer_c16_t&) {
+                blocks_passed++;
+            });
+        }
+    };
+
+    // One second of noise: the demodulators never run.
+    run(channel_fs / 256, 0);
+    CHECK(blocks_passed == 0);
+
+    // A 20 ms packet 10 dB over the noise runs them for its length plus
+    // the lead-in and the hold time, then the gate closes again.
+    run(41, 450);
+    CHECK(detector.active());
+    run(100, 0);
+    CHECK_FALSE(detector.active());
+    CHECK(blocks_passed >= 1 + 41);
+    CHECK(blocks_passed <= 1 + 41 + 2624 / 256 + 2);
+}
+
+TEST_CASE("reset forgets the burst and the floor") {
+    Detector detector{32, 64};
+    feed(detector, 100);
+    feed(detector, 1000);
+    feed(detector, 1000);
+    REQUIRE(detector.active());
+
+    detector.reset();
+    CHECK_FALSE(detector.active());
+    CHECK(detector.noise_floor() == UINT32_MAX);
+
+    // A fresh start: the floor is learned again, then a full burst passes
+    // before the overlong limit, not what was left of the old one.
+    feed(detector, 100);
+    CHECK(detector.noise_floor() == 100 * 100 * 2);
+    CHECK(feed(detector, 1000).size() == 4 + 16);
+    CHECK(feed(detector, 1000).size() == 16);
+    CHECK(feed(detector, 1000).size() == 16);
+    CHECK(detector.active());
+}
+
+TEST_CASE("burst is passed with its lead-in and held") {
+    Detector detector{32, 1024};
+    feed(detector, 100);
+    feed(detector, 100);
+
+    // Lead-in from the quiet block, then the burst block.
+    const auto seen = feed(detector, 1000);
+    REQUIRE(seen.size() == 4 + 16);
+    CHECK(seen.front().real() == 100);
+    CHECK(seen.back().real() == 1000);
+    CHECK(detector.active());
+
+    // Held for hold_samples after the window clears, then gated again.
+    CHECK(feed(detector, 100).size() == 16);
+    CHECK(feed(detector, 100).size() == 16);
+    CHECK(detector.active());
+    CHECK(feed(detector, 100).size() == 16);
+    CHECK_FALSE(detector.active());
+    CHECK(feed(detector, 100).empty());
+
+    // The floor didn't learn from the burst.
+    CHECK(detector.noise_floor() == 100 * 100 * 2);
+}
+
+TEST_CASE("overlong burst re-learns the floor") {
+    Detector detector{32, 64};
+    feed(detector, 100);
+
+    for (int i = 0; i < 3; i++)
+        CHECK(feed(detector, 1000).size() >= 16);
+    feed(detector, 1000);
+    CHECK_FALSE(detector.active());
+    CHECK(feed(detector, 1000).empty());
+}
+
+TEST_CASE("lead-in keeps its position in the stream") {
+    Detector detector{32, 1024};
+    std::vector<complex16_t> quiet(16, complex16_t{100, 100});
+    std::vector<complex16_t> loud(16, complex16_t{1000, 1000});
+    std::vector<uint64_t> starts;
+    auto handler = [&starts](const buffer_c16_t& burst) {
+        starts.push_back(burst.sample_index);
+    };
+
+    detector.execute(buffer_c16_t{quiet.data(), quiet.size(), 0, {}, 100}, handler);
+    detector.execute(buffer_c16_t{loud.data(), loud.size(), 0, {}, 116}, handler);
+
+    REQUIRE(starts.size() == 2);
+    CHECK(starts[0] == 116 - 4);
+    CHECK(starts[1] == 116);
+}
@@ -0,0 +1,279 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "clock_recovery.hpp"
+#include "symbol_coding.hpp"
+#include "doctest.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace clock_recovery;
+
+namespace {
+
+/* Small LCG, the tests need repeatable data rather than good randomness. */
+class Lcg {
+   public:
+    uint32_t next() {
+        state = state * 1664525u + 1013904223u;
+        return state >> 8;
+    }
+
+    int32_t next_in(const int32_t range) {
+        return static_cast<int32_t>(next() % (2 * range + 1)) - range;
+    }
+
+   private:
+    uint32_t state{12345};
+};
+
+std::vector<uint8_t> random_bits(const size_t count) {
+    Lcg lcg;
+    std::vector<uint8_t> bits;
+    for (size_t i = 0; i < count; i++)
+        bits.push_back((lcg.next() >> 7) & 1);
+    return bits;
+}
+
+/* Symbols of +/-amplitude with raised cosine transitions between them,
+ * sampled samples_per_symbol times per symbol starting offset symbols in. */
+std::vector<int32_t> shape(const std::vector<uint8_t>& bits, const size_t samples_per_symbol, const float offset, const float amplitude) {
+    std::vector<int32_t> samples;
+    for (size_t n = 0; n < (bits.size() - 2) * samples_per_symbol; n++) {
+        const float t = static_cast<float>(n) / samples_per_symbol + offset;
+        const size_t k = static_cast<size_t>(t);
+        const float frac = t - k;
+        const float a = bits[k] ? amplitude : -amplitude;
+        const float b = bits[k + 1] ? amplitude : -amplitude;
+        samples.push_back(std::lround(a + (b - a) * (1.0f - std::cos(3.14159265f * frac)) / 2.0f));
+    }
+    return samples;
+}
+
+/* Runs samples through a clock recovery and returns the sliced symbols. */
+template <typename TimingErrorDetector>
+std::vector<uint8_t> recover(const std::vector<int32_t>& samples, const float samples_per_symbol) {
+    using sample_t = typename TimingErrorDetector::sample_t;
+    std::vector<uint8_t> symbols;
+    ClockRecovery<FixedErrorFilter, TimingErrorDetector> recovery{
+        samples_per_symbol,
+        1.0f,
+        {1.0f / 16.0f},
+        [&symbols](const sample_t symbol) { symbols.push_back(symbol >= 0); }};
+    for (const auto sample : samples)
+        recovery(static_cast<sample_t>(sample));
+    return symbols;
+}
+
+/* Whether 256 symbols of recovered, past its first skip, are a run of
+ * sent. */
+bool locked_onto(const std::vector<uint8_t>& recovered, const std::vector<uint8_t>& sent, const size_t skip) {
+    if (recovered.size() < skip + 256)
+        return false;
+
+    const std::vector<uint8_t> tail{recovered.begin() + skip, recovered.begin() + skip + 256};
+    for (size_t start = 0; start + tail.size() <= sent.size(); start++) {
+        if (std::equal(tail.begin(), tail.end(), sent.begin() + start))
+            return true;
+    }
+    return false;
+}
+
+/* The float Mueller-Muller detector, written out from its definition. */
+float reference_mueller_muller(const float last, const float in) {
+    const float decision = (in >= 0.0f) ? 1.0f : -1.0f;
+    const float last_decision = (last >= 0.0f) ? 1.0f : -1.0f;
+    return decision * last - last_decision * in;
+}
+
+/* ::ManchesterDecoder on the M0, for one chip pair. */
+symbol_coding::ManchesterChipDecoder::Bit reference_manchester(const uint8_t first, const uint8_t second, const size_t sense) {
+    return {sense ? second : first, first == second};
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("clock recovery");
+
+TEST_CASE("fixed point Gardner detector matches the float one") {
+    GardnerTimingErrorDetector<int32_t> fixed;
+    GardnerTimingErrorDetector<float> reference;
+    Lcg lcg;
+
+    size_t symbols = 0;
+    for (size_t i = 0; i < 256; i++) {
+        // Small enough that the float products are exact.
+        const auto in = lcg.next_in(2000);
+
+        int64_t fixed_lateness = 0;
+        float reference_lateness = 0.0f;
+        fixed(in, [&fixed_lateness](const int32_t, const int64_t lateness) { fixed_lateness = lateness; });
+        reference(static_cast<float>(in), [&reference_lateness, &symbols](const float, const float lateness) {
+            reference_lateness = lateness;
+            symbols++;
+        });
+        CHECK(static_cast<float>(fixed_lateness) == reference_lateness);
+    }
+    CHECK(symbols == 128);
+}
+
+TEST_CASE("fixed point Gardner lateness doesn't overflow at full scale") {
+    GardnerTimingErrorDetector<int32_t> ted;
+    int64_t lateness = 0;
+    const auto handler = [&lateness](const int32_t, const int64_t value) { lateness = value; };
+
+    ted(-1000000, handler);
+    ted(1000000, handler);
+    ted(1000000, handler);
+    CHECK(lateness == int64_t{2000000} * 1000000);
+}
+
+TEST_CASE("Mueller-Muller detectors match the reference") {
+    MuellerMullerTimingErrorDetector<int32_t> fixed;
+    MuellerMullerTimingErrorDetector<float> floating;
+    Lcg lcg;
+
+    float last = 0.0f;
+    for (size_t i = 0; i < 256; i++) {
+        const auto in = lcg.next_in(2000);
+
+        int64_t fixed_lateness = 0;
+        float float_lateness = 0.0f;
+        fixed(in, [&fixed_lateness](const int32_t, const int64_t lateness) { fixed_lateness = lateness; });
+        floating(static_cast<float>(in), [&float_lateness](const float, const float lateness) { float_lateness = lateness; });
+
+        const auto expected = reference_mueller_muller(last, static_cast<float>(in));
+        CHECK(static_cast<float>(fixed_lateness) == expected);
+        CHECK(float_lateness == expected);
+        last = in;
+    }
+}
+
+TEST_CASE("Mueller-Muller detector reports late sampling as positive") {
+    MuellerMullerTimingErrorDetector<int32_t> ted;
+    int64_t lateness = 0;
+    const auto handler = [&lateness](const int32_t, const int64_t value) { lateness = value; };
+
+    // A -1 -> +1 transition sampled late has leaked into the previous
+    // symbol and reached the current one in full.
+    ted(-1000, handler);
+    ted(-600, handler);
+    ted(1000, handler);
+    CHECK(lateness > 0);
+
+    // Sampled early, the previous symbol is clean and the current one short.
+    ted(-1000, handler);
+    ted(-1000, handler);
+    ted(600, handler);
+    CHECK(lateness < 0);
+}
+
+TEST_CASE("fixed point resampler tracks the float one") {
+    dsp::interpolation::FixedLinearResampler fixed;
+    dsp::interpolation::LinearResampler reference;
+    fixed.configure(3.0f, 2.0f);
+    reference.configure(3.0f, 2.0f);
+
+    std::vector<int32_t> fixed_out;
+    std::vector<float> reference_out;
+    Lcg lcg;
+    for (size_t i = 0; i < 300; i++) {
+        const auto in = lcg.next_in(30000);
+        fixed(in, [&fixed_out](const int32_t out) { fixed_out.push_back(out); });
+        reference(static_cast<float>(in), [&reference_out](const float out) { reference_out.push_back(out); });
+    }
+
+    REQUIRE(fixed_out.size() == reference_out.size());
+    CHECK(fixed_out.size() == 200);
+    for (size_t i = 0; i < fixed_out.size(); i++)
+        CHECK(std::abs(fixed_out[i] - reference_out[i]) <= 1.0f);
+}
+
+TEST_CASE("fixed point clock recovery locks onto the symbols") {
+    const auto bits = random_bits(400);
+    // Start a third of a symbol off the symbol centres.
+    const auto samples = shape(bits, 8, 0.33f, 10000.0f);
+
+    const auto fixed = recover<GardnerTimingErrorDetector<int32_t>>(samples, 8.0f);
+    CHECK(locked_onto(fixed, bits, 64));
+
+    // Same decisions as the float loop once both have locked.
+    const auto reference = recover<GardnerTimingErrorDetector<float>>(samples, 8.0f);
+    REQUIRE(reference.size() == fixed.size());
+    CHECK(std::equal(fixed.begin() + 64, fixed.end(), reference.begin() + 64));
+
+    const auto mueller_muller = recover<MuellerMullerTimingErrorDetector<int32_t>>(samples, 8.0f);
+    CHECK(locked_onto(mueller_muller, bits, 64));
+}
+
+TEST_CASE("Manchester chip decoder matches the M0 decoder") {
+    const auto chips = random_bits(256);
+
+    for (const size_t sense : {0u, 1u}) {
+        symbol_coding::ManchesterChipDecoder decode{sense};
+        size_t pairs = 0;
+        for (size_t i = 0; i < chips.size(); i++) {
+            symbol_coding::ManchesterChipDecoder::Bit bit{};
+            if (!decode(chips[i], bit))
+                continue;
+
+            const auto expected = reference_manchester(chips[i - 1], chips[i], sense);
+            CHECK(bit.value == expected.value);
+            CHECK(bit.error == expected.error);
+            pairs++;
+        }
+        CHECK(pairs == chips.size() / 2);
+    }
+}
+
+TEST_CASE("Manchester payloads are told from noise") {
+    const auto bits = random_bits(75);
+    std::vector<uint8_t> chips;
+    for (const auto bit : bits) {
+        chips.push_back(bit);
+        chips.push_back(!bit);
+    }
+    CHECK(symbol_coding::is_manchester(chips));
+
+    // A weak packet with a few broken pairs still passes.
+    for (size_t i = 1; i < 30; i += 4)
+        chips[i] = chips[i - 1];
+    CHECK(symbol_coding::is_manchester(chips));
+
+    // Noise breaks about half of them.
+    CHECK_FALSE(symbol_coding::is_manchester(random_bits(150)));
+}
+
+TEST_CASE("NRZI decoder undoes NRZI coding") {
+    // NRZI as AIS sends it: a zero toggles the line, a one holds it.
+    const auto bits = random_bits(128);
+    symbol_coding::NRZIDecoder decode;
+    uint8_t line = 0;
+    for (const auto bit : bits) {
+        if (!bit)
+            line ^= 1;
+        CHECK(decode(line) == bit);
+    }
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,264 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "dsp_interpolate.hpp"
+#include "doctest.h"
+
+#include <array>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+using dsp::interpolate::PolyphaseInterpolator;
+
+namespace {
+
+/* Magnitude of the DFT of the output at bin k. */
+float bin_magnitude(const std::vector<complex8_t>& x, const size_t k) {
+    std::complex<double> sum{};
+    for (size_t n = 0; n < x.size(); n++) {
+        const double phase = -2.0 * M_PI * k * n / x.size();
+        sum += std::complex<double>(x[n].real(), x[n].imag()) * std::polar(1.0, phase);
+    }
+    return std::abs(sum);
+}
+
+/* Strongest image of a tone at 1/10 the input rate, relative to the tone,
+ * in dB. Images sit at multiples of the input rate plus or minus the tone. */
+float image_level_db(const size_t taps_per_phase) {
+    constexpr size_t factor = 8;
+    constexpr size_t cycles = 40;
+    constexpr size_t length = cycles * 10;
+
+    PolyphaseInterpolator interp;
+    interp.configure(factor, taps_per_phase);
+
+    std::vector<complex16_t> src(length);
+    for (size_t n = 0; n < length; n++) {
+        const double phase = 2.0 * M_PI * cycles * n / length;
+        src[n] = {static_cast<int16_t>(std::lround(24000 * std::cos(phase))),
+                  static_cast<int16_t>(std::lround(24000 * std::sin(phase)))};
+    }
+
+    // A first pass fills the history, the second is periodic.
+    std::vector<complex8_t> dst(length * factor);
+    interp.execute({src.data(), length, 500'000}, {dst.data(), dst.size()});
+    interp.execute({src.data(), length, 500'000}, {dst.data(), dst.size()});
+
+    const float tone = bin_magnitude(dst, cycles);
+    float image = 0.0f;
+    for (size_t m = 1; m < factor; m++) {
+        image = std::max(image, bin_magnitude(dst, m * length - cycles));
+        image = std::max(image, bin_magnitude(dst, m * length + cycles));
+    }
+    return 20.0f * std::log10(image / tone);
+}
+
+}  // namespace
+
+TEST_CASE("PolyphaseInterpolator phases sum to unity") {
+    PolyphaseInterpolator interp;
+    interp.configure(8, 4);
+
+    // Unity maps C16 onto C8, a 1 / 256 gain.
+    const int32_t unity = 1 << (interp.shift() - 8);
+    for (size_t p = 0; p < interp.factor(); p++) {
+        int32_t sum = 0;
+        for (size_t t = 0; t < interp.taps_per_phase(); t++)
+            sum += interp.phase(p)[t];
+        // Each tap is rounded on its own.
+        CHECK(sum >= unity - 2);
+        CHECK(sum <= unity + 2);
+    }
+}
+
+TEST_CASE("PolyphaseInterpolator rejects the images the sample hold leaves") {
+    const auto hold = image_level_db(1);
+    const auto four_taps = image_level_db(4);
+    const auto eight_taps = image_level_db(8);
+
+    // The sample hold's first image is only about 19 dB down.
+    CHECK(hold > -21.0f);
+    CHECK(four_taps < -36.0f);
+    CHECK(eight_taps < -45.0f);
+}
+
+TEST_CASE("PolyphaseInterpolator taps fit the cycle budget") {
+    // ReplayProcessor's budget.
+    constexpr uint32_t budget = 60'000'000;
+    CHECK(PolyphaseInterpolator::taps_for_budget(4'000'000, budget) == 4);
+    CHECK(PolyphaseInterpolator::taps_for_budget(2'000'000, budget) == 8);
+    CHECK(PolyphaseInterpolator::taps_for_budget(8'000'000, budget) == 1);
+
+    for (uint32_t rate = 500'000; rate <= 20'000'000; rate += 500'000) {
+        const auto taps = PolyphaseInterpolator::taps_for_budget(rate, budget);
+        if (taps > 1)
+            CHECK(uint64_t{rate} * PolyphaseInterpolator::cycles_per_output(taps) <= budget);
+    }
+}
+
+TEST_CASE("PolyphaseInterpolator keeps 16 bit taps for any gain") {
+    PolyphaseInterpolator interp;
+    interp.configure(4, 8);
+
+    for (const uint16_t peak : {uint16_t{1}, uint16_t{100}, uint16_t{0x7fff}}) {
+        interp.set_peak(peak);
+
+        // Full scale in takes the largest tap sum without overflow.
+        int64_t largest_sum = 0;
+        for (size_t p = 0; p < interp.factor(); p++) {
+            int64_t sum = 0;
+            for (size_t t = 0; t < interp.taps_per_phase(); t++)
+                sum += std::abs(interp.phase(p)[t]);
+            largest_sum = std::max(largest_sum, sum);
+        }
+        CHECK(largest_sum * 32768 < (int64_t{1} << 31));
+        CHECK(interp.shift() >= 8);
+    }
+}
+
+TEST_CASE("PolyphaseInterpolator with one tap holds each sample") {
+    PolyphaseInterpolator interp;
+    interp.configure(4, 1);
+
+    std::array<complex16_t, 2> src{{{0x1000, -0x2000}, {0x7f00, -0x8000}}};
+    std::array<complex8_t, 8> dst{};
+    auto out = interp.execute({src.data(), src.size(), 500'000}, {dst.data(), dst.size()});
+
+    CHECK(out.count == 8);
+    CHECK(out.sampling_rate == 2'000'000);
+    for (size_t i = 0; i < 4; i++) {
+        CHECK(dst[i].real() == 0x10);
+        CHECK(dst[i].imag() == -0x20);
+        CHECK(dst[i + 4].real() == 0x7f);
+        CHECK(dst[i + 4].imag() == -0x80);
+    }
+}
+
+TEST_CASE("PolyphaseInterpolator passes DC once the history is full") {
+    PolyphaseInterpolator interp;
+    interp.configure(4, 8);
+
+    std::array<complex16_t, 16> src{};
+    src.fill({0x2000, -0x1000});
+    std::array<complex8_t, 64> dst{};
+    interp.execute({src.data(), src.size(), 500'000}, {dst.data(), dst.size()});
+
+    for (size_t i = 8 * 4; i < dst.size(); i++) {
+        CHECK(dst[i].real() == doctest::Approx(0x20).epsilon(0.05));
+        CHECK(dst[i].imag() == doctest::Approx(-0x10).epsilon(0.1));
+    }
+}
+
+TEST_CASE("PolyphaseInterpolator scales the source peak near full scale") {
+    PolyphaseInterpolator interp;
+    interp.configure(2, 1);
+    interp.set_peak(0x0800);
+
+    std::array<complex16_t, 1> src{{{0x0800, -0x0800}}};
+    std::array<complex8_t, 2> dst{};
+    interp.execute({src.data(), src.size(), 1'000'000}, {dst.data(), dst.size()});
+
+    CHECK(dst[0].real() == 112);
+    CHECK(dst[0].imag() == -112);
+}
+
+TEST_CASE("PolyphaseInterpolator dither averages out between C8 steps") {
+    PolyphaseInterpolator interp;
+    interp.configure(4, 1);
+
+    // 32.5 in C8 units, plain rounding always gives 33.
+    std::array<complex16_t, 256> src{};
+    src.fill({0x2080, -0x2080});
+    std::array<complex8_t, 1024> dst{};
+    interp.execute({src.data(), src.size(), 500'000}, {dst.data(), dst.size()});
+    CHECK(dst[0].real() == 33);
+
+    interp.set_dither(true);
+    interp.execute({src.data(), src.size(), 500'000}, {dst.data(), dst.size()});
+
+    double sum = 0.0;
+    for (const auto& value : dst) {
+        // Triangular noise moves the output at most one step either way.
+        CHECK(value.real() >= 31);
+        CHECK(value.real() <= 34);
+        sum += value.real();
+    }
+    CHECK(sum / dst.size() == doctest::Approx(32.5).epsilon(0.005));
+
+    // Each held output gets its own noise.
+    size_t varied_holds = 0;
+    for (size_t i = 0; i < dst.size(); i += 4)
+        varied_holds += dst[i].real() != dst[i + 1].real() ||
+                        dst[i].real() != dst[i + 2].real() ||
+                        dst[i].real() != dst[i + 3].real();
+    CHECK(varied_holds > 0);
+}
+
+TEST_CASE("PolyphaseInterpolator carries the sample index to the output rate") {
+    PolyphaseInterpolator interp;
+    interp.configure(4, 2);
+
+    std::array<complex16_t, 4> src{};
+    std::array<complex8_t, 16> dst{};
+    auto out = interp.execute({src.data(), src.size(), 250'000, {}, 10}, {dst.data(), dst.size()});
+
+    CHECK(out.sample_index == 40);
+}
+
+TEST_CASE("PolyphaseInterpolator passes C8 through at unity gain") {
+    PolyphaseInterpolator interp;
+    interp.configure(2, 1);
+
+    std::array<complex8_t, 2> src{{{-1, 1}, {127, -128}}};
+    std::array<complex8_t, 4> dst{};
+    auto out = interp.execute(buffer_c8_t{src.data(), src.size(), 1'000'000}, {dst.data(), dst.size()});
+
+    CHECK(out.count == 4);
+    CHECK(dst[0].real() == -1);
+    CHECK(dst[1].imag() == 1);
+    CHECK(dst[2].real() == 127);
+    CHECK(dst[3].imag() == -128);
+}
+
+TEST_CASE("PolyphaseInterpolator filters C8 like the same C16") {
+    PolyphaseInterpolator c8_interp;
+    PolyphaseInterpolator c16_interp;
+    c8_interp.configure(4, 4);
+    c16_interp.configure(4, 4);
+
+    std::array<complex8_t, 8> src8{};
+    std::array<complex16_t, 8> src16{};
+    for (size_t i = 0; i < src8.size(); i++) {
+        src8[i] = {static_cast<int8_t>(i * 9), static_cast<int8_t>(-i * 5)};
+        src16[i] = {static_cast<int16_t>(i * 9 * 256), static_cast<int16_t>(-i * 5 * 256)};
+    }
+
+    std::array<complex8_t, 32> dst8{};
+    std::array<complex8_t, 32> dst16{};
+    c8_interp.execute(buffer_c8_t{src8.data(), src8.size(), 1'000'000}, {dst8.data(), dst8.size()});
+    c16_interp.execute({src16.data(), src16.size(), 1'000'000}, {dst16.data(), dst16.size()});
+
+    for (size_t i = 0; i < dst8.size(); i++) {
+        CHECK(dst8[i].real() == dst16[i].real());
+        CHECK(dst8[i].imag() == dst16[i].imag());
+    }
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "dsp_window.hpp"
+#include "spectrum_detector.hpp"
+#include "doctest.h"
+
+#include <cstdlib>
+
+using namespace dsp::window;
+
+TEST_CASE("constexpr cos matches known values") {
+    CHECK(std::abs(dsp::window::cos(0.0) - 1.0) < 1e-12);
+    CHECK(std::abs(dsp::window::cos(3.14159265358979323846) + 1.0) < 1e-12);
+    CHECK(std::abs(dsp::window::cos(7.0) - 0.7539022543433046) < 1e-12);
+}
+
+TEST_CASE("Hann window is zero at the ends and unity in the middle") {
+    constexpr Table<256> hann_table{hann};
+    static_assert(hann_table[0] == 0, "Hann should start at zero");
+    CHECK(hann_table[128] == 32767);
+    CHECK(hann_table[64] == hann_table[192]);
+    CHECK(std::abs(hann_table[64] - 16384) <= 1);
+}
+
+TEST_CASE("window mean matches its coherent gain") {
+    for (auto type : {Type::Hann, Type::BlackmanHarris, Type::FlatTop}) {
+        const auto w = table<256>(type);
+        REQUIRE(w != nullptr);
+
+        int64_t sum = 0;
+        for (size_t i = 0; i < 256; i++)
+            sum += w->operator[](i);
+
+        const double mean = sum / 256.0 / 32767.0;
+        CHECK(std::abs(mean - w->gain()) < 1e-3);
+    }
+}
+
+TEST_CASE("table returns nullptr for frequency domain windows") {
+    CHECK(table<256>(Type::Hamming3) == nullptr);
+    CHECK(table<256>(Type::Rectangular) == nullptr);
+}
+
+TEST_CASE("linear averaging emits one frame per count") {
+    SpectrumDetector<2> detector;
+    detector.configure(SpectrumDetectorMode::AverageLinear, 3);
+
+    std::array<uint8_t, 2> db{10, 100};
+    CHECK_FALSE(detector.apply(db));
+    db = {20, 110};
+    CHECK_FALSE(detector.apply(db));
+    db = {30, 120};
+    REQUIRE(detector.apply(db));
+    CHECK(db[0] == 20);
+    CHECK(db[1] == 110);
+}
+
+TEST_CASE("exponential averaging converges") {
+    SpectrumDetector<1> detector;
+    detector.configure(SpectrumDetectorMode::AverageExponential, 4);
+
+    std::array<uint8_t, 1> db{0};
+    CHECK(detector.apply(db));
+    for (int i = 0; i < 64; i++) {
+        db = {200};
+        detector.apply(db);
+    }
+    CHECK(db[0] == 200);
+}
+
+TEST_CASE("max and min hold keep extremes until reset") {
+    SpectrumDetector<1> detector;
+    detector.configure(SpectrumDetectorMode::MaxHold, 1);
+
+    std::array<uint8_t, 1> db{50};
+    detector.apply(db);
+    db = {10};
+    detector.apply(db);
+    CHECK(db[0] == 50);
+
+    detector.configure(SpectrumDetectorMode::MinHold, 1);
+    db = {50};
+    detector.apply(db);
+    db = {10};
+    detector.apply(db);
+    db = {30};
+    detector.apply(db);
+    CHECK(db[0] == 10);
+
+    detector.reset();
+    db = {30};
+    detector.apply(db);
+    CHECK(db[0] == 30);
+}
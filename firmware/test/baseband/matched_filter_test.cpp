@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "matched_filter.hpp"
+#include "symbol_coding.hpp"
+#include "ais_baseband.hpp"
+#include "doctest.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace dsp::matched_filter;
+
+/* The float filter the fixed-point one replaced. */
+static float reference_output(const std::vector<complex16_t>& window, const std::array<std::complex<float>, 4>& taps) {
+    std::complex<float> n{};
+    std::complex<float> p{};
+    for (size_t i = 0; i < taps.size(); i++) {
+        const std::complex<float> s = window[i];
+        const auto tap = taps[taps.size() - 1 - i];
+        n += s * std::conj(tap);
+        p += s * tap;
+    }
+    return std::abs(p) - std::abs(n);
+}
+
+/* A tone at +/-deviation, the two FSK symbols. */
+static std::vector<complex16_t> make_tone(const float deviation, const float sampling_rate, const size_t count) {
+    std::vector<complex16_t> samples;
+    for (size_t i = 0; i < count; i++) {
+        const float phase = 2.0f * 3.14159265f * deviation * i / sampling_rate;
+        samples.push_back({static_cast<int16_t>(std::cos(phase) * 20000.0f),
+                           static_cast<int16_t>(std::sin(phase) * 20000.0f)});
+    }
+    return samples;
+}
+
+TEST_CASE("matched filter tracks the float reference") {
+    const auto& taps = baseband::ais::square_taps_38k4_1t_p;
+    MatchedFilter<4> mf{taps, 2};
+    const auto samples = make_tone(3000.0f, 38400.0f, 64);
+
+    size_t outputs = 0;
+    for (size_t i = 0; i < samples.size(); i++) {
+        if (mf.execute_once(samples[i])) {
+            outputs++;
+            if (i >= 3) {
+                const std::vector<complex16_t> window{samples.begin() + i - 3, samples.begin() + i + 1};
+                CHECK(mf.get_output() == doctest::Approx(reference_output(window, taps)).epsilon(0.01));
+            }
+        }
+    }
+    CHECK(outputs == samples.size() / 2);
+}
+
+TEST_CASE("matched filter output sign follows the deviation") {
+    MatchedFilter<4> mf_high{baseband::ais::square_taps_38k4_1t_p, 1};
+    MatchedFilter<4> mf_low{baseband::ais::square_taps_38k4_1t_p, 1};
+
+    for (const auto& s : make_tone(2400.0f, 38400.0f, 16))
+        mf_high.execute_once(s);
+    for (const auto& s : make_tone(-2400.0f, 38400.0f, 16))
+        mf_low.execute_once(s);
+
+    CHECK(mf_high.get_output() > 1000.0f);
+    CHECK(mf_low.get_output() < -1000.0f);
+}
+
+TEST_CASE("slicer holds its decision inside the hysteresis band") {
+    symbol_coding::Slicer slicer{0.0f, 0.1f};
+    CHECK(slicer(0.5f) == 1);
+    CHECK(slicer(0.05f) == 1);
+    CHECK(slicer(-0.05f) == 1);
+    CHECK(slicer(-0.5f) == 0);
+    CHECK(slicer(0.05f) == 0);
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "ook_pulse_estimator.hpp"
+#include "doctest.h"
+
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t sample_rate = 524288;  // The ISM channel rate.
+constexpr uint32_t ns_per_sample = 1'000'000'000 / sample_rate;
+
+/* An OOK carrier switched on and off, with some noise on top. */
+class PulseTrain {
+   public:
+    /* Appends duration_us of carrier (on) or noise only (off). */
+    void add(const bool on, const uint32_t duration_us) {
+        const size_t count = static_cast<uint64_t>(duration_us) * sample_rate / 1'000'000;
+        for (size_t i = 0; i < count; i++) {
+            const int16_t level = on ? 2000 : 0;
+            samples.push_back({static_cast<int16_t>(level + noise()), static_cast<int16_t>(noise())});
+        }
+    }
+
+    /* Runs the estimator in blocks of 256, as the ISM processor does. */
+    std::vector<std::pair<bool, uint32_t>> run(OOKPulseEstimator& estimator) {
+        std::vector<std::pair<bool, uint32_t>> edges;
+        for (size_t i = 0; i < samples.size(); i += 256) {
+            const size_t count = std::min<size_t>(256, samples.size() - i);
+            estimator.execute(buffer_c16_t{&samples[i], count}, [&edges](const bool level, const uint32_t duration) {
+                edges.push_back({level, duration});
+            });
+        }
+        return edges;
+    }
+
+   private:
+    std::vector<complex16_t> samples{};
+    uint32_t state{1};
+
+    int16_t noise() {
+        state = state * 1664525 + 1013904223;
+        return static_cast<int16_t>((state >> 16) % 41) - 20;
+    }
+};
+
+}  // namespace
+
+TEST_SUITE_BEGIN("OOK pulse estimator");
+
+TEST_CASE("pulse and gap durations are measured") {
+    OOKPulseEstimator estimator;
+    estimator.configure(ns_per_sample);
+
+    PulseTrain train;
+    train.add(false, 5000);
+    for (int i = 0; i < 8; i++) {
+        train.add(true, 400);
+        train.add(false, 800);
+    }
+    train.add(true, 1600);
+    train.add(false, 5000);
+
+    const auto edges = train.run(estimator);
+
+    // Lead-in noise, 8 short pulses and gaps, the long pulse and whatever
+    // of the trailing gap ended before the input did.
+    REQUIRE(edges.size() == 1 + 16 + 1);
+    CHECK_FALSE(edges[0].first);
+    for (size_t i = 1; i < 17; i += 2) {
+        CHECK(edges[i].first);
+        CHECK(std::abs((int)edges[i].second - 400) <= 10);
+        CHECK_FALSE(edges[i + 1].first);
+        CHECK(std::abs((int)edges[i + 1].second - 800) <= 10);
+    }
+    CHECK(edges[17].first);
+    CHECK(std::abs((int)edges[17].second - 1600) <= 10);
+}
+
+TEST_CASE("a one sample glitch is not a pulse") {
+    OOKPulseEstimator estimator;
+    estimator.configure(ns_per_sample);
+
+    PulseTrain train;
+    train.add(false, 5000);
+    train.add(true, 2);  // About one sample.
+    train.add(false, 5000);
+    train.add(true, 500);
+    train.add(false, 1000);
+
+    const auto edges = train.run(estimator);
+    REQUIRE(edges.size() >= 2);
+    // The glitch and its surroundings read as one gap before the real pulse.
+    CHECK(edges.back().first);
+    CHECK(std::abs((int)edges.back().second - 500) <= 10);
+}
+
+TEST_SUITE_END();
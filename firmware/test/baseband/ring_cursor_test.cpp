@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "ring_cursor.hpp"
+#include "doctest.h"
+
+TEST_CASE("RingCursor hands out blocks in order") {
+    RingCursor cursor;
+    cursor.reset(4);
+    CHECK_FALSE(cursor.pending());
+
+    cursor.complete();
+    cursor.complete();
+    REQUIRE(cursor.pending());
+
+    auto block = cursor.take();
+    CHECK(block.index == 0);
+    CHECK(block.sequence == 0);
+    CHECK(block.lost == 0);
+
+    block = cursor.take();
+    CHECK(block.index == 1);
+    CHECK(block.sequence == 1);
+    CHECK(block.lost == 0);
+    CHECK_FALSE(cursor.pending());
+}
+
+TEST_CASE("RingCursor wraps around the ring") {
+    RingCursor cursor;
+    cursor.reset(3);
+
+    for (uint64_t i = 0; i < 7; i++) {
+        cursor.complete();
+        const auto block = cursor.take();
+        CHECK(block.index == i % 3);
+        CHECK(block.sequence == i);
+    }
+    CHECK(cursor.lost_total() == 0);
+}
+
+TEST_CASE("RingCursor skips to the newest block on overrun") {
+    RingCursor cursor;
+    cursor.reset(4);
+
+    // Two pending blocks still leave a block of margin.
+    cursor.complete();
+    cursor.complete();
+    CHECK(cursor.take().lost == 0);
+    CHECK(cursor.take().lost == 0);
+
+    // Three pending blocks could be overwritten while handled.
+    cursor.complete();
+    cursor.complete();
+    cursor.complete();
+    const auto block = cursor.take();
+    CHECK(block.lost == 2);
+    CHECK(block.sequence == 4);
+    CHECK(block.index == 0);
+    CHECK_FALSE(cursor.pending());
+    CHECK(cursor.lost_total() == 2);
+}
@@ -0,0 +1,338 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "framebuffer_lcd.hpp"
+#include "lcd_ili9341.hpp"
+#include "portapack.hpp"
+
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+
+namespace portapack {
+
+lcd::ILI9341 display;
+
+} /* namespace portapack */
+
+namespace framebuffer {
+namespace {
+
+constexpr size_t width = ui::screen_width;
+constexpr size_t height = ui::screen_height;
+
+std::array<uint16_t, width * height> gram{};
+Stats counters{};
+
+/* Address window of the current RAM write, filled left to right,
+ * top to bottom and wrapping back to the top like the panel does. */
+ui::Rect window{};
+ui::Point cursor{};
+
+/* Vertical scrolling definition and start address. */
+uint_fast16_t scroll_top = 0;
+uint_fast16_t scroll_height = height;
+uint_fast16_t scroll_start = 0;
+
+void start_ram_write(const ui::Rect r) {
+    window = r;
+    cursor = r.location();
+    counters.ram_writes++;
+}
+
+void write_pixel(const ui::Color color) {
+    if (window.is_empty())
+        return;
+
+    if (cursor.x() >= 0 && cursor.x() < (int)width && cursor.y() >= 0 && cursor.y() < (int)height)
+        gram[cursor.y() * width + cursor.x()] = color.v;
+    counters.pixels_written++;
+
+    cursor = {cursor.x() + 1, cursor.y()};
+    if (cursor.x() >= window.right()) {
+        cursor = {window.left(), cursor.y() + 1};
+        if (cursor.y() >= window.bottom())
+            cursor = window.location();
+    }
+}
+
+} /* namespace */
+
+void clear(const ui::Color color) {
+    gram.fill(color.v);
+    scroll_top = 0;
+    scroll_height = height;
+    scroll_start = 0;
+}
+
+ui::Color pixel(const ui::Point p) {
+    if (p.x() < 0 || p.x() >= (int)width || p.y() < 0 || p.y() >= (int)height)
+        return ui::Color::black();
+
+    // Lines in the scrolling area are shown starting at the start address.
+    int y = p.y();
+    const int top = scroll_top;
+    const int area = scroll_height;
+    if (y >= top && y < top + area)
+        y = top + ((y - top + (int)scroll_start - top) % area + area) % area;
+
+    return ui::Color(gram[y * width + p.x()]);
+}
+
+size_t count_pixels(const ui::Rect r, const ui::Color color) {
+    size_t count = 0;
+    for (int y = r.top(); y < r.bottom(); y++) {
+        for (int x = r.left(); x < r.right(); x++) {
+            if (pixel({x, y}).v == color.v)
+                count++;
+        }
+    }
+    return count;
+}
+
+const Stats& stats() {
+    return counters;
+}
+
+void reset_stats() {
+    counters = {};
+}
+
+uint32_t checksum() {
+    uint32_t hash = 2166136261u;
+    for (size_t y = 0; y < height; y++) {
+        for (size_t x = 0; x < width; x++) {
+            const auto v = pixel({(int)x, (int)y}).v;
+            hash = (hash ^ (v & 0xFF)) * 16777619u;
+            hash = (hash ^ (v >> 8)) * 16777619u;
+        }
+    }
+    return hash;
+}
+
+bool write_ppm(const std::string& path) {
+    auto f = std::fopen(path.c_str(), "wb");
+    if (!f)
+        return false;
+
+    std::fprintf(f, "P6\n%zu %zu\n255\n", width, height);
+    for (size_t y = 0; y < height; y++) {
+        for (size_t x = 0; x < width; x++) {
+            auto c = pixel({(int)x, (int)y});
+            const uint8_t rgb[3] = {c.r(), c.g(), c.b()};
+            std::fwrite(rgb, sizeof(rgb), 1, f);
+        }
+    }
+
+    return std::fclose(f) == 0;
+}
+
+} /* namespace framebuffer */
+
+namespace lcd {
+
+using namespace framebuffer;
+
+bool ILI9341::read_display_status() {
+    return true;
+}
+
+void ILI9341::init() {
+    framebuffer::clear();
+}
+
+void ILI9341::shutdown() {
+}
+
+void ILI9341::sleep() {
+}
+
+void ILI9341::wake() {
+}
+
+void ILI9341::set_inverted(bool) {
+}
+
+void ILI9341::fill_rectangle(ui::Rect r, const ui::Color c) {
+    const auto r_clipped = r.intersect(screen_rect());
+    if (!r_clipped.is_empty()) {
+        start_ram_write(r_clipped);
+        size_t count = r_clipped.width() * r_clipped.height();
+        while (count--)
+            write_pixel(c);
+    }
+}
+
+void ILI9341::fill_rectangle_unrolled8(ui::Rect r, const ui::Color c) {
+    fill_rectangle(r, c);
+}
+
+void ILI9341::render_line(const ui::Point p, const uint8_t count, const ui::Color* line_buffer) {
+    render_box(p, {count, 1}, line_buffer);
+}
+
+void ILI9341::render_box(const ui::Point p, const ui::Size s, const ui::Color* line_buffer) {
+    start_ram_write({p, s});
+    for (int i = 0; i < s.width() * s.height(); i++)
+        write_pixel(line_buffer[i]);
+}
+
+void ILI9341::draw_bmp_from_bmp_hex_arr(const ui::Point, const uint8_t*, const uint8_t*) {
+}
+
+bool ILI9341::draw_bmp_from_sdcard_file(const ui::Point, const std::filesystem::path&) {
+    return false;
+}
+
+void ILI9341::draw_line(const ui::Point start, const ui::Point end, const ui::Color color) {
+    int x0 = start.x();
+    int y0 = start.y();
+    int x1 = end.x();
+    int y1 = end.y();
+
+    int dx = std::abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+    int dy = std::abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+    int err = (dx > dy ? dx : -dy) / 2, e2;
+
+    for (;;) {
+        draw_pixel({x0, y0}, color);
+        if (x0 == x1 && y0 == y1) break;
+        e2 = err;
+        if (e2 > -dx) {
+            err -= dy;
+            x0 += sx;
+        }
+        if (e2 < dy) {
+            err += dx;
+            y0 += sy;
+        }
+    }
+}
+
+void ILI9341::fill_circle(
+    const ui::Point center,
+    const ui::Dim radius,
+    const ui::Color foreground,
+    const ui::Color background) {
+    const uint32_t radius2 = radius * radius;
+    for (int32_t y = -radius; y < radius; y++) {
+        const int32_t y2 = y * y;
+        for (int32_t x = -radius; x < radius; x++) {
+            const uint32_t d2 = x * x + y2;
+            draw_pixel({x + center.x(), y + center.y()}, d2 < radius2 ? foreground : background);
+        }
+    }
+}
+
+void ILI9341::draw_pixel(const ui::Point p, const ui::Color color) {
+    if (screen_rect().contains(p)) {
+        start_ram_write({p, {1, 1}});
+        write_pixel(color);
+    }
+}
+
+void ILI9341::draw_pixels(const ui::Rect r, const ui::Color* const colors, const size_t count) {
+    start_ram_write(r);
+    for (size_t i = 0; i < count; i++)
+        write_pixel(colors[i]);
+}
+
+void ILI9341::draw_pixels(const ui::Rect r, const uint8_t* const indexes, const size_t count, const ui::Color* const lut) {
+    start_ram_write(r);
+    for (size_t i = 0; i < count; i++)
+        write_pixel(lut[indexes[i]]);
+}
+
+void ILI9341::read_pixels(const ui::Rect r, ui::ColorRGB888* const colors, const size_t count) {
+    size_t i = 0;
+    for (int y = r.top(); y < r.bottom() && i < count; y++) {
+        for (int x = r.left(); x < r.right() && i < count; x++) {
+            auto c = pixel({x, y});
+            colors[i++] = {c.r(), c.g(), c.b()};
+        }
+    }
+}
+
+void ILI9341::draw_bitmap(
+    const ui::Point p,
+    const ui::Size size,
+    const uint8_t* const pixels,
+    const ui::Color foreground,
+    const ui::Color background) {
+    const size_t count = size.width() * size.height();
+
+    // Magenta background is transparent, only the set bits are drawn.
+    if (ui::Color::magenta().v != background.v) {
+        start_ram_write({p, size});
+        for (size_t i = 0; i < count; i++) {
+            const auto pixel = pixels[i >> 3] & (1U << (i & 0x7));
+            write_pixel(pixel ? foreground : background);
+        }
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            if (pixels[i >> 3] & (1U << (i & 0x7)))
+                draw_pixel({p.x() + (int)(i % size.width()), p.y() + (int)(i / size.width())}, foreground);
+        }
+    }
+}
+
+void ILI9341::draw_glyph(
+    const ui::Point p,
+    const ui::Glyph& glyph,
+    const ui::Color foreground,
+    const ui::Color background) {
+    draw_bitmap(p, glyph.size(), glyph.pixels(), foreground, background);
+}
+
+void ILI9341::scroll_set_area(
+    const ui::Coord top_y,
+    const ui::Coord bottom_y) {
+    scroll_state.top_area = top_y;
+    scroll_state.bottom_area = height() - bottom_y;
+    scroll_state.height = bottom_y - top_y;
+    scroll_top = scroll_state.top_area;
+    scroll_height = scroll_state.height;
+}
+
+ui::Coord ILI9341::scroll_set_position(
+    const ui::Coord position) {
+    scroll_state.current_position = position % scroll_state.height;
+    const uint_fast16_t address = scroll_state.top_area + scroll_state.current_position;
+    scroll_start = address;
+    return address;
+}
+
+ui::Coord ILI9341::scroll(const int32_t delta) {
+    return scroll_set_position(scroll_state.current_position + scroll_state.height - delta);
+}
+
+ui::Coord ILI9341::scroll_area_y(const ui::Coord y) const {
+    const auto wrapped_y = (scroll_state.current_position + y) % scroll_state.height;
+    return wrapped_y + scroll_state.top_area;
+}
+
+void ILI9341::scroll_disable() {
+    scroll_top = 0;
+    scroll_height = height();
+    scroll_start = 0;
+}
+
+} /* namespace lcd */
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __FRAMEBUFFER_LCD_H__
+#define __FRAMEBUFFER_LCD_H__
+
+#include "ui.hpp"
+
+#include <cstdint>
+#include <string>
+
+/* Host side of lcd::ILI9341. The driver writes into an in-memory copy of
+ * the panel's GRAM instead of the CPLD bus. Pixels read back through
+ * pixel() are as shown on screen, with vertical scrolling applied. */
+namespace framebuffer {
+
+struct Stats {
+    uint32_t pixels_written;  // Pixels sent over the bus, the cost of a frame.
+    uint32_t ram_writes;      // Address window setups (CASET/PASET/RAMWR).
+};
+
+/* Fills the GRAM and resets scrolling, doesn't count as drawing. */
+void clear(const ui::Color color = ui::Color::black());
+
+ui::Color pixel(const ui::Point p);
+
+/* Counts the pixels of r that are color. */
+size_t count_pixels(const ui::Rect r, const ui::Color color);
+
+const Stats& stats();
+void reset_stats();
+
+/* FNV-1a hash of the screen, for golden tests. */
+uint32_t checksum();
+
+/* Writes the screen as a binary PPM. */
+bool write_ppm(const std::string& path);
+
+} /* namespace framebuffer */
+
+#endif /*__FRAMEBUFFER_LCD_H__*/
@@ -0,0 +1,363 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Link-time stand-ins for the hardware and the other core, so whole
+ * application views can be instantiated on the host. Anything a view
+ * test must not reach panics instead of pretending to work. */
+
+#include "host_app_stubs.hpp"
+
+#include "audio.hpp"
+#include "baseband_api.hpp"
+#include "buffer_exchange.hpp"
+#include "clock_manager.hpp"
+#include "irq_controls.hpp"
+#include "log_file.hpp"
+#include "memory_stats.hpp"
+#include "portapack.hpp"
+#include "portapack_shared_memory.hpp"
+#include "radio.hpp"
+#include "rtc_time.hpp"
+#include "ui_navigation.hpp"
+#include "usb_serial_thread.hpp"
+
+#include "ch.h"
+
+#include <sys/mman.h>
+
+namespace host_app {
+
+BasebandState baseband_state{};
+RadioState radio_state{};
+
+void reset() {
+    baseband_state = {};
+    radio_state = {};
+}
+
+} /* namespace host_app */
+
+/* Kernel ****************************************************************/
+
+ReadyList rlist;
+VTList vtlist;
+SDCDriver SDCD1;
+
+extern "C" {
+
+Thread* chThdCreateFromHeap(MemoryHeap*, size_t, tprio_t, tfunc_t, void*) {
+    chDbgPanic("host: no threads");
+    return nullptr;
+}
+
+void chThdTerminate(Thread*) {
+}
+
+msg_t chThdWait(Thread*) {
+    return 0;
+}
+
+void chThdSleep(systime_t) {
+}
+
+/* chMtxInit, chMtxLock and chMtxUnlock come from the application
+ * linker_stubs.cpp. */
+bool_t chMtxTryLock(Mutex*) {
+    return TRUE;
+}
+
+void chEvtSignal(Thread*, eventmask_t) {
+}
+
+void sdio_cclk_set(const size_t) {
+}
+
+bool_t sdc_lld_is_card_inserted(SDCDriver*) {
+    return FALSE;
+}
+
+} /* extern "C" */
+
+void MessageQueue::signal() {
+}
+
+BufferExchange::BufferExchange(CaptureConfig* const) {
+    chDbgPanic("host: no capture");
+}
+
+BufferExchange::BufferExchange(ReplayConfig* const) {
+    chDbgPanic("host: no replay");
+}
+
+BufferExchange::~BufferExchange() {
+}
+
+StreamBuffer* BufferExchange::get(FIFO<StreamBuffer*>*) {
+    return nullptr;
+}
+
+StreamBuffer* BufferExchange::get_prefill(FIFO<StreamBuffer*>*) {
+    return nullptr;
+}
+
+UsbSerialThread::UsbSerialThread() {
+}
+
+UsbSerialThread::~UsbSerialThread() {
+}
+
+/* Log files are not written on the host. */
+LogFile::LogFile() {
+}
+
+LogFile::~LogFile() {
+}
+
+Optional<File::Error> LogFile::append(const std::filesystem::path&) {
+    return {};
+}
+
+Optional<File::Error> LogFile::write_entry(std::string_view) {
+    return {};
+}
+
+uint8_t swizzled_switches() {
+    return 0;
+}
+
+SwitchesState get_switches_state() {
+    return {};
+}
+
+/* The host has no SystemView; views under test sit in a NavigationView. */
+ui::SystemView* system_view_ptr = nullptr;
+
+void ui::SystemView::set_app_fullscreen(bool) {
+    chDbgPanic("host: no system view");
+}
+
+namespace rtc_time {
+
+void dst_init() {
+}
+
+} /* namespace rtc_time */
+
+/* Memory ****************************************************************/
+
+/* Views light LEDs and poke GPIOs through fixed peripheral addresses.
+ * Back the AHB peripheral window with scratch memory so those stores
+ * land somewhere harmless. */
+[[maybe_unused]] static const bool host_peripherals_mapped = [] {
+    constexpr uintptr_t ahb_base = 0x40000000;
+    constexpr size_t ahb_size = 0x00100000;
+    const auto p = mmap(reinterpret_cast<void*>(ahb_base), ahb_size,
+                        PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+    return p == reinterpret_cast<void*>(ahb_base);
+}();
+
+uint32_t _textend;
+bool hackrf_r9 = false;
+
+static SharedMemory host_shared_memory{};
+SharedMemory& shared_memory = host_shared_memory;
+
+namespace memory_stats {
+
+void set_thread_tag(Tag) {
+}
+
+} /* namespace memory_stats */
+
+/* Radio *****************************************************************/
+
+static si5351::Si5351 host_clock_generator{portapack::i2c0, 0};
+
+bool I2C::transmit(const address_t, const uint8_t* const, const size_t, const systime_t) {
+    return true;
+}
+
+ClockManager::Reference ClockManager::get_reference() const {
+    return reference;
+}
+
+void ClockManager::set_reference_ppb(const int32_t) {
+}
+
+namespace portapack {
+
+I2C i2c0{nullptr};
+ClockManager clock_manager{i2c0, host_clock_generator};
+ReceiverModel receiver_model;
+TransmitterModel transmitter_model;
+
+bool get_antenna_bias() {
+    return false;
+}
+
+} /* namespace portapack */
+
+namespace radio {
+
+bool set_tuning_frequency(const rf::Frequency frequency) {
+    host_app::radio_state.tuning_frequency = frequency;
+    return true;
+}
+
+void set_direction(const rf::Direction new_direction) {
+    host_app::radio_state.enabled = true;
+    host_app::radio_state.direction = new_direction;
+}
+
+void set_baseband_rate(const uint32_t rate) {
+    host_app::radio_state.baseband_rate = rate;
+}
+
+void disable() {
+    host_app::radio_state.enabled = false;
+}
+
+void set_rf_amp(const bool) {}
+void set_lna_gain(const int_fast8_t) {}
+void set_vga_gain(const int_fast8_t) {}
+void set_tx_gain(const int_fast8_t) {}
+void set_baseband_filter_bandwidth_rx(const uint32_t) {}
+void set_baseband_filter_bandwidth_tx(const uint32_t) {}
+void set_antenna_bias(const bool) {}
+void set_rx_max283x_iq_phase_calibration(const size_t) {}
+void set_tx_max283x_iq_phase_calibration(const size_t) {}
+
+} /* namespace radio */
+
+/* Audio *****************************************************************/
+
+namespace audio {
+
+namespace output {
+
+void start() {}
+void stop() {}
+void mute() {}
+void unmute() {}
+
+} /* namespace output */
+
+namespace input {
+
+void start(int8_t, bool) {}
+void stop() {}
+void loopback_mic_to_hp_enable() {}
+void loopback_mic_to_hp_disable() {}
+
+} /* namespace input */
+
+namespace headphone {
+
+volume_range_t volume_range() {
+    return {-121.0_dB, 6.0_dB};
+}
+
+void set_volume(const volume_t) {}
+
+} /* namespace headphone */
+
+namespace debug {
+
+std::string codec_name() {
+    return "host";
+}
+
+} /* namespace debug */
+
+void set_rate(const Rate) {}
+
+} /* namespace audio */
+
+/* Baseband **************************************************************/
+
+namespace baseband {
+
+void AMConfig::apply() const {}
+void NBFMConfig::apply(const uint8_t) const {}
+void WFMConfig::apply() const {}
+
+void run_image(const portapack::spi_flash::image_tag_t image_tag) {
+    host_app::baseband_state.image_runs++;
+    host_app::baseband_state.image = image_tag;
+}
+
+void shutdown() {
+    host_app::baseband_state.shutdowns++;
+    host_app::baseband_state.spectrum_streaming = false;
+}
+
+void spectrum_streaming_start(const bool waterfall_rows) {
+    host_app::baseband_state.spectrum_streaming = true;
+    host_app::baseband_state.waterfall_rows = waterfall_rows;
+}
+
+void spectrum_streaming_stop() {
+    host_app::baseband_state.spectrum_streaming = false;
+}
+
+void set_spectrum_processing(
+    const dsp::window::Type window,
+    const SpectrumDetectorMode detector,
+    const uint8_t detector_count) {
+    host_app::baseband_state.window = window;
+    host_app::baseband_state.detector = detector;
+    host_app::baseband_state.detector_count = detector_count;
+}
+
+void set_sample_rate(uint32_t sample_rate, OversampleRate) {
+    host_app::baseband_state.sample_rate = sample_rate;
+}
+
+void set_spectrum(const size_t, const size_t) {}
+void set_btlerx(uint8_t) {}
+void set_subghzd_config(uint8_t, uint32_t) {}
+void set_ism(const uint8_t decoders) {
+    host_app::baseband_state.ism_decoders = decoders;
+}
+void set_replay_gain(const uint16_t, const bool) {}
+void set_btletx(uint8_t, char*, char*, uint8_t) {}
+void set_fifo_data(const int8_t*) {}
+void set_audiotx_config(const uint32_t, const float, const float, uint8_t, uint8_t, const uint32_t, const bool, const bool, const bool, const bool) {}
+void set_pitch_rssi(int32_t, bool) {}
+void request_roger_beep() {}
+void request_beep_stop() {}
+void request_audio_beep(uint32_t, uint32_t, uint32_t) {}
+
+void capture_start(CaptureConfig* const) {
+    chDbgPanic("host: no capture");
+}
+
+void capture_stop() {}
+
+void replay_start(ReplayConfig* const) {
+    chDbgPanic("host: no replay");
+}
+
+void replay_stop() {}
+
+} /* namespace baseband */
+
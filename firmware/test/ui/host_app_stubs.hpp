@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __HOST_APP_STUBS_H__
+#define __HOST_APP_STUBS_H__
+
+#include "message.hpp"
+#include "rf_path.hpp"
+#include "spectrum_modes.hpp"
+#include "spi_image.hpp"
+
+#include <cstdint>
+
+/* What the application views asked of the radio and the baseband. The
+ * host has neither, so the calls are recorded here for the tests. */
+namespace host_app {
+
+struct BasebandState {
+    uint32_t image_runs;
+    portapack::spi_flash::image_tag_t image;
+    uint32_t shutdowns;
+    bool spectrum_streaming;
+    bool waterfall_rows;
+    dsp::window::Type window;
+    SpectrumDetectorMode detector;
+    uint8_t detector_count;
+    uint32_t sample_rate;
+    uint8_t ism_decoders;
+};
+
+struct RadioState {
+    bool enabled;
+    rf::Frequency tuning_frequency;
+    rf::Direction direction;
+    uint32_t baseband_rate;
+};
+
+extern BasebandState baseband_state;
+extern RadioState radio_state;
+
+void reset();
+
+} /* namespace host_app */
+
+#endif /*__HOST_APP_STUBS_H__*/
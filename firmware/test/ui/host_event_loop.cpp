@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "host_event_loop.hpp"
+#include "event_m0.hpp"
+#include "framebuffer_lcd.hpp"
+#include "theme.hpp"
+
+#include <array>
+#include <chrono>
+
+/* Host stand-in for the M0 message map in event_m0.cpp. */
+static std::array<std::function<void(Message* const)>, toUType(Message::ID::MAX)> message_map{};
+
+Thread* EventDispatcher::thread_event_loop = nullptr;
+
+MessageHandlerRegistration::MessageHandlerRegistration(
+    const Message::ID message_id,
+    std::function<void(Message* const p)>&& callback)
+    : message_id{message_id} {
+    if (message_map[toUType(message_id)] != nullptr) {
+        chDbgPanic("MsgDblReg");
+    }
+    message_map[toUType(message_id)] = std::move(callback);
+}
+
+MessageHandlerRegistration::~MessageHandlerRegistration() {
+    message_map[toUType(message_id)] = nullptr;
+}
+
+namespace ui {
+
+HostEventLoop::RootView::RootView(Context& context)
+    : View{{0, 0, screen_width, screen_height}},
+      context_{context} {
+    set_style(Theme::getInstance()->bg_darkest);
+}
+
+Context& HostEventLoop::RootView::context() const {
+    return context_;
+}
+
+HostEventLoop::HostEventLoop() {
+    framebuffer::clear();
+}
+
+HostEventLoop::FrameMetrics HostEventLoop::frame() {
+    framebuffer::reset_stats();
+
+    const auto start = std::chrono::steady_clock::now();
+    painter_.paint_widget_tree(&root_);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    return {
+        .frames = 1,
+        .pixels_written = framebuffer::stats().pixels_written,
+        .ram_writes = framebuffer::stats().ram_writes,
+        .microseconds = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()),
+    };
+}
+
+bool HostEventLoop::key(const KeyEvent event) {
+    auto target = context_.focus_manager().focus_widget();
+    while ((target != nullptr) && !target->on_key(event)) {
+        target = target->parent();
+    }
+
+    if (target != nullptr)
+        return true;
+
+    context_.focus_manager().update(&root_, event);
+    return false;
+}
+
+void HostEventLoop::encoder(const EncoderEvent event) {
+    auto target = context_.focus_manager().focus_widget();
+    while ((target != nullptr) && !target->on_encoder(event)) {
+        target = target->parent();
+    }
+}
+
+bool HostEventLoop::send(Message* const message) {
+    if (message->id >= Message::ID::MAX)
+        return false;
+
+    auto& fn = message_map[toUType(message->id)];
+    if (!fn)
+        return false;
+
+    fn(message);
+    return true;
+}
+
+HostEventLoop::FrameMetrics HostEventLoop::replay(const std::string& script) {
+    FrameMetrics total{};
+
+    for (auto c : script) {
+        switch (c) {
+            case 'U':
+                key(KeyEvent::Up);
+                break;
+            case 'D':
+                key(KeyEvent::Down);
+                break;
+            case 'L':
+                key(KeyEvent::Left);
+                break;
+            case 'R':
+                key(KeyEvent::Right);
+                break;
+            case 'S':
+                key(KeyEvent::Select);
+                break;
+            case 'B':
+                key(KeyEvent::Back);
+                break;
+            case '+':
+                encoder(1);
+                break;
+            case '-':
+                encoder(-1);
+                break;
+            case 'F': {
+                auto metrics = frame();
+                total.frames++;
+                total.pixels_written += metrics.pixels_written;
+                total.ram_writes += metrics.ram_writes;
+                total.microseconds += metrics.microseconds;
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    return total;
+}
+
+} /* namespace ui */
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __HOST_EVENT_LOOP_H__
+#define __HOST_EVENT_LOOP_H__
+
+#include "message.hpp"
+#include "ui_painter.hpp"
+#include "ui_widget.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace ui {
+
+/* Stand-in for EventDispatcher on the host. Owns the focus context and a
+ * screen sized top widget, paints the tree on frame sync and bubbles key
+ * and encoder events from the focused widget the same way. */
+class HostEventLoop {
+   public:
+    struct FrameMetrics {
+        uint32_t frames;
+        uint32_t pixels_written;
+        uint32_t ram_writes;
+        uint32_t microseconds;
+    };
+
+    HostEventLoop();
+
+    /* Views under test are added as children of root(). */
+    View& root() { return root_; }
+    Context& context() { return context_; }
+
+    /* One LCD frame sync: paints everything dirty. */
+    FrameMetrics frame();
+
+    bool key(const KeyEvent event);
+    void encoder(const EncoderEvent event);
+
+    /* Delivers a message to its registered handler, as the M0 event
+     * loop does for messages from the baseband. Returns false when no
+     * view is listening. */
+    bool send(Message* const message);
+
+    /* Replays a script, one step per character:
+     *   U D L R S  Up, Down, Left, Right, Select
+     *   B          Back
+     *   + -        encoder step clockwise, counter-clockwise
+     *   F          frame sync
+     * Anything else is ignored. Returns the metrics of all frames. */
+    FrameMetrics replay(const std::string& script);
+
+   private:
+    class RootView : public View {
+       public:
+        RootView(Context& context);
+        Context& context() const override;
+
+       private:
+        Context& context_;
+    };
+
+    Context context_{};
+    RootView root_{context_};
+    Painter painter_{};
+};
+
+} /* namespace ui */
+
+#endif /*__HOST_EVENT_LOOP_H__*/
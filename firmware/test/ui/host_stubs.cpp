@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Stubs for the hardware and RTOS symbols the widget code links
+ * against. Only what the widgets under test need is provided. */
+
+#include "ch.h"
+#include "irq_controls.hpp"
+#include "rtc_time.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+
+extern "C" void chDbgPanic(const char* msg) {
+    std::fprintf(stderr, "panic: %s\n", msg);
+    std::abort();
+}
+
+namespace rtc_time {
+
+Signal<> signal_tick_second;
+
+rtc::RTC now(rtc::RTC& out_datetime) {
+    out_datetime = {2025, 1, 1, 12, 0, 0};
+    return out_datetime;
+}
+
+rtc::RTC now() {
+    return {2025, 1, 1, 12, 0, 0};
+}
+
+} /* namespace rtc_time */
+
+void set_switches_long_press_config(SwitchesState) {
+}
+
+SwitchesState get_switches_long_press_config() {
+    return {};
+}
+
+bool switch_is_long_pressed(Switch) {
+    return false;
+}
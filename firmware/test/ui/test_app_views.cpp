@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "framebuffer_lcd.hpp"
+#include "host_app_stubs.hpp"
+#include "host_event_loop.hpp"
+#include "ui_navigation.hpp"
+
+#include "ble_rx_app.hpp"
+#include "ism_app.hpp"
+#include "ui_looking_glass_app.hpp"
+#include "ui_recon.hpp"
+
+using namespace ui;
+
+namespace {
+
+/* Stands in for the main menu at the bottom of the stack, which the
+ * navigation view never pops. */
+class HomeView : public View {
+   public:
+    HomeView(NavigationView&) {}
+};
+
+/* A NavigationView filling the screen, the way SystemView hosts apps. */
+struct AppHarness {
+    HostEventLoop loop{};
+    NavigationView nav{};
+
+    AppHarness() {
+        host_app::reset();
+        nav.set_parent_rect({0, 0, screen_width, screen_height});
+        loop.root().add_child(&nav);
+        nav.push<HomeView>();
+    }
+
+    ~AppHarness() {
+        nav.home(false);
+        loop.root().remove_child(&nav);
+    }
+};
+
+}  // namespace
+
+TEST_SUITE_BEGIN("Application views");
+
+TEST_CASE("Looking Glass instantiates, paints and streams the spectrum.") {
+    AppHarness app;
+
+    auto view = app.nav.push<GlassView>();
+    REQUIRE(view != nullptr);
+    CHECK(host_app::baseband_state.image == portapack::spi_flash::image_tag_wideband_spectrum);
+    CHECK(host_app::radio_state.enabled);
+
+    // Streaming starts once the view is first shown.
+    CHECK(app.loop.frame().pixels_written > 0);
+    CHECK(host_app::baseband_state.spectrum_streaming);
+    // Nothing changed, so nothing is repainted.
+    CHECK(app.loop.frame().pixels_written == 0);
+
+    DisplayFrameSyncMessage frame_sync{};
+    CHECK(app.loop.send(&frame_sync));
+
+    app.nav.pop();
+    CHECK_FALSE(host_app::baseband_state.spectrum_streaming);
+    CHECK_FALSE(host_app::radio_state.enabled);
+    // The view's handlers went with it.
+    CHECK_FALSE(app.loop.send(&frame_sync));
+}
+
+TEST_CASE("Recon instantiates and paints.") {
+    AppHarness app;
+
+    auto view = app.nav.push<ReconView>();
+    REQUIRE(view != nullptr);
+    CHECK(host_app::baseband_state.image_runs > 0);
+
+    CHECK(app.loop.frame().pixels_written > 0);
+
+    app.nav.pop();
+    CHECK(host_app::baseband_state.shutdowns > 0);
+}
+
+TEST_CASE("BLE Rx lists a received packet.") {
+    AppHarness app;
+
+    auto view = app.nav.push<BLERxView>();
+    REQUIRE(view != nullptr);
+    CHECK(host_app::baseband_state.image == portapack::spi_flash::image_tag_btle_rx);
+
+    app.loop.frame();
+    CHECK(app.loop.frame().pixels_written == 0);
+
+    BlePacketData packet{};
+    packet.max_dB = -40;
+    packet.type = 0;  // ADV_IND
+    packet.size = 12;
+    packet.macAddress[0] = 0x11;
+    packet.macAddress[5] = 0x66;
+    packet.dataLen = 6;
+    BLEPacketMessage message{&packet};
+    CHECK(app.loop.send(&message));
+
+    // The new entry is drawn into the list.
+    CHECK(app.loop.frame().pixels_written > 0);
+
+    app.nav.pop();
+    CHECK_FALSE(app.loop.send(&message));
+}
+
+TEST_CASE("ISM Multi logs a decoded packet.") {
+    AppHarness app;
+
+    auto view = app.nav.push<external_app::ismrx::ISMAppView>();
+    REQUIRE(view != nullptr);
+    CHECK(host_app::baseband_state.image == portapack::spi_flash::image_tag_ism);
+    CHECK(host_app::baseband_state.ism_decoders == ism::all_decoders);
+
+    app.loop.frame();
+    CHECK(app.loop.frame().pixels_written == 0);
+
+    ISMPacketMessage message{ism::Protocol::Weather, 3, 40, 0x0123456789ull};
+    framebuffer::reset_stats();
+    CHECK(app.loop.send(&message));
+
+    // The console draws the decode straight away, not on the next frame.
+    CHECK(framebuffer::stats().pixels_written > 0);
+
+    app.nav.pop();
+    CHECK(host_app::baseband_state.shutdowns == 1);
+    CHECK_FALSE(app.loop.send(&message));
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "replay_thread.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+/* Serves count bytes of fill, the way a file reads. */
+class PatternReader : public stream::Reader {
+   public:
+    PatternReader(const uint8_t fill, const size_t count)
+        : fill_{fill}, remaining_{count} {}
+
+    File::Result<File::Size> read(void* const buffer, const File::Size bytes) override {
+        reads.push_back(bytes);
+        File::Size n = std::min<File::Size>(bytes, remaining_);
+        std::memset(buffer, fill_, n);
+        remaining_ -= n;
+        return n;
+    }
+
+    std::vector<File::Size> reads{};
+
+   private:
+    uint8_t fill_;
+    size_t remaining_;
+};
+
+class FailingReader : public stream::Reader {
+   public:
+    File::Result<File::Size> read(void* const, const File::Size) override {
+        return File::Error{FR_DISK_ERR};
+    }
+};
+
+/* A stream buffer over its own storage, poisoned to show stale bytes. */
+struct Buffer {
+    std::array<uint8_t, 1024> data{};
+    StreamBuffer stream{data.data(), data.size()};
+
+    Buffer() { data.fill(0xee); }
+
+    size_t count(const uint8_t value, const size_t size) const {
+        return std::count(data.begin(), data.begin() + size, value);
+    }
+};
+
+}  // namespace
+
+TEST_SUITE_BEGIN("ReplayThread");
+
+TEST_CASE("fill reads whole buffers and only the last one is short.") {
+    std::unique_ptr<stream::Reader> reader = std::make_unique<PatternReader>(0x11, 2500);
+    Buffer buffer;
+
+    auto result = ReplayThread::fill(buffer.stream, reader, {});
+    CHECK(result.value() == 1024);
+    CHECK(buffer.stream.size() == 1024);
+
+    result = ReplayThread::fill(buffer.stream, reader, {});
+    CHECK(result.value() == 1024);
+
+    result = ReplayThread::fill(buffer.stream, reader, {});
+    CHECK(result.value() == 452);
+    CHECK(buffer.stream.size() == 452);
+
+    result = ReplayThread::fill(buffer.stream, reader, {});
+    CHECK(result.value() == 0);
+}
+
+TEST_CASE("fill starts the next track at a fresh buffer.") {
+    std::unique_ptr<stream::Reader> reader = std::make_unique<PatternReader>(0xaa, 1500);
+    size_t continuations = 0;
+    PatternReader* second = nullptr;
+    const ReplayThread::Continuation next_track = [&](std::unique_ptr<stream::Reader>& r) {
+        if (continuations++ > 0)
+            return false;
+        auto track = std::make_unique<PatternReader>(0xbb, 1024);
+        second = track.get();
+        r = std::move(track);
+        return true;
+    };
+
+    Buffer buffer;
+    CHECK(ReplayThread::fill(buffer.stream, reader, next_track).value() == 1024);
+    CHECK(buffer.count(0xaa, 1024) == 1024);
+
+    // The end of the first track goes out short...
+    buffer.data.fill(0xee);
+    CHECK(ReplayThread::fill(buffer.stream, reader, next_track).value() == 476);
+    CHECK(buffer.count(0xaa, 476) == 476);
+    CHECK(continuations == 1);
+
+    // ...and the second one is read from the front of the next buffer, in
+    // one whole-buffer read.
+    buffer.data.fill(0xee);
+    CHECK(ReplayThread::fill(buffer.stream, reader, next_track).value() == 1024);
+    CHECK(buffer.count(0xbb, 1024) == 1024);
+    REQUIRE(second != nullptr);
+    CHECK(second->reads.front() == 1024);
+
+    CHECK(ReplayThread::fill(buffer.stream, reader, next_track).value() == 0);
+    CHECK(continuations == 2);
+}
+
+TEST_CASE("fill runs straight into the next track when a buffer ends with the last one.") {
+    std::unique_ptr<stream::Reader> reader = std::make_unique<PatternReader>(0xaa, 1024);
+    bool continued = false;
+    const ReplayThread::Continuation next_track = [&](std::unique_ptr<stream::Reader>& r) {
+        if (continued)
+            return false;
+        continued = true;
+        r = std::make_unique<PatternReader>(0xbb, 1024);
+        return true;
+    };
+
+    Buffer buffer;
+    CHECK(ReplayThread::fill(buffer.stream, reader, next_track).value() == 1024);
+    CHECK(ReplayThread::fill(buffer.stream, reader, next_track).value() == 1024);
+    CHECK(buffer.count(0xbb, 1024) == 1024);
+}
+
+TEST_CASE("fill ends the stream on an empty track after a continuation.") {
+    std::unique_ptr<stream::Reader> reader = std::make_unique<PatternReader>(0xaa, 0);
+    size_t rewinds = 0;
+    const ReplayThread::Continuation rewind = [&](std::unique_ptr<stream::Reader>&) {
+        rewinds++;
+        return true;
+    };
+
+    Buffer buffer;
+    CHECK(ReplayThread::fill(buffer.stream, reader, rewind).value() == 0);
+    CHECK(rewinds == 1);
+}
+
+TEST_CASE("fill passes read errors on.") {
+    std::unique_ptr<stream::Reader> reader = std::make_unique<FailingReader>();
+    Buffer buffer;
+    CHECK(ReplayThread::fill(buffer.stream, reader, {}).is_error());
+}
+
+TEST_CASE("A short stream buffer is read from its front.") {
+    Buffer buffer;
+    buffer.data.fill(0x11);
+    buffer.data[0] = 0x22;
+    buffer.stream.set_size(100);
+
+    std::array<uint8_t, 60> out{};
+    CHECK(buffer.stream.read(out.data(), out.size()) == 60);
+    CHECK(out[0] == 0x22);
+    CHECK(buffer.stream.size() == 40);
+    CHECK(buffer.stream.read(out.data(), out.size()) == 40);
+    CHECK(buffer.stream.is_empty());
+}
+
+TEST_SUITE_END();
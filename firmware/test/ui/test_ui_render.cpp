@@ -0,0 +1,270 @@
+/*
+ * Copyright (C) 2025 PortaPack Mayhem contributors
+ *
+ * This file is part of PortaPack.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include "doctest.h"
+#include "framebuffer_lcd.hpp"
+#include "host_event_loop.hpp"
+#include "portapack.hpp"
+#include "ui_widget.hpp"
+
+#include <cstdlib>
+
+using namespace ui;
+
+namespace {
+
+constexpr uint32_t screen_area = screen_width * screen_height;
+
+/* Set UI_TEST_DUMP to a directory to get the screens as PPM files. */
+void dump(const char* name) {
+    if (auto dir = std::getenv("UI_TEST_DUMP"))
+        framebuffer::write_ppm(std::string{dir} + "/" + name + ".ppm");
+}
+
+void report(const char* name, const HostEventLoop::FrameMetrics& m) {
+    MESSAGE(std::string{name}, ": ", m.pixels_written, " px, ", m.ram_writes, " windows, ", m.microseconds, " us");
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("UI rendering");
+
+TEST_CASE("First frame paints every pixel exactly once.") {
+    HostEventLoop loop;
+    Text text{{16, 32, 128, 16}, "Hello"};
+    Rectangle box{{16, 64, 64, 64}, Color::red()};
+    loop.root().add_children({&text, &box});
+
+    auto metrics = loop.frame();
+    report("first frame", metrics);
+    dump("first_frame");
+
+    // Opaque children are cut out of the background fill.
+    CHECK_EQ(metrics.pixels_written, screen_area);
+    CHECK_EQ(framebuffer::count_pixels({16, 64, 64, 64}, Color::red()), 64 * 64);
+}
+
+TEST_CASE("Clean tree paints nothing.") {
+    HostEventLoop loop;
+    Text text{{16, 32, 128, 16}, "Hello"};
+    loop.root().add_child(&text);
+
+    loop.frame();
+    CHECK_EQ(loop.frame().pixels_written, 0);
+}
+
+TEST_CASE("Text renders glyphs over its background.") {
+    HostEventLoop loop;
+    Text text{{0, 0, 80, 16}, "WWWW"};
+    loop.root().add_child(&text);
+    loop.frame();
+
+    const auto fg = text.style().foreground;
+    const auto glyphs = framebuffer::count_pixels({0, 0, 32, 16}, fg);
+    CHECK(glyphs > 0);
+    CHECK(glyphs < 32 * 16);
+
+    // Nothing past the string.
+    CHECK_EQ(framebuffer::count_pixels({32, 0, 48, 16}, fg), 0);
+}
+
+TEST_CASE("Changing text only repaints the text.") {
+    HostEventLoop loop;
+    Text text{{16, 32, 128, 16}, "Hello"};
+    loop.root().add_child(&text);
+    loop.frame();
+
+    auto before = framebuffer::checksum();
+    text.set("World");
+    auto metrics = loop.frame();
+    report("set text", metrics);
+
+    CHECK_EQ(metrics.pixels_written, 128 * 16);
+    CHECK(framebuffer::checksum() != before);
+
+    text.set("Hello");
+    loop.frame();
+    CHECK_EQ(framebuffer::checksum(), before);
+}
+
+TEST_CASE("Hiding a widget repaints only what it covered.") {
+    HostEventLoop loop;
+    Rectangle box{{40, 40, 32, 32}, Color::green()};
+    loop.root().add_child(&box);
+    loop.frame();
+
+    box.hidden(true);
+    auto metrics = loop.frame();
+    report("hide", metrics);
+    dump("hidden");
+
+    CHECK_EQ(metrics.pixels_written, 32 * 32);
+    CHECK_EQ(framebuffer::count_pixels({40, 40, 32, 32}, Color::green()), 0);
+}
+
+TEST_CASE("Occluded widgets aren't painted.") {
+    HostEventLoop loop;
+    Rectangle under{{40, 40, 32, 32}, Color::green()};
+    Rectangle over{{32, 32, 48, 48}, Color::blue()};
+    loop.root().add_children({&under, &over});
+
+    auto metrics = loop.frame();
+    CHECK_EQ(metrics.pixels_written, screen_area);
+    CHECK_EQ(framebuffer::count_pixels({32, 32, 48, 48}, Color::blue()), 48 * 48);
+}
+
+TEST_CASE("A sibling painted first doesn't occlude.") {
+    HostEventLoop loop;
+    Rectangle over{{32, 32, 48, 48}, Color::blue()};
+    Rectangle under{{40, 40, 32, 32}, Color::green()};
+    loop.root().add_children({&over, &under});
+
+    loop.frame();
+    CHECK_EQ(framebuffer::count_pixels({40, 40, 32, 32}, Color::green()), 32 * 32);
+}
+
+TEST_CASE("A partly covered widget is painted.") {
+    HostEventLoop loop;
+    Rectangle under{{40, 40, 32, 32}, Color::green()};
+    Rectangle over{{56, 40, 32, 32}, Color::blue()};
+    loop.root().add_children({&under, &over});
+
+    loop.frame();
+    CHECK_EQ(framebuffer::count_pixels({40, 40, 16, 32}, Color::green()), 16 * 32);
+    CHECK_EQ(framebuffer::count_pixels({56, 40, 32, 32}, Color::blue()), 32 * 32);
+}
+
+TEST_CASE("The background fill around a column of widgets merges windows.") {
+    HostEventLoop loop;
+    Rectangle rows[] = {
+        {{16, 16, 64, 32}, Color::red()},
+        {{16, 48, 64, 32}, Color::green()},
+        {{16, 80, 64, 32}, Color::blue()},
+        {{16, 112, 64, 32}, Color::red()},
+    };
+    for (auto& row : rows)
+        loop.root().add_child(&row);
+
+    auto metrics = loop.frame();
+    report("column", metrics);
+
+    // Above, left, right and below of the column, then one per row.
+    CHECK_EQ(metrics.pixels_written, screen_area);
+    CHECK_EQ(metrics.ram_writes, 4 + 4);
+}
+
+namespace {
+
+/* A container that draws its own text, like a view with labels. */
+class LabelledView : public View {
+   public:
+    LabelledView(Rect parent_rect)
+        : View{parent_rect} {
+        add_child(&corner);
+    }
+
+    void paint(Painter& painter) override {
+        View::paint(painter);
+        painter.draw_string(screen_pos(), style(), "WWWWWWWWWWWWWWWWWWWWWWWWWWWWWW");
+    }
+
+    Rectangle corner{{200, 200, 8, 8}, Color::white()};
+};
+
+}  // namespace
+
+TEST_CASE("Repairing damage clips glyphs to the damage.") {
+    HostEventLoop loop;
+    LabelledView view{{0, 0, 240, 240}};
+    Rectangle box{{12, 4, 40, 40}, Color::green()};
+    loop.root().add_children({&view, &box});
+    loop.frame();
+
+    // Marks just outside the damage, inside glyphs that straddle its edges.
+    auto& display = portapack::display;
+    display.draw_pixel({10, 8}, Color::red());
+    display.draw_pixel({53, 8}, Color::red());
+
+    box.hidden(true);
+    auto metrics = loop.frame();
+    dump("clipped_glyphs");
+
+    CHECK_EQ(framebuffer::pixel({10, 8}).v, Color::red().v);
+    CHECK_EQ(framebuffer::pixel({53, 8}).v, Color::red().v);
+    CHECK_EQ(framebuffer::count_pixels({12, 4, 40, 40}, Color::green()), 0);
+    CHECK(metrics.pixels_written <= 2 * 40 * 40);
+}
+
+TEST_CASE("Replayed keys move focus between buttons.") {
+    HostEventLoop loop;
+    Button first{{8, 8, 96, 32}, "One"};
+    Button second{{8, 48, 96, 32}, "Two"};
+    int selected = 0;
+    second.on_select = [&selected](Button&) { selected++; };
+    loop.root().add_children({&first, &second});
+    first.focus();
+    loop.frame();
+
+    auto metrics = loop.replay("DFSF");
+    report("focus and select", metrics);
+    dump("buttons");
+
+    CHECK_EQ(metrics.frames, 2);
+    CHECK(second.has_focus());
+    CHECK_EQ(selected, 1);
+
+    // Only the two buttons are repainted, never the background.
+    CHECK(metrics.pixels_written > 0);
+    CHECK(metrics.pixels_written <= 2 * (2 * 96 * 32));
+}
+
+TEST_CASE("Golden screen matches.") {
+    HostEventLoop loop;
+    Text title{{0, 0, 240, 16}, "PortaPack"};
+    Button button{{8, 24, 112, 32}, "Select"};
+    Rectangle bar{{0, 304, 240, 16}, Color::dark_blue()};
+    loop.root().add_children({&title, &button, &bar});
+    button.focus();
+    loop.frame();
+    dump("golden");
+
+    // Update when the theme, fonts or widget painting change on purpose.
+    CHECK_EQ(framebuffer::checksum(), 0x4a88e139u);
+}
+
+TEST_CASE("Scrolling area wraps at the start address.") {
+    HostEventLoop loop;
+    auto& display = portapack::display;
+    display.fill_rectangle({0, 100, 240, 10}, Color::red());
+
+    display.scroll_set_area(100, 200);
+    display.scroll_set_position(0);
+    CHECK_EQ(framebuffer::pixel({0, 100}).v, Color::red().v);
+
+    // Content moves down by the scrolled amount.
+    display.scroll(10);
+    CHECK_EQ(framebuffer::pixel({0, 100}).v, Color::black().v);
+    CHECK_EQ(framebuffer::pixel({0, 110}).v, Color::red().v);
+
+    display.scroll_disable();
+}
+
+TEST_SUITE_END();
@@ -54,6 +54,7 @@ message(STATUS "Toolchain prefix: ${CMAKE_INSTALL_PREFIX}")
 set(CMAKE_ASM_COMPILER ${CMAKE_C_COMPILER})
 #set(CMAKE_LD ${CMAKE_INSTALL_PREFIX}/bin/ld CACHE INTERNAL "ld tool")
 set(CMAKE_OBJCOPY ${CMAKE_INSTALL_PREFIX}/bin/objcopy CACHE INTERNAL "objcopy tool")
+set(CMAKE_NM ${CMAKE_INSTALL_PREFIX}/bin/nm CACHE INTERNAL "nm tool")
 
 set(CMAKE_FIND_ROOT_PATH ${CMAKE_INSTALL_PREFIX})
 set(CMAKE_FIND_ROOT_PATH_MODE_PROGRAM NEVER)
@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+
+#
+# Copyright (C) 2025 PortaPack Mayhem contributors
+#
+# This file is part of PortaPack.
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2, or (at your option)
+# any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+
+# Prints the RAM budget of firmware images: how the image RAM is split
+# between code, static data, stacks and the heap left for runtime
+# allocations, plus the largest static buffers. Reads the linker symbols
+# with nm, so it works on any M0 or M4 ELF built with the PortaPack
+# linker scripts.
+
+import argparse
+import os
+import subprocess
+import sys
+
+FLASH_SYMBOLS = ('_text', '_textend')
+SECTIONS = [
+    ('stacks', '__main_stack_base__', '__process_stack_end__'),
+    ('data', '_data', '_edata'),
+    ('bss', '_bss_start', '_bss_end'),
+    ('heap', '__heap_base__', '__heap_end__'),
+]
+STATIC_TYPES = 'bBdD'
+
+
+def read_symbols(nm, elf):
+    output = subprocess.check_output([nm, '-S', elf], universal_newlines=True)
+    addresses = {}
+    statics = []
+    for line in output.splitlines():
+        fields = line.split()
+        if len(fields) == 3:
+            addresses[fields[2]] = int(fields[0], 16)
+        elif len(fields) == 4 and fields[2] in STATIC_TYPES:
+            statics.append((int(fields[1], 16), fields[3]))
+    statics.sort(reverse=True)
+    return addresses, statics
+
+
+def budget(nm, elf, top):
+    addresses, statics = read_symbols(nm, elf)
+    row = {'image': os.path.basename(elf).replace('.elf', '')}
+    for name, start, end in SECTIONS:
+        if start not in addresses or end not in addresses:
+            raise ValueError('%s: missing symbol %s or %s' % (elf, start, end))
+        row[name] = addresses[end] - addresses[start]
+    if all(s in addresses for s in FLASH_SYMBOLS):
+        row['code'] = addresses[FLASH_SYMBOLS[1]] - addresses[FLASH_SYMBOLS[0]]
+    else:
+        row['code'] = 0
+    row['largest'] = ', '.join('%s %d' % (name, size) for size, name in statics[:top])
+    return row
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Print the RAM budget of PortaPack firmware images.')
+    parser.add_argument('elves', nargs='+', help='image ELF files')
+    parser.add_argument('--nm', default='arm-none-eabi-nm', help='nm tool')
+    parser.add_argument('-o', '--output', help='also write the table to this file')
+    parser.add_argument('-t', '--top', type=int, default=3, help='number of largest static buffers listed')
+    parser.add_argument('-m', '--min-heap', type=int, default=0, help='fail if an image has less heap than this')
+    args = parser.parse_args()
+
+    rows = [budget(args.nm, elf, args.top) for elf in args.elves]
+    rows.sort(key=lambda row: row['heap'])
+
+    lines = ['%-28s %6s %6s %6s %6s %6s  %s' % ('image', 'code', 'stacks', 'data', 'bss', 'heap', 'largest static')]
+    for row in rows:
+        lines.append('%-28s %6d %6d %6d %6d %6d  %s' % (
+            row['image'], row['code'], row['stacks'], row['data'], row['bss'], row['heap'], row['largest']))
+    table = '\n'.join(lines) + '\n'
+
+    sys.stdout.write(table)
+    if args.output:
+        with open(args.output, 'w') as f:
+            f.write(table)
+
+    short = [row['image'] for row in rows if row['heap'] < args.min_heap]
+    if short:
+        sys.exit('heap below %d bytes: %s' % (args.min_heap, ', '.join(short)))
+
+
+if __name__ == '__main__':
+    main()
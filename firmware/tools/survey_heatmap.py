@@ -0,0 +1,180 @@
+#!/usr/bin/env python3
+
+#
+# Copyright (C) 2025 PortaPack Mayhem contributors
+#
+# This file is part of PortaPack.
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2, or (at your option)
+# any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street,
+# Boston, MA 02110-1301, USA.
+#
+
+# Renders Looking Glass band survey files (LOOKINGGLASS/SURVEY_????.PHM)
+# to a PNG heatmap. See firmware/application/spectrum_survey.hpp for the
+# file layout.
+
+import argparse
+import struct
+import sys
+from datetime import datetime, timedelta
+
+HEADER_FORMAT = '<IHHQQIBBHHBBBBBB'
+HEADER_SIZE = struct.calcsize(HEADER_FORMAT)
+# Version 1 files stored a 16-bit sweep count.
+RECORD_FORMATS = {1: '<IHH', 2: '<IIHH'}
+FILE_MAGIC = 0x4D485050
+ROWS_PER_RECORD = 3
+STAT_NAMES = ['max', 'mean', 'occupancy']
+
+
+def decode_row(data, pos, width):
+    row = bytearray(width)
+    row[0] = data[pos]
+    pos += 1
+    i = 1
+    while i < width:
+        value = data[pos]
+        pos += 1
+        if value != 0:
+            row[i] = (row[i - 1] + value) & 0xFF
+            i += 1
+            continue
+        run = data[pos]
+        pos += 1
+        if run == 0 or i + run > width:
+            raise ValueError('malformed row')
+        for _ in range(run):
+            row[i] = row[i - 1]
+            i += 1
+    return row, pos
+
+
+def read_survey(filename):
+    with open(filename, 'rb') as f:
+        data = f.read()
+
+    if len(data) < HEADER_SIZE:
+        raise ValueError('%s: file too short' % filename)
+
+    fields = struct.unpack_from(HEADER_FORMAT, data, 0)
+    (magic, version, width, f_min, f_max, bucket_seconds, threshold, _,
+     index_capacity, year, month, day, hour, minute, second, _) = fields
+    if magic != FILE_MAGIC:
+        raise ValueError('%s: not a survey file' % filename)
+    if version not in RECORD_FORMATS:
+        raise ValueError('%s: unsupported version %d' % (filename, version))
+    record_format = RECORD_FORMATS[version]
+    record_size = struct.calcsize(record_format)
+
+    header = {
+        'version': version,
+        'width': width,
+        'f_min': f_min,
+        'f_max': f_max,
+        'bucket_seconds': bucket_seconds,
+        'threshold': threshold,
+        'start': datetime(year, month, day, hour, minute, second) if year else None,
+    }
+
+    offsets = struct.unpack_from('<%dI' % index_capacity, data, HEADER_SIZE)
+    records = []
+    for offset in offsets:
+        if offset == 0 or offset + record_size > len(data):
+            break  # End of index, or record lost to a power cut.
+        elapsed, sweeps, payload_size = struct.unpack_from(record_format, data, offset)[:3]
+        pos = offset + record_size
+        if pos + payload_size > len(data):
+            break
+        rows = []
+        for _ in range(ROWS_PER_RECORD):
+            row, pos = decode_row(data, pos, width)
+            rows.append(row)
+        records.append((elapsed, sweeps, rows))
+
+    return header, records
+
+
+def colorize(value):
+    # Black -> blue -> green -> yellow -> red, like the waterfall.
+    stops = [(0, 0, 0), (0, 0, 255), (0, 255, 0), (255, 255, 0), (255, 0, 0)]
+    pos = value * (len(stops) - 1) / 255.0
+    i = min(int(pos), len(stops) - 2)
+    t = pos - i
+    a, b = stops[i], stops[i + 1]
+    return tuple(int(a[c] + (b[c] - a[c]) * t) for c in range(3))
+
+
+def render(header, records, stat, scale):
+    from PIL import Image, ImageDraw
+
+    width = header['width']
+    height = len(records)
+    image = Image.new('RGB', (width, height))
+    lut = [colorize(v) for v in range(256)]
+    pixels = image.load()
+    for y, (_, _, rows) in enumerate(records):
+        row = rows[STAT_NAMES.index(stat)]
+        for x in range(width):
+            pixels[x, y] = lut[row[x]]
+
+    if scale > 1:
+        image = image.resize((width * scale, height * scale), Image.NEAREST)
+
+    # Frequency axis labels along the bottom.
+    margin = 14
+    framed = Image.new('RGB', (image.width, image.height + margin))
+    framed.paste(image, (0, 0))
+    draw = ImageDraw.Draw(framed)
+    draw.text((2, image.height + 1), '%.3f' % (header['f_min'] / 1e6), fill=(255, 255, 255))
+    label = '%.3f MHz' % (header['f_max'] / 1e6)
+    draw.text((framed.width - 6 * len(label) - 2, image.height + 1), label, fill=(255, 255, 255))
+    return framed
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Render PortaPack Looking Glass survey heatmaps.')
+    parser.add_argument('files', nargs='+', help='SURVEY_????.PHM files, rendered in order')
+    parser.add_argument('-o', '--output', default='survey.png', help='output PNG file')
+    parser.add_argument('-s', '--stat', choices=STAT_NAMES, default='max', help='statistic to plot')
+    parser.add_argument('-x', '--scale', type=int, default=2, help='pixel scale factor')
+    parser.add_argument('-i', '--info', action='store_true', help='print file summary only')
+    args = parser.parse_args()
+
+    header = None
+    records = []
+    for filename in args.files:
+        file_header, file_records = read_survey(filename)
+        if header and (file_header['f_min'], file_header['f_max']) != (header['f_min'], header['f_max']):
+            sys.exit('%s: frequency range differs from previous files' % filename)
+        header = header or file_header
+        records.extend(file_records)
+
+    start = header['start']
+    print('range      %.3f - %.3f MHz' % (header['f_min'] / 1e6, header['f_max'] / 1e6))
+    print('bucket     %d s, threshold %d' % (header['bucket_seconds'], header['threshold']))
+    print('records    %d' % len(records))
+    if start and records:
+        print('start      %s' % start)
+        print('end        %s' % (start + timedelta(seconds=records[-1][0] + header['bucket_seconds'])))
+
+    if args.info or not records:
+        return
+
+    render(header, records, args.stat, args.scale).save(args.output)
+    print('wrote      %s' % args.output)
+
+
+if __name__ == '__main__':
+    main()